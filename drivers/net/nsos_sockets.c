@@ -145,6 +145,9 @@ static int socket_flags_to_nsos_mid(int flags)
 	nsos_socket_flag_convert(&flags, ZSOCK_MSG_WAITALL,
 				 &flags_mid, NSOS_MID_MSG_WAITALL);
 
+	/* Only a hint, the host stack does not need it */
+	flags &= ~ZSOCK_MSG_MORE;
+
 	if (flags != 0) {
 		return -NSOS_MID_EINVAL;
 	}
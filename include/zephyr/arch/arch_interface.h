@@ -938,6 +938,25 @@ static inline void arch_cohere_stacks(struct k_thread *old_thread,
 }
 #endif
 
+#ifdef CONFIG_ARCH_HAS_NET_CHKSUM
+/**
+ * @brief Add data to an Internet checksum
+ *
+ * Required when ARCH_HAS_NET_CHKSUM is true.  Adds the data to the
+ * one's complement sum of RFC 1071, e.g. with SIMD or add-with-carry
+ * instructions.  The data is read as 16-bit words in native byte order.
+ *
+ * @param sum Partial sum to add the data to
+ * @param data Data to add, aligned to 4 bytes
+ * @param len Length of the data in bytes, a multiple of 4
+ *
+ * @return Partial sum which folds to the same 16-bit value as @a sum plus
+ *         the words of @a data, and is below 2^48 so that more words can
+ *         be added to it
+ */
+uint64_t arch_net_chksum_add(uint64_t sum, const void *data, size_t len);
+#endif
+
 /** @} */
 
 /**
@@ -22,6 +22,7 @@
 #include <zephyr/tracing/tracing_macros.h>
 #include <zephyr/sys/mem_stats.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/mpmc_lockfree.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -72,6 +73,7 @@ struct k_thread;
 struct k_mutex;
 struct k_sem;
 struct k_msgq;
+struct k_mpmcq;
 struct k_mbox;
 struct k_pipe;
 struct k_queue;
@@ -4045,6 +4047,38 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Pool this queue is a worker of, if any. */
+	struct k_work_pool *pool;
+#endif /* CONFIG_WORKQUEUE_POOL */
+};
+
+/** @brief A structure holding a pool of work queues sharing their work.
+ *
+ * Each worker of the pool is a regular work queue, with its own thread
+ * and list of pending work.  A worker that runs out of work steals
+ * pending items from its siblings, so a slow handler only stalls the
+ * worker running it.
+ *
+ * Use K_WORK_POOL_DEFINE() to define a pool.
+ */
+struct k_work_pool {
+	/* The workers of the pool. */
+	struct k_work_q *workers;
+
+	/* Stacks of the workers, stack_stride bytes apart. */
+	k_thread_stack_t *stacks;
+	size_t stack_stride;
+	size_t stack_size;
+
+	/* Number of workers. */
+	uint8_t num_workers;
+
+	/* Next worker to submit to, accessed only while the work module
+	 * spinlock is held.
+	 */
+	uint8_t next;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4083,6 +4117,123 @@ static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue)
 	return &queue->thread;
 }
 
+/**
+ * @brief Statically define a work queue pool.
+ *
+ * The pool must be started with k_work_pool_start() before use.
+ *
+ * @param name Name of the work queue pool.
+ * @param _num_workers Number of worker threads, at most 255.
+ * @param _stack_size Stack size of each worker thread, in bytes.
+ */
+#define K_WORK_POOL_DEFINE(name, _num_workers, _stack_size)			\
+	BUILD_ASSERT(((_num_workers) > 0) && ((_num_workers) <= UINT8_MAX));	\
+	static K_THREAD_STACK_ARRAY_DEFINE(_k_work_pool_stacks_##name,		\
+					   _num_workers, _stack_size);		\
+	static struct k_work_q _k_work_pool_workers_##name[_num_workers];	\
+	struct k_work_pool name = {						\
+		.workers = _k_work_pool_workers_##name,				\
+		.stacks = &_k_work_pool_stacks_##name[0][0],			\
+		.stack_stride = sizeof(_k_work_pool_stacks_##name[0]),		\
+		.stack_size = K_THREAD_STACK_SIZEOF(_k_work_pool_stacks_##name[0]), \
+		.num_workers = (_num_workers),					\
+	}
+
+/** @brief Start the workers of a work queue pool.
+ *
+ * @param pool pointer to the pool, defined with K_WORK_POOL_DEFINE().
+ *
+ * @param prio initial priority of the worker threads.
+ *
+ * @param cfg optional additional configuration parameters, applied to
+ * all workers.  Pass @c NULL if not required.
+ */
+void k_work_pool_start(struct k_work_pool *pool, int prio,
+		       const struct k_work_queue_config *cfg);
+
+/** @brief Submit a work item to a work queue pool.
+ *
+ * The item is queued to one of the workers, preferring the calling
+ * worker when invoked from a handler of the pool, then idle workers.
+ * It may be stolen by another worker before it starts running.  Like
+ * with k_work_submit_to_queue(), an item that is running is queued to
+ * the worker running it, so handlers are never re-entered.
+ *
+ * k_work_cancel(), k_work_flush() and their variants apply unchanged
+ * to items submitted to a pool.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param work pointer to the work item.
+ *
+ * @return as for k_work_submit_to_queue().
+ */
+int k_work_pool_submit(struct k_work_pool *pool, struct k_work *work);
+
+/** @brief Schedule a delayable work item on a work queue pool.
+ *
+ * Like k_work_schedule_for_queue(), with the target worker selected as
+ * for k_work_pool_submit().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param delay the time to wait before submitting the work item.
+ *
+ * @return as for k_work_schedule_for_queue().
+ */
+int k_work_pool_schedule(struct k_work_pool *pool,
+			 struct k_work_delayable *dwork, k_timeout_t delay);
+
+/** @brief Reschedule a delayable work item on a work queue pool.
+ *
+ * Like k_work_reschedule_for_queue(), with the target worker selected
+ * as for k_work_pool_submit().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param delay the time to wait before submitting the work item.
+ *
+ * @return as for k_work_reschedule_for_queue().
+ */
+int k_work_pool_reschedule(struct k_work_pool *pool,
+			   struct k_work_delayable *dwork, k_timeout_t delay);
+
+/** @brief Wait until all workers of a pool have drained.
+ *
+ * Applies k_work_queue_drain() to each worker in turn.
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param plug if true the workers will continue to block new
+ * submissions after all items have drained.
+ *
+ * @retval 1 if call had to wait for the drain to complete
+ * @retval 0 if call did not have to wait
+ * @retval negative if wait was interrupted or failed
+ */
+int k_work_pool_drain(struct k_work_pool *pool, bool plug);
+
+/** @brief Release the workers of a pool to accept new submissions.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @retval 0 if successfully unplugged
+ * @retval -EALREADY if the pool was not plugged.
+ */
+int k_work_pool_unplug(struct k_work_pool *pool);
+
 /** @} */
 
 struct k_work_user;
@@ -4701,6 +4852,170 @@ static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 
 /** @} */
 
+/**
+ * @defgroup mpmcq_apis Lock-free Message Queue APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Lock-free Message Queue Structure
+ *
+ * Like a message queue, but messages go through a lock-free ring, so
+ * putting and getting a message only costs a few atomic operations as
+ * long as the queue is neither full nor empty.  The lock only serializes
+ * threads waiting on the queue and the threads waking them up.
+ */
+struct k_mpmcq {
+	/** Message ring */
+	struct mpmc ring;
+	/** Lock */
+	struct k_spinlock lock;
+	/** Threads waiting for a message */
+	_wait_q_t get_wait_q;
+	/** Threads waiting for room */
+	_wait_q_t put_wait_q;
+	/** Number of threads in or about to enter get_wait_q */
+	atomic_t get_waiters;
+	/** Number of threads in or about to enter put_wait_q */
+	atomic_t put_waiters;
+
+	Z_DECL_POLL_EVENT
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define Z_MPMCQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
+	{ \
+	.ring = MPMC_INITIALIZER(q_buffer, q_msg_size, q_max_msgs), \
+	.get_wait_q = Z_WAIT_Q_INIT(&obj.get_wait_q), \
+	.put_wait_q = Z_WAIT_Q_INIT(&obj.put_wait_q), \
+	Z_POLL_EVENT_OBJ_INIT(obj) \
+	}
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Statically define and initialize a lock-free message queue.
+ *
+ * The message queue's ring buffer holds @a q_max_msgs messages of
+ * @a q_msg_size bytes, plus a sequence number per message.
+ *
+ * The lock-free message queue can be accessed outside the module where it
+ * is defined using:
+ *
+ * @code extern struct k_mpmcq <name>; @endcode
+ *
+ * @param q_name Name of the message queue.
+ * @param q_msg_size Message size (in bytes).
+ * @param q_max_msgs Maximum number of messages that can be queued, a
+ *                   power of 2 of at least 2.
+ */
+#define K_MPMCQ_DEFINE(q_name, q_msg_size, q_max_msgs) \
+	BUILD_ASSERT(IS_POWER_OF_TWO(q_max_msgs) && ((q_max_msgs) > 1), \
+		     "k_mpmcq size must be a power of 2 of at least 2"); \
+	static atomic_t _k_mpmcq_buf_##q_name[ \
+		MPMC_BUF_SIZE(q_msg_size, q_max_msgs) / sizeof(atomic_t)]; \
+	struct k_mpmcq q_name = \
+		Z_MPMCQ_INITIALIZER(q_name, _k_mpmcq_buf_##q_name, \
+				    q_msg_size, q_max_msgs)
+
+/**
+ * @brief Initialize a lock-free message queue.
+ *
+ * This routine initializes a lock-free message queue object, prior to
+ * its first use.
+ *
+ * The ring buffer must be MPMC_BUF_SIZE(@a msg_size, @a max_msgs) bytes
+ * long and aligned to an atomic_t, as every message is stored along
+ * with a sequence number.
+ *
+ * @param q Address of the lock-free message queue.
+ * @param buffer Pointer to ring buffer that holds queued messages.
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued, a
+ *                 power of 2 of at least 2.
+ */
+void k_mpmcq_init(struct k_mpmcq *q, void *buffer, size_t msg_size,
+		  uint32_t max_msgs);
+
+/**
+ * @brief Send a message to a lock-free message queue.
+ *
+ * This routine sends a message to lock-free message queue @a q.
+ *
+ * @note The message content is copied from @a data into @a q and the
+ * @a data pointer is not retained, so the message content will not be
+ * modified by this function.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the lock-free message queue.
+ * @param data Pointer to the message.
+ * @param timeout Waiting period to add the message, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message sent.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_mpmcq_put(struct k_mpmcq *q, const void *data, k_timeout_t timeout);
+
+/**
+ * @brief Receive a message from a lock-free message queue.
+ *
+ * This routine receives a message from lock-free message queue @a q in a
+ * "first in, first out" manner.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the lock-free message queue.
+ * @param data Address of area to hold the received message.
+ * @param timeout Waiting period to receive the message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_mpmcq_get(struct k_mpmcq *q, void *data, k_timeout_t timeout);
+
+/**
+ * @brief Get the number of messages in a lock-free message queue.
+ *
+ * The count includes messages still being copied in or out of the
+ * queue, it is only a snapshot when other threads use the queue.
+ *
+ * @param q Address of the lock-free message queue.
+ *
+ * @return Number of messages.
+ */
+static inline uint32_t k_mpmcq_num_used_get(struct k_mpmcq *q)
+{
+	return (uint32_t)mpmc_num_used(&q->ring);
+}
+
+/**
+ * @brief Get the amount of free space in a lock-free message queue.
+ *
+ * @param q Address of the lock-free message queue.
+ *
+ * @return Number of unused ring buffer entries.
+ */
+static inline uint32_t k_mpmcq_num_free_get(struct k_mpmcq *q)
+{
+	return (uint32_t)(mpmc_capacity(&q->ring) - mpmc_num_used(&q->ring));
+}
+
+/** @} */
+
 /**
  * @defgroup mailbox_apis Mailbox APIs
  * @ingroup kernel_apis
@@ -5080,12 +5395,26 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+/* Free blocks of a memory slab cached by one CPU */
+struct z_mem_slab_cache {
+	struct k_spinlock lock;
+	uint8_t count;
+	void *blocks[CONFIG_MEM_SLAB_CACHE_SIZE];
+};
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
 	char *buffer;
 	char *free_list;
 	struct k_mem_slab_info info;
+#ifdef CONFIG_MEM_SLAB_CACHE
+	struct z_mem_slab_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+	/* allocations past the caches, which may pend */
+	atomic_t cache_bypass;
+#endif /* CONFIG_MEM_SLAB_CACHE */
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
@@ -5104,6 +5433,27 @@ struct k_mem_slab {
 	.info = {_slab_num_blocks, _slab_block_size, 0}               \
 	}
 
+/* Blocks in use.  With CONFIG_MEM_SLAB_CACHE, info.num_used also counts
+ * the free blocks held by the per-CPU caches, which are subtracted here.
+ * The counts are read without locking, as a snapshot.
+ */
+static inline uint32_t z_mem_slab_num_used(struct k_mem_slab *slab)
+{
+	uint32_t used = slab->info.num_used;
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+	uint32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		cached += slab->cache[i].count;
+	}
+
+	used -= MIN(cached, used);
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
+	return used;
+}
+
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -5228,6 +5578,41 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+/**
+ * @brief Allocate multiple memory blocks from a memory slab.
+ *
+ * This routine allocates @a count memory blocks from a memory slab at
+ * once, with a single acquisition of the slab lock. Either all blocks
+ * are allocated, or none is.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of @a count block addresses, set to the starting
+ *            addresses of the memory blocks.
+ * @param count Number of memory blocks to allocate.
+ *
+ * @retval 0 Memory allocated.
+ * @retval -ENOMEM Less than @a count blocks are free.
+ */
+int k_mem_slab_alloc_bulk(struct k_mem_slab *slab, void **mem, uint32_t count);
+
+/**
+ * @brief Free multiple memory blocks allocated from a memory slab.
+ *
+ * This routine releases @a count previously allocated memory blocks
+ * back to their associated memory slab, with a single acquisition of
+ * the slab lock. Threads waiting for a block are given one each.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of @a count memory blocks (as returned by
+ *            k_mem_slab_alloc() or k_mem_slab_alloc_bulk()).
+ * @param count Number of memory blocks to free.
+ */
+void k_mem_slab_free_bulk(struct k_mem_slab *slab, void **mem, uint32_t count);
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5240,7 +5625,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_used;
+	return z_mem_slab_num_used(slab);
 }
 
 /**
@@ -5275,7 +5660,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - z_mem_slab_num_used(slab);
 }
 
 /**
@@ -5312,12 +5697,31 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
  * @{
  */
 
+#ifdef CONFIG_KHEAP_CACHE
+/* Blocks of one size class cached by one CPU */
+struct z_heap_magazine {
+	uint8_t count;
+	void *blocks[CONFIG_KHEAP_CACHE_MAGAZINE_SIZE];
+};
+
+/* Per-CPU front-end cache of a k_heap, see kernel/kheap.c */
+struct z_heap_cache {
+	struct k_spinlock lock;
+	struct z_heap_magazine magazines[CONFIG_KHEAP_CACHE_CLASSES];
+};
+#endif /* CONFIG_KHEAP_CACHE */
+
 /* kernel synchronized heap struct */
 
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_KHEAP_CACHE
+	struct z_heap_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+	/* Allocations which may pend, frees bypass the caches meanwhile */
+	atomic_t cache_bypass;
+#endif /* CONFIG_KHEAP_CACHE */
 };
 
 /**
@@ -5421,6 +5825,24 @@ void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes, k_timeout_t time
  */
 void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+/**
+ * @brief Get the memory stats for a k_heap
+ *
+ * This routine gets the runtime memory usage stats of the sys_heap
+ * underlying @a h, as sys_heap_runtime_stats_get() does.  With
+ * CONFIG_KHEAP_CACHE, the usable bytes of the blocks held by the
+ * per-CPU caches are reported as free rather than allocated.
+ *
+ * @param h Heap to get the statistics of
+ * @param stats Pointer to memory into which to copy memory usage statistics
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Any parameter points to NULL
+ */
+int k_heap_runtime_stats_get(struct k_heap *h, struct sys_memory_stats *stats);
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
@@ -5605,6 +6027,9 @@ enum _poll_types_bits {
 	/* pipe data availability */
 	_POLL_TYPE_PIPE_DATA_AVAILABLE,
 
+	/* lock-free msgq data availability */
+	_POLL_TYPE_MPMCQ_DATA_AVAILABLE,
+
 	_POLL_NUM_TYPES
 };
 
@@ -5633,6 +6058,9 @@ enum _poll_states_bits {
 	/* data is available to read from a pipe */
 	_POLL_STATE_PIPE_DATA_AVAILABLE,
 
+	/* data is available to read on a lock-free message queue */
+	_POLL_STATE_MPMCQ_DATA_AVAILABLE,
+
 	_POLL_NUM_STATES
 };
 
@@ -5665,6 +6093,7 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
 #define K_POLL_TYPE_MSGQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MSGQ_DATA_AVAILABLE)
 #define K_POLL_TYPE_PIPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_PIPE_DATA_AVAILABLE)
+#define K_POLL_TYPE_MPMCQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MPMCQ_DATA_AVAILABLE)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -5682,6 +6111,7 @@ enum k_poll_modes {
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_MSGQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MSGQ_DATA_AVAILABLE)
 #define K_POLL_STATE_PIPE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_PIPE_DATA_AVAILABLE)
+#define K_POLL_STATE_MPMCQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MPMCQ_DATA_AVAILABLE)
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
 
 /* public - poll signal object */
@@ -5744,6 +6174,9 @@ struct k_poll_event {
 		struct k_msgq *msgq, *typed_K_POLL_TYPE_MSGQ_DATA_AVAILABLE;
 #ifdef CONFIG_PIPES
 		struct k_pipe *pipe, *typed_K_POLL_TYPE_PIPE_DATA_AVAILABLE;
+#endif
+#ifdef CONFIG_MPMCQ
+		struct k_mpmcq *mpmcq, *typed_K_POLL_TYPE_MPMCQ_DATA_AVAILABLE;
 #endif
 	};
 };
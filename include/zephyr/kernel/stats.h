@@ -30,4 +30,22 @@ struct k_cycle_stats {
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+#if defined(CONFIG_SCHED_THREAD_WAKEUP_LATENCY) || defined(__DOXYGEN__)
+/**
+ * Structure used to track the latency between a thread being made
+ * ready and it being switched in.
+ */
+struct k_wakeup_latency_stats {
+	uint32_t  ready0;       /**< cycle count when made ready, 0 if running */
+	uint32_t  count;        /**< \# of wakeups */
+	uint32_t  longest;      /**< longest wakeup latency, in cycles */
+	/**
+	 * \# of wakeups per latency range.  Bucket 0 counts latencies of
+	 * less than 2 cycles, bucket N >= 1 those of [2^N, 2^(N+1)) cycles,
+	 * and the last bucket also counts all longer latencies.
+	 */
+	uint32_t  buckets[CONFIG_SCHED_THREAD_WAKEUP_LATENCY_BUCKETS];
+};
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
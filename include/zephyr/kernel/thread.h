@@ -114,6 +114,11 @@ struct _thread_base {
 	/* CPU index on which thread was last run */
 	uint8_t cpu;
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* CPU whose ready queue holds this thread */
+	uint8_t runq_cpu;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
@@ -145,6 +150,10 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+	struct k_wakeup_latency_stats wakeup; /* Track wakeup latencies */
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -237,8 +246,20 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+	/*
+	 * Latencies between the thread being made ready and it being
+	 * switched in, see struct k_wakeup_latency_stats. These fields
+	 * are always zero for the CPU and system statistics.
+	 */
+	uint32_t wakeup_count;        /* # of wakeups */
+	uint32_t wakeup_peak_cycles;  /* longest wakeup latency */
+	uint32_t wakeup_buckets[CONFIG_SCHED_THREAD_WAKEUP_LATENCY_BUCKETS];
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
-	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL) && \
+	!defined(CONFIG_SCHED_THREAD_WAKEUP_LATENCY)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
 	 * which is not allowed in C++ (it'll have a size 1). To prevent this, we add a 1 byte dummy
 	 * variable when the struct would otherwise be empty.
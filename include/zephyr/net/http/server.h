@@ -25,6 +25,11 @@
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/socket.h>
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+#include <zephyr/fs/fs.h>
+#include <zephyr/net/http/status.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -44,9 +49,14 @@ extern "C" {
 #endif
 
 /* Maximum header field name / value length. This is only used to detect Upgrade and
- * websocket header fields and values in the http1 server so the value is quite short.
+ * websocket header fields and values in the http1 server so the value is quite short,
+ * unless the longer request headers of file system resources are used.
  */
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+#define HTTP_SERVER_MAX_HEADER_LEN CONFIG_HTTP_SERVER_STATIC_FS_HEADER_LEN
+#else
 #define HTTP_SERVER_MAX_HEADER_LEN 32
+#endif
 
 #define HTTP2_PREFACE "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
 
@@ -68,6 +78,11 @@ enum http_resource_type {
 	 *  after and upgrade.
 	 */
 	HTTP_RESOURCE_TYPE_WEBSOCKET,
+
+	/** Static file system resource, files are read from a mounted file
+	 *  system when requested.
+	 */
+	HTTP_RESOURCE_TYPE_STATIC_FS,
 };
 
 /**
@@ -115,6 +130,28 @@ struct http_resource_detail_static {
 BUILD_ASSERT(offsetof(struct http_resource_detail_static, common) == 0);
 /** @endcond */
 
+/**
+ * @brief Representation of a static file system resource.
+ *
+ * The file served for a request is the request path, without the query
+ * string, appended to @a fs_path. "index.html" is added to a path ending
+ * with '/'. When the client accepts it, a precompressed variant of the file
+ * with a ".br" or ".gz" suffix is sent instead, if it exists.
+ */
+struct http_resource_detail_static_fs {
+	/** Common resource details. The content type is guessed from the file
+	 *  name extension when not set.
+	 */
+	struct http_resource_detail common;
+
+	/** Directory of the files, for example "/lfs1/www". */
+	const char *fs_path;
+};
+
+/** @cond INTERNAL_HIDDEN */
+BUILD_ASSERT(offsetof(struct http_resource_detail_static_fs, common) == 0);
+/** @endcond */
+
 struct http_client_ctx;
 
 /** Indicates the status of the currently processed piece of data.  */
@@ -268,6 +305,36 @@ enum http1_parser_state {
 #define HTTP_SERVER_INITIAL_WINDOW_SIZE 65536
 #define HTTP_SERVER_WS_MAX_SEC_KEY_LEN 32
 
+/* Initial flow-control window of the peer, until it sends another one in its
+ * SETTINGS frame (RFC 9113, section 6.9.2).
+ */
+#define HTTP_SERVER_DEFAULT_TX_WINDOW_SIZE 65535
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+/* File being sent in response to a request for a file system resource */
+struct http_fs_response {
+	struct fs_file_t file;
+	const char *content_type;
+	/* NULL when the file is not compressed */
+	const char *content_encoding;
+	/* Empty when the entity tag of the file is not known yet */
+	char etag[sizeof("\"01234567-01234567\"")];
+	enum http_status status;
+	/* Size of the whole file */
+	size_t size;
+	/* First byte and number of bytes to send */
+	size_t offset;
+	size_t len;
+	/* CRC of the content sent so far, put in the entity tag cache once the
+	 * whole file is sent if the tag was not known.
+	 */
+	uint32_t path_crc;
+	uint32_t content_crc;
+	uint32_t cache_generation;
+	bool compute_crc;
+};
+#endif
+
 /** @endcond */
 
 /** @brief HTTP/2 stream representation. */
@@ -275,6 +342,17 @@ struct http_stream_ctx {
 	int stream_id; /**< Stream identifier. */
 	enum http_stream_state stream_state; /**< Stream state. */
 	int window_size; /**< Stream-level window size. */
+	int tx_window_size; /**< Stream-level window size of the peer. */
+
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	/** File whose sending waits for the peer to open its window. */
+	struct http_fs_response fs_rsp;
+
+	/** Flag indicating that @a fs_rsp is being sent. */
+	bool fs_pending;
+#endif
+/** @endcond */
 };
 
 /** @brief HTTP/2 frame representation. */
@@ -305,6 +383,12 @@ struct http_client_ctx {
 	/** Connection-level window size. */
 	int window_size;
 
+	/** Connection-level window size of the peer. */
+	int tx_window_size;
+
+	/** Initial stream-level window size of the peer. */
+	int tx_initial_window_size;
+
 	/** Server state for the associated client. */
 	enum http_server_state server_state;
 
@@ -357,6 +441,20 @@ struct http_client_ctx {
 /** @cond INTERNAL_HIDDEN */
 	/** Websocket security key. */
 	IF_ENABLED(CONFIG_WEBSOCKET, (uint8_t ws_sec_key[HTTP_SERVER_WS_MAX_SEC_KEY_LEN]));
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	/** Range header of the request. */
+	char range[HTTP_SERVER_MAX_HEADER_LEN];
+
+	/** If-None-Match header of the request. */
+	char if_none_match[HTTP_SERVER_MAX_HEADER_LEN];
+
+	/** Content encodings accepted by the client. */
+	uint8_t accept_encoding;
+
+	/** Request header whose value is expected next (HTTP/1 only). */
+	uint8_t fs_header_next;
+#endif
 /** @endcond */
 
 	/** Flag indicating that headers were sent in the reply. */
@@ -392,6 +490,24 @@ int http_server_start(void);
  */
 int http_server_stop(void);
 
+/** @brief Forget the entity tags of the static file system resources.
+ *
+ * The entity tag of a file is computed from its content the first time the
+ * file is entirely sent, and then kept along with the file size. The file
+ * systems do not all provide a modification time, so this, or
+ * @ref http_server_static_fs_cache_invalidate, must be called when a served
+ * file is modified without changing its size.
+ */
+void http_server_static_fs_cache_clear(void);
+
+/** @brief Forget the entity tag of a file of a static file system resource.
+ *
+ * @param path Path of the modified file, for example "/lfs1/www/index.html".
+ *        The compressed variants of the file are separate files, each
+ *        invalidated with its own path.
+ */
+void http_server_static_fs_cache_invalidate(const char *path);
+
 #ifdef __cplusplus
 }
 #endif
@@ -46,7 +46,8 @@ enum mqtt_evt_type {
 	MQTT_EVT_CONNACK,
 
 	/** Disconnection Event. MQTT Client Reference is no longer valid once
-	 *  this event is received for the client.
+	 *  this event is received for the client. The event parameter tells
+	 *  how many messages of the publish queue were dropped.
 	 */
 	MQTT_EVT_DISCONNECT,
 
@@ -245,6 +246,14 @@ struct mqtt_unsuback_param {
 	uint16_t message_id;
 };
 
+/** @brief Parameters for a disconnection notification. */
+struct mqtt_disconnect_param {
+	/** Number of messages queued with mqtt_publish_queue() and not
+	 *  retired yet, dropped with the connection.
+	 */
+	uint8_t pub_dropped;
+};
+
 /** @brief Parameters for a publish message (PUBLISH). */
 struct mqtt_publish_param {
 	/** Messages including topic, QoS and its payload (if any)
@@ -311,6 +320,9 @@ union mqtt_evt_param {
 
 	/** Parameters accompanying MQTT_EVT_UNSUBACK event. */
 	struct mqtt_unsuback_param unsuback;
+
+	/** Parameters accompanying MQTT_EVT_DISCONNECT event. */
+	struct mqtt_disconnect_param disconnect;
 };
 
 /** @brief Defines MQTT asynchronous event notified to the application. */
@@ -485,6 +497,28 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0
+	/** Internal. Messages queued with mqtt_publish_queue(). */
+	struct mqtt_publish_param pub_queue[CONFIG_MQTT_PUBLISH_QUEUE_SIZE];
+
+	/** Internal. Queued messages retired, but not the oldest one yet. */
+	uint32_t pub_retired;
+
+	/** Internal. Index of the oldest message in the publish queue. */
+	uint8_t pub_head;
+
+	/** Internal. Number of messages in the publish queue. */
+	uint8_t pub_count;
+
+	/** Internal. Number of queued messages already written. */
+	uint8_t pub_written;
+
+	/** Internal. Number of QoS 1 and 2 messages waiting for their
+	 *  acknowledgment.
+	 */
+	uint8_t pub_inflight;
+#endif
 };
 
 /**
@@ -627,6 +661,58 @@ int mqtt_connect(struct mqtt_client *client);
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+#if CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0
+/**
+ * @brief API to queue a message to publish, without waiting for the
+ *        acknowledgment of the messages published before.
+ *
+ * The message is written by mqtt_publish_queue_flush(), or by mqtt_input()
+ * when an acknowledgment frees room in the in-flight window, along with the
+ * other queued messages. At most @kconfig{CONFIG_MQTT_PUBLISH_QUEUE_INFLIGHT}
+ * QoS 1 and 2 messages are waiting for their acknowledgment at a time.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] param Parameters to be used for the publish message.
+ *                  Shall not be NULL. The parameters are copied, but not the
+ *                  topic and the payload they point to.
+ *
+ * @note The topic and the payload shall stay valid until the message is
+ *       retired: for QoS 0 once written, for QoS 1 on @ref MQTT_EVT_PUBACK
+ *       and for QoS 2 on @ref MQTT_EVT_PUBCOMP. The application is still
+ *       expected to answer @ref MQTT_EVT_PUBREC with
+ *       mqtt_publish_qos2_release().
+ * @note The messages not retired are dropped when the connection closes,
+ *       their number being given with @ref MQTT_EVT_DISCONNECT.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure,
+ *         -ENOBUFS when the queue is full.
+ */
+int mqtt_publish_queue(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param);
+
+/**
+ * @brief API to write the queued messages which the in-flight window allows.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_publish_queue_flush(struct mqtt_client *client);
+
+/**
+ * @brief API to get the number of messages in the publish queue, either
+ *        waiting to be written or waiting for their acknowledgment.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return Number of messages not retired yet.
+ */
+int mqtt_publish_queue_count(struct mqtt_client *client);
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0 */
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -286,6 +286,11 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	/** Persistent readiness watches, see struct zvfs_poll_watch */
+	sys_slist_t poll_watch;
+#endif /* CONFIG_FDTABLE_POLL_WATCH */
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -1206,6 +1211,38 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a network buffer chain to a peer without copying it.
+ *
+ * @details The data of the buffer chain is linked behind the protocol
+ * headers of a UDP datagram, or to the send queue of a TCP connection,
+ * instead of being copied. On success the network stack takes over the
+ * reference to the buffers and unrefs them once it is done with them,
+ * that is when the datagram has been transmitted or when the TCP data
+ * has been acknowledged. Until then the data must not be modified. The
+ * destroy callback of the buffer pool can be used as a completion
+ * notification. On failure the buffers are still owned by the caller.
+ * Only UDP and TCP contexts on interfaces that are not offloaded are
+ * supported.
+ *
+ * @param context The network context to use.
+ * @param buf The buffer chain holding the data to send.
+ * @param dst_addr Destination address, NULL for a connected context.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *buf,
+			 const struct sockaddr *dst_addr,
+			 socklen_t addrlen,
+			 net_context_send_cb_t cb,
+			 k_timeout_t timeout,
+			 void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -687,6 +687,13 @@ struct net_if {
 	/** Network interface instance configuration */
 	struct net_if_config config;
 
+#if defined(CONFIG_NET_RX_STEERING)
+	/** Number of RX queues of each traffic class the received packets
+	 * are spread over, 0 meaning all of them.
+	 */
+	uint8_t rx_queues;
+#endif
+
 #if defined(CONFIG_NET_POWER_MANAGEMENT)
 	/** Keep track of packets pending in traffic queues. This is
 	 * needed to avoid putting network device driver to sleep if
@@ -2998,6 +3005,53 @@ static inline bool net_if_is_promisc(struct net_if *iface)
 }
 #endif
 
+/**
+ * @brief Set the number of RX queues the received packets of a network
+ *        interface are spread over.
+ *
+ * @details The packets of a flow always go to the same queue, so they are
+ * processed in order. Packets already queued are not moved, so flows may
+ * see reordering once right after the change.
+ *
+ * @param iface Pointer to network interface
+ * @param queues Number of queues of each traffic class, from 1 which
+ *        disables the steering to CONFIG_NET_RX_STEERING_QUEUES. 0 selects
+ *        all the queues.
+ *
+ * @return 0 on success, <0 if error
+ */
+#if defined(CONFIG_NET_RX_STEERING)
+int net_if_rx_steering_set(struct net_if *iface, uint8_t queues);
+#else
+static inline int net_if_rx_steering_set(struct net_if *iface, uint8_t queues)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(queues);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Get the number of RX queues the received packets of a network
+ *        interface are spread over.
+ *
+ * @param iface Pointer to network interface
+ *
+ * @return Number of queues of each traffic class, 1 if the packets are not
+ *         spread.
+ */
+#if defined(CONFIG_NET_RX_STEERING)
+uint8_t net_if_rx_steering_get(struct net_if *iface);
+#else
+static inline uint8_t net_if_rx_steering_get(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return 1U;
+}
+#endif
+
 /**
  * @brief Check if there are any pending TX network data for a given network
  *        interface.
@@ -3418,6 +3472,51 @@ struct net_if_api {
 				sizeof(struct net_if);			\
 		} while (0)
 
+#if defined(CONFIG_NET_RX_STEERING) && defined(CONFIG_NET_MGMT)
+/* Management part definitions */
+
+/** @cond INTERNAL_HIDDEN */
+
+#define _NET_RX_STEERING_LAYER	NET_MGMT_LAYER_L3
+#define _NET_RX_STEERING_CODE	0x102
+#define _NET_RX_STEERING_BASE	(NET_MGMT_LAYER(_NET_RX_STEERING_LAYER) | \
+				 NET_MGMT_LAYER_CODE(_NET_RX_STEERING_CODE))
+
+enum net_request_rx_steering_cmd {
+	NET_REQUEST_RX_STEERING_CMD_SET = 1,
+	NET_REQUEST_RX_STEERING_CMD_GET,
+};
+
+/** @endcond */
+
+/** RX packet steering configuration of a network interface */
+struct net_rx_steering_config {
+	/** Number of RX queues of each traffic class, see
+	 * net_if_rx_steering_set()
+	 */
+	uint8_t queues;
+};
+
+/** Request to set the RX steering configuration of an interface, the
+ *  data being a struct net_rx_steering_config.
+ */
+#define NET_REQUEST_RX_STEERING_SET				\
+	(_NET_RX_STEERING_BASE | NET_REQUEST_RX_STEERING_CMD_SET)
+
+/** Request the RX steering configuration of an interface, the data being
+ *  a struct net_rx_steering_config.
+ */
+#define NET_REQUEST_RX_STEERING_GET				\
+	(_NET_RX_STEERING_BASE | NET_REQUEST_RX_STEERING_CMD_GET)
+
+/** @cond INTERNAL_HIDDEN */
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_RX_STEERING_SET);
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_RX_STEERING_GET);
+
+/** @endcond */
+#endif /* CONFIG_NET_RX_STEERING && CONFIG_NET_MGMT */
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,7 @@
 #include <zephyr/device.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket_select.h>
+#include <zephyr/net/socket_epoll.h>
 #include <zephyr/net/socket_poll.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/fdtable.h>
@@ -74,6 +75,15 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_send: more data is coming, so the data may be held back and sent
+ *  along with the data of the next call. This is a hint, the sockets that
+ *  cannot make use of it ignore it. TLS sockets hold the data back when
+ *  CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE is not 0, so that it ends up in
+ *  the same TLS record as the data sent next.
+ */
+#define ZSOCK_MSG_MORE 0x8000
+/** zsock_recvmmsg: block for the first message only */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -232,6 +242,21 @@ extern "C" {
  *  will take place in consecutive send()/recv() call.
  */
 #define TLS_DTLS_HANDSHAKE_ON_CONNECT 18
+/** Socket option to enable RFC 5077 session tickets.
+ *  The option accepts an integer, indicating the setting.
+ *  Accepted values for the option are: 0, 1.
+ *  On a server socket, tickets are issued to the clients and accepted for
+ *  session resumption. The option is inherited by the accepted sockets.
+ *  On a client socket, a ticket is requested from the server, and stored
+ *  along with the session when @ref TLS_SESSION_CACHE is enabled.
+ *  If the option is not set, client sockets keep the mbedTLS default of
+ *  requesting tickets and server sockets do not issue them. Reading the
+ *  option returns 1 only if it was enabled on the socket.
+ *  Effective when set before connecting or accepting on the socket.
+ *  - 0 - Disabled.
+ *  - 1 - Enabled.
+ */
+#define TLS_SESSION_TICKETS 19
 
 /* Valid values for @ref TLS_PEER_VERIFY option */
 #define TLS_PEER_VERIFY_NONE 0     /**< Peer verification disabled. */
@@ -250,6 +275,10 @@ extern "C" {
 #define TLS_SESSION_CACHE_DISABLED 0 /**< Disable TLS session caching. */
 #define TLS_SESSION_CACHE_ENABLED 1 /**< Enable TLS session caching. */
 
+/* Valid values for @ref TLS_SESSION_TICKETS option */
+#define TLS_SESSION_TICKETS_DISABLED 0 /**< Disable TLS session tickets. */
+#define TLS_SESSION_TICKETS_ENABLED 1 /**< Enable TLS session tickets. */
+
 /* Valid values for @ref TLS_DTLS_CID (Connection ID) option */
 #define TLS_DTLS_CID_DISABLED		0 /**< CID is disabled  */
 #define TLS_DTLS_CID_SUPPORTED		1 /**< CID is supported */
@@ -522,6 +551,66 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Send several messages with a single call
+ *
+ * @details
+ * @rst
+ * Sends the messages in ``msgvec`` one after another, as
+ * :c:func:`zsock_sendmsg` would, but looking up the socket only once,
+ * and with a single system call in userspace builds. The socket lock is
+ * taken once per call, or once per group of 8 messages for user mode
+ * threads, whose messages are copied to the kernel a group at a time. The
+ * number of bytes sent for each message is stored in its ``msg_len``.
+ * Sending stops at the first message that fails. As on Linux, at most
+ * 1024 messages are sent per call.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @param sock Socket to send on
+ * @param msgvec Messages to send
+ * @param vlen Number of messages in @a msgvec
+ * @param flags Flags applied to every message, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ *         message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive several messages with a single call
+ *
+ * @details
+ * @rst
+ * Receives up to ``vlen`` messages into ``msgvec``, as repeated calls to
+ * :c:func:`zsock_recvmsg` would, but looking up the socket only once,
+ * and with a single system call in userspace builds. The socket lock is
+ * taken once per call, or once per group of 8 messages for user mode
+ * threads, and released while a message is waited for. As on Linux, at
+ * most 1024 messages are received per call. The
+ * number of bytes received for each message is stored in its
+ * ``msg_len``. With :c:macro:`ZSOCK_MSG_WAITFORONE`, only the first
+ * message is waited for and the call returns with what is queued after
+ * it. Unlike Linux, there is no timeout argument, the socket receive
+ * timeout applies to each message that is waited for.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @param sock Socket to receive from
+ * @param msgvec Messages to receive into
+ * @param vlen Number of messages in @a msgvec
+ * @param flags Flags for the call, as for zsock_recvmsg(), plus
+ *              ZSOCK_MSG_WAITFORONE
+ *
+ * @return Number of messages received, or -1 with errno set if no
+ *         message could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -540,6 +629,66 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details Hands the network buffers of the next received datagram, or of
+ * the next received chunk of a stream, over to the caller instead of
+ * copying their data. The buffers start at the first byte of payload and
+ * must be given back with zsock_buf_release() once the caller is done
+ * with them, as they come from the pool of the network interface.
+ * Blocking, timeouts and readiness reported by zsock_poll() are the same
+ * as for zsock_recvfrom().
+ * Available for native UDP and TCP sockets when
+ * :kconfig:option:`CONFIG_NET_SOCKETS_ZEROCOPY` is enabled.
+ *
+ * @param sock Socket to receive from
+ * @param buf Set to the buffer chain holding the data, or to NULL at the
+ *        end of a stream.
+ * @param flags ZSOCK_MSG_DONTWAIT is supported.
+ * @param src_addr If not NULL, set to the source address of a datagram.
+ * @param addrlen Length of @p src_addr, updated with the actual length.
+ *
+ * @return Number of bytes in the buffer chain, 0 at the end of a stream,
+ *         -1 with errno set on error.
+ */
+ssize_t zsock_recv_buf(int sock, struct net_buf **buf, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Give back buffers obtained with zsock_recv_buf()
+ *
+ * @param buf Buffer chain to release, may be NULL.
+ */
+void zsock_buf_release(struct net_buf *buf);
+
+/**
+ * @brief Send data without copying it
+ *
+ * @details Sends the data of a network buffer chain as a datagram, or
+ * queues it on a stream, without copying it. On success the socket takes
+ * over the reference to the buffers and releases it once the data has
+ * been transmitted, or for TCP acknowledged by the peer; until then the
+ * data must not be modified. To be notified of the completion, use
+ * buffers from a pool with a destroy callback. To send application memory
+ * in place, wrap it with net_buf_alloc_with_data(). On failure the
+ * buffers are still owned by the caller. Blocking and timeouts are the
+ * same as for zsock_sendto(). Available for native UDP and TCP sockets
+ * when :kconfig:option:`CONFIG_NET_SOCKETS_ZEROCOPY` is enabled.
+ *
+ * @param sock Socket to send on
+ * @param buf Buffer chain holding the data
+ * @param flags ZSOCK_MSG_DONTWAIT is supported.
+ * @param dest_addr Destination address, NULL for a connected socket.
+ * @param addrlen Length of @p dest_addr.
+ *
+ * @return Number of bytes sent, -1 with errno set on error.
+ */
+ssize_t zsock_send_buf(int sock, struct net_buf *buf, int flags,
+		       const struct sockaddr *dest_addr, socklen_t addrlen);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -952,6 +1101,20 @@ static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+/** POSIX wrapper for @ref zsock_recvmmsg */
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -1058,6 +1221,10 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_MORE */
+#define MSG_MORE ZSOCK_MSG_MORE
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -1207,6 +1374,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm, as a string such as "cubic" */
+#define TCP_CONGESTION 13
 
 /** @} */
 
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file socket_epoll.h
+ *
+ * @brief Persistent event sets (epoll) for sockets and file descriptors.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util_macro.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name Events reported by zsock_epoll_wait()
+ * @{
+ */
+/** The file descriptor is readable */
+#define ZSOCK_EPOLLIN 0x001
+/** Urgent data is available */
+#define ZSOCK_EPOLLPRI 0x002
+/** The file descriptor is writable */
+#define ZSOCK_EPOLLOUT 0x004
+/** Error condition, always reported */
+#define ZSOCK_EPOLLERR 0x008
+/** Hang up, always reported */
+#define ZSOCK_EPOLLHUP 0x010
+/** @} */
+
+/**
+ * @name Input flags for zsock_epoll_ctl()
+ * @{
+ */
+/** Disable the entry after an event was reported, until re-armed with ZSOCK_EPOLL_CTL_MOD */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+/** Edge-triggered: report an event only when the file descriptor changed state */
+#define ZSOCK_EPOLLET BIT(31)
+/** @} */
+
+/**
+ * @name Operations of zsock_epoll_ctl()
+ * @{
+ */
+/** Add a file descriptor to the event set */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** Remove a file descriptor from the event set */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** Change the events and data of a file descriptor in the event set */
+#define ZSOCK_EPOLL_CTL_MOD 3
+/** @} */
+
+/** User data attached to a file descriptor in an event set */
+typedef union zsock_epoll_data {
+	void *ptr;     /**< Pointer */
+	int fd;        /**< File descriptor */
+	uint32_t u32;  /**< 32-bit value */
+	uint64_t u64;  /**< 64-bit value */
+} zsock_epoll_data_t;
+
+/** Event interest on input of zsock_epoll_ctl(), event report on output of zsock_epoll_wait() */
+struct zsock_epoll_event {
+	uint32_t events;          /**< ZSOCK_EPOLL* event bits and flags */
+	zsock_epoll_data_t data;  /**< User data, returned as is */
+};
+
+/**
+ * @brief Create an event set
+ *
+ * @details
+ * @rst
+ * Creates a persistent set of file descriptors and the events they are
+ * waited for, as with the Linux ``epoll_create1()`` call. The set is
+ * itself a file descriptor, released with zsock_close(). It can be polled
+ * for :c:macro:`ZSOCK_POLLIN`, which is reported when
+ * zsock_epoll_wait() would not block.
+ * Sockets, socket pairs and eventfd descriptors can be added to the set.
+ * Requires :kconfig:option:`CONFIG_NET_SOCKETS_EPOLL`.
+ * This function is also exposed as ``epoll_create1()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @param flags Must be 0
+ *
+ * @return A file descriptor on success, -1 with errno set on error
+ */
+__syscall int zsock_epoll_create1(int flags);
+
+/**
+ * @brief Change the interest of an event set
+ *
+ * @details
+ * @rst
+ * Adds, modifies or removes a file descriptor of an event set, as with the
+ * Linux ``epoll_ctl()`` call. The interest persists until the file
+ * descriptor is removed from the set or closed.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @param epfd File descriptor of the event set
+ * @param op One of ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or ZSOCK_EPOLL_CTL_DEL
+ * @param fd File descriptor to add, modify or remove
+ * @param event Events of interest and user data, ignored for ZSOCK_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 with errno set on error
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on an event set
+ *
+ * @details
+ * @rst
+ * Waits until at least one file descriptor of the event set is ready, as
+ * with the Linux ``epoll_wait()`` call. Only the file descriptors that
+ * were signalled since the last call are looked at, so the cost of a call
+ * depends on the number of ready file descriptors rather than the size of
+ * the set.
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @param epfd File descriptor of the event set
+ * @param events Array receiving the events
+ * @param maxevents Size of the @p events array, greater than zero
+ * @param timeout Timeout in milliseconds, -1 to wait forever, 0 to return immediately
+ *
+ * @return Number of events stored, 0 on timeout, -1 with errno set on error
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+/** @cond INTERNAL_HIDDEN */
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLPRI ZSOCK_EPOLLPRI
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+#define epoll_data_t zsock_epoll_data_t
+#define epoll_event zsock_epoll_event
+
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create1(flags);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <zephyr/syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -44,6 +44,8 @@ struct zperf_upload_params {
 		int tcp_nodelay;
 		int priority;
 		uint32_t report_interval_ms;
+		bool zerocopy;
+		uint16_t batch;
 	} options;
 };
 
@@ -51,6 +53,8 @@ struct zperf_download_params {
 	uint16_t port;
 	struct sockaddr addr;
 	char if_name[IFNAMSIZ];
+	bool zerocopy;
+	uint16_t batch;
 };
 
 /** @endcond */
@@ -11,6 +11,7 @@
 /* FIXME: For native_posix ssize_t, off_t. */
 #include <zephyr/fs/fs.h>
 #include <zephyr/sys/mutex.h>
+#include <zephyr/sys/slist.h>
 
 /* File mode bits */
 #define ZVFS_MODE_IFMT   0170000
@@ -191,6 +192,59 @@ static inline int z_fdtable_call_ioctl(const struct fd_op_vtable *vtable, void *
 	return res;
 }
 
+/**
+ * @brief Persistent readiness watch on an I/O object.
+ *
+ * Unlike the one-shot k_poll events set up by ZFD_IOCTL_POLL_PREPARE,
+ * a watch stays attached to the object until it is detached, and its
+ * callback is invoked every time the readiness of the object may have
+ * changed. The callback does not tell what changed; the watcher is
+ * expected to re-check the object with the usual poll ioctls.
+ *
+ * Objects supporting watches attach them on ZFD_IOCTL_POLL_WATCH, which
+ * takes a pointer to the watch as argument.
+ *
+ * The callback may be invoked from any context, including the network
+ * stack threads, with a spinlock held. It must not block.
+ */
+struct zvfs_poll_watch {
+	sys_snode_t node;
+	sys_slist_t *list;
+	void (*cb)(struct zvfs_poll_watch *watch);
+};
+
+/**
+ * @brief Attach a watch to the watch list of an I/O object.
+ *
+ * @param list Watch list of the object
+ * @param watch Watch to attach, with its callback set
+ */
+void zvfs_poll_watch_attach(sys_slist_t *list, struct zvfs_poll_watch *watch);
+
+/**
+ * @brief Detach a watch from the object it is attached to, if any.
+ *
+ * @param watch Watch to detach
+ */
+void zvfs_poll_watch_detach(struct zvfs_poll_watch *watch);
+
+/**
+ * @brief Invoke the callback of every watch attached to a list.
+ *
+ * @param list Watch list of the object
+ */
+void zvfs_poll_watch_notify(sys_slist_t *list);
+
+/**
+ * @brief Notify and detach every watch attached to a list.
+ *
+ * To be called when the object is closed, so that the watchers see it
+ * once more and then find out it is gone.
+ *
+ * @param list Watch list of the object
+ */
+void zvfs_poll_watch_detach_all(sys_slist_t *list);
+
 /**
  * Request codes for fd_op_vtable.ioctl().
  *
@@ -210,6 +264,7 @@ enum {
 	ZFD_IOCTL_STAT,
 	ZFD_IOCTL_TRUNCATE,
 	ZFD_IOCTL_MMAP,
+	ZFD_IOCTL_POLL_WATCH,
 
 	/* Codes above 0x5400 and below 0x5500 are reserved for termios, FIO, etc */
 	ZFD_IOCTL_FIONREAD = 0x541B,
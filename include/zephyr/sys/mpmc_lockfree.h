@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2010-2011 Dmitry Vyukov
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SYS_MPMC_LOCKFREE_H_
+#define ZEPHYR_SYS_MPMC_LOCKFREE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Multiple Producer Multiple Consumer (MPMC) Lockfree Queue API
+ * @defgroup mpmc_lockfree MPMC Lockfree Queue API
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @file mpmc_lockfree.h
+ *
+ * @brief A lock-free bounded multi producer multi consumer (MPMC) queue
+ * of fixed size elements. Ordering is First-In-First-Out.
+ *
+ * Based on the bounded MPMC queue described by Dmitry Vyukov. Each cell
+ * of the ring carries a sequence number next to its element, which tells
+ * producers and consumers whether the cell is free for the current lap,
+ * holds an element, or is still being filled or emptied by another
+ * context. Producers and consumers claim a position with a single CAS and
+ * never wait on each other unless they race for the same cell.
+ *
+ * Elements are copied in and out of the ring. Both operations are safe in
+ * an ISR.
+ *
+ * @warning A producer (or consumer) preempted between claiming a cell and
+ * publishing it keeps the following elements from being consumed (or
+ * the following cells from being refilled) until it resumes.
+ */
+
+/**
+ * @brief Size of a ring cell
+ *
+ * @param elem_size Size of an element in bytes
+ */
+#define MPMC_CELL_SIZE(elem_size) \
+	ROUND_UP(sizeof(atomic_t) + (elem_size), sizeof(atomic_t))
+
+/**
+ * @brief Size of the buffer backing a ring
+ *
+ * @param elem_size Size of an element in bytes
+ * @param num_elems Number of elements, a power of 2 of at least 2
+ */
+#define MPMC_BUF_SIZE(elem_size, num_elems) \
+	(MPMC_CELL_SIZE(elem_size) * (num_elems))
+
+/**
+ * @brief MPMC Queue
+ */
+struct mpmc {
+	atomic_t enqueue_pos;
+	atomic_t dequeue_pos;
+	uint8_t *buffer;
+	size_t cell_size;
+	size_t elem_size;
+	unsigned long mask;
+};
+
+/**
+ * @brief Static initializer for a mpmc queue
+ *
+ * The sequence numbers are stored relative to the cell index, so a
+ * zeroed buffer is an empty ring.
+ *
+ * @param buf Zeroed buffer of MPMC_BUF_SIZE() bytes, aligned to atomic_t
+ * @param esize Size of an element in bytes
+ * @param num_elems Number of elements, a power of 2 of at least 2
+ */
+#define MPMC_INITIALIZER(buf, esize, num_elems)                                \
+	{                                                                      \
+		.buffer = (uint8_t *)(buf),                                    \
+		.cell_size = MPMC_CELL_SIZE(esize),                            \
+		.elem_size = (esize),                                          \
+		.mask = (num_elems) - 1,                                       \
+	}
+
+/**
+ * @brief Define and initialize a mpmc queue along with its buffer
+ *
+ * @param name Name of the queue
+ * @param esize Size of an element in bytes
+ * @param num_elems Number of elements, a power of 2 of at least 2
+ */
+#define MPMC_DEFINE(name, esize, num_elems)                                    \
+	BUILD_ASSERT(IS_POWER_OF_TWO(num_elems) && ((num_elems) > 1),          \
+		     "MPMC size must be a power of 2 of at least 2");          \
+	static atomic_t _mpmc_buf_##name[MPMC_BUF_SIZE(esize, num_elems) /     \
+					 sizeof(atomic_t)];                    \
+	static struct mpmc name = MPMC_INITIALIZER(_mpmc_buf_##name, esize,    \
+						   num_elems)
+
+/** @cond INTERNAL_HIDDEN */
+
+static inline atomic_t *z_mpmc_cell(struct mpmc *q, unsigned long pos)
+{
+	return (atomic_t *)&q->buffer[(pos & q->mask) * q->cell_size];
+}
+
+/* Cells store their sequence number minus their index, compares it
+ * against the expected value, minus the index as well.
+ */
+static inline long z_mpmc_seq_diff(atomic_t *cell, unsigned long expected)
+{
+	return (long)((unsigned long)atomic_get(cell) - expected);
+}
+
+/** @endcond */
+
+/**
+ * @brief Initialize queue
+ *
+ * @param q Queue to initialize or reset
+ * @param buffer Buffer of MPMC_BUF_SIZE() bytes, aligned to atomic_t
+ * @param elem_size Size of an element in bytes
+ * @param num_elems Number of elements, a power of 2 of at least 2
+ */
+static inline void mpmc_init(struct mpmc *q, void *buffer, size_t elem_size,
+			     size_t num_elems)
+{
+	q->buffer = buffer;
+	q->cell_size = MPMC_CELL_SIZE(elem_size);
+	q->elem_size = elem_size;
+	q->mask = num_elems - 1;
+
+	(void)memset(buffer, 0, MPMC_BUF_SIZE(elem_size, num_elems));
+	atomic_set(&q->enqueue_pos, 0);
+	atomic_set(&q->dequeue_pos, 0);
+}
+
+/**
+ * @brief Copy an element into the queue
+ *
+ * @param q Queue to put the element in
+ * @param data Element to copy
+ *
+ * @retval true The element was queued
+ * @retval false The queue is full
+ */
+static inline bool mpmc_put(struct mpmc *q, const void *data)
+{
+	unsigned long pos = (unsigned long)atomic_get(&q->enqueue_pos);
+	unsigned long idx;
+	atomic_t *cell;
+
+	for (;;) {
+		long diff;
+
+		idx = pos & q->mask;
+		cell = z_mpmc_cell(q, pos);
+		diff = z_mpmc_seq_diff(cell, pos - idx);
+
+		if (diff == 0) {
+			if (atomic_cas(&q->enqueue_pos, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1UL))) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* Cell not consumed yet since the previous lap */
+			return false;
+		} else {
+			/* Another producer claimed this position */
+		}
+
+		pos = (unsigned long)atomic_get(&q->enqueue_pos);
+	}
+
+	(void)memcpy(cell + 1, data, q->elem_size);
+	atomic_set(cell, (atomic_val_t)(pos + 1UL - idx));
+
+	return true;
+}
+
+/**
+ * @brief Copy an element out of the queue
+ *
+ * @param q Queue to get the element from
+ * @param data Where to copy the element
+ *
+ * @retval true An element was dequeued
+ * @retval false The queue is empty
+ */
+static inline bool mpmc_get(struct mpmc *q, void *data)
+{
+	unsigned long pos = (unsigned long)atomic_get(&q->dequeue_pos);
+	unsigned long idx;
+	atomic_t *cell;
+
+	for (;;) {
+		long diff;
+
+		idx = pos & q->mask;
+		cell = z_mpmc_cell(q, pos);
+		diff = z_mpmc_seq_diff(cell, pos + 1UL - idx);
+
+		if (diff == 0) {
+			if (atomic_cas(&q->dequeue_pos, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1UL))) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* Cell not filled yet for this lap */
+			return false;
+		} else {
+			/* Another consumer claimed this position */
+		}
+
+		pos = (unsigned long)atomic_get(&q->dequeue_pos);
+	}
+
+	(void)memcpy(data, cell + 1, q->elem_size);
+	atomic_set(cell, (atomic_val_t)(pos + q->mask + 1UL - idx));
+
+	return true;
+}
+
+/**
+ * @brief Check if the next element can be dequeued
+ *
+ * @param q Queue to check
+ *
+ * @retval true The cell at the head of the queue holds no element yet
+ * @retval false An element is ready to be dequeued
+ */
+static inline bool mpmc_is_empty(struct mpmc *q)
+{
+	unsigned long pos = (unsigned long)atomic_get(&q->dequeue_pos);
+
+	return z_mpmc_seq_diff(z_mpmc_cell(q, pos),
+			       pos + 1UL - (pos & q->mask)) < 0;
+}
+
+/**
+ * @brief Check if the next element can be queued
+ *
+ * @param q Queue to check
+ *
+ * @retval true The cell at the tail of the queue is not free yet
+ * @retval false An element can be queued
+ */
+static inline bool mpmc_is_full(struct mpmc *q)
+{
+	unsigned long pos = (unsigned long)atomic_get(&q->enqueue_pos);
+
+	return z_mpmc_seq_diff(z_mpmc_cell(q, pos),
+			       pos - (pos & q->mask)) < 0;
+}
+
+/**
+ * @brief Number of elements in the queue
+ *
+ * Includes the elements still being queued or dequeued, the value is
+ * only a snapshot when other contexts use the queue.
+ *
+ * @param q Queue to count the elements of
+ *
+ * @return Number of elements
+ */
+static inline size_t mpmc_num_used(struct mpmc *q)
+{
+	unsigned long out = (unsigned long)atomic_get(&q->dequeue_pos);
+	unsigned long in = (unsigned long)atomic_get(&q->enqueue_pos);
+
+	return MIN(in - out, q->mask + 1UL);
+}
+
+/**
+ * @brief Number of elements the queue can hold
+ *
+ * @param q Queue
+ *
+ * @return Capacity of the queue
+ */
+static inline size_t mpmc_capacity(struct mpmc *q)
+{
+	return q->mask + 1UL;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_SYS_MPMC_LOCKFREE_H_ */
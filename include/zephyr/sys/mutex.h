@@ -11,9 +11,9 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FUTEX, uncontended sys_mutexes are locked/unlocked
+ * with simple atomic ops instead of syscalls, and k_futex is used to wait
+ * for contended ones. Such mutexes do not implement priority inheritance.
  */
 
 #ifdef __cplusplus
@@ -25,13 +25,29 @@ extern "C" {
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
 
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+#include <zephyr/kernel.h>
+
+/* Values of sys_mutex::futex */
+#define Z_SYS_MUTEX_UNLOCKED  0
+#define Z_SYS_MUTEX_LOCKED    1
+#define Z_SYS_MUTEX_CONTENDED 2
+
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* Z_SYS_MUTEX_CONTENDED if there may be threads waiting on it */
+	struct k_futex futex;
+	/* Only written by the owner while it holds the mutex */
+	k_tid_t owner;
+	uint32_t lock_count;
+};
+#else
+struct sys_mutex {
+	/* Unused, a k_mutex is associated with each sys_mutex by the kernel
+	 * object tracking
 	 */
 	atomic_t val;
 };
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
 
 /**
  * @defgroup user_mutex_apis User mode mutex APIs
@@ -67,11 +83,17 @@ struct sys_mutex {
  */
 static inline void sys_mutex_init(struct sys_mutex *mutex)
 {
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+	(void)atomic_set(&mutex->futex.val, Z_SYS_MUTEX_UNLOCKED);
+	mutex->owner = NULL;
+	mutex->lock_count = 0U;
+#else
 	ARG_UNUSED(mutex);
 
 	/* Nothing to do, kernel-side data structures are initialized at
 	 * boot
 	 */
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
 }
 
 __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -79,6 +101,12 @@ __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
 
 __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+/* Contended paths, see lib/os/mutex.c */
+int z_sys_mutex_futex_lock(struct sys_mutex *mutex, k_timeout_t timeout);
+int z_sys_mutex_futex_unlock(struct sys_mutex *mutex);
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
+
 /**
  * @brief Lock a mutex.
  *
@@ -101,8 +129,18 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+	if (atomic_cas(&mutex->futex.val, Z_SYS_MUTEX_UNLOCKED,
+		       Z_SYS_MUTEX_LOCKED)) {
+		mutex->owner = k_current_get();
+		mutex->lock_count = 1U;
+		return 0;
+	}
+
+	return z_sys_mutex_futex_lock(mutex, timeout);
+#else
 	return z_sys_mutex_kernel_lock(mutex, timeout);
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
 }
 
 /**
@@ -124,8 +162,27 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+	k_tid_t self = k_current_get();
+
+	if ((mutex->owner == self) && (mutex->lock_count == 1U)) {
+		/* Cleared first, the next owner sets them once it got the lock */
+		mutex->owner = NULL;
+		mutex->lock_count = 0U;
+		if (atomic_cas(&mutex->futex.val, Z_SYS_MUTEX_LOCKED,
+			       Z_SYS_MUTEX_UNLOCKED)) {
+			return 0;
+		}
+
+		/* Contended, the slow path wakes up a waiter */
+		mutex->owner = self;
+		mutex->lock_count = 1U;
+	}
+
+	return z_sys_mutex_futex_unlock(mutex);
+#else
 	return z_sys_mutex_kernel_unlock(mutex);
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
 }
 
 #include <zephyr/syscalls/mutex.h>
@@ -5,6 +5,7 @@
  */
 #include <zephyr/kernel.h>
 #include <ksched.h>
+#include <timeout_q.h>
 #include <zephyr/spinlock.h>
 
 extern struct k_spinlock _sched_spinlock;
@@ -34,6 +35,15 @@ static int cpu_mask_mod(k_tid_t thread, uint32_t enable_mask, uint32_t disable_m
 		}
 	}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* A waiting thread may not be allowed on the CPU of its timeout
+	 * anymore.
+	 */
+	if (ret == 0) {
+		z_migrate_thread_timeout(thread);
+	}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 #if defined(CONFIG_ASSERT) && defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY)
 		int m = thread->base.cpu_mask;
 
@@ -284,6 +284,16 @@ void z_sched_usage_stop(void);
 
 void z_sched_usage_start(struct k_thread *thread);
 
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+/** @brief Start measuring the wakeup latency of a thread.
+ *
+ * Called with the scheduler lock held when the thread is made ready.
+ * The measurement completes in z_sched_usage_start() when the thread
+ * is switched in.
+ */
+void z_sched_wakeup_latency_start(struct k_thread *thread);
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
+
 /**
  * @brief Retrieves CPU cycle usage data for specified core
  */
@@ -24,7 +24,14 @@ extern "C" {
 
 static inline void z_init_timeout(struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	to->dticks = 0;
+#else
 	sys_dnode_init(&to->node);
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	to->cpu = 0;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
@@ -34,7 +41,12 @@ int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* Queued timeouts always expire at least one tick after boot */
+	return to->dticks == 0;
+#else
 	return !sys_dnode_is_linked(&to->node);
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
 }
 
 static inline void z_init_thread_timeout(struct _thread_base *thread_base)
@@ -44,10 +56,18 @@ static inline void z_init_thread_timeout(struct _thread_base *thread_base)
 
 extern void z_thread_timeout(struct _timeout *timeout);
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Queued on the CPU the thread runs on, rather than the calling one */
+void z_add_thread_timeout(struct k_thread *thread, k_timeout_t ticks);
+
+/* Moves the timeout of a waiting thread to a CPU it may run on */
+void z_migrate_thread_timeout(struct k_thread *thread);
+#else
 static inline void z_add_thread_timeout(struct k_thread *thread, k_timeout_t ticks)
 {
 	z_add_timeout(&thread->base.timeout, z_thread_timeout, ticks);
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
 static inline int z_abort_thread_timeout(struct k_thread *thread)
 {
@@ -58,6 +78,11 @@ int32_t z_get_next_timeout_expiry(void);
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout);
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Expires the due timeouts of the current CPU, called from z_sched_ipi() */
+void z_timeout_ipi(void);
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 #else
 
 /* Stubs when !CONFIG_SYS_CLOCK_EXISTS */
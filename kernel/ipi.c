@@ -100,6 +100,10 @@ void z_sched_ipi(void)
 	z_trace_sched_ipi();
 #endif /* CONFIG_TRACE_SCHED_IPI */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	z_timeout_ipi();
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 #ifdef CONFIG_TIMESLICING
 	if (thread_is_sliceable(_current)) {
 		z_time_slice();
@@ -8,14 +8,182 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <string.h>
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_KHEAP_CACHE
+/* Per-CPU magazine caches.  Each CPU keeps, per power of two size
+ * class, a small stack of free blocks previously allocated from the
+ * heap.  Cacheable allocations and frees only take the lock of the
+ * current CPU's cache, the heap lock is taken to move half a
+ * magazine at once when it runs empty or full.  Locking order is
+ * cache lock, then heap lock.
+ */
+
+#define CACHE_MIN_SHIFT 4
+#define CACHE_MAX_SIZE	(BIT(CACHE_MIN_SHIFT) << (CONFIG_KHEAP_CACHE_CLASSES - 1))
+#define CACHE_BATCH	(CONFIG_KHEAP_CACHE_MAGAZINE_SIZE / 2)
+
+static inline size_t class_size(int cls)
+{
+	return BIT(CACHE_MIN_SHIFT + cls);
+}
+
+static inline struct z_heap_cache *local_cache(struct k_heap *heap)
+{
+	/* We may be migrated right away, but every cache has its own
+	 * lock so using the one of another CPU is merely slower.
+	 */
+	return &heap->cache[arch_curr_cpu()->id];
+}
+
+/* must hold the cache lock */
+static void cache_refill(struct k_heap *heap, struct z_heap_cache *cache,
+			 int cls)
+{
+	struct z_heap_magazine *mag = &cache->magazines[cls];
+	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+
+	while (mag->count < CACHE_BATCH) {
+		void *mem = sys_heap_alloc(&heap->heap, class_size(cls));
+
+		if (mem == NULL) {
+			break;
+		}
+		mag->blocks[mag->count++] = mem;
+	}
+
+	k_spin_unlock(&heap->lock, key);
+}
+
+/* must hold the cache lock, returns the oldest half of the magazine */
+static void cache_flush(struct k_heap *heap, struct z_heap_cache *cache,
+			int cls)
+{
+	struct z_heap_magazine *mag = &cache->magazines[cls];
+	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+
+	for (int i = 0; i < CACHE_BATCH; i++) {
+		sys_heap_free(&heap->heap, mag->blocks[i]);
+	}
+
+	k_spin_unlock(&heap->lock, key);
+
+	mag->count -= CACHE_BATCH;
+	memmove(&mag->blocks[0], &mag->blocks[CACHE_BATCH],
+		mag->count * sizeof(mag->blocks[0]));
+}
+
+static void *cache_alloc(struct k_heap *heap, size_t bytes)
+{
+	struct z_heap_cache *cache;
+	struct z_heap_magazine *mag;
+	k_spinlock_key_t key;
+	void *ret = NULL;
+	int cls = 0;
+
+	if ((bytes == 0U) || (bytes > CACHE_MAX_SIZE)) {
+		return NULL;
+	}
+
+	if (bytes > class_size(0)) {
+		cls = find_msb_set((uint32_t)bytes - 1U) - CACHE_MIN_SHIFT;
+	}
+
+	cache = local_cache(heap);
+	mag = &cache->magazines[cls];
+	key = k_spin_lock(&cache->lock);
+
+	if (mag->count == 0U) {
+		cache_refill(heap, cache, cls);
+	}
+
+	if (mag->count > 0U) {
+		ret = mag->blocks[--mag->count];
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return ret;
+}
+
+static bool cache_free(struct k_heap *heap, void *mem)
+{
+	struct z_heap_cache *cache;
+	struct z_heap_magazine *mag;
+	k_spinlock_key_t key;
+	size_t bytes;
+	int cls;
+
+	/* Only the owner of an allocated block touches its size, so
+	 * this is safe without the heap lock.  Any block large enough
+	 * for a class can be cached, as long as it's less than twice as
+	 * large.
+	 */
+	bytes = sys_heap_usable_size(&heap->heap, mem);
+	if ((bytes < class_size(0)) || (bytes >= (2U * CACHE_MAX_SIZE))) {
+		return false;
+	}
+
+	cls = find_msb_set((uint32_t)bytes) - 1 - CACHE_MIN_SHIFT;
+	cache = local_cache(heap);
+	mag = &cache->magazines[cls];
+	key = k_spin_lock(&cache->lock);
+
+	/* Blocks must go back to the heap, which wakes up the waiters,
+	 * while allocations may pend.  These announce themselves before
+	 * draining the caches, and the drain takes this cache lock: either
+	 * the announcement is seen here, or the drain runs after the block
+	 * is cached and returns it to the heap before the allocation pends.
+	 */
+	if (atomic_get(&heap->cache_bypass) != 0) {
+		k_spin_unlock(&cache->lock, key);
+		return false;
+	}
+
+	if (mag->count == CONFIG_KHEAP_CACHE_MAGAZINE_SIZE) {
+		cache_flush(heap, cache, cls);
+	}
+	mag->blocks[mag->count++] = mem;
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+/* Returns all cached blocks to the heap, must not hold the heap lock */
+static void cache_drain(struct k_heap *heap)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct z_heap_cache *cache = &heap->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		K_SPINLOCK(&heap->lock) {
+			for (int cls = 0; cls < CONFIG_KHEAP_CACHE_CLASSES; cls++) {
+				struct z_heap_magazine *mag = &cache->magazines[cls];
+
+				while (mag->count > 0U) {
+					sys_heap_free(&heap->heap,
+						      mag->blocks[--mag->count]);
+				}
+			}
+		}
+
+		k_spin_unlock(&cache->lock, key);
+	}
+}
+#endif /* CONFIG_KHEAP_CACHE */
+
 void k_heap_init(struct k_heap *heap, void *mem, size_t bytes)
 {
 	z_waitq_init(&heap->wait_q);
 	sys_heap_init(&heap->heap, mem, bytes);
+#ifdef CONFIG_KHEAP_CACHE
+	(void)memset(heap->cache, 0, sizeof(heap->cache));
+	(void)atomic_set(&heap->cache_bypass, 0);
+#endif /* CONFIG_KHEAP_CACHE */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
 }
@@ -68,6 +236,20 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
+#ifdef CONFIG_KHEAP_CACHE
+	bool drained = false;
+	bool bypass = false;
+
+	if (align <= sizeof(void *)) {
+		ret = cache_alloc(heap, bytes);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
+			return ret;
+		}
+	}
+#endif /* CONFIG_KHEAP_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
@@ -79,6 +261,21 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&heap->heap, align, bytes);
 
+#ifdef CONFIG_KHEAP_CACHE
+		if ((ret == NULL) && !drained) {
+			/* The memory may be sitting in the caches */
+			drained = true;
+			k_spin_unlock(&heap->lock, key);
+			if (!bypass) {
+				bypass = true;
+				(void)atomic_inc(&heap->cache_bypass);
+			}
+			cache_drain(heap);
+			key = k_spin_lock(&heap->lock);
+			continue;
+		}
+#endif /* CONFIG_KHEAP_CACHE */
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -97,11 +294,21 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 		timeout = sys_timepoint_timeout(end);
 		(void) z_pend_curr(&heap->lock, key, &heap->wait_q, timeout);
 		key = k_spin_lock(&heap->lock);
+#ifdef CONFIG_KHEAP_CACHE
+		drained = false;
+#endif /* CONFIG_KHEAP_CACHE */
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
 
 	k_spin_unlock(&heap->lock, key);
+
+#ifdef CONFIG_KHEAP_CACHE
+	if (bypass) {
+		(void)atomic_dec(&heap->cache_bypass);
+	}
+#endif /* CONFIG_KHEAP_CACHE */
+
 	return ret;
 }
 
@@ -127,9 +334,28 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
+#ifdef CONFIG_KHEAP_CACHE
+	bool drained = false;
+	bool bypass = false;
+#endif /* CONFIG_KHEAP_CACHE */
+
 	while (ret == NULL) {
 		ret = sys_heap_aligned_realloc(&heap->heap, ptr, sizeof(void *), bytes);
 
+#ifdef CONFIG_KHEAP_CACHE
+		if ((ret == NULL) && !drained) {
+			drained = true;
+			k_spin_unlock(&heap->lock, key);
+			if (!bypass) {
+				bypass = true;
+				(void)atomic_inc(&heap->cache_bypass);
+			}
+			cache_drain(heap);
+			key = k_spin_lock(&heap->lock);
+			continue;
+		}
+#endif /* CONFIG_KHEAP_CACHE */
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -138,16 +364,33 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 		timeout = sys_timepoint_timeout(end);
 		(void) z_pend_curr(&heap->lock, key, &heap->wait_q, timeout);
 		key = k_spin_lock(&heap->lock);
+#ifdef CONFIG_KHEAP_CACHE
+		drained = false;
+#endif /* CONFIG_KHEAP_CACHE */
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, realloc, heap, ptr, bytes, timeout, ret);
 
 	k_spin_unlock(&heap->lock, key);
+
+#ifdef CONFIG_KHEAP_CACHE
+	if (bypass) {
+		(void)atomic_dec(&heap->cache_bypass);
+	}
+#endif /* CONFIG_KHEAP_CACHE */
+
 	return ret;
 }
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
+#ifdef CONFIG_KHEAP_CACHE
+	if ((mem != NULL) && cache_free(heap, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+		return;
+	}
+#endif /* CONFIG_KHEAP_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	sys_heap_free(&heap->heap, mem);
@@ -159,3 +402,43 @@ void k_heap_free(struct k_heap *heap, void *mem)
 		k_spin_unlock(&heap->lock, key);
 	}
 }
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int k_heap_runtime_stats_get(struct k_heap *heap, struct sys_memory_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&heap->lock) {
+		(void)sys_heap_runtime_stats_get(&heap->heap, stats);
+	}
+
+#ifdef CONFIG_KHEAP_CACHE
+	/* Only the cache owns the blocks it holds, so their size can be
+	 * read under its lock.
+	 */
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct z_heap_cache *cache = &heap->cache[i];
+		size_t cached = 0U;
+
+		K_SPINLOCK(&cache->lock) {
+			for (int cls = 0; cls < CONFIG_KHEAP_CACHE_CLASSES; cls++) {
+				struct z_heap_magazine *mag = &cache->magazines[cls];
+
+				for (int j = 0; j < mag->count; j++) {
+					cached += sys_heap_usable_size(&heap->heap,
+								       mag->blocks[j]);
+				}
+			}
+		}
+
+		cached = MIN(cached, stats->allocated_bytes);
+		stats->allocated_bytes -= cached;
+		stats->free_bytes += cached;
+	}
+#endif /* CONFIG_KHEAP_CACHE */
+
+	return 0;
+}
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
@@ -33,6 +33,7 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+	((struct k_mem_slab_info *)stats)->num_used = z_mem_slab_num_used(slab);
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -45,12 +46,14 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 	struct k_mem_slab *slab;
 	k_spinlock_key_t   key;
 	struct sys_memory_stats *ptr = stats;
+	uint32_t num_used;
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	num_used = z_mem_slab_num_used(slab);
+	ptr->free_bytes = (slab->info.num_blocks - num_used) *
 			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->allocated_bytes = num_used * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -72,7 +75,7 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	key = k_spin_lock(&slab->lock);
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = z_mem_slab_num_used(slab);
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
 	k_spin_unlock(&slab->lock, key);
@@ -198,6 +201,10 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 
 	z_waitq_init(&slab->wait_q);
 	k_object_init(slab);
+#ifdef CONFIG_MEM_SLAB_CACHE
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+	(void)atomic_set(&slab->cache_bypass, 0);
+#endif /* CONFIG_MEM_SLAB_CACHE */
 out:
 	SYS_PORT_TRACING_OBJ_INIT(k_mem_slab, slab, rc);
 
@@ -216,8 +223,184 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 }
 #endif
 
+/* must hold the slab lock, and the free list must not be empty */
+static void *free_list_get(struct k_mem_slab *slab)
+{
+	void *mem = slab->free_list;
+
+	slab->free_list = *(char **)(slab->free_list);
+	slab->info.num_used++;
+	__ASSERT((slab->free_list == NULL &&
+		  slab->info.num_used == slab->info.num_blocks) ||
+		 slab_ptr_is_good(slab, slab->free_list),
+		 "slab corruption detected");
+
+	return mem;
+}
+
+/* must hold the slab lock, extra blocks are about to be handed out */
+static void max_used_update(struct k_mem_slab *slab, uint32_t extra)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = MAX(z_mem_slab_num_used(slab) + extra,
+				  slab->info.max_used);
+#else
+	ARG_UNUSED(slab);
+	ARG_UNUSED(extra);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+}
+
+/* must hold the slab lock */
+static void free_list_put(struct k_mem_slab *slab, void *mem)
+{
+	*(char **) mem = slab->free_list;
+	slab->free_list = (char *) mem;
+	slab->info.num_used--;
+}
+
+/* must hold the slab lock, returns true if a waiting thread got the block */
+static bool give_to_waiter(struct k_mem_slab *slab, void *mem)
+{
+	if ((slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
+		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+		if (pending_thread != NULL) {
+			z_thread_return_value_set_with_data(pending_thread, 0, mem);
+			z_ready_thread(pending_thread);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+/* Per-CPU caches of free blocks.  A CPU allocates from and frees to its
+ * own cache under the cache lock only, and takes the slab lock to move
+ * CACHE_BATCH blocks between the cache and the free list when the cache
+ * runs empty or full.  Cached blocks are off the free list, hence part
+ * of info.num_used: z_mem_slab_num_used() leaves them out.  Locking
+ * order is cache lock, then slab lock.
+ */
+
+#define CACHE_BATCH (CONFIG_MEM_SLAB_CACHE_SIZE / 2)
+
+/* Any cache may be used as each has its own lock, the one of the CPU
+ * we run on is merely the least likely to be contended.
+ */
+static inline struct z_mem_slab_cache *local_cache(struct k_mem_slab *slab)
+{
+	return &slab->cache[arch_curr_cpu()->id];
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct z_mem_slab_cache *cache = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool ret = false;
+
+	if (cache->count == 0U) {
+		K_SPINLOCK(&slab->lock) {
+			while ((cache->count < CACHE_BATCH) &&
+			       (slab->free_list != NULL)) {
+				cache->blocks[cache->count++] = free_list_get(slab);
+			}
+			max_used_update(slab, MIN(cache->count, 1U));
+		}
+	}
+
+	if (cache->count > 0U) {
+		*mem = cache->blocks[--cache->count];
+		ret = true;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return ret;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	struct z_mem_slab_cache *cache = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	/* See cache_bypass_begin(): past that point, a block cached here
+	 * could be missed by the drain, and the thread waiting for it
+	 * would never get it.  It is freed to the slab instead.
+	 */
+	if (atomic_get(&slab->cache_bypass) != 0) {
+		k_spin_unlock(&cache->lock, key);
+		return false;
+	}
+
+	if (cache->count == CONFIG_MEM_SLAB_CACHE_SIZE) {
+		K_SPINLOCK(&slab->lock) {
+			for (int i = 0; i < CACHE_BATCH; i++) {
+				free_list_put(slab, cache->blocks[i]);
+			}
+		}
+
+		cache->count -= CACHE_BATCH;
+		memmove(&cache->blocks[0], &cache->blocks[CACHE_BATCH],
+			cache->count * sizeof(cache->blocks[0]));
+	}
+	cache->blocks[cache->count++] = mem;
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+/* Returns all cached blocks to the slab, must not hold the slab lock */
+static void cache_drain(struct k_mem_slab *slab)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct z_mem_slab_cache *cache = &slab->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		K_SPINLOCK(&slab->lock) {
+			while (cache->count > 0U) {
+				free_list_put(slab, cache->blocks[--cache->count]);
+			}
+		}
+
+		k_spin_unlock(&cache->lock, key);
+	}
+}
+
+/* Called before an allocation which may have to wait for a block.
+ * cache_bypass is raised before the caches are drained, and
+ * cache_free() reads it under the cache lock that the drain also
+ * takes.  A block freed concurrently is thus either cached before
+ * the drain gets to its cache and returned to the slab by it, or
+ * freed to the slab, where a waiting thread gets it, once the drain
+ * is past.
+ */
+static void cache_bypass_begin(struct k_mem_slab *slab)
+{
+	(void)atomic_inc(&slab->cache_bypass);
+	cache_drain(slab);
+}
+
+static void cache_bypass_end(struct k_mem_slab *slab)
+{
+	(void)atomic_dec(&slab->cache_bypass);
+}
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+
+	/* The slab is exhausted, unless blocks sit in other caches */
+	cache_bypass_begin(slab);
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
@@ -225,19 +408,8 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 	if (slab->free_list != NULL) {
 		/* take a free block */
-		*mem = slab->free_list;
-		slab->free_list = *(char **)(slab->free_list);
-		slab->info.num_used++;
-		__ASSERT((slab->free_list == NULL &&
-			  slab->info.num_used == slab->info.num_blocks) ||
-			 slab_ptr_is_good(slab, slab->free_list),
-			 "slab corruption detected");
-
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->info.max_used = MAX(slab->info.num_used,
-					  slab->info.max_used);
-#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
-
+		*mem = free_list_get(slab);
+		max_used_update(slab, 0U);
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
 		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -255,6 +427,10 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+		cache_bypass_end(slab);
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 		return result;
 	}
 
@@ -262,37 +438,92 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 	k_spin_unlock(&slab->lock, key);
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+	cache_bypass_end(slab);
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 	return result;
 }
 
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
-
 	__ASSERT(slab_ptr_is_good(slab, mem), "Invalid memory pointer provided");
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
-	if ((slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
-		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_CACHE */
 
-		if (pending_thread != NULL) {
-			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-			z_thread_return_value_set_with_data(pending_thread, 0, mem);
-			z_ready_thread(pending_thread);
-			z_reschedule(&slab->lock, key);
-			return;
-		}
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+	if (give_to_waiter(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		z_reschedule(&slab->lock, key);
+		return;
 	}
-	*(char **) mem = slab->free_list;
-	slab->free_list = (char *) mem;
-	slab->info.num_used--;
+	free_list_put(slab, mem);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
 	k_spin_unlock(&slab->lock, key);
 }
 
+int k_mem_slab_alloc_bulk(struct k_mem_slab *slab, void **mem, uint32_t count)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if ((slab->info.num_blocks - slab->info.num_used) < count) {
+		/* Try again with the blocks held by the caches */
+		k_spin_unlock(&slab->lock, key);
+		cache_drain(slab);
+		key = k_spin_lock(&slab->lock);
+	}
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
+	if ((slab->info.num_blocks - slab->info.num_used) < count) {
+		k_spin_unlock(&slab->lock, key);
+		return -ENOMEM;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		mem[i] = free_list_get(slab);
+	}
+	max_used_update(slab, 0U);
+
+	k_spin_unlock(&slab->lock, key);
+
+	return 0;
+}
+
+void k_mem_slab_free_bulk(struct k_mem_slab *slab, void **mem, uint32_t count)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	bool woken = false;
+
+	for (uint32_t i = 0; i < count; i++) {
+		__ASSERT(slab_ptr_is_good(slab, mem[i]),
+			 "Invalid memory pointer provided");
+
+		if (give_to_waiter(slab, mem[i])) {
+			woken = true;
+		} else {
+			free_list_put(slab, mem[i]);
+		}
+	}
+
+	if (woken) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
+}
+
 int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stats *stats)
 {
 	if ((slab == NULL) || (stats == NULL)) {
@@ -300,9 +531,10 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t num_used = z_mem_slab_num_used(slab);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = num_used * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - num_used) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -325,7 +557,7 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = z_mem_slab_num_used(slab);
 
 	k_spin_unlock(&slab->lock, key);
 
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Lock-free message queues.
+ *
+ * Messages go through a lock-free MPMC ring, so put and get are a CAS
+ * and two copies as long as the ring is neither full nor empty.  Only a
+ * thread which finds the ring full (or empty) takes the queue lock, to
+ * announce itself in the waiter count and pend.  Threads which complete
+ * an operation only take the lock when that count says there may be
+ * someone to wake up.  Both sides access the ring and the count with
+ * sequentially consistent atomics, so either the waiter sees the
+ * operation that would have unblocked it, or the other side sees the
+ * waiter.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/barrier.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <kernel_internal.h>
+
+void k_mpmcq_init(struct k_mpmcq *q, void *buffer, size_t msg_size,
+		  uint32_t max_msgs)
+{
+	__ASSERT(IS_POWER_OF_TWO(max_msgs) && (max_msgs > 1U),
+		 "k_mpmcq size must be a power of 2 of at least 2");
+	__ASSERT(((uintptr_t)buffer % sizeof(atomic_t)) == 0U,
+		 "k_mpmcq buffer must be aligned to atomic_t");
+
+	mpmc_init(&q->ring, buffer, msg_size, max_msgs);
+	z_waitq_init(&q->get_wait_q);
+	z_waitq_init(&q->put_wait_q);
+	atomic_set(&q->get_waiters, 0);
+	atomic_set(&q->put_waiters, 0);
+	q->lock = (struct k_spinlock) {};
+#ifdef CONFIG_POLL
+	sys_dlist_init(&q->poll_events);
+#endif	/* CONFIG_POLL */
+}
+
+static inline bool try_op(struct k_mpmcq *q, void *data, bool put)
+{
+	return put ? mpmc_put(&q->ring, data) : mpmc_get(&q->ring, data);
+}
+
+static inline bool can_op(struct k_mpmcq *q, bool put)
+{
+	return put ? !mpmc_is_full(&q->ring) : !mpmc_is_empty(&q->ring);
+}
+
+static bool wake_one_locked(_wait_q_t *wait_q)
+{
+	struct k_thread *thread = z_unpend_first_thread(wait_q);
+
+	if (thread == NULL) {
+		return false;
+	}
+
+	/* It retries the operation on its own */
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+
+	return true;
+}
+
+/* Called once a put (or get) went through, to wake up a thread waiting
+ * to get (or put) a message.
+ */
+static void notify(struct k_mpmcq *q, bool put)
+{
+	atomic_t *waiters = put ? &q->get_waiters : &q->put_waiters;
+	bool polled = false;
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_POLL
+	/* Pairs with the fence k_poll() issues between registering an
+	 * event on the queue and checking it again.
+	 */
+	if (put) {
+		barrier_dmem_fence_full();
+		if (!sys_dlist_is_empty(&q->poll_events)) {
+			z_handle_obj_poll_events(&q->poll_events,
+						 K_POLL_STATE_MPMCQ_DATA_AVAILABLE);
+			polled = true;
+		}
+	}
+#endif	/* CONFIG_POLL */
+
+	if (!polled && (atomic_get(waiters) == 0)) {
+		return;
+	}
+
+	key = k_spin_lock(&q->lock);
+	(void)wake_one_locked(put ? &q->get_wait_q : &q->put_wait_q);
+	z_reschedule(&q->lock, key);
+}
+
+/* Slow path of put and get, the ring was full (or empty) */
+static int wait_op(struct k_mpmcq *q, void *data, bool put,
+		   k_timeout_t timeout)
+{
+	_wait_q_t *wait_q = put ? &q->put_wait_q : &q->get_wait_q;
+	atomic_t *waiters = put ? &q->put_waiters : &q->get_waiters;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	key = k_spin_lock(&q->lock);
+
+	/* From here on, threads completing the opposite operation
+	 * take the lock to wake us up.
+	 */
+	atomic_inc(waiters);
+
+	while (!try_op(q, data, put)) {
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = -EAGAIN;
+			break;
+		}
+
+		(void)z_pend_curr(&q->lock, key, wait_q, timeout);
+		key = k_spin_lock(&q->lock);
+	}
+
+	atomic_dec(waiters);
+
+	/* We may have been woken up for the message (or room) we are
+	 * giving up on, pass it on to the next waiter.
+	 */
+	if ((ret != 0) && can_op(q, put) && wake_one_locked(wait_q)) {
+		z_reschedule(&q->lock, key);
+	} else {
+		k_spin_unlock(&q->lock, key);
+	}
+
+	return ret;
+}
+
+int k_mpmcq_put(struct k_mpmcq *q, const void *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	if (!mpmc_put(&q->ring, data)) {
+		int ret;
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		ret = wait_op(q, (void *)data, true, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	notify(q, true);
+
+	return 0;
+}
+
+int k_mpmcq_get(struct k_mpmcq *q, void *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	if (!mpmc_get(&q->ring, data)) {
+		int ret;
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		ret = wait_op(q, data, false, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	notify(q, false);
+
+	return 0;
+}
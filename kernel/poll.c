@@ -22,6 +22,7 @@
 #include <ksched.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/sys/dlist.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/__assert.h>
 #include <stdbool.h>
@@ -87,6 +88,14 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 			return true;
 		}
 		break;
+#ifdef CONFIG_MPMCQ
+	case K_POLL_TYPE_MPMCQ_DATA_AVAILABLE:
+		if (!mpmc_is_empty(&event->mpmcq->ring)) {
+			*state = K_POLL_STATE_MPMCQ_DATA_AVAILABLE;
+			return true;
+		}
+		break;
+#endif /* CONFIG_MPMCQ */
 #ifdef CONFIG_PIPES
 	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
 		if (k_pipe_read_avail(event->pipe)) {
@@ -160,6 +169,12 @@ static inline void register_event(struct k_poll_event *event,
 		add_event(&event->pipe->poll_events, event, poller);
 		break;
 #endif /* CONFIG_PIPES */
+#ifdef CONFIG_MPMCQ
+	case K_POLL_TYPE_MPMCQ_DATA_AVAILABLE:
+		__ASSERT(event->mpmcq != NULL, "invalid lock-free message queue\n");
+		add_event(&event->mpmcq->poll_events, event, poller);
+		break;
+#endif /* CONFIG_MPMCQ */
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -201,6 +216,12 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		remove_event = true;
 		break;
 #endif /* CONFIG_PIPES */
+#ifdef CONFIG_MPMCQ
+	case K_POLL_TYPE_MPMCQ_DATA_AVAILABLE:
+		__ASSERT(event->mpmcq != NULL, "invalid lock-free message queue\n");
+		remove_event = true;
+		break;
+#endif /* CONFIG_MPMCQ */
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -249,6 +270,19 @@ static inline int register_events(struct k_poll_event *events,
 		} else if (!just_check && poller->is_polling) {
 			register_event(&events[ii], poller);
 			events_registered += 1;
+#ifdef CONFIG_MPMCQ
+			/* Lock-free message queues are filled without taking
+			 * our lock, check again now that a put is bound to see
+			 * the registration.
+			 */
+			if (events[ii].type == K_POLL_TYPE_MPMCQ_DATA_AVAILABLE) {
+				barrier_dmem_fence_full();
+				if (is_condition_met(&events[ii], &state)) {
+					set_event_ready(&events[ii], state);
+					poller->is_polling = false;
+				}
+			}
+#endif /* CONFIG_MPMCQ */
 		} else {
 			/* Event is not one of those identified in is_condition_met()
 			 * catching non-polling events, or is marked for just check,
@@ -101,6 +101,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -109,18 +111,111 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
+}
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Priority of the best thread of each CPU's ready queue, and mask of
+ * the CPUs whose queue is not empty.  They let a CPU find the queues
+ * holding a better thread than its own best one without visiting
+ * them.
+ */
+static int runq_prio[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t runq_busy_mask;
+
+/* Queue a thread where it last ran, if its affinity still allows it */
+static ALWAYS_INLINE uint8_t runq_cpu_pick(struct k_thread *thread)
+{
+	uint8_t cpu = thread->base.cpu;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask;
+
+	if ((m != 0U) && ((m & BIT(cpu)) == 0U)) {
+		cpu = u32_count_trailing_zeros(m);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	return (cpu < arch_num_cpus()) ? cpu : 0U;
+}
+
+/* Refresh the summary of a queue after a thread was added or removed */
+static ALWAYS_INLINE void runq_summary_update(uint8_t cpu)
+{
+	void *runq = &_kernel.cpus[cpu].ready_q.runq;
+	struct k_thread *head;
+
+	/* The head of the queue, whatever CPU it may run on */
+#ifdef CONFIG_SCHED_DUMB
+	head = z_priq_dumb_best(runq);
+#else
+	head = _priq_run_best(runq);
+#endif /* CONFIG_SCHED_DUMB */
+
+	if (head != NULL) {
+		runq_prio[cpu] = head->base.prio;
+		runq_busy_mask |= BIT(cpu);
+	} else {
+		runq_busy_mask &= ~BIT(cpu);
+	}
 }
 
+/* The best thread of this CPU's queue, unless another CPU's queue
+ * holds one of strictly higher priority that we can run, which is
+ * then stolen.  When the local queue is empty, the best thread of
+ * the other queues is stolen whatever its priority, and compared
+ * against _current as usual.  Ties go to the local queue for cache
+ * affinity, and between remote queues to the first one after this
+ * CPU so that idle CPUs do not all steal from the same one.  Only
+ * the queues whose summary beats the best thread found so far are
+ * visited.
+ */
+static ALWAYS_INLINE struct k_thread *runq_best_steal(void)
+{
+	unsigned int id = arch_curr_cpu()->id;
+	unsigned int num_cpus = arch_num_cpus();
+	struct k_thread *best = _priq_run_best(curr_cpu_runq());
+	uint32_t busy = runq_busy_mask & ~BIT(id);
+
+	for (unsigned int n = 1; (busy != 0U) && (n < num_cpus); n++) {
+		unsigned int i = (id + n) % num_cpus;
+		struct k_thread *thread;
+
+		if (((busy & BIT(i)) == 0U) ||
+		    ((best != NULL) && (runq_prio[i] >= best->base.prio))) {
+			continue;
+		}
+
+		thread = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if ((thread != NULL) &&
+		    ((best == NULL) || (thread->base.prio < best->base.prio))) {
+			best = thread;
+		}
+	}
+
+	return best;
+}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	uint8_t cpu = runq_cpu_pick(thread);
+
+	thread->base.runq_cpu = cpu;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 	_priq_run_add(thread_runq(thread), thread);
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	runq_summary_update(cpu);
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
@@ -128,11 +223,19 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
 	_priq_run_remove(thread_runq(thread), thread);
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	runq_summary_update(thread->base.runq_cpu);
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	return runq_best_steal();
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -382,6 +485,9 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+		z_sched_wakeup_latency_start(thread);
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
 		queue_thread(thread);
 		update_cache(0);
 
@@ -1012,7 +1118,7 @@ void init_ready_q(struct _ready_q *ready_q)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(ready_q->runq.queues); i++) {
 		sys_dlist_init(&ready_q->runq.queues[i]);
 	}
 #else
@@ -1022,13 +1128,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
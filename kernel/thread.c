@@ -648,6 +648,10 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 		CONFIG_SCHED_THREAD_USAGE_AUTO_ENABLE;
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+	new_thread->base.wakeup = (struct k_wakeup_latency_stats) {};
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
+
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, create, new_thread);
 
 	return stack_ptr;
@@ -761,6 +765,11 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->is_idle = 0;
 #endif /* CONFIG_SMP */
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Only a placement hint until the thread first runs */
+	thread_base->cpu = 0;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	thread_base->slice_ticks = 0;
 	thread_base->slice_expired = NULL;
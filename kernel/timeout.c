@@ -8,21 +8,64 @@
 #include <zephyr/spinlock.h>
 #include <ksched.h>
 #include <timeout_q.h>
+#include <ipi.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/math_extras.h>
 
 static uint64_t curr_tick;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b);
+
+struct timeout_queue {
+	struct rbtree tree;
+	uint32_t next_order_key;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	struct k_spinlock lock;
+	/* Expiry of the timeout being handled while announcing */
+	uint64_t announce_tick;
+	bool announcing;
+	/* Earliest expiry of the queue, as published under timeout_lock.
+	 * Never later than the actual one, it may be earlier after the
+	 * first timeout was aborted.
+	 */
+	uint64_t next;
+	/* Set when the owning CPU was asked to expire its due timeouts */
+	atomic_t pending;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+};
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+static struct timeout_queue timeout_queues[CONFIG_MP_MAX_NUM_CPUS] = {
+	[0 ... (CONFIG_MP_MAX_NUM_CPUS - 1)] = {
+		.tree = { .lessthan_fn = timeout_lessthan },
+		.next = UINT64_MAX,
+	},
+};
+
+/* Odd while curr_tick is being written, see read_curr_tick() */
+static atomic_t curr_tick_seq;
+#else
+static struct timeout_queue timeout_queue = {
+	.tree = { .lessthan_fn = timeout_lessthan },
+};
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+#else
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
 
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
 		  ? K_TICKS_FOREVER : INT_MAX)
 
+#ifndef CONFIG_TIMEOUT_QUEUE_PER_CPU
 /* Ticks left to process in the currently-executing sys_clock_announce() */
 static int announce_remaining;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
 int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
@@ -36,6 +79,90 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+
+/* In the scalable backend, dticks holds the absolute expiry tick.
+ * Comparisons are done on the difference so that they stay correct
+ * across a sys_clock_tick_set() rebase.
+ */
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct _timeout *ta = CONTAINER_OF(a, struct _timeout, node);
+	struct _timeout *tb = CONTAINER_OF(b, struct _timeout, node);
+	int64_t d = (int64_t)((uint64_t)ta->dticks - (uint64_t)tb->dticks);
+
+	if (d != 0) {
+		return d < 0;
+	}
+
+	return (int32_t)(ta->order_key - tb->order_key) < 0;
+}
+
+static struct _timeout *q_first(struct timeout_queue *q)
+{
+	struct rbnode *n = rb_get_min(&q->tree);
+
+	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* to->dticks is the absolute expiry tick on entry */
+static void q_insert(struct timeout_queue *q, struct _timeout *to)
+{
+	__ASSERT(to->dticks != 0, "");
+	to->order_key = q->next_order_key++;
+
+	rb_insert(&q->tree, &to->node);
+}
+
+static void q_remove(struct timeout_queue *q, struct _timeout *t)
+{
+	rb_remove(&q->tree, &t->node);
+	t->dticks = 0;
+}
+
+#ifdef CONFIG_ZTEST
+/* Keeps queued expiries at the same distance from a new curr_tick */
+static void q_rebase(struct timeout_queue *q, uint64_t delta)
+{
+	struct rbnode *n;
+
+	RB_FOR_EACH(&q->tree, n) {
+		struct _timeout *t = CONTAINER_OF(n, struct _timeout, node);
+
+		t->dticks = (int64_t)((uint64_t)t->dticks + delta);
+	}
+}
+#endif /* CONFIG_ZTEST */
+
+#ifndef CONFIG_TIMEOUT_QUEUE_PER_CPU
+
+static struct _timeout *first(void)
+{
+	return q_first(&timeout_queue);
+}
+
+/* must be locked, to->dticks is relative to curr_tick on entry */
+static void insert_timeout(struct _timeout *to)
+{
+	to->dticks = (int64_t)(curr_tick + (uint64_t)to->dticks);
+	q_insert(&timeout_queue, to);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	q_remove(&timeout_queue, t);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	return (int64_t)((uint64_t)timeout->dticks - curr_tick);
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,6 +177,25 @@ static struct _timeout *next(struct _timeout *t)
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+/* must be locked, to->dticks is relative to curr_tick on entry */
+static void insert_timeout(struct _timeout *to)
+{
+	struct _timeout *t;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -59,6 +205,25 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
+#ifndef CONFIG_TIMEOUT_QUEUE_PER_CPU
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -87,10 +252,10 @@ static int32_t next_timeout(void)
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_rem(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_rem(to) - ticks_elapsed);
 	}
 
 	return ret;
@@ -107,12 +272,10 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT_NO_MSG(arch_mem_coherent(to));
 #endif /* CONFIG_KERNEL_COHERENCE */
 
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	__ASSERT(z_is_inactive_timeout(to), "");
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
-
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    (Z_TICK_ABS(timeout.ticks) >= 0)) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -122,18 +285,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to);
 
 		if (to == first() && announce_remaining == 0) {
 			sys_clock_set_timeout(next_timeout(), false);
@@ -146,7 +298,7 @@ int z_abort_timeout(struct _timeout *to)
 	int ret = -EINVAL;
 
 	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
+		if (!z_is_inactive_timeout(to)) {
 			remove_timeout(to);
 			ret = 0;
 		}
@@ -155,21 +307,6 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks;
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -228,12 +365,15 @@ void sys_clock_announce(int32_t ticks)
 	struct _timeout *t;
 
 	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
+	     (t != NULL) && (timeout_rem(t) <= announce_remaining);
 	     t = first()) {
-		int dt = t->dticks;
+		int dt = timeout_rem(t);
 
 		curr_tick += dt;
+#ifndef CONFIG_TIMEOUT_QUEUE_SCALABLE
+		/* The remaining deltas are now relative to curr_tick */
 		t->dticks = 0;
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
 		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
@@ -242,9 +382,11 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
+#ifndef CONFIG_TIMEOUT_QUEUE_SCALABLE
 	if (t != NULL) {
 		t->dticks -= announce_remaining;
 	}
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -268,6 +410,431 @@ int64_t sys_clock_tick_get(void)
 	return t;
 }
 
+#else
+
+/* With per-CPU queues, a timeout is queued on the CPU that arms it,
+ * or for a thread timeout on the CPU the thread runs on, under that
+ * queue's own lock.  Each queue publishes its earliest expiry under
+ * timeout_lock when it changes, so that sys_clock_announce() and
+ * next_timeout() never take the lock of another CPU's queue:
+ * sys_clock_announce() advances curr_tick and flags the CPUs with due
+ * timeouts, which then expire them from their scheduler IPI.
+ *
+ * Lock order: a queue's lock, then timeout_lock.
+ */
+
+static inline struct timeout_queue *this_queue(void)
+{
+	return &timeout_queues[arch_curr_cpu()->id];
+}
+
+/* must hold timeout_lock */
+static void set_curr_tick(uint64_t tick)
+{
+	atomic_inc(&curr_tick_seq);
+	barrier_dmem_fence_full();
+	*(volatile uint64_t *)&curr_tick = tick;
+	barrier_dmem_fence_full();
+	atomic_inc(&curr_tick_seq);
+}
+
+/* Reads curr_tick, and the ticks elapsed since if ticks_elapsed is
+ * not NULL, without timeout_lock.  The 64-bit read may be torn on 32-bit
+ * CPUs, the sequence count tells when it must be done again.
+ */
+static uint64_t read_curr_tick(int32_t *ticks_elapsed)
+{
+	atomic_val_t seq;
+	uint64_t tick;
+
+	do {
+		seq = atomic_get(&curr_tick_seq);
+		barrier_dmem_fence_full();
+		tick = *(volatile uint64_t *)&curr_tick;
+		if (ticks_elapsed != NULL) {
+			*ticks_elapsed = sys_clock_elapsed();
+		}
+		barrier_dmem_fence_full();
+	} while (((seq & 1) != 0) || (seq != atomic_get(&curr_tick_seq)));
+
+	return tick;
+}
+
+/* Current tick as seen by the calling CPU.  Like with the global
+ * queue, while a CPU runs timeout callbacks (or an ISR preempts
+ * them) time stands still at the expiry of the firing timeout.
+ */
+static uint64_t cpu_tick(bool with_elapsed)
+{
+	unsigned int key = arch_irq_lock();
+	struct timeout_queue *q = this_queue();
+	int32_t ticks_elapsed = 0;
+	uint64_t tick;
+
+	/* announcing only changes on the owning CPU, with IRQs locked */
+	if (q->announcing) {
+		tick = q->announce_tick;
+	} else {
+		tick = read_curr_tick(&ticks_elapsed);
+	}
+
+	arch_irq_unlock(key);
+
+	return with_elapsed ? (tick + ticks_elapsed) : tick;
+}
+
+/* Locks the queue holding a timeout, returns NULL if it's not queued */
+static struct timeout_queue *lock_timeout_queue(const struct _timeout *to,
+						k_spinlock_key_t *key)
+{
+	while (true) {
+		uint8_t cpu = to->cpu;
+		struct timeout_queue *q = &timeout_queues[cpu];
+
+		*key = k_spin_lock(&q->lock);
+
+		if (z_is_inactive_timeout(to)) {
+			k_spin_unlock(&q->lock, *key);
+			return NULL;
+		}
+
+		if (to->cpu == cpu) {
+			return q;
+		}
+
+		/* Expired and re-armed on another CPU meanwhile */
+		k_spin_unlock(&q->lock, *key);
+	}
+}
+
+/* must hold timeout_lock */
+static int32_t next_timeout(void)
+{
+	uint64_t now = curr_tick + sys_clock_elapsed();
+	uint64_t next = UINT64_MAX;
+	int32_t ret;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct timeout_queue *q = &timeout_queues[i];
+
+		if (q->next > curr_tick) {
+			next = MIN(next, q->next);
+		} else if (atomic_get(&q->pending) == 0) {
+			/* Became due before it was published, announce it
+			 * right away.  The queues already flagged reprogram
+			 * the timer once their CPU has expired them.
+			 */
+			next = curr_tick;
+		}
+	}
+
+	if ((next == UINT64_MAX) ||
+	    ((int64_t)(next - now) > (int64_t)INT_MAX)) {
+		ret = MAX_WAIT;
+	} else {
+		ret = MAX(0, (int64_t)(next - now));
+	}
+
+	return ret;
+}
+
+/* Publishes a timeout just queued if it is the new earliest one of its
+ * queue, must hold q->lock.  A CPU running its expiry loop publishes
+ * when it is done.
+ */
+static void publish_timeout(struct timeout_queue *q, struct _timeout *to)
+{
+	if ((to != q_first(q)) || q->announcing) {
+		return;
+	}
+
+	K_SPINLOCK(&timeout_lock) {
+		q->next = to->dticks;
+		sys_clock_set_timeout(next_timeout(), false);
+	}
+}
+
+/* CPU for the timeout of a thread: the one it last ran on, if its
+ * affinity still allows it, so that the thread is woken up there.
+ */
+static unsigned int thread_timeout_cpu(struct k_thread *thread)
+{
+	unsigned int cpu = thread->base.cpu;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask;
+
+	if ((m != 0U) && ((m & BIT(cpu)) == 0U)) {
+		cpu = u32_count_trailing_zeros(m);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	return (cpu < arch_num_cpus()) ? cpu : 0U;
+}
+
+/* Queues a timeout on the current CPU, or on the CPU of a thread */
+static void add_timeout(struct _timeout *to, _timeout_func_t fn,
+			k_timeout_t timeout, struct k_thread *thread)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
+	__ASSERT(z_is_inactive_timeout(to), "");
+	to->fn = fn;
+
+	/* Stay on this CPU until the timeout is queued */
+	unsigned int irq_key = arch_irq_lock();
+	unsigned int id = arch_curr_cpu()->id;
+	unsigned int cpu = (thread != NULL) ? thread_timeout_cpu(thread) : id;
+	struct timeout_queue *q = &timeout_queues[cpu];
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+	int32_t ticks_elapsed = 0;
+	uint64_t tick;
+
+	if ((cpu == id) && q->announcing) {
+		tick = q->announce_tick;
+	} else {
+		tick = read_curr_tick(&ticks_elapsed);
+	}
+
+	if (Z_TICK_ABS(timeout.ticks) >= 0) {
+		k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - tick;
+
+		to->dticks = tick + MAX(1, ticks);
+	} else {
+		to->dticks = tick + timeout.ticks + 1 + ticks_elapsed;
+	}
+
+	to->cpu = cpu;
+	q_insert(q, to);
+	publish_timeout(q, to);
+
+	k_spin_unlock(&q->lock, key);
+	arch_irq_unlock(irq_key);
+}
+
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
+		   k_timeout_t timeout)
+{
+	add_timeout(to, fn, timeout, NULL);
+}
+
+void z_add_thread_timeout(struct k_thread *thread, k_timeout_t ticks)
+{
+	add_timeout(&thread->base.timeout, z_thread_timeout, ticks, thread);
+}
+
+void z_migrate_thread_timeout(struct k_thread *thread)
+{
+	struct _timeout *to = &thread->base.timeout;
+	unsigned int cpu = thread_timeout_cpu(thread);
+	struct timeout_queue *dst = &timeout_queues[cpu];
+	struct timeout_queue *src, *lo, *hi;
+	k_spinlock_key_t lo_key, hi_key;
+
+	/* Both queues are locked, lowest CPU first, so that the timeout
+	 * is never seen unqueued while it moves.
+	 */
+	while (true) {
+		unsigned int from = to->cpu;
+
+		if (from == cpu) {
+			return;
+		}
+
+		src = &timeout_queues[from];
+		lo = (from < cpu) ? src : dst;
+		hi = (from < cpu) ? dst : src;
+
+		lo_key = k_spin_lock(&lo->lock);
+		hi_key = k_spin_lock(&hi->lock);
+
+		if (z_is_inactive_timeout(to) || (to->cpu == from)) {
+			break;
+		}
+
+		/* Expired and re-armed on another CPU meanwhile */
+		k_spin_unlock(&hi->lock, hi_key);
+		k_spin_unlock(&lo->lock, lo_key);
+	}
+
+	if (!z_is_inactive_timeout(to)) {
+		/* The expiry is absolute, it is kept as is */
+		k_ticks_t dticks = to->dticks;
+
+		q_remove(src, to);
+		to->dticks = dticks;
+		to->cpu = cpu;
+		q_insert(dst, to);
+		publish_timeout(dst, to);
+	}
+
+	k_spin_unlock(&hi->lock, hi_key);
+	k_spin_unlock(&lo->lock, lo_key);
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_timeout_queue(to, &key);
+
+	if (q == NULL) {
+		return -EINVAL;
+	}
+
+	/* q->next is left as is, the next expiry pass publishes the new
+	 * earliest timeout.
+	 */
+	q_remove(q, to);
+	k_spin_unlock(&q->lock, key);
+
+	return 0;
+}
+
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_timeout_queue(timeout, &key);
+	k_ticks_t ticks = 0;
+
+	if (q != NULL) {
+		ticks = timeout->dticks - (int64_t)cpu_tick(true);
+		k_spin_unlock(&q->lock, key);
+	}
+
+	return ticks;
+}
+
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+{
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_timeout_queue(timeout, &key);
+	k_ticks_t ticks;
+
+	if (q != NULL) {
+		ticks = timeout->dticks;
+		k_spin_unlock(&q->lock, key);
+	} else {
+		ticks = cpu_tick(false);
+	}
+
+	return ticks;
+}
+
+int32_t z_get_next_timeout_expiry(void)
+{
+	int32_t ret = (int32_t) K_TICKS_FOREVER;
+
+	K_SPINLOCK(&timeout_lock) {
+		ret = next_timeout();
+	}
+	return ret;
+}
+
+/* Runs the due timeouts of the current CPU, from ISR context */
+static void expire_timeouts(void)
+{
+	struct timeout_queue *q = this_queue();
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+	struct _timeout *t;
+	bool due = false;
+
+	/* If we interrupted our own expiry loop, it will see the new
+	 * due timeouts before returning.
+	 */
+	if (q->announcing) {
+		k_spin_unlock(&q->lock, key);
+		return;
+	}
+
+	q->announcing = true;
+
+	do {
+		uint64_t target = read_curr_tick(NULL);
+
+		for (t = q_first(q);
+		     (t != NULL) && ((uint64_t)t->dticks <= target);
+		     t = q_first(q)) {
+			q->announce_tick = t->dticks;
+			q_remove(q, t);
+
+			k_spin_unlock(&q->lock, key);
+			t->fn(t);
+			key = k_spin_lock(&q->lock);
+		}
+
+		K_SPINLOCK(&timeout_lock) {
+			t = q_first(q);
+			q->next = (t == NULL) ? UINT64_MAX : (uint64_t)t->dticks;
+
+			/* Time went on while the callbacks ran */
+			due = q->next <= curr_tick;
+			if (!due) {
+				atomic_clear(&q->pending);
+				sys_clock_set_timeout(next_timeout(), false);
+			}
+		}
+	} while (due);
+
+	q->announcing = false;
+
+	k_spin_unlock(&q->lock, key);
+}
+
+void z_timeout_ipi(void)
+{
+	if (atomic_get(&this_queue()->pending) != 0) {
+		expire_timeouts();
+	}
+}
+
+void sys_clock_announce(int32_t ticks)
+{
+	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	unsigned int id = arch_curr_cpu()->id;
+	uint32_t ipi_mask = 0U;
+
+	set_curr_tick(curr_tick + ticks);
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct timeout_queue *q = &timeout_queues[i];
+
+		if (q->next <= curr_tick) {
+			atomic_set(&q->pending, 1);
+			if (i != id) {
+				ipi_mask |= BIT(i);
+			}
+		}
+	}
+
+	sys_clock_set_timeout(next_timeout(), false);
+
+	k_spin_unlock(&timeout_lock, key);
+
+	if (ipi_mask != 0U) {
+		flag_ipi(ipi_mask);
+		signal_pending_ipi();
+	}
+
+	z_timeout_ipi();
+
+#ifdef CONFIG_TIMESLICING
+	z_time_slice();
+#endif /* CONFIG_TIMESLICING */
+}
+
+int64_t sys_clock_tick_get(void)
+{
+	return cpu_tick(true);
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 uint32_t sys_clock_tick_get_32(void)
 {
 #ifdef CONFIG_TICKLESS_KERNEL
@@ -330,7 +897,38 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#if defined(CONFIG_TIMEOUT_QUEUE_PER_CPU)
+	k_spinlock_key_t keys[CONFIG_MP_MAX_NUM_CPUS];
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		keys[i] = k_spin_lock(&timeout_queues[i].lock);
+	}
+
+	K_SPINLOCK(&timeout_lock) {
+		uint64_t delta = tick - curr_tick;
+
+		for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+			struct timeout_queue *q = &timeout_queues[i];
+
+			q_rebase(q, delta);
+			if (q->next != UINT64_MAX) {
+				q->next += delta;
+			}
+		}
+
+		set_curr_tick(tick);
+	}
+
+	for (unsigned int i = arch_num_cpus(); i > 0; i--) {
+		k_spin_unlock(&timeout_queues[i - 1].lock, keys[i - 1]);
+	}
+#else
+#if defined(CONFIG_TIMEOUT_QUEUE_SCALABLE)
+	q_rebase(&timeout_queue, tick - curr_tick);
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
 	curr_tick = tick;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
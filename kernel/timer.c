@@ -43,7 +43,7 @@ void z_timer_expiration_handler(struct _timeout *t)
 	 * was restarted, its expiration handler should not be executed then,
 	 * so the function exits immediately.
 	 */
-	if (sys_dnode_is_linked(&t->node)) {
+	if (!z_is_inactive_timeout(t)) {
 		k_spin_unlock(&lock, key);
 		return;
 	}
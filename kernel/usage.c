@@ -10,6 +10,7 @@
 #include <ksched.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/check.h>
+#include <string.h>
 
 /* Need one of these for this to work */
 #if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
@@ -71,14 +72,52 @@ static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 }
 
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+void z_sched_wakeup_latency_start(struct k_thread *thread)
+{
+	thread->base.wakeup.ready0 = usage_now();
+}
+
+/* Only called by the CPU switching the thread in, which owns it */
+static void sched_wakeup_latency_update(struct k_thread *thread, uint32_t now)
+{
+	struct k_wakeup_latency_stats *wakeup = &thread->base.wakeup;
+	uint32_t cycles;
+	unsigned int bucket;
+
+	if (wakeup->ready0 == 0) {
+		/* Not switched in after a wakeup */
+		return;
+	}
+
+	cycles = now - wakeup->ready0;
+	wakeup->ready0 = 0;
+
+	bucket = (cycles < 2U) ? 0U : (find_msb_set(cycles) - 1U);
+	bucket = MIN(bucket, CONFIG_SCHED_THREAD_WAKEUP_LATENCY_BUCKETS - 1);
+
+	wakeup->buckets[bucket]++;
+	wakeup->count++;
+	if (wakeup->longest < cycles) {
+		wakeup->longest = cycles;
+	}
+}
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
+
 void z_sched_usage_start(struct k_thread *thread)
 {
+	uint32_t now = usage_now();
+
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+	sched_wakeup_latency_update(thread, now);
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 	k_spinlock_key_t  key;
 
 	key = k_spin_lock(&usage_lock);
 
-	_current_cpu->usage0 = usage_now();   /* Always update */
+	_current_cpu->usage0 = now;   /* Always update */
 
 	if (thread->base.usage.track_usage) {
 		thread->base.usage.num_windows++;
@@ -92,7 +131,7 @@ void z_sched_usage_start(struct k_thread *thread)
 	 * (we can't race with _stop() by design).
 	 */
 
-	_current_cpu->usage0 = usage_now();
+	_current_cpu->usage0 = now;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 }
 
@@ -221,6 +260,13 @@ void z_sched_thread_usage(struct k_thread *thread,
 	stats->idle_cycles = 0;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+	stats->wakeup_count = thread->base.wakeup.count;
+	stats->wakeup_peak_cycles = thread->base.wakeup.longest;
+	memcpy(stats->wakeup_buckets, thread->base.wakeup.buckets,
+	       sizeof(stats->wakeup_buckets));
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
+
 	k_spin_unlock(&usage_lock, key);
 }
 
@@ -245,6 +245,100 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Wake an idle sibling of a pool worker, to steal work from it.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue a queue that got work but could not be woken.
+ *
+ * @return true if and only if a sibling was woken.
+ */
+static bool notify_pool_locked(struct k_work_q *queue)
+{
+	struct k_work_pool *pool = queue->pool;
+
+	if (pool == NULL) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < pool->num_workers; i++) {
+		struct k_work_q *sibling = &pool->workers[i];
+
+		if ((sibling != queue) &&
+		    flag_test(&sibling->flags, K_WORK_QUEUE_STARTED_BIT) &&
+		    notify_queue_locked(sibling)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Check whether a pending work item may run on another worker.
+ *
+ * A running item is queued to the worker running it to prevent handler
+ * re-entrancy, and an item being flushed must stay in front of its
+ * flusher, which itself must stay where it is.
+ *
+ * Invoked with work lock held.
+ */
+static bool work_stealable_locked(struct k_work *work)
+{
+	sys_snode_t *next = sys_slist_peek_next(&work->node);
+
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT) ||
+	    flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+		return false;
+	}
+
+	return (next == NULL) ||
+	       !flag_test(&CONTAINER_OF(next, struct k_work, node)->flags,
+			  K_WORK_FLUSHING_BIT);
+}
+
+/* Take the oldest stealable work item from a sibling of a pool worker.
+ *
+ * The item is moved to @p queue, so that cancellation and flushing
+ * find it there.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the idle worker.
+ *
+ * @return the node of the stolen item, or NULL if there is none.
+ */
+static sys_snode_t *pool_steal_locked(struct k_work_q *queue)
+{
+	struct k_work_pool *pool = queue->pool;
+	unsigned int self = queue - pool->workers;
+
+	for (unsigned int i = 1; i < pool->num_workers; i++) {
+		struct k_work_q *victim =
+			&pool->workers[(self + i) % pool->num_workers];
+		sys_snode_t *prev = NULL;
+		struct k_work *work;
+
+		/* Whoever waits for it to drain waits for its items */
+		if (flag_test(&victim->flags, K_WORK_QUEUE_DRAIN_BIT)) {
+			continue;
+		}
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&victim->pending, work, node) {
+			if (work_stealable_locked(work)) {
+				sys_slist_remove(&victim->pending, prev,
+						 &work->node);
+				work->queue = queue;
+				return &work->node;
+			}
+			prev = &work->node;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /* Submit an work item to a queue if queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
@@ -292,7 +386,14 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (!notify_queue_locked(queue)) {
+			/* Busy, let an idle sibling take the work */
+			(void)notify_pool_locked(queue);
+		}
+#else
 		(void)notify_queue_locked(queue);
+#endif /* CONFIG_WORKQUEUE_POOL */
 	}
 
 	return ret;
@@ -629,6 +730,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 
 		/* Check for and prepare any new work. */
 		node = sys_slist_get(&queue->pending);
+#ifdef CONFIG_WORKQUEUE_POOL
+		/* Out of work: help the other workers of our pool, unless
+		 * we're asked to drain.
+		 */
+		if ((node == NULL) && (queue->pool != NULL) &&
+		    !flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT)) {
+			node = pool_steal_locked(queue);
+		}
+#endif /* CONFIG_WORKQUEUE_POOL */
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
@@ -822,6 +932,128 @@ int k_work_queue_unplug(struct k_work_q *queue)
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Select the worker of a pool new work is submitted to.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work_q *pool_queue_locked(struct k_work_pool *pool)
+{
+	struct k_work_q *queue;
+
+	/* Work submitted from a handler stays on its worker.  This also
+	 * allows chained submissions while the pool drains.
+	 */
+	if (!k_is_in_isr()) {
+		for (unsigned int i = 0; i < pool->num_workers; i++) {
+			queue = &pool->workers[i];
+			if (_current == &queue->thread) {
+				return queue;
+			}
+		}
+	}
+
+	/* Otherwise prefer an idle worker */
+	for (unsigned int i = 0; i < pool->num_workers; i++) {
+		unsigned int idx = (pool->next + i) % pool->num_workers;
+
+		queue = &pool->workers[idx];
+		if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT) &&
+		    sys_slist_is_empty(&queue->pending)) {
+			pool->next = (idx + 1) % pool->num_workers;
+			return queue;
+		}
+	}
+
+	queue = &pool->workers[pool->next];
+	pool->next = (pool->next + 1) % pool->num_workers;
+
+	return queue;
+}
+
+static struct k_work_q *pool_queue_get(struct k_work_pool *pool)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_work_q *queue = pool_queue_locked(pool);
+
+	k_spin_unlock(&lock, key);
+
+	return queue;
+}
+
+void k_work_pool_start(struct k_work_pool *pool, int prio,
+		       const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(pool->num_workers > 0U);
+
+	/* Workers look at each other as soon as they run */
+	for (unsigned int i = 0; i < pool->num_workers; i++) {
+		k_work_queue_init(&pool->workers[i]);
+		pool->workers[i].pool = pool;
+	}
+
+	for (unsigned int i = 0; i < pool->num_workers; i++) {
+		k_thread_stack_t *stack = (k_thread_stack_t *)
+			((char *)pool->stacks + (i * pool->stack_stride));
+
+		k_work_queue_start(&pool->workers[i], stack, pool->stack_size,
+				   prio, cfg);
+	}
+}
+
+int k_work_pool_submit(struct k_work_pool *pool, struct k_work *work)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	return k_work_submit_to_queue(pool_queue_get(pool), work);
+}
+
+int k_work_pool_drain(struct k_work_pool *pool, bool plug)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Stop all stealing first, so that no item escapes to a worker
+	 * that already drained.
+	 */
+	for (unsigned int i = 0; i < pool->num_workers; i++) {
+		flag_set(&pool->workers[i].flags, K_WORK_QUEUE_DRAIN_BIT);
+		(void)notify_queue_locked(&pool->workers[i]);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	for (unsigned int i = 0; i < pool->num_workers; i++) {
+		int rc = k_work_queue_drain(&pool->workers[i], plug);
+
+		if (rc < 0) {
+			return rc;
+		}
+		ret = MAX(ret, rc);
+	}
+
+	return ret;
+}
+
+int k_work_pool_unplug(struct k_work_pool *pool)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	int ret = -EALREADY;
+
+	for (unsigned int i = 0; i < pool->num_workers; i++) {
+		if (k_work_queue_unplug(&pool->workers[i]) == 0) {
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 
 /* Timeout handler for delayable work.
@@ -1046,6 +1278,24 @@ int k_work_reschedule(struct k_work_delayable *dwork,
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+int k_work_pool_schedule(struct k_work_pool *pool,
+			 struct k_work_delayable *dwork, k_timeout_t delay)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	return k_work_schedule_for_queue(pool_queue_get(pool), dwork, delay);
+}
+
+int k_work_pool_reschedule(struct k_work_pool *pool,
+			   struct k_work_delayable *dwork, k_timeout_t delay)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	return k_work_reschedule_for_queue(pool_queue_get(pool), dwork, delay);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_cancel_delayable(struct k_work_delayable *dwork)
 {
 	__ASSERT_NO_MSG(dwork != NULL);
@@ -374,6 +374,72 @@ int zvfs_close(int fd)
 	return res;
 }
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+/* A single lock for all watch lists, the lists are short and the
+ * callbacks only queue work.
+ */
+static struct k_spinlock poll_watch_lock;
+
+void zvfs_poll_watch_attach(sys_slist_t *list, struct zvfs_poll_watch *watch)
+{
+	k_spinlock_key_t key = k_spin_lock(&poll_watch_lock);
+
+	if (watch->list != NULL) {
+		(void)sys_slist_find_and_remove(watch->list, &watch->node);
+	}
+
+	watch->list = list;
+	sys_slist_append(list, &watch->node);
+
+	k_spin_unlock(&poll_watch_lock, key);
+}
+
+void zvfs_poll_watch_detach(struct zvfs_poll_watch *watch)
+{
+	k_spinlock_key_t key = k_spin_lock(&poll_watch_lock);
+
+	if (watch->list != NULL) {
+		(void)sys_slist_find_and_remove(watch->list, &watch->node);
+		watch->list = NULL;
+	}
+
+	k_spin_unlock(&poll_watch_lock, key);
+}
+
+void zvfs_poll_watch_notify(sys_slist_t *list)
+{
+	struct zvfs_poll_watch *watch;
+	k_spinlock_key_t key;
+
+	if (sys_slist_is_empty(list)) {
+		return;
+	}
+
+	key = k_spin_lock(&poll_watch_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, watch, node) {
+		watch->cb(watch);
+	}
+
+	k_spin_unlock(&poll_watch_lock, key);
+}
+
+void zvfs_poll_watch_detach_all(sys_slist_t *list)
+{
+	struct zvfs_poll_watch *watch;
+	sys_snode_t *node;
+	k_spinlock_key_t key = k_spin_lock(&poll_watch_lock);
+
+	while ((node = sys_slist_get(list)) != NULL) {
+		watch = CONTAINER_OF(node, struct zvfs_poll_watch, node);
+		watch->list = NULL;
+		watch->cb(watch);
+	}
+
+	k_spin_unlock(&poll_watch_lock, key);
+}
+#endif /* CONFIG_FDTABLE_POLL_WATCH */
+
 int zvfs_fstat(int fd, struct stat *buf)
 {
 	if (_check_fd(fd) < 0) {
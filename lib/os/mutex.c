@@ -9,6 +9,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/kernel_structs.h>
 
+#ifndef CONFIG_SYS_MUTEX_FUTEX
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
 	struct k_object *obj;
@@ -72,3 +73,83 @@ static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 	return z_impl_z_sys_mutex_kernel_unlock(mutex);
 }
 #include <zephyr/syscalls/z_sys_mutex_kernel_unlock_mrsh.c>
+
+#else
+/* The k_futex contained in a sys_mutex is the kernel object tracked for it,
+ * which k_futex_wait() and k_futex_wake() validate.
+ */
+int z_sys_mutex_futex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
+{
+	k_tid_t self = k_current_get();
+	int ret;
+
+	if (mutex->owner == self) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	if (atomic_cas(&mutex->futex.val, Z_SYS_MUTEX_UNLOCKED,
+		       Z_SYS_MUTEX_LOCKED)) {
+		goto locked;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+#ifdef CONFIG_TIMEOUT_64BIT
+	/* Waking up without getting the mutex must not restart the
+	 * waiting period
+	 */
+	if (!K_TIMEOUT_EQ(timeout, K_FOREVER) &&
+	    (Z_TICK_ABS(timeout.ticks) < 0)) {
+		timeout = K_TIMEOUT_ABS_TICKS(k_uptime_ticks() + timeout.ticks);
+	}
+#endif /* CONFIG_TIMEOUT_64BIT */
+
+	/* Once a thread had to wait, other waiters may remain when it gets
+	 * the mutex, so it's always taken as contended from here on.
+	 */
+	while (atomic_set(&mutex->futex.val, Z_SYS_MUTEX_CONTENDED) !=
+	       Z_SYS_MUTEX_UNLOCKED) {
+		ret = k_futex_wait(&mutex->futex, Z_SYS_MUTEX_CONTENDED, timeout);
+		if (ret == -ETIMEDOUT) {
+			return -EAGAIN;
+		} else if ((ret != 0) && (ret != -EAGAIN)) {
+			return ret;
+		} else {
+			;
+		}
+	}
+
+locked:
+	mutex->owner = self;
+	mutex->lock_count = 1U;
+
+	return 0;
+}
+
+int z_sys_mutex_futex_unlock(struct sys_mutex *mutex)
+{
+	if (atomic_get(&mutex->futex.val) == Z_SYS_MUTEX_UNLOCKED) {
+		return -EINVAL;
+	}
+
+	if (mutex->owner != k_current_get()) {
+		return -EPERM;
+	}
+
+	mutex->lock_count--;
+	if (mutex->lock_count > 0U) {
+		return 0;
+	}
+
+	mutex->owner = NULL;
+	if (atomic_set(&mutex->futex.val, Z_SYS_MUTEX_UNLOCKED) ==
+	    Z_SYS_MUTEX_CONTENDED) {
+		(void)k_futex_wake(&mutex->futex, false);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
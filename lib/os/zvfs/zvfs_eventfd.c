@@ -23,6 +23,9 @@ struct zvfs_eventfd {
 	struct k_spinlock lock;
 	zvfs_eventfd_t cnt;
 	int flags;
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	sys_slist_t poll_watch;
+#endif
 };
 
 static ssize_t zvfs_eventfd_rw_op(void *obj, void *buf, size_t sz,
@@ -47,6 +50,15 @@ static inline bool zvfs_eventfd_is_blocking(struct zvfs_eventfd *efd)
 	return (efd->flags & ZVFS_EFD_NONBLOCK) == 0;
 }
 
+static inline void zvfs_eventfd_notify_watch(struct zvfs_eventfd *efd)
+{
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	zvfs_poll_watch_notify(&efd->poll_watch);
+#else
+	ARG_UNUSED(efd);
+#endif
+}
+
 static int zvfs_eventfd_poll_prepare(struct zvfs_eventfd *efd,
 				struct zsock_pollfd *pfd,
 				struct k_poll_event **pev,
@@ -124,6 +136,7 @@ static int zvfs_eventfd_read_locked(struct zvfs_eventfd *efd, zvfs_eventfd_t *va
 	}
 
 	k_poll_signal_raise(&efd->write_sig, 0);
+	zvfs_eventfd_notify_watch(efd);
 
 	return 0;
 }
@@ -155,6 +168,7 @@ static int zvfs_eventfd_write_locked(struct zvfs_eventfd *efd, zvfs_eventfd_t *v
 	}
 
 	k_poll_signal_raise(&efd->read_sig, 0);
+	zvfs_eventfd_notify_watch(efd);
 
 	return 0;
 }
@@ -206,6 +220,10 @@ static int zvfs_eventfd_close_op(void *obj)
 	efd->flags = 0;
 	efd->cnt = 0;
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	zvfs_poll_watch_detach_all(&efd->poll_watch);
+#endif
+
 	ret = 0;
 
 unlock:
@@ -277,6 +295,13 @@ static int zvfs_eventfd_ioctl_op(void *obj, unsigned int request, va_list args)
 		ret = zvfs_eventfd_poll_update(obj, pfd, pev);
 	} break;
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	case ZFD_IOCTL_POLL_WATCH:
+		zvfs_poll_watch_attach(&efd->poll_watch, va_arg(args, struct zvfs_poll_watch *));
+		ret = 0;
+		break;
+#endif
+
 	default:
 		errno = EOPNOTSUPP;
 		ret = -1;
@@ -434,6 +459,9 @@ int zvfs_eventfd(unsigned int initval, int flags)
 
 	k_poll_signal_init(&efd->write_sig);
 	k_poll_signal_init(&efd->read_sig);
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	sys_slist_init(&efd->poll_watch);
+#endif
 
 	if (initval != 0) {
 		k_poll_signal_raise(&efd->read_sig, 0);
@@ -537,6 +537,11 @@ def find_kobjects(elf, syms):
     user_stack_start = syms["z_user_stacks_start"]
     user_stack_end = syms["z_user_stacks_end"]
 
+    # A futex based sys_mutex is not backed by a k_mutex: it is analyzed as
+    # a plain struct instead, so that the k_futex it contains is tracked.
+    if "CONFIG_SYS_MUTEX_FUTEX" in syms:
+        del kobjects["sys_mutex"]
+
     di = elf.get_dwarf_info()
 
     variables = []
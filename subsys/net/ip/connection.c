@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/hash_map.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
@@ -59,6 +60,12 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** Local and remote address and port all specified */
+#define NET_CONN_TUPLE_SPEC		(NET_CONN_REMOTE_PORT_SPEC | \
+					 NET_CONN_LOCAL_PORT_SPEC |  \
+					 NET_CONN_REMOTE_ADDR_SPEC | \
+					 NET_CONN_LOCAL_ADDR_SPEC)
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
@@ -116,6 +123,323 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Connections bound to a complete 4-tuple are kept in conn_tuple_map,
+ * keyed by a hash of the tuple, and the other UDP/TCP ones in
+ * conn_port_map, keyed by protocol and local port. Connections sharing
+ * a key are chained through hash_next, newest first as in conn_used,
+ * and the map holds the head of the chain. Both maps are protected by
+ * conn_lock.
+ *
+ * The heap is sized for every connection having its own key, plus the
+ * bucket arrays of both maps while they are being reallocated.
+ */
+#define CONN_HASH_HEAP_SIZE (CONFIG_NET_MAX_CONN * 28 * sizeof(void *) + 256)
+
+K_HEAP_DEFINE(net_conn_hash_heap, CONN_HASH_HEAP_SIZE);
+
+static void *conn_hash_alloc(void *ptr, size_t new_size)
+{
+	if (new_size == 0) {
+		k_heap_free(&net_conn_hash_heap, ptr);
+		return NULL;
+	}
+
+	return k_heap_realloc(&net_conn_hash_heap, ptr, new_size, K_NO_WAIT);
+}
+
+SYS_HASHMAP_DEFAULT_DEFINE_STATIC_ADVANCED(conn_tuple_map, sys_hash32, conn_hash_alloc,
+	SYS_HASHMAP_CONFIG(CONFIG_NET_MAX_CONN, SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+SYS_HASHMAP_DEFAULT_DEFINE_STATIC_ADVANCED(conn_port_map, sys_hash32, conn_hash_alloc,
+	SYS_HASHMAP_CONFIG(CONFIG_NET_MAX_CONN, SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+/* Addresses and ports are in network byte order, as found in packets */
+static uint64_t conn_tuple_key(sa_family_t family, uint16_t proto,
+			       const void *remote_addr, const void *local_addr,
+			       uint16_t remote_port, uint16_t local_port)
+{
+	struct {
+		uint8_t remote[sizeof(struct in6_addr)];
+		uint8_t local[sizeof(struct in6_addr)];
+		uint16_t proto;
+		uint16_t family;
+	} tuple = {
+		.proto = proto,
+		.family = family,
+	};
+	size_t len = family == AF_INET6 ? sizeof(struct in6_addr) :
+					  sizeof(struct in_addr);
+
+	memcpy(tuple.remote, remote_addr, len);
+	memcpy(tuple.local, local_addr, len);
+
+	return ((uint64_t)sys_hash32(&tuple, sizeof(tuple)) << 32) |
+	       ((uint32_t)remote_port << 16) | local_port;
+}
+
+static uint64_t conn_port_key(uint16_t proto, uint16_t local_port)
+{
+	return ((uint32_t)proto << 16) | local_port;
+}
+
+static const void *conn_sa_addr(const struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		return &net_sin6(addr)->sin6_addr;
+	}
+
+	return &net_sin(addr)->sin_addr;
+}
+
+static bool conn_sa_equal(const struct sockaddr *a, const struct sockaddr *b)
+{
+	if (a->sa_family != b->sa_family ||
+	    net_sin(a)->sin_port != net_sin(b)->sin_port) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && a->sa_family == AF_INET6) {
+		return net_ipv6_addr_cmp(&net_sin6(a)->sin6_addr,
+					 &net_sin6(b)->sin6_addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && a->sa_family == AF_INET) {
+		return net_ipv4_addr_cmp(&net_sin(a)->sin_addr,
+					 &net_sin(b)->sin_addr);
+	}
+
+	return false;
+}
+
+/* Packet and CAN sockets are not hashed, they are only matched against
+ * packets of their own family, which always walk conn_used.
+ */
+static bool conn_hash_map_key(struct net_conn *conn,
+			      struct sys_hashmap **map, uint64_t *key)
+{
+	sa_family_t family = conn->local_addr.sa_family;
+
+	if (conn->family == AF_PACKET || conn->family == AF_CAN) {
+		return false;
+	}
+
+	if ((conn->flags & NET_CONN_TUPLE_SPEC) == NET_CONN_TUPLE_SPEC &&
+	    (family == AF_INET || family == AF_INET6) &&
+	    conn->remote_addr.sa_family == family) {
+		*map = &conn_tuple_map;
+		*key = conn_tuple_key(family, conn->proto,
+				      conn_sa_addr(&conn->remote_addr),
+				      conn_sa_addr(&conn->local_addr),
+				      net_sin(&conn->remote_addr)->sin_port,
+				      net_sin(&conn->local_addr)->sin_port);
+	} else {
+		*map = &conn_port_map;
+		*key = conn_port_key(conn->proto,
+				     net_sin(&conn->local_addr)->sin_port);
+	}
+
+	return true;
+}
+
+static struct net_conn *conn_hash_get(struct sys_hashmap *map, uint64_t key)
+{
+	uint64_t head;
+
+	if (!sys_hashmap_get(map, key, &head)) {
+		return NULL;
+	}
+
+	return (struct net_conn *)(uintptr_t)head;
+}
+
+/* Must be called with conn_lock held */
+static int conn_hash_add(struct net_conn *conn)
+{
+	struct sys_hashmap *map;
+	uint64_t key;
+	struct net_conn *head;
+	int ret;
+
+	if (!conn_hash_map_key(conn, &map, &key)) {
+		return 0;
+	}
+
+	head = conn_hash_get(map, key);
+
+	ret = sys_hashmap_insert(map, key, (uintptr_t)conn, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	conn->hash_next = head;
+
+	return 0;
+}
+
+/* Must be called with conn_lock held, before the addresses, ports or
+ * flags the key was computed from are changed.
+ */
+static void conn_hash_del(struct net_conn *conn)
+{
+	struct sys_hashmap *map;
+	struct net_conn **prev;
+	struct net_conn *head;
+	uint64_t key;
+
+	if (!conn_hash_map_key(conn, &map, &key)) {
+		return;
+	}
+
+	head = conn_hash_get(map, key);
+	if (head == conn) {
+		if (conn->hash_next != NULL) {
+			/* Replacing the value of a key never allocates */
+			(void)sys_hashmap_insert(map, key,
+						 (uintptr_t)conn->hash_next, NULL);
+		} else {
+			(void)sys_hashmap_remove(map, key, NULL);
+		}
+	} else if (head != NULL) {
+		for (prev = &head->hash_next; *prev != NULL;
+		     prev = &(*prev)->hash_next) {
+			if (*prev == conn) {
+				*prev = conn->hash_next;
+				break;
+			}
+		}
+	}
+
+	conn->hash_next = NULL;
+}
+
+struct net_context *net_conn_find_context(uint16_t proto,
+					  const struct sockaddr *remote_addr,
+					  const struct sockaddr *local_addr)
+{
+	struct net_context *context = NULL;
+	struct net_conn *conn;
+	uint64_t key;
+
+	key = conn_tuple_key(remote_addr->sa_family, proto,
+			     conn_sa_addr(remote_addr),
+			     conn_sa_addr(local_addr),
+			     net_sin(remote_addr)->sin_port,
+			     net_sin(local_addr)->sin_port);
+
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
+	for (conn = conn_hash_get(&conn_tuple_map, key); conn != NULL;
+	     conn = conn->hash_next) {
+		if (conn->proto == proto &&
+		    conn_sa_equal(&conn->remote_addr, remote_addr) &&
+		    conn_sa_equal(&conn->local_addr, local_addr)) {
+			context = conn->context;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&conn_lock);
+
+	return context;
+}
+#else
+#define conn_hash_add(...) 0
+#define conn_hash_del(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
+/* Connections a received packet is matched against. With the hashed
+ * lookup, UDP and TCP packets are only matched against the connections
+ * bound to their 4-tuple, then the ones on their destination port and
+ * the ones on any port, in that order. Other packets, or all of them
+ * without the hashed lookup, are matched against every connection.
+ */
+struct conn_input_iter {
+#if defined(CONFIG_NET_CONN_HASH)
+	struct net_conn *chains[3];
+	uint8_t chain;
+	bool hashed;
+#endif
+	struct net_conn *conn;
+};
+
+/* Must be called with conn_lock held */
+static void conn_input_iter_init(struct conn_input_iter *iter,
+				 struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 uint8_t proto,
+				 uint16_t src_port, uint16_t dst_port)
+{
+	*iter = (struct conn_input_iter){ 0 };
+
+#if defined(CONFIG_NET_CONN_HASH)
+	sa_family_t family = net_pkt_family(pkt);
+	const uint8_t *src;
+	const uint8_t *dst;
+
+	if (proto != IPPROTO_UDP && proto != IPPROTO_TCP) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		src = ip_hdr->ipv6->src;
+		dst = ip_hdr->ipv6->dst;
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		src = ip_hdr->ipv4->src;
+		dst = ip_hdr->ipv4->dst;
+	} else {
+		return;
+	}
+
+	iter->chains[0] = conn_hash_get(&conn_tuple_map,
+					conn_tuple_key(family, proto, src, dst,
+						       src_port, dst_port));
+	iter->chains[1] = conn_hash_get(&conn_port_map,
+					conn_port_key(proto, dst_port));
+	if (dst_port != 0U) {
+		iter->chains[2] = conn_hash_get(&conn_port_map,
+						conn_port_key(proto, 0U));
+	}
+
+	iter->hashed = true;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto);
+	ARG_UNUSED(src_port);
+	ARG_UNUSED(dst_port);
+#endif /* CONFIG_NET_CONN_HASH */
+}
+
+static struct net_conn *conn_input_iter_next(struct conn_input_iter *iter)
+{
+	struct net_conn *conn = iter->conn;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	if (iter->hashed) {
+		conn = conn != NULL ? conn->hash_next : NULL;
+
+		while (conn == NULL && iter->chain < ARRAY_SIZE(iter->chains)) {
+			conn = iter->chains[iter->chain++];
+		}
+
+		iter->conn = conn;
+
+		return conn;
+	}
+#endif /* CONFIG_NET_CONN_HASH */
+
+	if (conn == NULL) {
+		conn = SYS_SLIST_PEEK_HEAD_CONTAINER(&conn_used, conn, node);
+	} else {
+		conn = SYS_SLIST_PEEK_NEXT_CONTAINER(conn, node);
+	}
+
+	iter->conn = conn;
+
+	return conn;
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -135,13 +459,21 @@ static struct net_conn *conn_get_unused(void)
 	return CONTAINER_OF(node, struct net_conn, node);
 }
 
-static void conn_set_used(struct net_conn *conn)
+static int conn_set_used(struct net_conn *conn)
 {
-	conn->flags |= NET_CONN_IN_USE;
+	int ret;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
-	sys_slist_prepend(&conn_used, &conn->node);
+
+	ret = conn_hash_add(conn);
+	if (ret == 0) {
+		conn->flags |= NET_CONN_IN_USE;
+		sys_slist_prepend(&conn_used, &conn->node);
+	}
+
 	k_mutex_unlock(&conn_lock);
+
+	return ret;
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -420,12 +752,17 @@ int net_conn_register(uint16_t proto, uint8_t family,
 		goto error;
 	}
 
+	ret = conn_set_used(conn);
+	if (ret < 0) {
+		NET_ERR("Cannot add connection handler to lookup table (%d)", ret);
+		conn_set_unused(conn);
+		return ret;
+	}
+
 	if (handle) {
 		*handle = (struct net_conn_handle *)conn;
 	}
 
-	conn_set_used(conn);
-
 	conn->v6only = net_context_is_v6only_set(context);
 
 	conn_register_debug(conn, remote_port, local_port);
@@ -451,6 +788,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_hash_del(conn);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
 	k_mutex_unlock(&conn_lock);
 
@@ -476,10 +814,22 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
 	net_conn_change_callback(conn, cb, user_data);
 
+	/* The remote address and port are part of the lookup key */
+	conn_hash_del(conn);
+
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
 
+	if (conn_hash_add(conn) < 0) {
+		NET_ERR("Cannot add connection handler to lookup table");
+		ret = -ENOMEM;
+	}
+
+	k_mutex_unlock(&conn_lock);
+
 	return ret;
 }
 
@@ -688,6 +1038,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool is_bcast_pkt = false;
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
+	struct conn_input_iter iter;
 	struct net_conn *conn;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
@@ -710,7 +1061,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	conn_input_iter_init(&iter, pkt, ip_hdr, proto, src_port, dst_port);
+
+	while ((conn = conn_input_iter_next(&iter)) != NULL) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
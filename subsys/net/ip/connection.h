@@ -82,6 +82,11 @@ struct net_conn {
 
 	/** Is v4-mapping-to-v6 enabled for this connection */
 	uint8_t v6only : 1;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Next connection with the same lookup table key */
+	struct net_conn *hash_next;
+#endif
 };
 
 /**
@@ -174,6 +179,25 @@ int net_conn_update(struct net_conn_handle *handle,
 		    const struct sockaddr *remote_addr,
 		    uint16_t remote_port);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/**
+ * @brief Find the context of the connection handler registered for
+ * a complete address and port 4-tuple.
+ *
+ * Only handlers registered with all of the local and remote address
+ * and port specified are considered.
+ *
+ * @param proto Protocol of the connection (IPPROTO_UDP or IPPROTO_TCP)
+ * @param remote_addr Remote address and port of the connection.
+ * @param local_addr Local address and port of the connection.
+ *
+ * @return Context of the matching handler, NULL if there is none.
+ */
+struct net_context *net_conn_find_context(uint16_t proto,
+					  const struct sockaddr *remote_addr,
+					  const struct sockaddr *local_addr);
+#endif /* CONFIG_NET_CONN_HASH */
+
 /**
  * @brief Called by net_core.c when a network packet is received.
  *
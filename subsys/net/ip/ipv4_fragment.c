@@ -142,6 +142,7 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 	struct net_ipv4_hdr *ipv4_hdr;
 	struct net_pkt *pkt;
 	struct net_buf *last;
+	uint16_t len;
 	int i;
 
 	k_work_cancel_delayable(&reass->timer);
@@ -195,12 +196,18 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 		goto error;
 	}
 
-	/* Fix the total length, offset and checksum of the IPv4 packet */
-	ipv4_hdr->len = htons(net_pkt_get_len(pkt));
+	/* Fix the total length, offset and checksum of the IPv4 packet. The
+	 * checksum of the first fragment was valid, so only the changes
+	 * need to be accounted for.
+	 */
+	len = htons(net_pkt_get_len(pkt));
+	ipv4_hdr->chksum = net_chksum_update16(ipv4_hdr->chksum, ipv4_hdr->len, len);
+	ipv4_hdr->len = len;
+	ipv4_hdr->chksum = net_chksum_update16(ipv4_hdr->chksum,
+					       UNALIGNED_GET((uint16_t *)ipv4_hdr->offset),
+					       0U);
 	ipv4_hdr->offset[0] = 0;
 	ipv4_hdr->offset[1] = 0;
-	ipv4_hdr->chksum = 0;
-	ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
 
 	net_pkt_set_data(pkt, &ipv4_access);
 	net_pkt_set_ip_reassembled(pkt, true);
@@ -621,9 +628,9 @@ enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
 	}
 
 	/* If we have already fragmented the packet, the ID field will contain a non-zero value
-	 * and we can skip other checks.
+	 * and we can skip other checks. TCP super-packets are segmented later instead.
 	 */
-	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0) {
+	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0 && net_pkt_gso_size(pkt) == 0U) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -374,6 +374,18 @@ drop:
 	return ret;
 }
 
+/* Segments of a TCP super-packet destined back to us */
+static int loopback_segment(struct net_if *iface, struct net_pkt *pkt)
+{
+	int len = net_pkt_get_len(pkt);
+
+	ARG_UNUSED(iface);
+
+	processing_data(pkt, true);
+
+	return len;
+}
+
 /* Called when data needs to be sent to network */
 int net_send_data(struct net_pkt *pkt)
 {
@@ -407,6 +419,16 @@ int net_send_data(struct net_pkt *pkt)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
+
+		/* A super-packet is not finalized, it must be cut into
+		 * segments as net_if_tx() would do.
+		 */
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0U) {
+			status = net_tcp_gso_send(net_pkt_iface(pkt), pkt,
+						  loopback_segment);
+			return status < 0 ? status : 0;
+		}
+
 		processing_data(pkt, true);
 		return 0;
 	}
@@ -463,6 +485,143 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
+#if defined(CONFIG_NET_RX_STEERING)
+#define FNV_PRIME 16777619U
+#define FNV_OFFSET_BASIS 2166136261U
+
+static uint32_t flow_hash_add(uint32_t hash, const uint8_t *data, size_t len)
+{
+	while (len-- > 0) {
+		hash = (hash ^ *data++) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+/* Interfaces whose packets start with the IP header */
+static bool rx_flow_hash_raw_ip(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_DUMMY)
+	/* Loopback and the other dummy L2 drivers */
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		return true;
+	}
+#endif
+
+#if defined(CONFIG_NET_L2_VIRTUAL)
+	/* IP tunnels */
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(VIRTUAL)) {
+		return true;
+	}
+#endif
+
+	ARG_UNUSED(iface);
+
+	return false;
+}
+
+/* Hash of the addresses and ports of a received packet, so that all the
+ * packets of a flow go to the same RX queue. Only the headers in the first
+ * buffer are looked at, packets of other protocols all get the same hash.
+ * The ports of IP fragments are not hashed as only the first fragment has
+ * them. The headers are only parsed for the Ethernet and raw IP L2s, the
+ * packets of the other L2s (IEEE 802.15.4, PPP, CAN...) all get the same
+ * hash, as their L2 header is not understood here.
+ */
+static uint32_t net_rx_flow_hash(struct net_if *iface, struct net_pkt *pkt)
+{
+	const uint8_t *data = pkt->buffer->data;
+	size_t len = pkt->buffer->len;
+	uint32_t hash = net_pkt_rx_hash(pkt);
+	bool ports = false;
+	size_t hdr_len;
+	uint8_t proto;
+
+	if (hash != 0U) {
+		/* Computed by the hardware */
+		return hash;
+	}
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		size_t eth_len = sizeof(struct net_eth_hdr);
+		uint16_t type;
+
+		if (len < eth_len + sizeof(uint32_t)) {
+			return 0U;
+		}
+
+		type = sys_get_be16(&data[eth_len - sizeof(uint16_t)]);
+		if (type == NET_ETH_PTYPE_VLAN) {
+			type = sys_get_be16(&data[eth_len + sizeof(uint16_t)]);
+			eth_len += sizeof(uint32_t);
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return 0U;
+		}
+
+		data += eth_len;
+		len -= eth_len;
+	} else
+#endif
+	if (!rx_flow_hash_raw_ip(iface)) {
+		return 0U;
+	}
+
+	hash = FNV_OFFSET_BASIS;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && len >= sizeof(struct net_ipv4_hdr) &&
+	    (data[0] & 0xf0) == 0x40) {
+		const struct net_ipv4_hdr *hdr = (const struct net_ipv4_hdr *)data;
+
+		hdr_len = (hdr->vhl & 0x0f) * 4U;
+		proto = hdr->proto;
+		ports = (sys_get_be16(hdr->offset) &
+			 ((NET_IPV4_MF << 13) | NET_IPV4_FRAGH_OFFSET_MASK)) == 0U;
+
+		hash = flow_hash_add(hash, hdr->src, 2 * NET_IPV4_ADDR_SIZE);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && len >= sizeof(struct net_ipv6_hdr) &&
+		   (data[0] & 0xf0) == 0x60) {
+		const struct net_ipv6_hdr *hdr = (const struct net_ipv6_hdr *)data;
+
+		/* Extension headers are not skipped, the packets that have
+		 * them are spread on their addresses only.
+		 */
+		hdr_len = sizeof(struct net_ipv6_hdr);
+		proto = hdr->nexthdr;
+		ports = true;
+
+		hash = flow_hash_add(hash, hdr->src, 2 * NET_IPV6_ADDR_SIZE);
+	} else {
+		return 0U;
+	}
+
+	/* The source and destination ports are the first fields of both
+	 * the TCP and the UDP header.
+	 */
+	if (ports && (proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    len >= hdr_len + 2 * sizeof(uint16_t)) {
+		hash = flow_hash_add(hash, &data[hdr_len], 2 * sizeof(uint16_t));
+	}
+
+	/* FNV mixes the high bits poorly and they select the queue */
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bU;
+	hash ^= hash >> 13;
+
+	return hash;
+}
+#else
+static inline uint32_t net_rx_flow_hash(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+#endif /* CONFIG_NET_RX_STEERING */
+
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
@@ -481,7 +640,7 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
 	} else {
-		net_tc_submit_to_rx_queue(tc, pkt);
+		net_tc_submit_to_rx_queue(tc, net_rx_flow_hash(iface, pkt), pkt);
 	}
 }
 
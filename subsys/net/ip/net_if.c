@@ -34,6 +34,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv4.h"
 #include "ipv6.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -209,6 +210,23 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+/* TCP super-packets are segmented here, unless the device does it itself */
+static bool net_if_tx_needs_gso(struct net_if *iface, struct net_pkt *pkt)
+{
+	if (net_pkt_gso_size(pkt) == 0U) {
+		return false;
+	}
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	    (net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO)) {
+		return false;
+	}
+#endif
+
+	return true;
+}
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = {
@@ -259,7 +277,11 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		}
 
 		net_if_tx_lock(iface);
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_if_tx_needs_gso(iface, pkt)) {
+			status = net_tcp_gso_send(iface, pkt, net_if_l2(iface)->send);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 		net_if_tx_unlock(iface);
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
@@ -5535,6 +5557,57 @@ bool net_if_is_promisc(struct net_if *iface)
 }
 #endif /* CONFIG_NET_PROMISCUOUS_MODE */
 
+#if defined(CONFIG_NET_RX_STEERING)
+int net_if_rx_steering_set(struct net_if *iface, uint8_t queues)
+{
+	NET_ASSERT(iface);
+
+	if (queues > CONFIG_NET_RX_STEERING_QUEUES) {
+		return -EINVAL;
+	}
+
+	iface->rx_queues = queues;
+
+	NET_DBG("iface %d RX queues %d", net_if_get_by_iface(iface),
+		net_if_rx_steering_get(iface));
+
+	return 0;
+}
+
+uint8_t net_if_rx_steering_get(struct net_if *iface)
+{
+	uint8_t queues = iface->rx_queues;
+
+	return queues == 0U ? CONFIG_NET_RX_STEERING_QUEUES : queues;
+}
+
+#if defined(CONFIG_NET_MGMT)
+static int net_if_rx_steering_mgmt(uint32_t mgmt_request, struct net_if *iface,
+				   void *data, size_t len)
+{
+	struct net_rx_steering_config *config = data;
+
+	if (iface == NULL || config == NULL || len != sizeof(*config)) {
+		return -EINVAL;
+	}
+
+	if (mgmt_request == NET_REQUEST_RX_STEERING_SET) {
+		return net_if_rx_steering_set(iface, config->queues);
+	}
+
+	config->queues = net_if_rx_steering_get(iface);
+
+	return 0;
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_RX_STEERING_SET,
+				  net_if_rx_steering_mgmt);
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_RX_STEERING_GET,
+				  net_if_rx_steering_mgmt);
+#endif /* CONFIG_NET_MGMT */
+#endif /* CONFIG_NET_RX_STEERING */
+
 #ifdef CONFIG_NET_POWER_MANAGEMENT
 
 int net_if_suspend(struct net_if *iface)
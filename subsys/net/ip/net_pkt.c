@@ -1876,6 +1876,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_rx_timestamping(clone_pkt, net_pkt_is_rx_timestamping(pkt));
 	net_pkt_set_forwarding(clone_pkt, net_pkt_forwarding(pkt));
 	net_pkt_set_chksum_done(clone_pkt, net_pkt_is_chksum_done(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 	net_pkt_set_ip_reassembled(pkt, net_pkt_is_ip_reassembled(pkt));
 
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
@@ -2044,6 +2045,14 @@ int net_pkt_update_length(struct net_pkt *pkt, size_t length)
 	return !length ? 0 : -EINVAL;
 }
 
+/* External data (e.g. lent by a zero-copy send) or data also referenced
+ * by someone else must not be written, even to move it in the buffer.
+ */
+static bool buf_data_borrowed(struct net_buf *buf)
+{
+	return (buf->flags & NET_BUF_EXTERNAL_DATA) != 0U || buf->ref > 1U;
+}
+
 int net_pkt_pull(struct net_pkt *pkt, size_t length)
 {
 	struct net_pkt_cursor *c_op = &pkt->cursor;
@@ -2067,13 +2076,23 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 			rem = length;
 		}
 
-		c_op->buf->len -= rem;
 		left -= rem;
-		if (left) {
+		if (left && c_op->pos == c_op->buf->data &&
+		    buf_data_borrowed(c_op->buf)) {
+			/* Pulling from the start of a buffer whose data is
+			 * not owned by the packet alone, advance it instead
+			 * of moving the data.
+			 */
+			net_buf_pull(c_op->buf, rem);
+			c_op->pos = c_op->buf->data;
+		} else if (left) {
+			c_op->buf->len -= rem;
 			memmove(c_op->pos, c_op->pos+rem, left);
 		} else {
 			struct net_buf *buf = pkt->buffer;
 
+			c_op->buf->len -= rem;
+
 			if (buf) {
 				pkt->buffer = buf->frags;
 				buf->frags = NULL;
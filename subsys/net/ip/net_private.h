@@ -162,8 +162,20 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 	return NET_CONTINUE;
 }
 #endif
+
+/* Number of RX queues of each traffic class, and in total */
+#if defined(CONFIG_NET_RX_STEERING)
+#define NET_TC_RX_QUEUES CONFIG_NET_RX_STEERING_QUEUES
+#else
+#define NET_TC_RX_QUEUES 1
+#endif
+#define NET_RX_QUEUE_COUNT (NET_TC_RX_COUNT * NET_TC_RX_QUEUES)
+
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
-extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_to_rx_queue(uint8_t tc, uint32_t hash,
+				      struct net_pkt *pkt);
+extern int net_tc_rx_current(void);
+extern bool net_tc_rx_pending(uint8_t queue);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -249,6 +261,66 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Update an Internet checksum after a 16-bit field it covers was
+ *        rewritten, without summing the whole data again (RFC 1624).
+ *
+ * @param chksum	Checksum field, in network byte order
+ * @param old_val	Old value of the field, as stored in the data
+ * @param new_val	New value of the field, as stored in the data
+ *
+ * @return The updated checksum field, in network byte order
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	/* HC' = ~(~HC + ~m + m'). The one's complement sum does not depend
+	 * on byte order, so all values are used as stored.
+	 */
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+/**
+ * @brief Update an Internet checksum after a 32-bit field it covers,
+ *        e.g. an IPv4 address or a TCP sequence number, was rewritten.
+ *
+ * @param chksum	Checksum field, in network byte order
+ * @param old_val	Old value of the field, as stored in the data
+ * @param new_val	New value of the field, as stored in the data
+ *
+ * @return The updated checksum field, in network byte order
+ */
+static inline uint16_t net_chksum_update32(uint16_t chksum, uint32_t old_val,
+					   uint32_t new_val)
+{
+	chksum = net_chksum_update16(chksum, (uint16_t)(old_val >> 16),
+				     (uint16_t)(new_val >> 16));
+
+	return net_chksum_update16(chksum, (uint16_t)old_val, (uint16_t)new_val);
+}
+
+/**
+ * @brief Update an Internet checksum after a field it covers, e.g. an
+ *        IPv6 address, was rewritten.
+ *
+ * The field must start at an even offset of the checksummed data, and
+ * both copies of it must be 16-bit aligned.
+ *
+ * @param chksum	Checksum field, in network byte order
+ * @param old_data	Old contents of the field
+ * @param new_data	New contents of the field
+ * @param len		Length of the field in bytes
+ *
+ * @return The updated checksum field, in network byte order
+ */
+extern uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+				  const void *new_data, size_t len);
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "tcp_internal.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
@@ -24,12 +25,15 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
  */
 #define MAX_NAME_LEN sizeof("xx_q[y]")
 
+/* With RX steering, "z" is the queue of the traffic class, from 0 to 15 */
+#define MAX_RX_NAME_LEN sizeof("rx_q[y.zz]")
+
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +41,8 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+/* The queues of traffic class tc are at tc * NET_TC_RX_QUEUES onwards */
+static struct net_traffic_class rx_classes[NET_RX_QUEUE_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -60,18 +65,66 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
-void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
+#if NET_TC_RX_QUEUES > 1
+/* Map the flow hash to one of the queues used by the interface */
+static int rx_steering_queue(struct net_if *iface, uint32_t hash)
+{
+	uint8_t queues = net_if_rx_steering_get(iface);
+
+	return (int)(((uint64_t)hash * queues) >> 32);
+}
+#endif
+
+void net_tc_submit_to_rx_queue(uint8_t tc, uint32_t hash, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	int queue = tc * NET_TC_RX_QUEUES;
+
+#if NET_TC_RX_QUEUES > 1
+	queue += rx_steering_queue(net_pkt_iface(pkt), hash);
+#else
+	ARG_UNUSED(hash);
+#endif
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[queue].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
+	ARG_UNUSED(hash);
 	ARG_UNUSED(pkt);
 #endif
 }
 
+/* Return the RX queue served by the calling thread, or -1 if it is not
+ * an RX traffic class thread.
+ */
+int net_tc_rx_current(void)
+{
+#if NET_TC_RX_COUNT > 0
+	k_tid_t tid = k_current_get();
+	int i;
+
+	for (i = 0; i < NET_RX_QUEUE_COUNT; i++) {
+		if (tid == &rx_classes[i].handler) {
+			return i;
+		}
+	}
+#endif
+	return -1;
+}
+
+bool net_tc_rx_pending(uint8_t queue)
+{
+#if NET_TC_RX_COUNT > 0
+	return !k_fifo_is_empty(&rx_classes[queue].fifo);
+#else
+	ARG_UNUSED(queue);
+
+	return false;
+#endif
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -255,6 +308,11 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 		}
 
 		net_process_rx_packet(pkt);
+
+		/* Nothing left to merge with, pass on what TCP held back */
+		if (IS_ENABLED(CONFIG_NET_TCP_GRO) && k_fifo_is_empty(fifo)) {
+			net_tcp_gro_flush();
+		}
 	}
 }
 #endif
@@ -354,12 +412,13 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_RX_QUEUE_COUNT; i++) {
+		int tc = i / NET_TC_RX_QUEUES;
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(tc);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -386,10 +445,21 @@ void net_tc_rx_init(void)
 			continue;
 		}
 
+#if defined(CONFIG_NET_RX_STEERING_CPU_PIN)
+		(void)k_thread_cpu_pin(tid, (i % NET_TC_RX_QUEUES) %
+				       CONFIG_MP_MAX_NUM_CPUS);
+#endif
+
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
-			char name[MAX_NAME_LEN];
+			char name[MAX_RX_NAME_LEN];
+
+			if (NET_TC_RX_QUEUES > 1) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]", tc,
+					 i % NET_TC_RX_QUEUES);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", tc);
+			}
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
 			k_thread_name_set(tid, name);
 		}
 
@@ -32,7 +32,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -263,19 +263,236 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_TRIE)
+/* Path-compressed binary (Patricia) trie of the route prefixes. A node
+ * holds the routes of one prefix, or none if it only joins two subtries
+ * that diverge right after its prefix. Children always have a longer
+ * prefix than their parent, so a lookup visits at most one node per bit
+ * of the destination address.
+ */
+struct route_trie_node {
+	struct route_trie_node *child[2];
+	sys_slist_t routes;
+	struct in6_addr prefix;
+	uint8_t prefix_len;
+};
+
+/* N prefixes need at most N - 1 nodes without routes, so the trie never
+ * runs out of nodes.
+ */
+static struct route_trie_node route_trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *route_trie_free_list;
+static struct route_trie_node *route_trie_root;
+
+static void route_trie_init(void)
+{
+	route_trie_root = NULL;
+	route_trie_free_list = NULL;
+
+	/* The free nodes are chained through their first child */
+	for (int i = 0; i < ARRAY_SIZE(route_trie_nodes); i++) {
+		route_trie_nodes[i].child[0] = route_trie_free_list;
+		route_trie_free_list = &route_trie_nodes[i];
+	}
+}
+
+static struct route_trie_node *route_trie_node_alloc(const struct in6_addr *prefix,
+						     uint8_t prefix_len)
+{
+	struct route_trie_node *node = route_trie_free_list;
+
+	NET_ASSERT(node, "Route trie has no free nodes");
+
+	route_trie_free_list = node->child[0];
+
+	node->child[0] = NULL;
+	node->child[1] = NULL;
+	sys_slist_init(&node->routes);
+	net_ipaddr_copy(&node->prefix, prefix);
+	node->prefix_len = prefix_len;
+
+	return node;
+}
+
+static void route_trie_node_free(struct route_trie_node *node)
+{
+	node->child[0] = route_trie_free_list;
+	route_trie_free_list = node;
+}
+
+static inline uint8_t route_trie_bit(const struct in6_addr *addr, uint8_t bit)
+{
+	return (addr->s6_addr[bit / 8U] >> (7U - (bit % 8U))) & 1U;
+}
+
+/* Number of leading bits the two addresses have in common, up to max_len */
+static uint8_t route_trie_common_len(const struct in6_addr *addr1,
+				     const struct in6_addr *addr2,
+				     uint8_t max_len)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; i < sizeof(addr1->s6_addr) && len < max_len; i++) {
+		uint32_t diff = addr1->s6_addr[i] ^ addr2->s6_addr[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - 24U;
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max_len);
+}
+
+static void route_trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &route_trie_root;
+	struct route_trie_node *node = route_trie_root;
+	struct route_trie_node *leaf, *branch;
+	uint8_t len = route->prefix_len;
+	uint8_t common = 0U;
+
+	while (node != NULL) {
+		common = route_trie_common_len(&node->prefix, &route->addr,
+					       MIN(node->prefix_len, len));
+		if (common < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == len) {
+			sys_slist_append(&node->routes, &route->trie_node);
+			return;
+		}
+
+		link = &node->child[route_trie_bit(&route->addr, node->prefix_len)];
+		node = *link;
+	}
+
+	leaf = route_trie_node_alloc(&route->addr, len);
+	sys_slist_append(&leaf->routes, &route->trie_node);
+
+	if (node == NULL) {
+		*link = leaf;
+	} else if (common == len) {
+		/* The new prefix covers the one of the node */
+		leaf->child[route_trie_bit(&node->prefix, len)] = node;
+		*link = leaf;
+	} else {
+		branch = route_trie_node_alloc(&route->addr, common);
+		branch->child[route_trie_bit(&route->addr, common)] = leaf;
+		branch->child[route_trie_bit(&node->prefix, common)] = node;
+		*link = branch;
+	}
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &route_trie_root;
+	struct route_trie_node **parent_link = NULL;
+	struct route_trie_node *node = route_trie_root;
+	struct route_trie_node *child, *parent;
+
+	while (node != NULL && node->prefix_len < route->prefix_len) {
+		parent_link = link;
+		link = &node->child[route_trie_bit(&route->addr, node->prefix_len)];
+		node = *link;
+	}
+
+	if (node == NULL ||
+	    !sys_slist_find_and_remove(&node->routes, &route->trie_node)) {
+		return;
+	}
+
+	if (!sys_slist_is_empty(&node->routes) ||
+	    (node->child[0] != NULL && node->child[1] != NULL)) {
+		return;
+	}
+
+	child = node->child[0] != NULL ? node->child[0] : node->child[1];
+	*link = child;
+	route_trie_node_free(node);
+
+	/* A parent without routes is only needed while it has two children */
+	if (child == NULL && parent_link != NULL) {
+		parent = *parent_link;
+
+		if (sys_slist_is_empty(&parent->routes)) {
+			*parent_link = parent->child[0] != NULL ?
+				       parent->child[0] : parent->child[1];
+			route_trie_node_free(parent);
+		}
+	}
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	struct route_trie_node *node = route_trie_root;
+	struct net_route_entry *route, *found = NULL;
+
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+				  node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[route_trie_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+
+static struct net_route_entry *route_find_exact(struct net_if *iface,
+						struct in6_addr *addr,
+						uint8_t prefix_len)
+{
+	struct route_trie_node *node = route_trie_root;
+	struct net_route_entry *route;
+
+	while (node != NULL && node->prefix_len < prefix_len) {
+		node = node->child[route_trie_bit(addr, node->prefix_len)];
+	}
+
+	if (node == NULL || node->prefix_len != prefix_len ||
+	    !net_ipv6_is_prefix(addr->s6_addr, node->prefix.s6_addr,
+				prefix_len)) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+		if (route->iface == iface) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+#else
+static inline void route_trie_init(void) { }
+static inline void route_trie_insert(struct net_route_entry *route) { }
+static inline void route_trie_remove(struct net_route_entry *route) { }
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +515,110 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+
+static struct net_route_entry *route_find_exact(struct net_if *iface,
+						struct in6_addr *addr,
+						uint8_t prefix_len)
+{
+	struct net_route_entry *route;
+
+	for (int i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
+		struct net_nbr *nbr = get_nbr(i);
+
+		if (!nbr->ref || nbr->iface != iface) {
+			continue;
+		}
+
+		route = net_route_data(nbr);
+
+		if (route->prefix_len == prefix_len &&
+		    net_ipv6_is_prefix(addr->s6_addr, route->addr.s6_addr,
+				       prefix_len)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_NET_ROUTE_TRIE */
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Direct-mapped cache of the last lookups */
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+	uint32_t generation;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+/* Bumped on every route change, older entries are stale */
+static uint32_t route_cache_generation = 1U;
+
+static struct route_cache_entry *route_cache_slot(struct net_if *iface,
+						  struct in6_addr *dst)
+{
+	uint32_t hash = UNALIGNED_GET(&dst->s6_addr32[2]) ^
+			UNALIGNED_GET(&dst->s6_addr32[3]) ^
+			POINTER_TO_UINT(iface);
+
+	hash ^= hash >> 16;
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static struct net_route_entry *route_cache_get(struct net_if *iface,
+					       struct in6_addr *dst)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	if (entry->generation == route_cache_generation &&
+	    entry->iface == iface && net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return entry->route;
+	}
+
+	return NULL;
+}
+
+static void route_cache_put(struct net_if *iface, struct in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	net_ipaddr_copy(&entry->dst, dst);
+	entry->iface = iface;
+	entry->route = route;
+	entry->generation = route_cache_generation;
+}
+
+static inline void route_cache_flush(void)
+{
+	route_cache_generation++;
+}
+#else
+#define route_cache_get(iface, dst) NULL
+#define route_cache_put(iface, dst, route)
+#define route_cache_flush()
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	found = route_cache_get(iface, dst);
+	if (found == NULL) {
+		found = route_find(iface, dst);
+		if (found) {
+			route_cache_put(iface, dst, found);
+		}
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -361,7 +682,10 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 			net_sprint_ll_addr(nexthop_lladdr->addr, nexthop_lladdr->len));
 	}
 
-	route = net_route_lookup(iface, addr);
+	/* A route to a longer prefix is a new route, even if a shorter
+	 * prefix covers it already.
+	 */
+	route = route_find_exact(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -393,9 +717,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		sys_dlist_remove(last);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -444,7 +768,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
+	route_trie_insert(route);
+	route_cache_flush();
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -586,7 +912,9 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -594,6 +922,9 @@ int net_route_del(struct net_route_entry *route)
 		return -ENOENT;
 	}
 
+	route_trie_remove(route);
+	route_cache_flush();
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
@@ -1119,4 +1450,6 @@ void net_route_init(void)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
 #endif
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
+
+	route_trie_init();
 }
@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/random/random.h>
+#include <zephyr/sys/fdtable.h>
 
 #if defined(CONFIG_NET_TCP_ISN_RFC6528)
 #include <psa/crypto.h>
@@ -58,16 +59,12 @@ static int tcp_tx_window =
 	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
-
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
@@ -420,6 +417,12 @@ out:
 
 static void tcp_derive_rto(struct tcp *conn)
 {
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Once the RTT has been measured, the RTO follows the estimate */
+	if (conn->srtt != 0U) {
+		return;
+	}
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
 	uint32_t gain;
@@ -435,18 +438,61 @@ static void tcp_derive_rto(struct tcp *conn)
 	rto = (uint32_t)tcp_rto;
 	rto = (gain * rto) >> 9;
 	conn->rto = (uint16_t)rto;
+#elif defined(CONFIG_NET_TCP_TIMESTAMPS)
+	conn->rto = (uint16_t)tcp_rto;
 #else
 	ARG_UNUSED(conn);
 #endif
 }
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+#define TCP_RTO_MAX_MS 60000U
+
+static uint32_t tcp_ts_now(void)
+{
+	return k_uptime_get_32();
+}
+
+/* Update the RTT estimate with a new sample and derive the RTO from it,
+ * as described in RFC 6298. The RTO is never set below the configured
+ * initial RTO.
+ */
+static void tcp_rtt_update(struct tcp *conn, uint32_t rtt)
+{
+	int32_t delta;
+	uint32_t rto;
+
+	if (conn->srtt == 0U) {
+		conn->srtt = MAX(rtt, 1U) << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+		conn->srtt = MAX((int32_t)conn->srtt + delta, 1);
+
+		if (delta < 0) {
+			delta = -delta;
+		}
+
+		delta -= (int32_t)(conn->rttvar >> 2);
+		conn->rttvar = MAX((int32_t)conn->rttvar + delta, 0);
+	}
+
+	rto = (conn->srtt >> 3) + MAX(conn->rttvar, 1U);
+	rto = CLAMP(rto, (uint32_t)tcp_rto, TCP_RTO_MAX_MS);
+	conn->rto = (uint16_t)rto;
+
+	NET_DBG("conn: %p rtt=%u srtt=%u rttvar=%u rto=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, rto);
+}
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
 /* Implementation according to RFC6582 */
 
 static void tcp_new_reno_log(struct tcp *conn, char *step)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
+	NET_DBG("conn: %p, ca %s, cwnd=%u, ssthres=%u, fast_pend=%u",
 		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
 		conn->ca.pending_fast_retransmit_bytes);
 }
@@ -483,15 +529,18 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 	int32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, (int32_t)NET_TCP_MAX_WIN);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
-static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
+static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len,
+				    uint32_t rtt)
 {
 	int32_t new_win = conn->ca.cwnd;
 	int32_t win_inc = MIN(acked_len, conn_mss(conn));
 
+	ARG_UNUSED(rtt);
+
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
 		if (conn->ca.cwnd < conn->ca.ssthresh) {
 			new_win += win_inc;
@@ -499,7 +548,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, (int32_t)NET_TCP_MAX_WIN);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -513,29 +562,150 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+static const struct tcp_ca_ops tcp_ca_new_reno = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+static const struct tcp_ca_ops *const tcp_ca_algorithms[] = {
+	&tcp_ca_new_reno,
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+	&tcp_ca_cubic,
+#endif
+#if defined(CONFIG_NET_TCP_CA_BBR)
+	&tcp_ca_bbr,
+#endif
+};
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	ARRAY_FOR_EACH(tcp_ca_algorithms, i) {
+		const char *ca_name = tcp_ca_algorithms[i]->name;
+
+		if (strlen(ca_name) == len && strncmp(ca_name, name, len) == 0) {
+			return tcp_ca_algorithms[i];
+		}
+	}
+
+	return NULL;
+}
+
+static const struct tcp_ca_ops *tcp_ca_default(void)
+{
+#if defined(CONFIG_NET_TCP_CA_DEFAULT_CUBIC)
+	return &tcp_ca_cubic;
+#elif defined(CONFIG_NET_TCP_CA_DEFAULT_BBR)
+	return &tcp_ca_bbr;
+#else
+	return &tcp_ca_new_reno;
+#endif
+}
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.rtt_pending = false;
+#if defined(CONFIG_NET_TCP_PACING)
+	conn->ca.pacing_rate = 0U;
+#endif
+	conn->ca.ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.rtt_pending = false;
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.rtt_pending = false;
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	uint32_t rtt = 0U;
+
+	if (conn->ca.rtt_pending &&
+	    net_tcp_seq_cmp(conn->seq + acked_len, conn->ca.rtt_seq) >= 0) {
+		rtt = MAX(k_uptime_get_32() - conn->ca.rtt_start, 1U);
+		conn->ca.rtt_pending = false;
+	}
+
+	conn->ca.ops->pkts_acked(conn, acked_len, rtt);
+}
+
+/* Time one segment at a time for the RTT samples given to the algorithm.
+ * Retransmitted segments are never timed (Karn's algorithm).
+ */
+static void tcp_ca_data_sent(struct tcp *conn, uint32_t seq_end, bool resent)
+{
+	if (resent) {
+		conn->ca.rtt_pending = false;
+	} else if (!conn->ca.rtt_pending) {
+		conn->ca.rtt_seq = seq_end;
+		conn->ca.rtt_start = k_uptime_get_32();
+		conn->ca.rtt_pending = true;
+	}
+}
+
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca.ops = from->ca.ops;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	if (conn == NULL || value == NULL) {
+		return -EINVAL;
+	}
+
+	/* The name does not have to be NUL terminated */
+	ops = tcp_ca_find(value, strnlen(value, len));
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops == conn->ca.ops) {
+		return 0;
+	}
+
+	conn->ca.ops = ops;
+
+	/* Otherwise the algorithm is initialized once the connection
+	 * is established.
+	 */
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		tcp_ca_init(conn);
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len;
+
+	if (conn == NULL || value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	name_len = MIN(strlen(conn->ca.ops->name) + 1, *len);
+	memcpy(value, conn->ca.ops->name, name_len);
+	*len = name_len;
+
+	return 0;
 }
 #else
 
@@ -549,6 +719,12 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_data_sent(struct tcp *conn, uint32_t seq_end, bool resent) { }
+
+#define tcp_ca_param_copy(...)
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -804,6 +980,9 @@ static void tcp_conn_release(struct k_work *work)
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 	(void)k_work_cancel_delayable(&conn->send_timer);
 	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
+#if defined(CONFIG_NET_TCP_PACING)
+	(void)k_work_cancel_delayable(&conn->pacing_timer);
+#endif
 	keep_alive_timer_stop(conn);
 
 	k_mutex_unlock(&conn->lock);
@@ -863,6 +1042,20 @@ static int tcp_conn_unref(struct tcp *conn)
 	return ref_count;
 }
 
+/* The tx_sem and connect_sem can only be polled by one waiter at a time,
+ * let the persistent socket watchers know about them as well.
+ */
+static inline void tcp_notify_poll(struct tcp *conn)
+{
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	if (conn->context != NULL) {
+		zvfs_poll_watch_notify(&conn->context->poll_watch);
+	}
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 #define tcp_conn_close(conn, status)				\
 	tcp_conn_close_debug(conn, status, __func__, __LINE__)
@@ -894,6 +1087,7 @@ static int tcp_conn_close(struct tcp *conn, int status)
 	}
 
 	k_sem_give(&conn->tx_sem);
+	tcp_notify_poll(conn);
 
 	return tcp_conn_unref(conn);
 }
@@ -1093,8 +1287,25 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+/* The MSS, window scale and SACK permitted options are only valid in a SYN
+ * segment, so they are reset only when a SYN is received.
+ */
+static void tcp_options_reset(struct tcp_options *recv_options, bool syn)
+{
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
+
+	recv_options->ts_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_count = 0U;
+#endif
+}
+
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -1104,8 +1315,7 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	tcp_options_reset(recv_options, syn);
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1135,24 +1345,76 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 		switch (opt) {
 		case NET_TCP_MSS_OPT:
-			if (opt_len != 4) {
+			if (opt_len != NET_TCP_MSS_SIZE) {
 				result = false;
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
 			NET_DBG("MSS=%hu", recv_options->mss);
 			break;
 		case NET_TCP_WINDOW_SCALE_OPT:
-			if (opt_len != 3) {
+			if (opt_len != NET_TCP_WINDOW_SCALE_SIZE) {
 				result = false;
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = MIN(options[2],
+						   NET_TCP_WINDOW_SCALE_MAX);
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", recv_options->window);
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
+			break;
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+			recv_options->tsval =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+#endif
+			recv_options->ts_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+#if defined(CONFIG_NET_TCP_SACK)
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_count < NET_TCP_SACK_BLOCKS_MAX;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *blk =
+					&recv_options->sack[recv_options->sack_count++];
+
+				blk->start = ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				blk->end = ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+			}
+#endif
 			break;
 		default:
 			continue;
@@ -1166,6 +1428,98 @@ end:
 	return result;
 }
 
+/* Settle the options negotiated during the SYN exchange */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	conn->wscale_ok = IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) && opts->wnd_found;
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) && opts->sack_perm_found;
+	conn->ts_ok = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) && opts->ts_found;
+
+	if (conn->wscale_ok) {
+		conn->snd_wscale = opts->window;
+	} else {
+		/* Without scaling, no more than 64 KiB can be advertised */
+		conn->snd_wscale = 0U;
+		conn->rcv_wscale = 0U;
+		conn->recv_win_max = MIN(conn->recv_win_max, UINT16_MAX);
+		conn->recv_win = MIN(conn->recv_win, conn->recv_win_max);
+	}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok) {
+		conn->ts_recent = opts->tsval;
+	}
+#endif
+
+	NET_DBG("conn: %p wscale %d (%hu/%hu) sack %d ts %d", conn,
+		conn->wscale_ok, (uint16_t)conn->snd_wscale,
+		(uint16_t)conn->rcv_wscale, conn->sack_ok, conn->ts_ok);
+}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* Protection against wrapped sequence numbers (RFC 7323 ch 5.3). Returns
+ * false if the segment is an old duplicate that must be dropped.
+ */
+static bool tcp_paws_check(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	if (!conn->ts_ok || !opts->ts_found) {
+		return true;
+	}
+
+	return (int32_t)(opts->tsval - conn->ts_recent) >= 0;
+}
+
+/* The timestamp to echo is the one of the acceptable segment which is
+ * acknowledged next (RFC 7323 ch 4.3), so a segment that does not reach
+ * the next expected sequence number must not update it.
+ */
+static void tcp_ts_recent_update(struct tcp *conn, struct tcphdr *th, size_t len)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	if (!conn->ts_ok || !opts->ts_found) {
+		return;
+	}
+
+	if (net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0 &&
+	    net_tcp_seq_cmp(th_seq(th) + len, conn->ack) >= 0) {
+		conn->ts_recent = opts->tsval;
+	}
+}
+
+/* Take an RTT sample from an acknowledgment of new data (RFC 7323 ch 4) */
+static void tcp_rtt_sample(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t rtt;
+
+	if (!conn->ts_ok || !opts->ts_found || opts->tsecr == 0U) {
+		return;
+	}
+
+	/* Ignore the echoed values that cannot be ours */
+	rtt = tcp_ts_now() - opts->tsecr;
+	if (rtt < TCP_RTO_MAX_MS) {
+		tcp_rtt_update(conn, rtt);
+	}
+}
+#else
+static bool tcp_paws_check(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+
+	return true;
+}
+
+static void tcp_ts_recent_update(struct tcp *conn, struct tcphdr *th, size_t len) { }
+
+static void tcp_rtt_sample(struct tcp *conn) { }
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
 static bool tcp_short_window(struct tcp *conn)
 {
 	int32_t threshold = MIN(conn_mss(conn), conn->recv_win_max / 2);
@@ -1327,8 +1681,20 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Window scaling is never applied to the window field of a SYN segment */
+static uint16_t tcp_adv_win(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+	if (!(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1342,14 +1708,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + options_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_adv_win(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1407,23 +1769,95 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+/* Smallest shift count that lets the maximum receive window be advertised */
+static uint8_t tcp_rcv_wscale(struct tcp *conn)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	uint8_t shift = 0U;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	while (shift < NET_TCP_WINDOW_SCALE_MAX &&
+	       (conn->recv_win_max >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+
+/* Write the TCP options of an outgoing segment into buf, which must be able
+ * to hold the 40 bytes of maximum options size. Every option is padded with
+ * NOPs to a 32-bit boundary, so the returned length is a multiple of 4.
+ *
+ * Our own SYN offers all the enabled options, a SYN-ACK only carries the ones
+ * offered by the peer.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, bool data,
+				uint8_t *buf)
+{
+	bool syn = (flags & SYN) != 0;
+	bool offer = syn && !(flags & ACK);
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		buf[len++] = NET_TCP_MSS_OPT;
+		buf[len++] = NET_TCP_MSS_SIZE;
+		UNALIGNED_PUT(htons(net_tcp_get_supported_mss(conn)),
+			      (uint16_t *)(buf + len));
+		len += sizeof(uint16_t);
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) && syn &&
+	    (offer || conn->wscale_ok)) {
+		conn->rcv_wscale = tcp_rcv_wscale(conn);
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		buf[len++] = conn->rcv_wscale;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) && syn && (offer || conn->sack_ok)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (offer || conn->ts_ok) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_SIZE;
+		UNALIGNED_PUT(htonl(tcp_ts_now()), (uint32_t *)(buf + len));
+		len += sizeof(uint32_t);
+		UNALIGNED_PUT(htonl(conn->ts_recent), (uint32_t *)(buf + len));
+		len += sizeof(uint32_t);
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* The out-of-order queue is kept contiguous, so it is always reported
+	 * as a single block. Only pure ACKs carry it, so that data segments
+	 * never exceed the MSS.
+	 */
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT && conn->sack_ok && !syn && !data &&
+	    !net_pkt_is_empty(conn->queue_recv_data)) {
+		uint32_t start = tcp_get_seq(conn->queue_recv_data->buffer);
+		uint32_t end = start + net_pkt_get_len(conn->queue_recv_data);
+
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_OPT;
+		buf[len++] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		UNALIGNED_PUT(htonl(start), (uint32_t *)(buf + len));
+		len += sizeof(uint32_t);
+		UNALIGNED_PUT(htonl(end), (uint32_t *)(buf + len));
+		len += sizeof(uint32_t);
+	}
+#else
+	ARG_UNUSED(data);
+#endif
+
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1530,15 +1964,14 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	size_t options_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
+	options_len = tcp_options_build(conn, flags, data != NULL, options_buf);
 
-	pkt = tcp_pkt_alloc(conn, alloc_len);
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + options_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
@@ -1548,6 +1981,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -1556,14 +1990,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len > 0) {
+		ret = net_pkt_write(pkt, options_buf, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1692,6 +2126,26 @@ static bool tcp_window_full(struct tcp *conn)
 	return window_full;
 }
 
+/* Length of data that can still be queued within the send window */
+static size_t tcp_window_free(struct tcp *conn)
+{
+	size_t free_len = 0;
+
+	if (conn->send_data_total < conn->send_win) {
+		free_len = conn->send_win - conn->send_data_total;
+	}
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	if (conn->send_data_total < conn->ca.cwnd) {
+		free_len = MIN(free_len, conn->ca.cwnd - conn->send_data_total);
+	} else {
+		free_len = 0;
+	}
+#endif
+
+	return free_len;
+}
+
 static int tcp_unsent_len(struct tcp *conn)
 {
 	int unsent_len;
@@ -1721,13 +2175,155 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Allocate the payload of a super-packet carrying more than one MSS. The
+ * regular allocation is capped to the interface MTU, so the buffer is
+ * allocated raw. On failure, fall back to sending a single MSS.
+ */
+static struct net_pkt *tcp_gso_pkt_alloc(struct tcp *conn, int *len)
+{
+	int mss = conn_mss(conn);
+	struct net_pkt *pkt;
+
+	if (*len > mss && !conn->tcp_nodelay) {
+		/* Let Nagle's algorithm decide about the last partial segment */
+		*len = ROUND_DOWN(*len, mss);
+	}
+
+	if (*len <= mss) {
+		return tcp_pkt_alloc(conn, *len);
+	}
+
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (pkt) {
+		if (net_pkt_alloc_buffer_raw(pkt, *len, TCP_PKT_ALLOC_TIMEOUT) == 0) {
+			net_pkt_set_gso_size(pkt, mss);
+			return pkt;
+		}
+
+		tcp_pkt_unref(pkt);
+	}
+
+	*len = mss;
+
+	return tcp_pkt_alloc(conn, *len);
+}
+
+static int tcp_send_data_max_len(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+	return MAX(ROUND_DOWN(CONFIG_NET_TCP_GSO_MAX_SIZE, mss), mss);
+}
+#else
+#define tcp_gso_pkt_alloc(_conn, _len) tcp_pkt_alloc(_conn, *(_len))
+#define tcp_send_data_max_len(_conn) conn_mss(_conn)
+#endif /* CONFIG_NET_TCP_GSO */
+
+/* Send up to len bytes of the send_data, starting at offset. On return, len
+ * holds the number of bytes actually put into the segment.
+ */
+static int tcp_send_data_at(struct tcp *conn, int offset, int *len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = tcp_gso_pkt_alloc(conn, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, *len);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, *len);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+#if defined(CONFIG_NET_TCP_PACING)
+/* Check whether the next segment is due. If not, the pacing timer is armed
+ * to send it later.
+ */
+static bool tcp_pacing_delay(struct tcp *conn)
+{
+	int64_t now;
+
+	if (conn->ca.pacing_rate == 0U) {
+		return false;
+	}
+
+	now = k_ticks_to_us_floor64(k_uptime_ticks());
+	if (now >= conn->pacing_next) {
+		return false;
+	}
+
+	if (!k_work_delayable_is_pending(&conn->pacing_timer)) {
+		k_work_reschedule_for_queue(&tcp_work_q, &conn->pacing_timer,
+					    K_USEC(conn->pacing_next - now));
+	}
+
+	return true;
+}
+
+/* Intervals shorter than a system tick add up, so that a burst of the size
+ * sent at the pacing rate during a tick goes out at each tick.
+ */
+static void tcp_pacing_update(struct tcp *conn, int len)
+{
+	int64_t now;
+
+	if (conn->ca.pacing_rate == 0U) {
+		return;
+	}
+
+	now = k_ticks_to_us_floor64(k_uptime_ticks());
+	conn->pacing_next = MAX(conn->pacing_next, now) +
+			    (int64_t)len * USEC_PER_SEC / conn->ca.pacing_rate;
+}
+
+static int tcp_send_queued_data(struct tcp *conn);
+
+static void tcp_pacing_send(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, pacing_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		(void)tcp_send_queued_data(conn);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+#else
+static bool tcp_pacing_delay(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+
+	return false;
+}
+
+static void tcp_pacing_update(struct tcp *conn, int len) { }
+#endif /* CONFIG_NET_TCP_PACING */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
-	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = MIN(tcp_unsent_len(conn), tcp_send_data_max_len(conn));
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1738,21 +2334,7 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
-	}
-
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
-	}
-
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_send_data_at(conn, conn->unacked_len, &len);
 	if (ret == 0) {
 		conn->unacked_len += len;
 
@@ -1763,13 +2345,11 @@ static int tcp_send_data(struct tcp *conn)
 			net_stats_update_tcp_sent(conn->iface, len);
 			net_stats_update_tcp_seg_sent(conn->iface);
 		}
-	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
-	 */
-	tcp_pkt_unref(pkt);
+		tcp_ca_data_sent(conn, conn->seq + conn->unacked_len,
+				 conn->data_mode == TCP_DATA_MODE_RESEND);
+		tcp_pacing_update(conn, len);
+	}
 
 	conn_send_data_dump(conn);
 
@@ -1802,28 +2382,226 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
+		if (tcp_pacing_delay(conn)) {
+			break;
+		}
+
 		ret = tcp_send_data(conn);
 		if (ret < 0) {
 			break;
 		}
 	}
 
-	if (conn->send_data_total) {
-		subscribe = true;
+	if (conn->send_data_total) {
+		subscribe = true;
+	}
+
+	if (k_work_delayable_remaining_get(&conn->send_data_timer)) {
+		subscribe = false;
+	}
+
+	if (subscribe) {
+		conn->send_data_retries = 0;
+		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
+					    K_MSEC(TCP_RTO_MS));
+	}
+ out:
+	return ret;
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sacked_count = 0U;
+	conn->in_sack_recovery = false;
+}
+
+/* Insert a block into the scoreboard, keeping it sorted and merging blocks
+ * that overlap or touch. When the scoreboard is full, the highest blocks are
+ * forgotten, as the holes below them are retransmitted first anyway.
+ */
+static void tcp_sack_add(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block blocks[NET_TCP_SACK_BLOCKS_MAX + 1];
+	struct tcp_sack_block *last;
+	bool added = false;
+	int count = 0;
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		if (!added && net_tcp_seq_cmp(start, conn->sacked[i].start) < 0) {
+			blocks[count].start = start;
+			blocks[count++].end = end;
+			added = true;
+		}
+
+		blocks[count++] = conn->sacked[i];
+	}
+
+	if (!added) {
+		blocks[count].start = start;
+		blocks[count++].end = end;
+	}
+
+	conn->sacked_count = 0U;
+
+	for (int i = 0; i < count; i++) {
+		last = conn->sacked_count > 0U ?
+			&conn->sacked[conn->sacked_count - 1] : NULL;
+
+		if (last && net_tcp_seq_cmp(blocks[i].start, last->end) <= 0) {
+			if (net_tcp_seq_cmp(blocks[i].end, last->end) > 0) {
+				last->end = blocks[i].end;
+			}
+
+			continue;
+		}
+
+		if (conn->sacked_count == NET_TCP_SACK_BLOCKS_MAX) {
+			break;
+		}
+
+		conn->sacked[conn->sacked_count++] = blocks[i];
+	}
+}
+
+/* Add the blocks reported in the last received segment to the scoreboard.
+ * Blocks that do not cover unacknowledged data are ignored.
+ */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t snd_max = conn->seq + conn->send_data_total;
+
+	for (int i = 0; i < conn->recv_options.sack_count; i++) {
+		struct tcp_sack_block *blk = &conn->recv_options.sack[i];
+		uint32_t start = blk->start;
+
+		if (net_tcp_seq_cmp(blk->end, conn->seq) <= 0 ||
+		    net_tcp_seq_cmp(blk->end, snd_max) > 0 ||
+		    net_tcp_seq_cmp(start, blk->end) >= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(start, conn->seq) < 0) {
+			start = conn->seq;
+		}
+
+		tcp_sack_add(conn, start, blk->end);
+	}
+}
+
+/* Forget the blocks that have been cumulatively acknowledged */
+static void tcp_sack_trim(struct tcp *conn)
+{
+	uint8_t count = 0U;
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		struct tcp_sack_block blk = conn->sacked[i];
+
+		if (net_tcp_seq_cmp(blk.end, conn->seq) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(blk.start, conn->seq) < 0) {
+			blk.start = conn->seq;
+		}
+
+		conn->sacked[count++] = blk;
+	}
+
+	conn->sacked_count = count;
+
+	if (conn->in_sack_recovery &&
+	    net_tcp_seq_cmp(conn->seq, conn->recovery_point) >= 0) {
+		NET_DBG("conn: %p SACK recovery done", conn);
+		conn->in_sack_recovery = false;
+	}
+}
+
+/* Retransmit, at most one MSS of, the first hole of the scoreboard that has
+ * not been retransmitted yet during the current recovery.
+ */
+static bool tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t seq = conn->rexmit_next;
+	int len = 0;
+
+	if (net_tcp_seq_cmp(seq, conn->seq) < 0) {
+		seq = conn->seq;
+	}
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		struct tcp_sack_block *blk = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(seq, blk->start) < 0) {
+			len = blk->start - seq;
+			break;
+		}
+
+		if (net_tcp_seq_cmp(seq, blk->end) < 0) {
+			seq = blk->end;
+		}
+	}
+
+	if (len == 0) {
+		return false;
+	}
+
+	len = MIN(len, conn_mss(conn));
+
+	if (tcp_send_data_at(conn, seq - conn->seq, &len) < 0) {
+		return false;
+	}
+
+	NET_DBG("conn: %p SACK retransmit seq %u len %d", conn, seq, len);
+
+	conn->rexmit_next = seq + len;
+	net_stats_update_tcp_resent(conn->iface, len);
+	net_stats_update_tcp_seg_rexmit(conn->iface);
+	tcp_ca_data_sent(conn, seq + len, true);
+
+	return true;
+}
+
+/* Start a loss recovery driven by the scoreboard (RFC 6675) instead of
+ * resending everything from the first unacknowledged byte.
+ */
+static bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	if (!conn->sack_ok || conn->sacked_count == 0U) {
+		return false;
+	}
+
+	if (!conn->in_sack_recovery) {
+		conn->in_sack_recovery = true;
+		conn->recovery_point = conn->seq + conn->unacked_len;
+		conn->rexmit_next = conn->seq;
 	}
 
-	if (k_work_delayable_remaining_get(&conn->send_data_timer)) {
-		subscribe = false;
-	}
+	(void)tcp_sack_retransmit(conn);
 
-	if (subscribe) {
-		conn->send_data_retries = 0;
-		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-					    K_MSEC(TCP_RTO_MS));
-	}
- out:
-	return ret;
+	return true;
+}
+#else
+static void tcp_sack_reset(struct tcp *conn) { }
+
+static void tcp_sack_update(struct tcp *conn) { }
+
+static void tcp_sack_trim(struct tcp *conn) { }
+
+static bool tcp_sack_retransmit(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+
+	return false;
+}
+
+static bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+
+	return false;
 }
+#endif /* CONFIG_NET_TCP_SACK */
 
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
@@ -1868,6 +2646,9 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
+	/* The peer may have discarded SACKed data, see RFC 2018 ch 8 */
+	tcp_sack_reset(conn);
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -2110,7 +2891,7 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN(tcp_rx_window, NET_TCP_MAX_WIN);
 	conn->recv_win = conn->recv_win_max;
 	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
 	conn->send_win = conn->send_win_max;
@@ -2123,7 +2904,8 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = NET_TCP_MAX_WIN;
+	conn->ca.ops = tcp_ca_default();
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2140,6 +2922,10 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
+#if defined(CONFIG_NET_TCP_PACING)
+	k_work_init_delayable(&conn->pacing_timer, tcp_pacing_send);
+	conn->pacing_next = 0;
+#endif
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
 
@@ -2199,6 +2985,38 @@ static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
 		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
 }
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Established connections have a connection handler registered for
+ * their 4-tuple, so they can be found with a single lookup.
+ */
+static struct tcp *tcp_conn_lookup(struct net_pkt *pkt)
+{
+	union tcp_endpoint src;
+	union tcp_endpoint dst;
+	struct net_context *context;
+	struct tcp *conn;
+
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_SRC) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_DST) < 0) {
+		return NULL;
+	}
+
+	context = net_conn_find_context(IPPROTO_TCP, &src.sa, &dst.sa);
+	if (context == NULL) {
+		return NULL;
+	}
+
+	conn = context->tcp;
+	if (conn == NULL ||
+	    memcmp(&conn->src, &dst, tcp_endpoint_len(dst.sa.sa_family)) ||
+	    memcmp(&conn->dst, &src, tcp_endpoint_len(src.sa.sa_family))) {
+		return NULL;
+	}
+
+	return conn;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
 	bool found = false;
@@ -2207,6 +3025,17 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 	k_mutex_lock(&tcp_lock, K_FOREVER);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	conn = tcp_conn_lookup(pkt);
+	if (conn != NULL) {
+		k_mutex_unlock(&tcp_lock);
+		return conn;
+	}
+#endif /* CONFIG_NET_CONN_HASH */
+
+	/* A connection may briefly have no handler for its 4-tuple, e.g.
+	 * while it is being accepted, so fall back to walking them all.
+	 */
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
 		found = tcp_conn_cmp(conn, pkt);
 		if (found) {
@@ -2221,6 +3050,162 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* In-order data segment held back by an RX queue thread while more
+ * packets are waiting in its queue, so that the next segments of the same
+ * connection can be appended to it.
+ */
+struct tcp_gro {
+	struct tcp *conn;
+	struct net_pkt *pkt;
+};
+
+static struct tcp_gro tcp_gro[NET_RX_QUEUE_COUNT];
+
+static bool tcp_gro_is_data(struct tcphdr *th, struct net_pkt *pkt)
+{
+	return (th_flags(th) & ~PSH) == ACK && tcp_data_len(pkt) > 0;
+}
+
+static bool tcp_gro_can_hold(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct tcphdr *th = th_get(pkt);
+	bool ret;
+
+	if (!th || !tcp_gro_is_data(th, pkt)) {
+		return false;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	ret = conn->state == TCP_ESTABLISHED && th_seq(th) == conn->ack;
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+
+static bool tcp_gro_same_options(struct net_pkt *a, struct net_pkt *b, size_t len)
+{
+	uint8_t buf_a[40]; /* TCP header max options size is 40 */
+	uint8_t buf_b[40];
+	uint8_t *opts_a = tcp_options_get(a, len, buf_a, sizeof(buf_a));
+	uint8_t *opts_b = tcp_options_get(b, len, buf_b, sizeof(buf_b));
+
+	return opts_a && opts_b && memcmp(opts_a, opts_b, len) == 0;
+}
+
+/* Append the payload of pkt to the held segment if it directly follows it */
+static bool tcp_gro_merge(struct tcp_gro *gro, struct net_pkt *pkt)
+{
+	size_t held_len = tcp_data_len(gro->pkt);
+	uint32_t held_seq, held_ack;
+	uint16_t held_win;
+	uint8_t held_off;
+	struct tcphdr *th;
+	size_t len;
+
+	th = th_get(gro->pkt);
+	if (!th) {
+		return false;
+	}
+
+	held_seq = th_seq(th);
+	held_ack = th_ack(th);
+	held_win = th_win(th);
+	held_off = th_off(th);
+
+	th = th_get(pkt);
+	if (!th || !tcp_gro_is_data(th, pkt)) {
+		return false;
+	}
+
+	len = tcp_data_len(pkt);
+
+	if (th_seq(th) != held_seq + held_len || th_ack(th) != held_ack ||
+	    th_win(th) != held_win || th_off(th) != held_off ||
+	    held_len + len > CONFIG_NET_TCP_GRO_MAX_SIZE) {
+		return false;
+	}
+
+	if (held_off > 5 && !tcp_gro_same_options(gro->pkt, pkt, (held_off - 5) * 4)) {
+		return false;
+	}
+
+	if (th_flags(th) & PSH) {
+		th = th_get(gro->pkt);
+		UNALIGNED_PUT(th_flags(th) | PSH, &th->th_flags);
+	}
+
+	/* The checksum was verified by net_tcp_input(), only the payload is
+	 * needed from now on.
+	 */
+	if (tcp_pkt_pull(pkt, net_pkt_get_len(pkt) - len) < 0) {
+		return false;
+	}
+
+	net_pkt_append_buffer(gro->pkt, pkt->buffer);
+	pkt->buffer = NULL;
+	tcp_pkt_unref(pkt);
+
+	return true;
+}
+
+static void tcp_gro_flush_one(struct tcp_gro *gro)
+{
+	struct tcp *conn = gro->conn;
+	struct net_pkt *pkt = gro->pkt;
+
+	gro->conn = NULL;
+	gro->pkt = NULL;
+
+	if (tcp_in(conn, pkt) == NET_DROP) {
+		tcp_pkt_unref(pkt);
+	}
+
+	tcp_conn_unref(conn);
+}
+
+/* Return true if the packet was held back or merged, and so consumed */
+static bool tcp_gro_receive(struct tcp *conn, struct net_pkt *pkt)
+{
+	int queue = net_tc_rx_current();
+	struct tcp_gro *gro;
+
+	if (queue < 0) {
+		return false;
+	}
+
+	gro = &tcp_gro[queue];
+
+	if (gro->pkt) {
+		if (gro->conn == conn && tcp_gro_merge(gro, pkt)) {
+			return true;
+		}
+
+		/* Keep the order of the segments */
+		tcp_gro_flush_one(gro);
+	}
+
+	if (!net_tc_rx_pending(queue) || !tcp_gro_can_hold(conn, pkt)) {
+		return false;
+	}
+
+	tcp_conn_ref(conn);
+	gro->conn = conn;
+	gro->pkt = pkt;
+
+	return true;
+}
+
+void net_tcp_gro_flush(void)
+{
+	int queue = net_tc_rx_current();
+
+	if (queue >= 0 && tcp_gro[queue].pkt) {
+		tcp_gro_flush_one(&tcp_gro[queue]);
+	}
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				 struct net_pkt *pkt,
 				 union net_ip_header *ip,
@@ -2236,6 +3221,11 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 
 	conn = tcp_conn_search(pkt);
 	if (conn) {
+#if defined(CONFIG_NET_TCP_GRO)
+		if (tcp_gro_receive(conn, pkt)) {
+			return NET_OK;
+		}
+#endif
 		goto in;
 	}
 
@@ -2850,12 +3840,26 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  th_flags(th) & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		do_close = true;
 		close_status = -ECONNRESET;
 		goto out;
+	} else if (th && tcp_options_len == 0) {
+		tcp_options_reset(&conn->recv_options, th_flags(th) & SYN);
+	}
+
+	/* RST segments have been handled above, as they are not subject to
+	 * PAWS (RFC 7323 ch 5.3).
+	 */
+	if (th && !tcp_paws_check(conn)) {
+		NET_DBG("conn: %p, PAWS: dropping old duplicate segment", conn);
+		net_stats_update_tcp_seg_drop(conn->iface);
+		tcp_out(conn, ACK);
+		k_mutex_unlock(&conn->lock);
+		return NET_DROP;
 	}
 
 	if (th && (conn->state != TCP_LISTEN) && (conn->state != TCP_SYN_SENT) &&
@@ -2874,7 +3878,13 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (th) {
+		tcp_ts_recent_update(conn, th, tcp_data_len(pkt));
+
 		conn->send_win = ntohs(th_win(th));
+		if (!(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2897,6 +3907,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 		} else {
 			k_sem_give(&conn->tx_sem);
+			tcp_notify_poll(conn);
 		}
 	}
 
@@ -2908,6 +3919,7 @@ next_state:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
@@ -2944,6 +3956,7 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_param_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3033,6 +4046,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3116,6 +4130,10 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		if (th && conn->sack_ok) {
+			tcp_sack_update(conn);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3136,20 +4154,27 @@ next_state:
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				/* Retransmit only what the peer is missing if
+				 * it reports it, else apply a fast retransmit.
+				 */
+				if (!tcp_sack_recovery_start(conn)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+			} else if (conn->in_sack_recovery && len == 0) {
+				/* Each further duplicate ACK clocks out the next hole */
+				(void)tcp_sack_retransmit(conn);
 			}
 		}
 #endif
@@ -3191,11 +4216,23 @@ next_state:
 
 			if (!tcp_window_full(conn)) {
 				k_sem_give(&conn->tx_sem);
+				tcp_notify_poll(conn);
 			}
 
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			tcp_rtt_sample(conn);
+
+			if (conn->sack_ok) {
+				tcp_sack_trim(conn);
+
+				/* A partial ACK reveals the next hole to fill */
+				if (conn->in_sack_recovery) {
+					(void)tcp_sack_retransmit(conn);
+				}
+			}
+
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
 			 * makes a "forward progress".
@@ -3292,6 +4329,7 @@ next_state:
 			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 		} else {
 			k_sem_give(&conn->tx_sem);
+			tcp_notify_poll(conn);
 		}
 
 		break;
@@ -3560,6 +4598,7 @@ out:
 			}
 
 			k_sem_give(&conn->connect_sem);
+			tcp_notify_poll(conn);
 		}
 
 		goto next_state;
@@ -3779,6 +4818,56 @@ out:
 	return ret;
 }
 
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *buf)
+{
+	struct tcp *conn = context->tcp;
+	size_t len = net_buf_frags_len(buf);
+	int ret;
+
+	if (!conn) {
+		return -ENOTCONN;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state != TCP_ESTABLISHED) {
+		ret = -ENOTCONN;
+		goto out;
+	}
+
+	/* The chain is not split, so it is only queued once it fits in the
+	 * send window, or once all the data queued before it has been
+	 * acknowledged if it is larger than the window. tcp_unsent_len()
+	 * then keeps the segments within the window.
+	 */
+	if (tcp_window_full(conn) ||
+	    (conn->send_data_total > 0 && len > tcp_window_free(conn))) {
+		/* Wait for the next acknowledgment to try again */
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	net_pkt_append_buffer(conn->send_data, buf);
+	conn->send_data_total += len;
+
+	/* The buffers belong to the connection now, so a transmit error
+	 * is reported by the next call once the connection is closed.
+	 */
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		tcp_conn_close(conn, ret);
+	} else if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	ret = len;
+out:
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+
 /* net context is about to send out queued data - inform caller only */
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *user_data)
@@ -4061,7 +5150,11 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* The checksum of a super-packet is computed per segment, by
+	 * net_tcp_gso_send() or by the device.
+	 */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) &&
+	    net_pkt_gso_size(pkt) == 0U) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4069,6 +5162,117 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+static struct net_pkt *tcp_gso_segment(struct net_pkt *pkt, size_t hdr_len,
+				       size_t offset, size_t len, bool last)
+{
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	uint8_t flags;
+
+	seg = net_pkt_shallow_clone(pkt, TCP_PKT_ALLOC_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	/* Keep the attributes of the super-packet, but not its data */
+	net_pkt_frag_unref(seg->buffer);
+	seg->buffer = NULL;
+	net_pkt_set_gso_size(seg, 0U);
+
+	if (net_pkt_alloc_buffer_raw(seg, hdr_len + len, TCP_PKT_ALLOC_TIMEOUT)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	th = th_get(seg);
+	if (!th) {
+		goto fail;
+	}
+
+	flags = th_flags(th);
+	if (!last) {
+		flags &= ~(FIN | PSH);
+	}
+
+	UNALIGNED_PUT(flags, &th->th_flags);
+	UNALIGNED_PUT(htonl(th_seq(th) + offset), &th->th_seq);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		/* Computed over the super-packet header, so redo it */
+		NET_IPV4_HDR(seg)->chksum = 0U;
+	}
+
+	if (tcp_finalize_pkt(seg) < 0) {
+		goto fail;
+	}
+
+	return seg;
+
+fail:
+	tcp_pkt_unref(seg);
+
+	return NULL;
+}
+
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt,
+		     int (*send)(struct net_if *iface, struct net_pkt *pkt))
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t seg_size = net_pkt_gso_size(pkt);
+	size_t hdr_len, data_len, offset;
+	struct tcphdr *th;
+	int sent = 0;
+	int ret = 0;
+
+	th = th_get(pkt);
+	if (!th) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + th_off(th) * 4U;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (offset = 0U; offset < data_len; offset += seg_size) {
+		size_t len = MIN(seg_size, data_len - offset);
+		struct net_pkt *seg;
+
+		seg = tcp_gso_segment(pkt, hdr_len, offset, len,
+				      offset + len == data_len);
+		if (!seg) {
+			/* The rest is retransmitted by TCP */
+			ret = -ENOBUFS;
+			break;
+		}
+
+		ret = send(iface, seg);
+		if (ret < 0) {
+			tcp_pkt_unref(seg);
+			break;
+		}
+
+		sent += ret;
+	}
+
+	if (sent == 0 && ret < 0) {
+		return ret;
+	}
+
+	tcp_pkt_unref(pkt);
+
+	return sent;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -4440,6 +5644,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4477,6 +5684,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Delay-based congestion control modeled after BBR (version 1).
+ *
+ * The bottleneck bandwidth is the maximum delivery rate measured over the
+ * last rounds, a round being the time it takes to get the data sent at its
+ * start acknowledged. Together with the minimum RTT it gives the
+ * bandwidth-delay product (BDP) of the path. Data is paced at a gain of the
+ * bandwidth and the congestion window only caps the data in flight to twice
+ * the BDP. Compared to the original algorithm, the delivery rate is sampled
+ * once per round instead of for each acknowledgment, and there is no
+ * PROBE_RTT state.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+enum bbr_mode {
+	BBR_STARTUP,
+	BBR_DRAIN,
+	BBR_PROBE_BW,
+};
+
+/* Gains are in percent. The startup gain of 2/ln(2) doubles the sending
+ * rate every round, drain gets rid of the queue built during startup.
+ */
+#define BBR_STARTUP_GAIN 289
+#define BBR_DRAIN_GAIN 35
+#define BBR_CWND_GAIN 200
+
+/* The bandwidth is considered reached when it did not grow by 25% for
+ * three rounds.
+ */
+#define BBR_FULL_BW_THRESH 125
+#define BBR_FULL_BW_ROUNDS 3
+
+/* Length of the max bandwidth filter, in rounds */
+#define BBR_BW_WINDOW 10
+
+/* Length of the min RTT filter, in ms */
+#define BBR_MIN_RTT_WINDOW_MS 10000
+
+/* The window never goes below this number of segments */
+#define BBR_MIN_CWND_SEGMENTS 4
+
+/* Probe for more bandwidth, then drain the queue it may have built, then
+ * cruise at the estimated bandwidth.
+ */
+static const uint8_t bbr_cycle_gain[] = { 125, 75, 100, 100, 100, 100, 100, 100 };
+
+static void bbr_log(struct tcp *conn, const char *step)
+{
+	NET_DBG("conn: %p, bbr %s, mode=%u, bw=%u, min_rtt=%u, cwnd=%u, pacing=%u",
+		conn, step, conn->ca.bbr.mode, conn->ca.bbr.max_bw,
+		conn->ca.bbr.min_rtt, conn->ca.cwnd, conn->ca.pacing_rate);
+}
+
+static uint32_t bbr_bdp(struct tcp *conn)
+{
+	struct tcp_ca_bbr_state *bbr = &conn->ca.bbr;
+
+	return MIN((uint64_t)bbr->max_bw * bbr->min_rtt / MSEC_PER_SEC,
+		   NET_TCP_MAX_WIN);
+}
+
+static uint32_t bbr_pacing_gain(struct tcp *conn)
+{
+	struct tcp_ca_bbr_state *bbr = &conn->ca.bbr;
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		return BBR_STARTUP_GAIN;
+	case BBR_DRAIN:
+		return BBR_DRAIN_GAIN;
+	default:
+		return bbr_cycle_gain[bbr->cycle_idx];
+	}
+}
+
+static void bbr_init(struct tcp *conn)
+{
+	struct tcp_ca_bbr_state *bbr = &conn->ca.bbr;
+
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = NET_TCP_MAX_WIN;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	/* Nothing is known about the path yet, so do not pace */
+	conn->ca.pacing_rate = 0U;
+
+	memset(bbr, 0, sizeof(*bbr));
+	bbr->mode = BBR_STARTUP;
+	bbr->round_start = k_uptime_get_32();
+	bbr->round_end_seq = conn->seq + conn->unacked_len;
+
+	bbr_log(conn, "init");
+}
+
+static void bbr_update_min_rtt(struct tcp *conn, uint32_t rtt, uint32_t now)
+{
+	struct tcp_ca_bbr_state *bbr = &conn->ca.bbr;
+
+	if (rtt == 0U) {
+		return;
+	}
+
+	if (bbr->min_rtt == 0U || rtt <= bbr->min_rtt ||
+	    now - bbr->min_rtt_stamp > BBR_MIN_RTT_WINDOW_MS) {
+		bbr->min_rtt = rtt;
+		bbr->min_rtt_stamp = now;
+	}
+}
+
+/* Called once per round, when the data sent at its start is acknowledged */
+static void bbr_round_end(struct tcp *conn, uint32_t now)
+{
+	struct tcp_ca_bbr_state *bbr = &conn->ca.bbr;
+	uint32_t interval = MAX(now - bbr->round_start, 1U);
+	uint32_t bw;
+
+	bw = MIN((uint64_t)bbr->round_delivered * MSEC_PER_SEC / interval,
+		 UINT32_MAX);
+
+	bbr->round_count++;
+	bbr->round_delivered = 0U;
+	bbr->round_start = now;
+	bbr->round_end_seq = conn->seq + conn->unacked_len;
+
+	if (bw >= bbr->max_bw ||
+	    bbr->round_count - bbr->max_bw_round > BBR_BW_WINDOW) {
+		bbr->max_bw = bw;
+		bbr->max_bw_round = bbr->round_count;
+	}
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		if ((uint64_t)bbr->max_bw * 100 >=
+		    (uint64_t)bbr->full_bw * BBR_FULL_BW_THRESH) {
+			bbr->full_bw = bbr->max_bw;
+			bbr->full_bw_cnt = 0U;
+		} else if (++bbr->full_bw_cnt >= BBR_FULL_BW_ROUNDS) {
+			bbr->mode = BBR_DRAIN;
+			bbr_log(conn, "drain");
+		}
+		break;
+	case BBR_PROBE_BW:
+		bbr->cycle_idx = (bbr->cycle_idx + 1) % ARRAY_SIZE(bbr_cycle_gain);
+		break;
+	default:
+		break;
+	}
+}
+
+static void bbr_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt)
+{
+	struct tcp_ca_bbr_state *bbr = &conn->ca.bbr;
+	uint32_t mss = conn_mss(conn);
+	uint32_t now = k_uptime_get_32();
+	uint32_t target;
+	uint32_t bdp;
+
+	bbr_update_min_rtt(conn, rtt, now);
+
+	bbr->round_delivered += acked_len;
+	if (net_tcp_seq_cmp(conn->seq + acked_len, bbr->round_end_seq) >= 0) {
+		bbr_round_end(conn, now);
+	}
+
+	bdp = bbr_bdp(conn);
+
+	/* The queue is drained once the data in flight fits the path */
+	if (bbr->mode == BBR_DRAIN &&
+	    conn->unacked_len - acked_len <= bdp) {
+		bbr->mode = BBR_PROBE_BW;
+		bbr->cycle_idx = 0U;
+		bbr_log(conn, "probe_bw");
+	}
+
+	if (bdp == 0U) {
+		target = NET_TCP_MAX_WIN;
+	} else if (bbr->mode == BBR_STARTUP) {
+		target = MIN((uint64_t)bdp * BBR_STARTUP_GAIN / 100, NET_TCP_MAX_WIN);
+	} else {
+		target = MIN((uint64_t)bdp * BBR_CWND_GAIN / 100, NET_TCP_MAX_WIN);
+	}
+
+	target = MAX(target, BBR_MIN_CWND_SEGMENTS * mss);
+
+	/* Grow towards the target as slow start does, but cut down at once */
+	conn->ca.cwnd = MIN(conn->ca.cwnd + acked_len, target);
+
+	conn->ca.pacing_rate = MIN((uint64_t)bbr->max_bw * bbr_pacing_gain(conn) / 100,
+				   UINT32_MAX);
+}
+
+static void bbr_fast_retransmit(struct tcp *conn)
+{
+	/* Loss is not a congestion signal, the window follows the model */
+	bbr_log(conn, "fast_retransmit");
+}
+
+static void bbr_timeout(struct tcp *conn)
+{
+	/* Restart from one segment, the window grows back to the BDP as the
+	 * acknowledgments come in.
+	 */
+	conn->ca.cwnd = conn_mss(conn);
+	bbr_log(conn, "timeout");
+}
+
+static void bbr_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+const struct tcp_ca_ops tcp_ca_bbr = {
+	.name = "bbr",
+	.init = bbr_init,
+	.fast_retransmit = bbr_fast_retransmit,
+	.timeout = bbr_timeout,
+	.dup_ack = bbr_dup_ack,
+	.pkts_acked = bbr_pkts_acked,
+};
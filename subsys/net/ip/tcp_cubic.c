@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, implementation according to RFC 9438 */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* Multiplicative window decrease factor, 0.7 */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+
+/* Cubic scaling constant C, 0.4 segment/s^3 */
+#define CUBIC_C_NUM 4
+#define CUBIC_C_DEN 10
+
+/* Reno-friendly additive increase, 3 * (1 - beta) / (1 + beta) */
+#define CUBIC_ALPHA_NUM 9
+#define CUBIC_ALPHA_DEN 17
+
+/* Bound of |t - K|, so that the cube fits into 64 bits */
+#define CUBIC_MAX_DELTA_MS 60000
+
+static void cubic_log(struct tcp *conn, const char *step)
+{
+	NET_DBG("conn: %p, cubic %s, cwnd=%u, ssthresh=%u, w_max=%u, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.cubic.w_max, conn->ca.cubic.k);
+}
+
+/* Integer cube root, bit by bit */
+static uint32_t cubic_root(uint64_t x)
+{
+	uint64_t y = 0U;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	/* Slow start until the first congestion event */
+	conn->ca.ssthresh = NET_TCP_MAX_WIN;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+	cubic_log(conn, "init");
+}
+
+static void cubic_reduce(struct tcp *conn)
+{
+	struct tcp_ca_cubic_state *cubic = &conn->ca.cubic;
+	uint64_t cwnd = conn->ca.cwnd;
+
+	/* Fast convergence, release bandwidth for new flows when the window
+	 * did not reach its previous maximum.
+	 */
+	if (cwnd < cubic->w_max) {
+		cubic->w_max = cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			       (2 * CUBIC_BETA_DEN);
+	} else {
+		cubic->w_max = cwnd;
+	}
+
+	conn->ca.ssthresh = MAX(cwnd * CUBIC_BETA_NUM / CUBIC_BETA_DEN,
+				2U * conn_mss(conn));
+	cubic->epoch_start = 0U;
+	cubic->cnt = 0U;
+}
+
+static void cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		cubic_reduce(conn);
+		/* Account for the segments that left the network */
+		conn->ca.cwnd = conn->ca.ssthresh + 3 * conn_mss(conn);
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void cubic_timeout(struct tcp *conn)
+{
+	cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	cubic_log(conn, "timeout");
+}
+
+static void cubic_dup_ack(struct tcp *conn)
+{
+	/* Inflate the window during fast recovery only */
+	if (conn->ca.pending_fast_retransmit_bytes != 0) {
+		conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn),
+				    NET_TCP_MAX_WIN);
+	}
+}
+
+static void cubic_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt)
+{
+	struct tcp_ca_cubic_state *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	int64_t delta;
+	int64_t target;
+	uint32_t inc;
+
+	ARG_UNUSED(rtt);
+
+	if (conn->ca.pending_fast_retransmit_bytes != 0) {
+		/* Deflate the window as New Reno does until the recovery ends */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+			conn->ca.cwnd = MAX(cwnd, acked_len + mss) - acked_len;
+		}
+		cubic_log(conn, "recovery");
+		return;
+	}
+
+	if (cwnd < conn->ca.ssthresh) {
+		conn->ca.cwnd = MIN(cwnd + MIN(acked_len, mss), NET_TCP_MAX_WIN);
+		return;
+	}
+
+	if (cubic->epoch_start == 0U) {
+		cubic->epoch_start = MAX(now, 1U);
+		cubic->w_est = cwnd;
+		cubic->cnt = 0U;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cubic_root((W_max - cwnd) / C), in ms */
+			cubic->k = cubic_root((uint64_t)(cubic->w_max - cwnd) *
+					      MSEC_PER_SEC / mss * USEC_PER_SEC *
+					      CUBIC_C_DEN / CUBIC_C_NUM);
+		} else {
+			cubic->k = 0U;
+			cubic->w_max = cwnd;
+		}
+
+		cubic_log(conn, "epoch");
+	}
+
+	/* W_cubic(t) = C * (t - K)^3 + W_max */
+	delta = (int64_t)(now - cubic->epoch_start) - cubic->k;
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+	target = cubic->w_max + delta * delta * delta / MSEC_PER_SEC *
+		 CUBIC_C_NUM * mss / ((int64_t)CUBIC_C_DEN * USEC_PER_SEC);
+
+	/* Window a Reno flow would have reached, CUBIC never does worse */
+	cubic->w_est += (uint64_t)acked_len * mss * CUBIC_ALPHA_NUM /
+			((uint64_t)CUBIC_ALPHA_DEN * cwnd);
+	target = MAX(target, (int64_t)cubic->w_est);
+
+	target = CLAMP(target, (int64_t)cwnd, (int64_t)cwnd + cwnd / 2);
+
+	/* Grow by (target - cwnd) / cwnd for each acknowledged byte */
+	cubic->cnt += (uint64_t)(target - cwnd) * acked_len;
+	inc = cubic->cnt / cwnd;
+	cubic->cnt -= (uint64_t)inc * cwnd;
+
+	conn->ca.cwnd = MIN(cwnd + inc, NET_TCP_MAX_WIN);
+}
+
+const struct tcp_ca_ops tcp_ca_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.fast_retransmit = cubic_fast_retransmit,
+	.timeout = cubic_timeout,
+	.dup_ack = cubic_dup_ack,
+	.pkts_acked = cubic_pkts_acked,
+};
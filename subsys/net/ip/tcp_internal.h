@@ -36,6 +36,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -312,6 +313,30 @@ static inline int net_tcp_queue(struct net_context *context, const void *data,
 }
 #endif
 
+/**
+ * @brief Enqueue a buffer chain for transmission without copying it
+ *
+ * On success the connection takes over the reference to the buffers,
+ * they are released once the peer has acknowledged their data.
+ *
+ * @param context	Network context
+ * @param buf		Buffer chain holding the data
+ *
+ * @return Number of bytes queued if ok, < 0 if error
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *buf);
+#else
+static inline int net_tcp_queue_buf(struct net_context *context,
+				    struct net_buf *buf)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(buf);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
 /**
  * @brief Update TCP receive window
  *
@@ -448,6 +473,47 @@ static inline void net_tcp_reply_rst(struct net_pkt *pkt)
 }
 #endif
 
+/**
+ * @brief Cut a TCP super-packet into segments and send them.
+ *
+ * @details The payload of the packet is split in net_pkt_gso_size() sized
+ * segments, each one getting a copy of the IP and TCP headers with updated
+ * lengths, sequence number and checksums.
+ *
+ * @param iface Network interface the packet is sent to
+ * @param pkt TCP super-packet, freed if at least one segment was sent
+ * @param send L2 send function called for each segment
+ *
+ * @return Number of bytes sent, <0 if no segment could be sent
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt,
+		     int (*send)(struct net_if *iface, struct net_pkt *pkt));
+#else
+static inline int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt,
+				   int (*send)(struct net_if *iface, struct net_pkt *pkt))
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(send);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Pass the segments held back for merging to TCP.
+ *
+ * @details Called by the RX traffic class thread when its queue is empty.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(void);
+#else
+static inline void net_tcp_gro_flush(void)
+{
+}
+#endif
+
 /**
  * @brief Get the TCP connection endpoint information.
  *
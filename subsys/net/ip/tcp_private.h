@@ -131,9 +131,10 @@
 #define NET_TCP_DEFAULT_MSS 536
 
 #define conn_mss(_conn)							\
-	MIN((_conn)->recv_options.mss_found ? (_conn)->recv_options.mss	\
-					    : NET_TCP_DEFAULT_MSS,	\
-	    net_tcp_get_supported_mss(_conn))
+	(MIN((_conn)->recv_options.mss_found ? (_conn)->recv_options.mss \
+					     : NET_TCP_DEFAULT_MSS,	\
+	     net_tcp_get_supported_mss(_conn)) -			\
+	 ((_conn)->ts_ok ? NET_TCP_TIMESTAMP_ALIGNED_SIZE : 0))
 
 #define conn_state(_conn, _s)						\
 ({									\
@@ -146,7 +147,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -192,10 +193,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_UNUSED = 0,
 	TCP_LISTEN,
@@ -227,30 +224,142 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* Timestamps option padded with two NOPs, as sent on every segment */
+#define NET_TCP_TIMESTAMP_ALIGNED_SIZE 12
+
+/* Largest shift count allowed for the window scale option */
+#define NET_TCP_WINDOW_SCALE_MAX 14
+
+/* Largest window that can be advertised */
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define NET_TCP_MAX_WIN ((uint32_t)UINT16_MAX << NET_TCP_WINDOW_SCALE_MAX)
+#else
+#define NET_TCP_MAX_WIN UINT16_MAX
+#endif
+
+/* Number of SACK blocks that fit into the TCP options */
+#define NET_TCP_SACK_BLOCKS_MAX 4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_BLOCKS_MAX];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
 };
 
+struct tcp;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+/* Define the number of MSS sections the congestion window is initialized at */
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+/* Congestion control algorithm. The callbacks are called with the
+ * connection lock held.
+ */
+struct tcp_ca_ops {
+	const char *name;
+	/* Connection is established */
+	void (*init)(struct tcp *conn);
+	/* Third duplicate ACK, the first unacknowledged segment was resent */
+	void (*fast_retransmit)(struct tcp *conn);
+	/* Retransmission timer expired */
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	/* New data acknowledged, called before conn->seq is advanced.
+	 * The rtt is a round trip time sample in ms, 0 if there is none.
+	 */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len, uint32_t rtt);
+};
+
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+struct tcp_ca_cubic_state {
+	uint64_t cnt;         /* cwnd increase not applied yet, bytes * bytes */
+	uint32_t w_max;       /* cwnd before the last reduction */
+	uint32_t w_est;       /* Reno-friendly window estimate */
+	uint32_t k;           /* time to reach w_max again, in ms */
+	uint32_t epoch_start; /* start of the avoidance epoch, 0 if none */
 };
 #endif
 
-struct tcp;
+#if defined(CONFIG_NET_TCP_CA_BBR)
+struct tcp_ca_bbr_state {
+	uint32_t max_bw;        /* bottleneck bandwidth estimate, bytes/s */
+	uint32_t max_bw_round;  /* round in which max_bw was measured */
+	uint32_t full_bw;       /* bandwidth at the last startup growth */
+	uint32_t min_rtt;       /* ms, 0 if not measured yet */
+	uint32_t min_rtt_stamp;
+	uint32_t round_count;
+	uint32_t round_end_seq;
+	uint32_t round_start;   /* uptime at the start of the round, in ms */
+	uint32_t round_delivered;
+	uint32_t cycle_stamp;
+	uint8_t mode;
+	uint8_t cycle_idx;
+	uint8_t full_bw_cnt;
+};
+#endif
+
+struct tcp_congestion_avoidance {
+	const struct tcp_ca_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+#if defined(CONFIG_NET_TCP_PACING)
+	uint32_t pacing_rate; /* bytes/s, 0 to send without pacing */
+#endif
+	uint32_t rtt_seq;   /* end of the segment being timed */
+	uint32_t rtt_start; /* uptime when it was sent, in ms */
+	bool rtt_pending;
+#if defined(CONFIG_NET_TCP_CA_CUBIC) || defined(CONFIG_NET_TCP_CA_BBR)
+	union {
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+		struct tcp_ca_cubic_state cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CA_BBR)
+		struct tcp_ca_bbr_state bbr;
+#endif
+	};
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+extern const struct tcp_ca_ops tcp_ca_cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CA_BBR)
+extern const struct tcp_ca_ops tcp_ca_bbr;
+#endif
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
 struct tcp { /* TCP connection */
@@ -285,6 +394,10 @@ struct tcp { /* TCP connection */
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
+#if defined(CONFIG_NET_TCP_PACING)
+	struct k_work_delayable pacing_timer;
+	int64_t pacing_next; /* earliest time of the next segment, in us */
+#endif
 	struct k_work conn_release;
 
 	union {
@@ -314,21 +427,35 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_recent; /* last timestamp received from the peer */
+	uint32_t srtt;      /* smoothed RTT in ms, scaled by 8 */
+	uint32_t rttvar;    /* RTT variation in ms, scaled by 4 */
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Blocks SACKed by the peer, sorted and non-overlapping */
+	struct tcp_sack_block sacked[NET_TCP_SACK_BLOCKS_MAX];
+	uint32_t recovery_point;
+	uint32_t rexmit_next;
+	uint8_t sacked_count;
+#endif
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_congestion_avoidance ca;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
 #endif
 	uint8_t zwp_retries;
+	uint8_t snd_wscale;
+	uint8_t rcv_wscale;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
@@ -337,6 +464,10 @@ struct tcp { /* TCP connection */
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
+	bool wscale_ok : 1;
+	bool ts_ok : 1;
+	bool sack_ok : 1;
+	bool in_sack_recovery : 1;
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -533,6 +533,86 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+#if !defined(CONFIG_ARCH_HAS_NET_CHKSUM)
+#if defined(CONFIG_64BIT)
+/* One's complement addition of a 64-bit word, the carry out is added
+ * back in. The result folds to the same 16-bit sum as the operands.
+ */
+static inline uint64_t chksum_add64(uint64_t sum, uint64_t word)
+{
+	sum += word;
+
+	return sum + (sum < word);
+}
+
+static uint64_t chksum_add_words(uint64_t sum, const void *data, size_t len)
+{
+	const uint64_t *p;
+	size_t i = 0;
+
+	if ((((uintptr_t)data & 0x04) != 0) && (len >= sizeof(uint32_t))) {
+		sum = chksum_add64(sum, *(const uint32_t *)data);
+		data = (const uint8_t *)data + sizeof(uint32_t);
+		len -= sizeof(uint32_t);
+	}
+
+	p = data;
+
+	/* Do loop unrolling for the very large data sets */
+	while (len >= sizeof(uint64_t) * 4) {
+		uint64_t sum_a = chksum_add64(p[i], p[i + 1]);
+		uint64_t sum_b = chksum_add64(p[i + 2], p[i + 3]);
+
+		len -= sizeof(uint64_t) * 4;
+		i += 4;
+		sum = chksum_add64(sum, chksum_add64(sum_a, sum_b));
+	}
+	while (len >= sizeof(uint64_t)) {
+		len -= sizeof(uint64_t);
+		sum = chksum_add64(sum, p[i++]);
+	}
+	if (len >= sizeof(uint32_t)) {
+		sum = chksum_add64(sum, *(const uint32_t *)(p + i));
+	}
+
+	/* Leave room for the caller to add the remaining bytes */
+	sum = (sum & 0xffffffff) + (sum >> 32);
+
+	return (sum & 0xffffffff) + (sum >> 32);
+}
+#else
+/* The 32-bit words are added in a 64-bit accumulator, which cannot
+ * overflow for any length that fits in memory, so the carries are only
+ * folded in at the end.
+ */
+static uint64_t chksum_add_words(uint64_t sum, const void *data, size_t len)
+{
+	const uint32_t *p = data;
+	size_t i = 0;
+
+	/* Do loop unrolling for the very large data sets */
+	while (len >= sizeof(uint32_t) * 4) {
+		uint64_t sum_a = p[i];
+		uint64_t sum_b = p[i + 1];
+
+		len -= sizeof(uint32_t) * 4;
+		sum_a += p[i + 2];
+		sum_b += p[i + 3];
+		i += 4;
+		sum += sum_a + sum_b;
+	}
+	while (len >= sizeof(uint32_t)) {
+		len -= sizeof(uint32_t);
+		sum = sum + p[i++];
+	}
+
+	return sum;
+}
+#endif /* CONFIG_64BIT */
+#else
+#define chksum_add_words arch_net_chksum_add
+#endif /* !CONFIG_ARCH_HAS_NET_CHKSUM */
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -543,8 +623,7 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 {
 	uint64_t sum;
-	uint32_t *p;
-	size_t i = 0;
+	size_t words;
 	size_t pending = len;
 	int odd_start = ((uintptr_t)data & 0x01);
 
@@ -568,24 +647,15 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
-	p = (uint32_t *)data;
 
-	/* Do loop unrolling for the very large data sets */
-	while (pending >= sizeof(uint32_t) * 4) {
-		uint64_t sum_a = p[i];
-		uint64_t sum_b = p[i + 1];
-
-		pending -= sizeof(uint32_t) * 4;
-		sum_a += p[i + 2];
-		sum_b += p[i + 3];
-		i += 4;
-		sum += sum_a + sum_b;
-	}
-	while (pending >= sizeof(uint32_t)) {
-		pending -= sizeof(uint32_t);
-		sum = sum + p[i++];
+	/* The bulk of the data, aligned to 32-bit words */
+	words = pending & ~(sizeof(uint32_t) - 1);
+	if (words != 0U) {
+		sum = chksum_add_words(sum, data, words);
+		data += words;
+		pending -= words;
 	}
-	data = (uint8_t *)(p + i);
+
 	if (pending >= 2) {
 		pending -= sizeof(uint16_t);
 		sum = sum + *((uint16_t *)data);
@@ -610,6 +680,21 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+			   const void *new_data, size_t len)
+{
+	uint32_t sum;
+
+	/* RFC 1624 eqn. 3: HC' = ~(~HC + ~m + m'), where m and m' are the
+	 * sums of the old and new data.
+	 */
+	sum = calc_chksum((uint16_t)~ntohs(chksum), new_data, len);
+	sum += (uint16_t)~calc_chksum(0U, old_data, len);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return htons((uint16_t)~sum);
+}
+
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
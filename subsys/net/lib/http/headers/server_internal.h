@@ -30,6 +30,8 @@ int handle_http1_request(struct http_client_ctx *client);
 int handle_http1_to_http2_upgrade(struct http_client_ctx *client);
 int handle_http1_to_websocket_upgrade(struct http_client_ctx *client);
 void http_server_release_client(struct http_client_ctx *client);
+bool http_server_resource_take(struct http_resource_detail_dynamic *dynamic_detail,
+			       struct http_client_ctx *client);
 
 int enter_http1_request(struct http_client_ctx *client);
 int enter_http2_request(struct http_client_ctx *client);
@@ -38,8 +40,28 @@ int enter_http_done_state(struct http_client_ctx *client);
 /* Others */
 struct http_resource_detail *get_resource_detail(const char *path, int *len, bool is_ws);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+int http_server_sendall_more(struct http_client_ctx *client, const void *buf, size_t len);
 void http_client_timer_restart(struct http_client_ctx *client);
 
+/* Static file system resources */
+enum http_fs_header {
+	HTTP_FS_HEADER_NONE,
+	HTTP_FS_HEADER_ACCEPT_ENCODING,
+	HTTP_FS_HEADER_RANGE,
+	HTTP_FS_HEADER_IF_NONE_MATCH,
+};
+
+void http_server_fs_request_init(struct http_client_ctx *client);
+enum http_fs_header http_server_fs_header_id(const char *name, size_t len);
+void http_server_fs_header_value(struct http_client_ctx *client, enum http_fs_header header,
+				 const char *value, size_t len);
+int http_server_fs_open(struct http_client_ctx *client,
+			struct http_resource_detail_static_fs *detail,
+			struct http_fs_response *rsp, char *buf, size_t buf_len);
+int http_server_fs_content_range(const struct http_fs_response *rsp, char *buf, size_t len);
+int http_server_fs_read(struct http_fs_response *rsp, void *buf, size_t len);
+void http_server_fs_close(struct http_fs_response *rsp);
+
 /* TODO Could be static, but currently used in tests. */
 int parse_http_frame_header(struct http_client_ctx *client);
 const char *get_frame_type_name(enum http_frame_type type);
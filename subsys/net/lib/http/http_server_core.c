@@ -19,7 +19,6 @@
 #include <zephyr/net/socket.h>
 #include <zephyr/net/tls_credentials.h>
 #include <zephyr/posix/sys/eventfd.h>
-#include <zephyr/posix/fnmatch.h>
 
 LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -38,23 +37,69 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
-#define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#define HTTP_SERVER_NUM_WORKERS  CONFIG_HTTP_SERVER_NUM_WORKERS
 
-struct http_server_ctx {
-	int num_clients;
+/* The client slots are split evenly between the workers */
+#define HTTP_SERVER_WORKER_CLIENTS DIV_ROUND_UP(HTTP_SERVER_MAX_CLIENTS, HTTP_SERVER_NUM_WORKERS)
+#define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_WORKER_CLIENTS)
+
+struct http_server_worker {
+	/* Slots in use or reserved for a client being handed over */
+	atomic_t num_clients;
+	int max_clients;
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
 
 	/* First pollfd is eventfd that can be used to stop the server,
-	 * then we have the server listen sockets,
+	 * then we have the server listen sockets (first worker only),
 	 * and then the accepted sockets.
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
+	struct http_client_ctx *clients;
+
+#if HTTP_SERVER_NUM_WORKERS > 1
+	/* Sockets accepted by the first worker for this worker */
+	struct k_msgq new_clients;
+	int new_clients_buf[HTTP_SERVER_WORKER_CLIENTS];
+	struct k_sem start;
+	struct k_sem stopped;
+	bool stop;
+#endif
+};
+
+struct http_server_ctx {
+	struct http_server_worker workers[HTTP_SERVER_NUM_WORKERS];
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
 };
 
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
+static struct k_spinlock resource_lock;
+
+static void worker_init(struct http_server_ctx *ctx, struct http_server_worker *worker)
+{
+	int first_client = ARRAY_INDEX(ctx->workers, worker) * HTTP_SERVER_WORKER_CLIENTS;
+
+	/* With more workers than clients, the last workers get no slot */
+	first_client = MIN(first_client, HTTP_SERVER_MAX_CLIENTS);
+
+	memset(worker->fds, 0, sizeof(worker->fds));
+
+	for (int i = 0; i < ARRAY_SIZE(worker->fds); i++) {
+		worker->fds[i].fd = INVALID_SOCK;
+	}
+
+	worker->clients = &ctx->clients[first_client];
+	worker->max_clients = MIN(HTTP_SERVER_WORKER_CLIENTS,
+				  HTTP_SERVER_MAX_CLIENTS - first_client);
+	worker->listen_fds = 1;
+	atomic_set(&worker->num_clients, 0);
+
+#if HTTP_SERVER_NUM_WORKERS > 1
+	worker->stop = false;
+	k_msgq_purge(&worker->new_clients);
+#endif
+}
 
 int http_server_init(struct http_server_ctx *ctx)
 {
@@ -71,27 +116,39 @@ int http_server_init(struct http_server_ctx *ctx)
 	} addr = {
 		.addr = (struct sockaddr *)&addr_storage
 	};
+	struct http_server_worker *first = &ctx->workers[0];
 
 	HTTP_SERVICE_COUNT(&svc_count);
 
 	/* Initialize fds */
-	memset(ctx->fds, 0, sizeof(ctx->fds));
 	memset(ctx->clients, 0, sizeof(ctx->clients));
 
-	for (i = 0; i < ARRAY_SIZE(ctx->fds); i++) {
-		ctx->fds[i].fd = INVALID_SOCK;
+	for (i = 0; i < ARRAY_SIZE(ctx->workers); i++) {
+		worker_init(ctx, &ctx->workers[i]);
 	}
 
-	/* Create an eventfd that can be used to trigger events during polling */
-	fd = eventfd(0, 0);
-	if (fd < 0) {
-		fd = -errno;
-		LOG_ERR("eventfd failed (%d)", fd);
-		return fd;
+	/* Create an eventfd per worker that can be used to trigger events
+	 * during polling.
+	 */
+	for (i = 0; i < ARRAY_SIZE(ctx->workers); i++) {
+		fd = eventfd(0, 0);
+		if (fd < 0) {
+			fd = -errno;
+			LOG_ERR("eventfd failed (%d)", fd);
+
+			while (i-- > 0) {
+				zsock_close(ctx->workers[i].fds[0].fd);
+				ctx->workers[i].fds[0].fd = INVALID_SOCK;
+			}
+
+			return fd;
+		}
+
+		ctx->workers[i].fds[0].fd = fd;
+		ctx->workers[i].fds[0].events = ZSOCK_POLLIN;
 	}
 
-	ctx->fds[count].fd = fd;
-	ctx->fds[count].events = ZSOCK_POLLIN;
+	/* The listen sockets go after the eventfd of the first worker */
 	count++;
 
 	HTTP_SERVICE_FOREACH(svc) {
@@ -202,19 +259,18 @@ int http_server_init(struct http_server_ctx *ctx)
 
 		LOG_DBG("Initialized HTTP Service %s:%u", svc->host, *svc->port);
 
-		ctx->fds[count].fd = fd;
-		ctx->fds[count].events = ZSOCK_POLLIN;
+		first->fds[count].fd = fd;
+		first->fds[count].events = ZSOCK_POLLIN;
 		count++;
 	}
 
+	first->listen_fds = count;
+
 	if (failed >= svc_count) {
 		LOG_ERR("All services failed (%d)", failed);
 		return -ESRCH;
 	}
 
-	ctx->listen_fds = count;
-	ctx->num_clients = 0;
-
 	return 0;
 }
 
@@ -241,18 +297,33 @@ static int accept_new_client(int server_fd)
 	return new_socket;
 }
 
-static int close_all_sockets(struct http_server_ctx *ctx)
+/* Close the files whose sending was waiting for a window update */
+static void client_close_files(struct http_client_ctx *client)
+{
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	ARRAY_FOR_EACH_PTR(client->streams, stream) {
+		if (stream->fs_pending) {
+			http_server_fs_close(&stream->fs_rsp);
+			stream->fs_pending = false;
+		}
+	}
+#endif
+}
+
+static int close_all_sockets(struct http_server_worker *worker)
 {
-	zsock_close(ctx->fds[0].fd); /* close eventfd */
-	ctx->fds[0].fd = -1;
+	for (int i = 0; i < worker->max_clients; i++) {
+		client_close_files(&worker->clients[i]);
+	}
 
-	for (int i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
-		if (ctx->fds[i].fd < 0) {
+	/* The eventfd is closed once all the workers are stopped */
+	for (int i = 1; i < ARRAY_SIZE(worker->fds); i++) {
+		if (worker->fds[i].fd < 0) {
 			continue;
 		}
 
-		zsock_close(ctx->fds[i].fd);
-		ctx->fds[i].fd = -1;
+		zsock_close(worker->fds[i].fd);
+		worker->fds[i].fd = -1;
 	}
 
 	return 0;
@@ -291,29 +362,60 @@ static void client_release_resources(struct http_client_ctx *client)
 					   NULL, 0, dynamic_detail->user_data);
 		}
 	}
+
+	client_close_files(client);
+}
+
+bool http_server_resource_take(struct http_resource_detail_dynamic *dynamic_detail,
+			       struct http_client_ctx *client)
+{
+	k_spinlock_key_t key;
+	bool taken = false;
+
+	/* The workers may handle requests for the same resource at once */
+	key = k_spin_lock(&resource_lock);
+
+	if (dynamic_detail->holder == NULL || dynamic_detail->holder == client) {
+		dynamic_detail->holder = client;
+		taken = true;
+	}
+
+	k_spin_unlock(&resource_lock, key);
+
+	return taken;
+}
+
+static struct http_server_worker *client_worker(struct http_client_ctx *client)
+{
+	return &server_ctx.workers[ARRAY_INDEX(server_ctx.clients, client) /
+				   HTTP_SERVER_WORKER_CLIENTS];
 }
 
 void http_server_release_client(struct http_client_ctx *client)
 {
+	struct http_server_worker *worker;
 	int i;
 	struct k_work_sync sync;
 
 	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
 
+	worker = client_worker(client);
+
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
-	server_ctx.num_clients--;
-
-	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
-		if (server_ctx.fds[i].fd == client->fd) {
-			server_ctx.fds[i].fd = INVALID_SOCK;
+	for (i = worker->listen_fds; i < worker->listen_fds + worker->max_clients; i++) {
+		if (worker->fds[i].fd == client->fd) {
+			worker->fds[i].fd = INVALID_SOCK;
 			break;
 		}
 	}
 
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
+
+	/* The slot can be given to a new client only once it is cleared */
+	atomic_dec(&worker->num_clients);
 }
 
 static void close_client_connection(struct http_client_ctx *client)
@@ -354,6 +456,8 @@ static void init_client_ctx(struct http_client_ctx *client, int new_socket)
 	client->has_upgrade_header = false;
 	client->preface_sent = false;
 	client->window_size = HTTP_SERVER_INITIAL_WINDOW_SIZE;
+	client->tx_window_size = HTTP_SERVER_DEFAULT_TX_WINDOW_SIZE;
+	client->tx_initial_window_size = HTTP_SERVER_DEFAULT_TX_WINDOW_SIZE;
 
 	memset(client->buffer, 0, sizeof(client->buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
@@ -462,20 +566,102 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
-static int http_server_run(struct http_server_ctx *ctx)
+static void add_client(struct http_server_worker *worker, int new_socket)
+{
+	int j;
+
+	for (j = worker->listen_fds; j < worker->listen_fds + worker->max_clients; j++) {
+		if (worker->fds[j].fd != INVALID_SOCK) {
+			continue;
+		}
+
+		worker->fds[j].fd = new_socket;
+		worker->fds[j].events = ZSOCK_POLLIN;
+		worker->fds[j].revents = 0;
+
+		LOG_DBG("Init client #%d", j - worker->listen_fds);
+
+		init_client_ctx(&worker->clients[j - worker->listen_fds], new_socket);
+		return;
+	}
+
+	/* Cannot happen as the slot was reserved before */
+	LOG_DBG("No free slot found.");
+	atomic_dec(&worker->num_clients);
+	zsock_close(new_socket);
+}
+
+#if HTTP_SERVER_NUM_WORKERS > 1
+static void add_new_clients(struct http_server_worker *worker)
+{
+	int new_socket;
+
+	while (k_msgq_get(&worker->new_clients, &new_socket, K_NO_WAIT) == 0) {
+		add_client(worker, new_socket);
+	}
+}
+#endif
+
+/* Give a new client to the worker with the most free slots */
+static void dispatch_client(int new_socket)
+{
+	struct http_server_worker *target = NULL;
+	int free_slots, most_free = 0;
+
+	ARRAY_FOR_EACH_PTR(server_ctx.workers, worker) {
+		free_slots = worker->max_clients - (int)atomic_get(&worker->num_clients);
+		if (free_slots > most_free) {
+			most_free = free_slots;
+			target = worker;
+		}
+	}
+
+	if (target == NULL) {
+		LOG_DBG("No free slot found.");
+		zsock_close(new_socket);
+		return;
+	}
+
+	/* Only this thread takes slots, so the slot found stays free */
+	atomic_inc(&target->num_clients);
+
+	if (target == &server_ctx.workers[0]) {
+		add_client(target, new_socket);
+		return;
+	}
+
+#if HTTP_SERVER_NUM_WORKERS > 1
+	/* The queue can hold all the reserved slots, so this cannot fail */
+	(void)k_msgq_put(&target->new_clients, &new_socket, K_NO_WAIT);
+	eventfd_write(target->fds[0].fd, 1);
+#endif
+}
+
+static bool worker_stopping(struct http_server_worker *worker)
+{
+#if HTTP_SERVER_NUM_WORKERS > 1
+	if (worker != &server_ctx.workers[0]) {
+		return worker->stop;
+	}
+#endif
+
+	return true;
+}
+
+static int http_server_run(struct http_server_worker *worker)
 {
 	struct http_client_ctx *client;
 	eventfd_t value;
-	bool found_slot;
 	int new_socket;
-	int ret, i, j;
+	int ret, i;
 	int sock_error;
 	socklen_t optlen = sizeof(int);
+	int nfds = worker->listen_fds + worker->max_clients;
 
 	value = 0;
 
 	while (1) {
-		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
+		ret = zsock_poll(worker->fds, nfds, -1);
 		if (ret < 0) {
 			ret = -errno;
 			LOG_DBG("poll failed (%d)", ret);
@@ -487,36 +673,43 @@ static int http_server_run(struct http_server_ctx *ctx)
 			break;
 		}
 
-		if (ret == 1 && ctx->fds[0].revents) {
-			eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			goto closing;
+		if (worker->fds[0].revents) {
+			eventfd_read(worker->fds[0].fd, &value);
+
+			if (worker_stopping(worker)) {
+				LOG_DBG("Received stop event. exiting ..");
+				goto closing;
+			}
+
+#if HTTP_SERVER_NUM_WORKERS > 1
+			add_new_clients(worker);
+#endif
 		}
 
-		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
-			if (ctx->fds[i].fd < 0) {
+		for (i = 1; i < nfds; i++) {
+			if (worker->fds[i].fd < 0) {
 				continue;
 			}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
-				if (i >= ctx->listen_fds) {
+			if (worker->fds[i].revents & ZSOCK_POLLHUP) {
+				if (i >= worker->listen_fds) {
 					LOG_DBG("Client #%d has disconnected",
-						i - ctx->listen_fds);
+						i - worker->listen_fds);
 
-					client = &ctx->clients[i - ctx->listen_fds];
+					client = &worker->clients[i - worker->listen_fds];
 					close_client_connection(client);
 				}
 
 				continue;
 			}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLERR) {
-				(void)zsock_getsockopt(ctx->fds[i].fd, SOL_SOCKET,
+			if (worker->fds[i].revents & ZSOCK_POLLERR) {
+				(void)zsock_getsockopt(worker->fds[i].fd, SOL_SOCKET,
 						       SO_ERROR, &sock_error, &optlen);
-				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
+				LOG_DBG("Error on fd %d %d", worker->fds[i].fd, sock_error);
 
-				if (i >= ctx->listen_fds) {
-					client = &ctx->clients[i - ctx->listen_fds];
+				if (i >= worker->listen_fds) {
+					client = &worker->clients[i - worker->listen_fds];
 					close_client_connection(client);
 					continue;
 				}
@@ -527,57 +720,32 @@ static int http_server_run(struct http_server_ctx *ctx)
 
 			}
 
-			if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
+			if (!(worker->fds[i].revents & ZSOCK_POLLIN)) {
 				continue;
 			}
 
 			/* First check if we have something to accept */
-			if (i < ctx->listen_fds) {
-				new_socket = accept_new_client(ctx->fds[i].fd);
+			if (i < worker->listen_fds) {
+				new_socket = accept_new_client(worker->fds[i].fd);
 				if (new_socket < 0) {
 					ret = -errno;
 					LOG_DBG("accept: %d", ret);
 					continue;
 				}
 
-				found_slot = false;
-
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
-
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
-
-					ctx->num_clients++;
-
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
-
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds],
-							new_socket);
-					found_slot = true;
-					break;
-				}
-
-				if (!found_slot) {
-					LOG_DBG("No free slot found.");
-					zsock_close(new_socket);
-				}
-
+				dispatch_client(new_socket);
 				continue;
 			}
 
 			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
+			client = &worker->clients[i - worker->listen_fds];
 
 			ret = zsock_recv(client->fd, client->buffer + client->data_len,
 					 sizeof(client->buffer) - client->data_len, 0);
 			if (ret <= 0) {
 				if (ret == 0) {
 					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
+						i - worker->listen_fds);
 				} else {
 					ret = -errno;
 					LOG_DBG("ERROR reading from socket (%d)", ret);
@@ -614,82 +782,13 @@ static int http_server_run(struct http_server_ctx *ctx)
 
 closing:
 	/* Close all client connections and the server socket */
-	return close_all_sockets(ctx);
-}
-
-/* Compare two strings where the terminator is either "\0" or "?" */
-static int compare_strings(const char *s1, const char *s2)
-{
-	while ((*s1 && *s2) && (*s1 == *s2) && (*s1 != '?')) {
-		s1++;
-		s2++;
-	}
-
-	/* Check if both strings have reached their terminators or '?' */
-	if ((*s1 == '\0' || *s1 == '?') && (*s2 == '\0' || *s2 == '?')) {
-		return 0; /* Strings are equal */
-	}
-
-	return 1; /* Strings are not equal */
-}
-
-static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
-{
-	struct http_resource_detail *detail;
-
-	detail = (struct http_resource_detail *)resource->detail;
-
-	if (is_websocket) {
-		if (detail->type != HTTP_RESOURCE_TYPE_WEBSOCKET) {
-			return true;
-		}
-	} else {
-		if (detail->type == HTTP_RESOURCE_TYPE_WEBSOCKET) {
-			return true;
-		}
-	}
-
-	return false;
-}
-
-struct http_resource_detail *get_resource_detail(const char *path,
-						 int *path_len,
-						 bool is_websocket)
-{
-	HTTP_SERVICE_FOREACH(service) {
-		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
-			if (skip_this(resource, is_websocket)) {
-				continue;
-			}
-
-			if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
-				int ret;
-
-				ret = fnmatch(resource->resource, path, FNM_PATHNAME);
-				if (ret == 0) {
-					*path_len = strlen(resource->resource);
-					return resource->detail;
-				}
-			}
-
-			if (compare_strings(path, resource->resource) == 0) {
-				NET_DBG("Got match for %s", resource->resource);
-
-				*path_len = strlen(resource->resource);
-				return resource->detail;
-			}
-		}
-	}
-
-	NET_DBG("No match for %s", path);
-
-	return NULL;
+	return close_all_sockets(worker);
 }
 
-int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len)
+static int sendall(struct http_client_ctx *client, const void *buf, size_t len, int flags)
 {
 	while (len) {
-		ssize_t out_len = zsock_send(client->fd, buf, len, 0);
+		ssize_t out_len = zsock_send(client->fd, buf, len, flags);
 
 		if (out_len < 0) {
 			return -errno;
@@ -704,6 +803,19 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len)
+{
+	return sendall(client, buf, len, 0);
+}
+
+/* For the data followed right away by more data, so that a TLS socket can
+ * send both in the same record.
+ */
+int http_server_sendall_more(struct http_client_ctx *client, const void *buf, size_t len)
+{
+	return sendall(client, buf, len, ZSOCK_MSG_MORE);
+}
+
 int http_server_start(void)
 {
 	if (server_running) {
@@ -728,13 +840,97 @@ int http_server_stop(void)
 
 	server_running = false;
 	k_sem_reset(&server_start);
-	eventfd_write(server_ctx.fds[0].fd, 1);
+	eventfd_write(server_ctx.workers[0].fds[0].fd, 1);
 
 	LOG_DBG("Stopping HTTP server");
 
 	return 0;
 }
 
+#if HTTP_SERVER_NUM_WORKERS > 1
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, HTTP_SERVER_NUM_WORKERS - 1,
+				   CONFIG_HTTP_SERVER_STACK_SIZE);
+static struct k_thread worker_threads[HTTP_SERVER_NUM_WORKERS - 1];
+
+static void http_server_worker_thread(void *p1, void *p2, void *p3)
+{
+	struct http_server_worker *worker = p1;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&worker->start, K_FOREVER);
+
+		ret = http_server_run(worker);
+		if (!worker->stop) {
+			/* Have the first worker restart the whole server */
+			LOG_DBG("Worker stopped (%d)", ret);
+			eventfd_write(server_ctx.workers[0].fds[0].fd, 1);
+		}
+
+		k_sem_give(&worker->stopped);
+	}
+}
+
+static void workers_create(void)
+{
+	char name[sizeof("http_server_w8")];
+
+	ARRAY_FOR_EACH_PTR(server_ctx.workers, worker) {
+		k_msgq_init(&worker->new_clients, (char *)worker->new_clients_buf,
+			    sizeof(worker->new_clients_buf[0]),
+			    ARRAY_SIZE(worker->new_clients_buf));
+		k_sem_init(&worker->start, 0, 1);
+		k_sem_init(&worker->stopped, 0, 1);
+	}
+
+	for (int i = 1; i < HTTP_SERVER_NUM_WORKERS; i++) {
+		k_thread_create(&worker_threads[i - 1], worker_stacks[i - 1],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i - 1]),
+				http_server_worker_thread, &server_ctx.workers[i], NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+
+		snprintk(name, sizeof(name), "http_server_w%d", i);
+		k_thread_name_set(&worker_threads[i - 1], name);
+	}
+}
+
+static void workers_start(void)
+{
+	for (int i = 1; i < HTTP_SERVER_NUM_WORKERS; i++) {
+		k_sem_give(&server_ctx.workers[i].start);
+	}
+}
+
+static void workers_stop(void)
+{
+	struct http_server_worker *worker;
+	int fd;
+
+	for (int i = 1; i < HTTP_SERVER_NUM_WORKERS; i++) {
+		worker = &server_ctx.workers[i];
+
+		worker->stop = true;
+		eventfd_write(worker->fds[0].fd, 1);
+		k_sem_take(&worker->stopped, K_FOREVER);
+
+		/* Sockets not closed yet if the worker stopped on an error */
+		(void)close_all_sockets(worker);
+
+		/* Sockets handed over but never picked up */
+		while (k_msgq_get(&worker->new_clients, &fd, K_NO_WAIT) == 0) {
+			zsock_close(fd);
+		}
+	}
+}
+#else
+static void workers_create(void) {}
+static void workers_start(void) {}
+static void workers_stop(void) {}
+#endif
+
 static void http_server_thread(void *p1, void *p2, void *p3)
 {
 	int ret;
@@ -743,6 +939,8 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+	workers_create();
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
@@ -753,7 +951,15 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 				return;
 			}
 
-			ret = http_server_run(&server_ctx);
+			workers_start();
+			ret = http_server_run(&server_ctx.workers[0]);
+			workers_stop();
+
+			ARRAY_FOR_EACH_PTR(server_ctx.workers, worker) {
+				zsock_close(worker->fds[0].fd); /* close eventfd */
+				worker->fds[0].fd = INVALID_SOCK;
+			}
+
 			if (server_running) {
 				LOG_INF("Re-starting server (%d)", ret);
 			}
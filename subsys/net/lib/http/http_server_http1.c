@@ -68,8 +68,8 @@ static int handle_http1_static_resource(
 				 len);
 		}
 
-		ret = http_server_sendall(client, http_response,
-					  strlen(http_response));
+		ret = http_server_sendall_more(client, http_response,
+					       strlen(http_response));
 		if (ret < 0) {
 			return ret;
 		}
@@ -83,6 +83,141 @@ static int handle_http1_static_resource(
 	return 0;
 }
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+static const char *static_fs_status_text(enum http_status status)
+{
+	switch (status) {
+	case HTTP_200_OK:
+		return "OK";
+	case HTTP_206_PARTIAL_CONTENT:
+		return "Partial Content";
+	case HTTP_304_NOT_MODIFIED:
+		return "Not Modified";
+	case HTTP_416_RANGE_NOT_SATISFIABLE:
+		return "Range Not Satisfiable";
+	case HTTP_500_INTERNAL_SERVER_ERROR:
+		return "Internal Server Error";
+	default:
+		return "Not Found";
+	}
+}
+
+static int handle_http1_static_fs_resource(
+	struct http_resource_detail_static_fs *static_fs_detail,
+	struct http_client_ctx *client)
+{
+	static const char not_found_response[] =
+		"HTTP/1.1 404 Not Found\r\n"
+		"Content-Length: 9\r\n\r\n"
+		"Not Found";
+	static const char internal_error_response[] =
+		"HTTP/1.1 500 Internal Server Error\r\n"
+		"Content-Length: 0\r\n\r\n";
+	char buf[CONFIG_HTTP_SERVER_STATIC_FS_BUFFER_SIZE];
+	char content_range[sizeof("bytes -/") + 3 * sizeof("18446744073709551615")];
+	struct http_fs_response rsp;
+	int len;
+	int ret;
+
+	if (!(BIT(client->method) & static_fs_detail->common.bitmask_of_supported_http_methods) ||
+	    (client->method != HTTP_GET && client->method != HTTP_HEAD)) {
+		LOG_DBG("HTTP method %s (%d) not supported.",
+			http_method_str(client->method),
+			client->method);
+
+		return -ENOTSUP;
+	}
+
+	ret = http_server_fs_open(client, static_fs_detail, &rsp, buf, sizeof(buf));
+	if (ret < 0) {
+		goto out;
+	}
+
+	if (rsp.status == HTTP_404_NOT_FOUND) {
+		ret = http_server_sendall(client, not_found_response,
+					  sizeof(not_found_response) - 1);
+		goto out;
+	}
+
+	if (rsp.status == HTTP_500_INTERNAL_SERVER_ERROR) {
+		ret = http_server_sendall(client, internal_error_response,
+					  sizeof(internal_error_response) - 1);
+		goto out;
+	}
+
+	/* The buffer is large enough for all the headers, see the range of
+	 * CONFIG_HTTP_SERVER_STATIC_FS_BUFFER_SIZE.
+	 */
+	len = snprintk(buf, sizeof(buf),
+		       "HTTP/1.1 %d %s\r\n"
+		       "Accept-Ranges: bytes\r\n"
+		       "Vary: Accept-Encoding\r\n",
+		       rsp.status, static_fs_status_text(rsp.status));
+
+	/* The entity tag is not known before the file was sent once */
+	if (rsp.etag[0] != '\0') {
+		len += snprintk(&buf[len], sizeof(buf) - len, "ETag: %s\r\n", rsp.etag);
+	}
+
+	if (http_server_fs_content_range(&rsp, content_range, sizeof(content_range)) > 0) {
+		len += snprintk(&buf[len], sizeof(buf) - len,
+				"Content-Range: %s\r\n", content_range);
+	}
+
+	if (rsp.status != HTTP_304_NOT_MODIFIED) {
+		len += snprintk(&buf[len], sizeof(buf) - len,
+				"Content-Type: %.*s\r\n"
+				"Content-Length: %zu\r\n",
+				HTTP_SERVER_MAX_CONTENT_TYPE_LEN, rsp.content_type, rsp.len);
+	}
+
+	if (rsp.content_encoding != NULL && rsp.status != HTTP_416_RANGE_NOT_SATISFIABLE) {
+		len += snprintk(&buf[len], sizeof(buf) - len,
+				"Content-Encoding: %s\r\n", rsp.content_encoding);
+	}
+
+	len += snprintk(&buf[len], sizeof(buf) - len, "\r\n");
+	if (len >= sizeof(buf)) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	if (client->method == HTTP_HEAD || rsp.len == 0) {
+		ret = http_server_sendall(client, buf, len);
+		goto out;
+	}
+
+	ret = http_server_sendall_more(client, buf, len);
+	if (ret < 0) {
+		goto out;
+	}
+
+	/* The file is sent in chunks, so that it is never entirely in RAM */
+	while (rsp.len > 0) {
+		ret = http_server_fs_read(&rsp, buf, sizeof(buf));
+		if (ret < 0) {
+			LOG_DBG("Cannot read file (%d)", ret);
+			goto out;
+		}
+
+		if (rsp.len > 0) {
+			ret = http_server_sendall_more(client, buf, ret);
+		} else {
+			ret = http_server_sendall(client, buf, ret);
+		}
+
+		if (ret < 0) {
+			goto out;
+		}
+	}
+
+out:
+	http_server_fs_close(&rsp);
+
+	return ret;
+}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS */
+
 #define RESPONSE_TEMPLATE_CHUNKED			\
 	"HTTP/1.1 200 OK\r\n"				\
 	"%s%s\r\n"					\
@@ -145,14 +280,14 @@ static int dynamic_get_req(struct http_resource_detail_dynamic *dynamic_detail,
 					      copy_len, dynamic_detail->user_data);
 		if (send_len > 0) {
 			ret = snprintk(tmp, sizeof(tmp), "%x\r\n", send_len);
-			ret = http_server_sendall(client, tmp, ret);
+			ret = http_server_sendall_more(client, tmp, ret);
 			if (ret < 0) {
 				return ret;
 			}
 
-			ret = http_server_sendall(client,
-						  dynamic_detail->data_buffer,
-						  send_len);
+			ret = http_server_sendall_more(client,
+						       dynamic_detail->data_buffer,
+						       send_len);
 			if (ret < 0) {
 				return ret;
 			}
@@ -223,14 +358,14 @@ static int dynamic_post_req(struct http_resource_detail_dynamic *dynamic_detail,
 					      copy_len, dynamic_detail->user_data);
 		if (send_len > 0) {
 			ret = snprintk(tmp, sizeof(tmp), "%x\r\n", send_len);
-			ret = http_server_sendall(client, tmp, ret);
+			ret = http_server_sendall_more(client, tmp, ret);
 			if (ret < 0) {
 				return ret;
 			}
 
-			ret = http_server_sendall(client,
-						  dynamic_detail->data_buffer,
-						  send_len);
+			ret = http_server_sendall_more(client,
+						       dynamic_detail->data_buffer,
+						       send_len);
 			if (ret < 0) {
 				return ret;
 			}
@@ -273,7 +408,7 @@ static int handle_http1_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_resource_take(dynamic_detail, client)) {
 		static const char conflict_response[] =
 				"HTTP/1.1 409 Conflict\r\n\r\n";
 
@@ -287,8 +422,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -362,6 +495,10 @@ static int on_header_field(struct http_parser *parser, const char *at,
 				ctx->websocket_sec_key_next = true;
 			}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+			ctx->fs_header_next = http_server_fs_header_id(ctx->header_buffer, offset);
+#endif
+
 			ctx->header_buffer[0] = '\0';
 		}
 	}
@@ -410,6 +547,14 @@ static int on_header_value(struct http_parser *parser,
 				ctx->websocket_sec_key_next = false;
 			}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+			if (ctx->fs_header_next != HTTP_FS_HEADER_NONE) {
+				http_server_fs_header_value(ctx, ctx->fs_header_next,
+							    ctx->header_buffer, offset);
+				ctx->fs_header_next = HTTP_FS_HEADER_NONE;
+			}
+#endif
+
 			ctx->header_buffer[0] = '\0';
 		}
 	}
@@ -490,6 +635,10 @@ int enter_http1_request(struct http_client_ctx *client)
 
 	memset(client->header_buffer, 0, sizeof(client->header_buffer));
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	http_server_fs_request_init(client);
+#endif
+
 	return 0;
 }
 
@@ -612,6 +761,15 @@ upgrade_not_found:
 			if (ret < 0) {
 				return ret;
 			}
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+		} else if (detail->type == HTTP_RESOURCE_TYPE_STATIC_FS) {
+			ret = handle_http1_static_fs_resource(
+				(struct http_resource_detail_static_fs *)detail,
+				client);
+			if (ret < 0) {
+				return ret;
+			}
+#endif
 		}
 	} else {
 not_found: ; /* Add extra semicolon to make clang to compile when using label */
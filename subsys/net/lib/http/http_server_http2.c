@@ -97,6 +97,8 @@ static struct http_stream_ctx *allocate_http_stream_context(
 			client->streams[i].stream_state = HTTP_SERVER_STREAM_OPEN;
 			client->streams[i].window_size =
 				HTTP_SERVER_INITIAL_WINDOW_SIZE;
+			client->streams[i].tx_window_size =
+				client->tx_initial_window_size;
 			return &client->streams[i];
 		}
 	}
@@ -109,6 +111,16 @@ static void release_http_stream_context(struct http_client_ctx *client,
 {
 	ARRAY_FOR_EACH(client->streams, i) {
 		if (client->streams[i].stream_id == stream_id) {
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+			if (client->streams[i].fs_pending) {
+				/* The response is still being sent, the context
+				 * is released once it is complete.
+				 */
+				client->streams[i].stream_state =
+					HTTP_SERVER_STREAM_HALF_CLOSED_REMOTE;
+				break;
+			}
+#endif
 			client->streams[i].stream_id = 0;
 			client->streams[i].stream_state = HTTP_SERVER_STREAM_IDLE;
 			break;
@@ -205,14 +217,30 @@ static int send_data_frame(struct http_client_ctx *client, const char *payload,
 			   size_t length, uint32_t stream_id, uint8_t flags)
 {
 	uint8_t frame_header[HTTP_SERVER_FRAME_HEADER_SIZE];
+	struct http_stream_ctx *stream;
 	int ret;
 
+	/* Only the file system resources wait for the peer to open its
+	 * window, the other responses are short enough to be sent at once.
+	 */
+	stream = find_http_stream_context(client, stream_id);
+	if (stream != NULL) {
+		stream->tx_window_size -= length;
+	}
+
+	client->tx_window_size -= length;
+
 	encode_frame_header(frame_header, length, HTTP_SERVER_DATA_FRAME,
 			    end_stream_flag(flags) ?
 			    HTTP_SERVER_FLAG_END_STREAM : 0,
 			    stream_id);
 
-	ret = http_server_sendall(client, frame_header, sizeof(frame_header));
+	if (payload != NULL && length > 0) {
+		ret = http_server_sendall_more(client, frame_header, sizeof(frame_header));
+	} else {
+		ret = http_server_sendall(client, frame_header, sizeof(frame_header));
+	}
+
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
 	} else {
@@ -342,6 +370,23 @@ static int send_http2_409(struct http_client_ctx *client,
 	return ret;
 }
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+static int send_http2_500(struct http_client_ctx *client,
+			  struct http_frame *frame)
+{
+	int ret;
+
+	ret = send_headers_frame(client, HTTP_500_INTERNAL_SERVER_ERROR,
+				 frame->stream_identifier, NULL,
+				 HTTP_SERVER_FLAG_END_STREAM);
+	if (ret < 0) {
+		LOG_DBG("Cannot write to socket (%d)", ret);
+	}
+
+	return ret;
+}
+#endif
+
 static int handle_http2_static_resource(
 	struct http_resource_detail_static *static_detail,
 	struct http_frame *frame, struct http_client_ctx *client)
@@ -376,6 +421,240 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+static int send_static_fs_headers_frame(struct http_client_ctx *client,
+					struct http_fs_response *rsp,
+					uint32_t stream_id, uint8_t flags,
+					uint8_t *headers_frame, size_t size)
+{
+	uint8_t *buf = headers_frame + HTTP_SERVER_FRAME_HEADER_SIZE;
+	size_t buflen = size - HTTP_SERVER_FRAME_HEADER_SIZE;
+	char content_range[sizeof("bytes -/") + 3 * sizeof("18446744073709551615")];
+	char content_length[sizeof("18446744073709551615")];
+	char status_str[4];
+	size_t payload_len;
+	int ret;
+
+	snprintk(status_str, sizeof(status_str), "%d", rsp->status);
+
+	ret = add_header_field(client, &buf, &buflen, ":status", status_str);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The entity tag is not known before the file was sent once */
+	if (rsp->etag[0] != '\0') {
+		ret = add_header_field(client, &buf, &buflen, "etag", rsp->etag);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	ret = add_header_field(client, &buf, &buflen, "accept-ranges", "bytes");
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = add_header_field(client, &buf, &buflen, "vary", "accept-encoding");
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (http_server_fs_content_range(rsp, content_range, sizeof(content_range)) > 0) {
+		ret = add_header_field(client, &buf, &buflen, "content-range",
+				       content_range);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (rsp->status != HTTP_304_NOT_MODIFIED) {
+		snprintk(content_length, sizeof(content_length), "%zu", rsp->len);
+
+		ret = add_header_field(client, &buf, &buflen, "content-type",
+				       rsp->content_type);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = add_header_field(client, &buf, &buflen, "content-length",
+				       content_length);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (rsp->content_encoding != NULL && rsp->status != HTTP_416_RANGE_NOT_SATISFIABLE) {
+		ret = add_header_field(client, &buf, &buflen, "content-encoding",
+				       rsp->content_encoding);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	payload_len = size - buflen - HTTP_SERVER_FRAME_HEADER_SIZE;
+	flags |= HTTP_SERVER_FLAG_END_HEADERS;
+
+	encode_frame_header(headers_frame, payload_len, HTTP_SERVER_HEADERS_FRAME,
+			    flags, stream_id);
+
+	ret = http_server_sendall(client, headers_frame,
+				  payload_len + HTTP_SERVER_FRAME_HEADER_SIZE);
+	if (ret < 0) {
+		LOG_DBG("Cannot write to socket (%d)", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+/* Send the file of a stream as long as the peer windows allow it. The DATA
+ * frames are at most as long as the buffer, which is less than the smallest
+ * SETTINGS_MAX_FRAME_SIZE allowed.
+ */
+static int send_static_fs_data(struct http_client_ctx *client,
+			       struct http_stream_ctx *stream,
+			       char *buf, size_t buflen)
+{
+	struct http_fs_response *rsp = &stream->fs_rsp;
+	int window;
+	int ret;
+
+	while (rsp->len > 0) {
+		window = MIN(client->tx_window_size, stream->tx_window_size);
+		if (window <= 0) {
+			LOG_DBG("Stream %d waits for a window update", stream->stream_id);
+			return 0;
+		}
+
+		ret = http_server_fs_read(rsp, buf, MIN(buflen, window));
+		if (ret < 0) {
+			LOG_DBG("Cannot read file (%d)", ret);
+			return ret;
+		}
+
+		ret = send_data_frame(client, buf, ret, stream->stream_id,
+				      rsp->len == 0 ? HTTP_SERVER_FLAG_END_STREAM : 0);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int resume_static_fs_stream(struct http_client_ctx *client,
+				   struct http_stream_ctx *stream,
+				   char *buf, size_t buflen)
+{
+	int ret;
+
+	ret = send_static_fs_data(client, stream, buf, buflen);
+	if (ret < 0 || stream->fs_rsp.len == 0) {
+		http_server_fs_close(&stream->fs_rsp);
+		stream->fs_pending = false;
+
+		if (stream->stream_state == HTTP_SERVER_STREAM_HALF_CLOSED_REMOTE) {
+			release_http_stream_context(client, stream->stream_id);
+		}
+	}
+
+	return ret;
+}
+
+/* Called when the peer windows may have been opened */
+static int resume_static_fs_streams(struct http_client_ctx *client)
+{
+	char buf[CONFIG_HTTP_SERVER_STATIC_FS_BUFFER_SIZE];
+	int ret;
+
+	ARRAY_FOR_EACH_PTR(client->streams, stream) {
+		if (client->tx_window_size <= 0) {
+			break;
+		}
+
+		if (!stream->fs_pending) {
+			continue;
+		}
+
+		ret = resume_static_fs_stream(client, stream, buf, sizeof(buf));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int handle_http2_static_fs_resource(
+	struct http_resource_detail_static_fs *static_fs_detail,
+	struct http_frame *frame, struct http_client_ctx *client)
+{
+	char buf[CONFIG_HTTP_SERVER_STATIC_FS_BUFFER_SIZE];
+	struct http_stream_ctx *stream;
+	struct http_fs_response *rsp;
+	int ret;
+
+	if (!(static_fs_detail->common.bitmask_of_supported_http_methods & BIT(HTTP_GET)) ||
+	    client->method != HTTP_GET) {
+		return -ENOTSUP;
+	}
+
+	/* The file may not be sent at once, so it is kept in the stream
+	 * context, which the request sent before an upgrade to HTTP/2 has not.
+	 */
+	stream = find_http_stream_context(client, frame->stream_identifier);
+	if (stream == NULL) {
+		stream = allocate_http_stream_context(client, frame->stream_identifier);
+		if (stream == NULL) {
+			LOG_DBG("No available stream slots. Connection closed.");
+			return -ENOMEM;
+		}
+	}
+
+	if (stream->fs_pending) {
+		LOG_DBG("Stream %d already has a response", stream->stream_id);
+		return -EBADMSG;
+	}
+
+	rsp = &stream->fs_rsp;
+
+	ret = http_server_fs_open(client, static_fs_detail, rsp, buf, sizeof(buf));
+	if (ret < 0) {
+		goto out;
+	}
+
+	if (rsp->status == HTTP_404_NOT_FOUND) {
+		ret = send_http2_404(client, frame);
+		goto out;
+	}
+
+	if (rsp->status == HTTP_500_INTERNAL_SERVER_ERROR) {
+		ret = send_http2_500(client, frame);
+		goto out;
+	}
+
+	ret = send_static_fs_headers_frame(client, rsp, frame->stream_identifier,
+					   rsp->len == 0 ? HTTP_SERVER_FLAG_END_STREAM : 0,
+					   (uint8_t *)buf, sizeof(buf));
+	if (ret < 0 || rsp->len == 0) {
+		goto out;
+	}
+
+	/* The file is sent in chunks, so that it is never entirely in RAM,
+	 * the rest of it when the peer sends WINDOW_UPDATE frames.
+	 */
+	stream->fs_pending = true;
+
+	return resume_static_fs_stream(client, stream, buf, sizeof(buf));
+
+out:
+	http_server_fs_close(rsp);
+
+	return ret;
+}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS */
+
 static int dynamic_get_req_v2(struct http_resource_detail_dynamic *dynamic_detail,
 			      struct http_client_ctx *client)
 {
@@ -561,7 +840,7 @@ static int handle_http2_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_resource_take(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -570,8 +849,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 		if (user_method & BIT(HTTP_GET)) {
@@ -684,6 +961,10 @@ static int enter_http_frame_headers_state(struct http_client_ctx *client)
 
 	client->server_state = HTTP_SERVER_FRAME_HEADERS_STATE;
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	http_server_fs_request_init(client);
+#endif
+
 	return 0;
 }
 
@@ -838,7 +1119,15 @@ int handle_http1_to_http2_upgrade(struct http_client_ctx *client)
 					goto error;
 				}
 			}
-
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+		} else if (detail->type == HTTP_RESOURCE_TYPE_STATIC_FS) {
+			ret = handle_http2_static_fs_resource(
+				(struct http_resource_detail_static_fs *)detail,
+				frame, client);
+			if (ret < 0) {
+				goto error;
+			}
+#endif
 		}
 	} else {
 		ret = send_http2_404(client, frame);
@@ -851,6 +1140,8 @@ int handle_http1_to_http2_upgrade(struct http_client_ctx *client)
 	 * to HTTP2.
 	 */
 	if (client->parser_state == HTTP1_MESSAGE_COMPLETE_STATE) {
+		release_http_stream_context(client, frame->stream_identifier);
+
 		client->current_detail = NULL;
 		client->server_state = HTTP_SERVER_PREFACE_STATE;
 		client->cursor += client->data_len;
@@ -972,6 +1263,17 @@ static int process_header(struct http_client_ctx *client,
 
 		client->content_len = (size_t)len;
 	} else {
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+		enum http_fs_header fs_header =
+			http_server_fs_header_id(header->name, header->name_len);
+
+		if (fs_header != HTTP_FS_HEADER_NONE) {
+			http_server_fs_header_value(client, fs_header, header->value,
+						    header->value_len);
+			return 0;
+		}
+#endif
+
 		/* Just ignore for now. */
 		LOG_DBG("Ignoring field %.*s", (int)header->name_len, header->name);
 	}
@@ -1044,6 +1346,15 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 			if (ret < 0) {
 				return ret;
 			}
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+		} else if (detail->type == HTTP_RESOURCE_TYPE_STATIC_FS) {
+			ret = handle_http2_static_fs_resource(
+				(struct http_resource_detail_static_fs *)detail,
+				frame, client);
+			if (ret < 0) {
+				return ret;
+			}
+#endif
 		}
 
 	} else {
@@ -1087,6 +1398,7 @@ int handle_http_frame_priority(struct http_client_ctx *client)
 int handle_http_frame_rst_frame(struct http_client_ctx *client)
 {
 	struct http_frame *frame = &client->current_frame;
+	struct http_stream_ctx *stream;
 	int bytes_consumed;
 
 	LOG_DBG("FRAME_RST_STREAM");
@@ -1101,11 +1413,54 @@ int handle_http_frame_rst_frame(struct http_client_ctx *client)
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
 
+	stream = find_http_stream_context(client, frame->stream_identifier);
+	if (stream != NULL) {
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+		if (stream->fs_pending) {
+			http_server_fs_close(&stream->fs_rsp);
+			stream->fs_pending = false;
+		}
+#endif
+		release_http_stream_context(client, frame->stream_identifier);
+	}
+
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
 
 	return 0;
 }
 
+/* Apply a new SETTINGS_INITIAL_WINDOW_SIZE to the windows of the open
+ * streams (RFC 9113, section 6.9.2).
+ */
+static int set_tx_initial_window_size(struct http_client_ctx *client, uint32_t value)
+{
+	int32_t delta;
+
+	if (value > INT32_MAX) {
+		LOG_DBG("Invalid initial window size %u", value);
+		return -EBADMSG;
+	}
+
+	delta = (int32_t)value - client->tx_initial_window_size;
+
+	ARRAY_FOR_EACH_PTR(client->streams, stream) {
+		if (stream->stream_state == HTTP_SERVER_STREAM_IDLE) {
+			continue;
+		}
+
+		if ((int64_t)stream->tx_window_size + delta > INT32_MAX) {
+			LOG_DBG("Stream %d window overflow", stream->stream_id);
+			return -EBADMSG;
+		}
+
+		stream->tx_window_size += delta;
+	}
+
+	client->tx_initial_window_size = value;
+
+	return 0;
+}
+
 int handle_http_frame_settings(struct http_client_ctx *client)
 {
 	struct http_frame *frame = &client->current_frame;
@@ -1119,13 +1474,27 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
-	bytes_consumed = client->current_frame.length;
-	client->data_len -= bytes_consumed;
-	client->cursor += bytes_consumed;
+	if (frame->length % sizeof(struct http_settings_field) != 0) {
+		LOG_DBG("Invalid SETTINGS frame length %u", frame->length);
+		return -EBADMSG;
+	}
 
 	if (!settings_ack_flag(frame->flags)) {
 		int ret;
 
+		for (uint32_t i = 0; i < frame->length;
+		     i += sizeof(struct http_settings_field)) {
+			uint16_t id = sys_get_be16(client->cursor + i);
+			uint32_t value = sys_get_be32(client->cursor + i + sizeof(uint16_t));
+
+			if (id == HTTP_SETTINGS_INITIAL_WINDOW_SIZE) {
+				ret = set_tx_initial_window_size(client, value);
+				if (ret < 0) {
+					return ret;
+				}
+			}
+		}
+
 		ret = send_settings_frame(client, true);
 		if (ret < 0) {
 			LOG_DBG("Cannot write to socket (%d)", ret);
@@ -1133,9 +1502,17 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		}
 	}
 
+	bytes_consumed = client->current_frame.length;
+	client->data_len -= bytes_consumed;
+	client->cursor += bytes_consumed;
+
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	return resume_static_fs_streams(client);
+#else
 	return 0;
+#endif
 }
 
 int handle_http_frame_goaway(struct http_client_ctx *client)
@@ -1163,25 +1540,58 @@ int handle_http_frame_goaway(struct http_client_ctx *client)
 int handle_http_frame_window_update(struct http_client_ctx *client)
 {
 	struct http_frame *frame = &client->current_frame;
-	int bytes_consumed;
+	struct http_stream_ctx *stream;
+	uint32_t increment;
+	int *window;
 
 	LOG_DBG("HTTP_SERVER_FRAME_WINDOW_UPDATE");
 
 	print_http_frames(client);
 
-	/* TODO Implement flow control, for now just ignore. */
-
 	if (client->data_len < frame->length) {
 		return -EAGAIN;
 	}
 
-	bytes_consumed = client->current_frame.length;
-	client->data_len -= bytes_consumed;
-	client->cursor += bytes_consumed;
+	if (frame->length != sizeof(uint32_t)) {
+		LOG_DBG("Invalid WINDOW_UPDATE frame length %u", frame->length);
+		return -EBADMSG;
+	}
+
+	/* The reserved bit is ignored */
+	increment = sys_get_be32(client->cursor) & 0x7FFFFFFF;
+
+	client->data_len -= frame->length;
+	client->cursor += frame->length;
 
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
 
+	if (frame->stream_identifier == 0) {
+		window = &client->tx_window_size;
+	} else {
+		stream = find_http_stream_context(client, frame->stream_identifier);
+		if (stream == NULL) {
+			/* The stream may have been closed in the meantime */
+			return 0;
+		}
+
+		window = &stream->tx_window_size;
+	}
+
+	/* These stream errors are treated as connection errors, as allowed by
+	 * RFC 9113, section 5.4.
+	 */
+	if (increment == 0 || (int64_t)*window + increment > INT32_MAX) {
+		LOG_DBG("Invalid window increment %u", increment);
+		return -EBADMSG;
+	}
+
+	*window += increment;
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS)
+	return resume_static_fs_streams(client);
+#else
 	return 0;
+#endif
 }
 
 int handle_http_frame_continuation(struct http_client_ctx *client)
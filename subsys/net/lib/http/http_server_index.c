@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/posix/fnmatch.h>
+
+LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include "headers/server_internal.h"
+
+/* Resources are found from the request path in this order:
+ *
+ * - a resource without wildcard equal to the path, the query string of the
+ *   path being ignored,
+ * - otherwise the wildcard resource with the longest fixed part matching
+ *   the path, the fixed part being what comes before the first wildcard
+ *   character.
+ *
+ * When several resources are equally good, the first one in the iteration
+ * order is used. A wildcard resource is "prefix" when its only wildcard is a trailing '*',
+ * and such a resource is matched without calling fnmatch().
+ */
+
+enum resource_match {
+	RESOURCE_MATCH_EXACT,
+	RESOURCE_MATCH_PREFIX,
+	RESOURCE_MATCH_WILDCARD,
+};
+
+static size_t resource_fixed_part(const char *resource, enum resource_match *match)
+{
+	size_t len;
+
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		/* The query string of the resource is ignored, as for the path */
+		*match = RESOURCE_MATCH_EXACT;
+		return strcspn(resource, "?");
+	}
+
+	len = strcspn(resource, "*?[");
+
+	if (resource[len] == '\0') {
+		*match = RESOURCE_MATCH_EXACT;
+	} else if (resource[len] == '*' && resource[len + 1] == '\0') {
+		*match = RESOURCE_MATCH_PREFIX;
+	} else {
+		*match = RESOURCE_MATCH_WILDCARD;
+	}
+
+	return len;
+}
+
+/* Check the part of the path after the fixed part of the resource */
+static bool resource_wildcard_match(const char *resource, enum resource_match match,
+				    const char *path, size_t fixed_len)
+{
+	if (match == RESOURCE_MATCH_PREFIX) {
+		/* As with FNM_PATHNAME, '*' does not match a '/' */
+		return strchr(path + fixed_len, '/') == NULL;
+	}
+
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		return false;
+	}
+
+	return fnmatch(resource, path, FNM_PATHNAME) == 0;
+}
+
+static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
+{
+	struct http_resource_detail *detail;
+
+	detail = (struct http_resource_detail *)resource->detail;
+
+	if (is_websocket) {
+		if (detail->type != HTTP_RESOURCE_TYPE_WEBSOCKET) {
+			return true;
+		}
+	} else {
+		if (detail->type == HTTP_RESOURCE_TYPE_WEBSOCKET) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static struct http_resource_detail *resource_found(struct http_resource_desc *resource,
+						   int *path_len)
+{
+	LOG_DBG("Got match for %s", resource->resource);
+
+	*path_len = strlen(resource->resource);
+
+	return resource->detail;
+}
+
+static struct http_resource_detail *lookup_linear(const char *path, int *path_len,
+						  bool is_websocket)
+{
+	size_t path_fixed_len = strcspn(path, "?");
+	struct http_resource_desc *best = NULL;
+	size_t best_len = 0;
+	enum resource_match match;
+	size_t len;
+
+	HTTP_SERVICE_FOREACH(service) {
+		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+			if (skip_this(resource, is_websocket)) {
+				continue;
+			}
+
+			len = resource_fixed_part(resource->resource, &match);
+
+			if (match == RESOURCE_MATCH_EXACT) {
+				if (len == path_fixed_len &&
+				    strncmp(resource->resource, path, len) == 0) {
+					return resource_found(resource, path_len);
+				}
+
+				continue;
+			}
+
+			if ((best != NULL && len <= best_len) ||
+			    strncmp(resource->resource, path, len) != 0 ||
+			    !resource_wildcard_match(resource->resource, match, path, len)) {
+				continue;
+			}
+
+			best = resource;
+			best_len = len;
+		}
+	}
+
+	if (best != NULL) {
+		return resource_found(best, path_len);
+	}
+
+	return NULL;
+}
+
+#if CONFIG_HTTP_SERVER_RESOURCE_INDEX_SIZE > 0
+
+/* The fixed parts of the resources are stored in a radix tree, the labels of
+ * the tree nodes pointing into the resource strings. The resources are
+ * attached to the node where their fixed part ends. Each new resource adds
+ * at most two nodes: one for its fixed part and one when an existing node
+ * has to be split.
+ */
+
+#define INDEX_SIZE  CONFIG_HTTP_SERVER_RESOURCE_INDEX_SIZE
+#define INDEX_NODES (2 * INDEX_SIZE + 1)
+#define INDEX_NONE  UINT16_MAX
+
+BUILD_ASSERT(INDEX_NODES < INDEX_NONE);
+
+struct index_node {
+	const char *label;
+	uint16_t label_len;
+	uint16_t parent;
+	uint16_t child;
+	uint16_t sibling;
+	/* First resource attached to this node */
+	uint16_t entry;
+};
+
+struct index_entry {
+	struct http_resource_desc *resource;
+	uint16_t fixed_len;
+	uint16_t next;
+	uint8_t match;
+};
+
+static struct index_node index_nodes[INDEX_NODES];
+static struct index_entry index_entries[INDEX_SIZE];
+static uint16_t index_node_count;
+static uint16_t index_entry_count;
+static bool index_ready;
+
+static uint16_t index_node_new(const char *label, size_t len, uint16_t parent)
+{
+	struct index_node *node = &index_nodes[index_node_count];
+
+	node->label = label;
+	node->label_len = len;
+	node->parent = parent;
+	node->child = INDEX_NONE;
+	node->sibling = INDEX_NONE;
+	node->entry = INDEX_NONE;
+
+	return index_node_count++;
+}
+
+static void index_insert(struct http_resource_desc *resource)
+{
+	struct index_entry *entry = &index_entries[index_entry_count];
+	const char *key = resource->resource;
+	enum resource_match match;
+	uint16_t node = 0;
+	uint16_t *link;
+	size_t pos = 0;
+	size_t len;
+
+	len = resource_fixed_part(key, &match);
+
+	while (pos < len) {
+		struct index_node *child;
+		uint16_t split;
+		size_t common = 0;
+
+		link = &index_nodes[node].child;
+		while (*link != INDEX_NONE && index_nodes[*link].label[0] != key[pos]) {
+			link = &index_nodes[*link].sibling;
+		}
+
+		if (*link == INDEX_NONE) {
+			*link = index_node_new(&key[pos], len - pos, node);
+			node = *link;
+			break;
+		}
+
+		child = &index_nodes[*link];
+
+		while (common < child->label_len && pos + common < len &&
+		       child->label[common] == key[pos + common]) {
+			common++;
+		}
+
+		if (common < child->label_len) {
+			/* Split the node where the key diverges from its label */
+			split = index_node_new(child->label, common, node);
+			index_nodes[split].child = *link;
+			index_nodes[split].sibling = child->sibling;
+
+			child->label += common;
+			child->label_len -= common;
+			child->parent = split;
+			child->sibling = INDEX_NONE;
+
+			*link = split;
+		}
+
+		node = *link;
+		pos += common;
+	}
+
+	entry->resource = resource;
+	entry->fixed_len = len;
+	entry->match = match;
+	entry->next = INDEX_NONE;
+
+	/* Keep the resources of a node in the iteration order */
+	link = &index_nodes[node].entry;
+	while (*link != INDEX_NONE) {
+		link = &index_entries[*link].next;
+	}
+
+	*link = index_entry_count++;
+}
+
+static struct http_resource_detail *lookup_index(const char *path, int *path_len,
+						 bool is_websocket)
+{
+	size_t path_fixed_len = strcspn(path, "?");
+	struct index_entry *entry;
+	struct index_node *child;
+	uint16_t node = 0;
+	uint16_t next;
+	size_t pos = 0;
+
+	/* Go down the tree as far as the path allows. The labels never
+	 * contain a '?', so this stops at the query string at the latest.
+	 */
+	while (pos < path_fixed_len) {
+		next = index_nodes[node].child;
+		while (next != INDEX_NONE && index_nodes[next].label[0] != path[pos]) {
+			next = index_nodes[next].sibling;
+		}
+
+		if (next == INDEX_NONE) {
+			break;
+		}
+
+		child = &index_nodes[next];
+
+		if (path_fixed_len - pos < child->label_len ||
+		    memcmp(child->label, &path[pos], child->label_len) != 0) {
+			break;
+		}
+
+		node = next;
+		pos += child->label_len;
+	}
+
+	if (pos == path_fixed_len) {
+		for (next = index_nodes[node].entry; next != INDEX_NONE; next = entry->next) {
+			entry = &index_entries[next];
+
+			if (entry->match == RESOURCE_MATCH_EXACT &&
+			    !skip_this(entry->resource, is_websocket)) {
+				return resource_found(entry->resource, path_len);
+			}
+		}
+	}
+
+	/* The fixed part of every node on the way up is a prefix of the path,
+	 * so the first wildcard resource matching the rest of the path has the
+	 * longest fixed part.
+	 */
+	while (true) {
+		for (next = index_nodes[node].entry; next != INDEX_NONE; next = entry->next) {
+			entry = &index_entries[next];
+
+			if (entry->match == RESOURCE_MATCH_EXACT ||
+			    skip_this(entry->resource, is_websocket)) {
+				continue;
+			}
+
+			if (resource_wildcard_match(entry->resource->resource, entry->match,
+						    path, entry->fixed_len)) {
+				return resource_found(entry->resource, path_len);
+			}
+		}
+
+		if (node == 0) {
+			break;
+		}
+
+		node = index_nodes[node].parent;
+	}
+
+	return NULL;
+}
+
+static int http_server_index_init(void)
+{
+	size_t count = 0;
+
+	HTTP_SERVICE_FOREACH(service) {
+		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+			count++;
+		}
+	}
+
+	if (count > INDEX_SIZE) {
+		LOG_WRN("%zu resources, only up to %d can be indexed", count, INDEX_SIZE);
+		return 0;
+	}
+
+	(void)index_node_new("", 0, INDEX_NONE);
+
+	HTTP_SERVICE_FOREACH(service) {
+		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+			index_insert(resource);
+		}
+	}
+
+	index_ready = true;
+
+	LOG_DBG("Indexed %u resources in %u nodes", index_entry_count, index_node_count);
+
+	return 0;
+}
+
+SYS_INIT(http_server_index_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#endif /* CONFIG_HTTP_SERVER_RESOURCE_INDEX_SIZE > 0 */
+
+struct http_resource_detail *get_resource_detail(const char *path,
+						 int *path_len,
+						 bool is_websocket)
+{
+	struct http_resource_detail *detail;
+
+#if CONFIG_HTTP_SERVER_RESOURCE_INDEX_SIZE > 0
+	if (index_ready) {
+		detail = lookup_index(path, path_len, is_websocket);
+	} else
+#endif
+	{
+		detail = lookup_linear(path, path_len, is_websocket);
+	}
+
+	if (detail == NULL) {
+		LOG_DBG("No match for %s", path);
+	}
+
+	return detail;
+}
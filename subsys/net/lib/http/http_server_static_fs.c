@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/sys/crc.h>
+
+LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include "headers/server_internal.h"
+
+/* Files are streamed from the file system through the buffer given by the
+ * caller, so the RAM used does not depend on the file size. The entity tag
+ * of a file is computed from its content, as the file systems do not all
+ * provide a modification time. It is computed while the whole file is sent,
+ * never by reading the file only for that, and is cached with the file size.
+ * The application invalidates the cached tag of a file it modifies.
+ */
+
+#define ACCEPT_GZIP BIT(0)
+#define ACCEPT_BR   BIT(1)
+
+#define INDEX_FILE "index.html"
+
+#define ETAG_CACHED (CONFIG_HTTP_SERVER_STATIC_FS_ETAG_CACHE_SIZE > 0)
+
+static const struct {
+	const char *suffix;
+	const char *encoding;
+	uint8_t accept;
+} variants[] = {
+	{ ".br", "br", ACCEPT_BR },
+	{ ".gz", "gzip", ACCEPT_GZIP },
+	{ "", NULL, 0 },
+};
+
+static const struct {
+	const char *extension;
+	const char *content_type;
+} content_types[] = {
+	{ "html", "text/html" },
+	{ "htm", "text/html" },
+	{ "css", "text/css" },
+	{ "js", "text/javascript" },
+	{ "json", "application/json" },
+	{ "txt", "text/plain" },
+	{ "svg", "image/svg+xml" },
+	{ "png", "image/png" },
+	{ "jpg", "image/jpeg" },
+	{ "jpeg", "image/jpeg" },
+	{ "gif", "image/gif" },
+	{ "ico", "image/x-icon" },
+	{ "wasm", "application/wasm" },
+};
+
+#if CONFIG_HTTP_SERVER_STATIC_FS_ETAG_CACHE_SIZE > 0
+struct etag_entry {
+	uint32_t path_crc;
+	uint32_t content_crc;
+	size_t size;
+};
+
+/* Empty files are not cached, so an entry with a zero size is free */
+static struct etag_entry etag_cache[CONFIG_HTTP_SERVER_STATIC_FS_ETAG_CACHE_SIZE];
+static size_t etag_next;
+/* Changed when entries are invalidated, so that a tag computed while a file
+ * was being modified is not cached.
+ */
+static uint32_t etag_generation;
+static K_MUTEX_DEFINE(etag_lock);
+
+static bool etag_cache_get(uint32_t path_crc, size_t size, uint32_t *content_crc,
+			   uint32_t *generation)
+{
+	bool found = false;
+
+	k_mutex_lock(&etag_lock, K_FOREVER);
+
+	*generation = etag_generation;
+
+	ARRAY_FOR_EACH_PTR(etag_cache, entry) {
+		if (entry->size > 0 && entry->size == size && entry->path_crc == path_crc) {
+			*content_crc = entry->content_crc;
+			found = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&etag_lock);
+
+	return found;
+}
+
+static void etag_cache_put(uint32_t path_crc, size_t size, uint32_t content_crc,
+			   uint32_t generation)
+{
+	if (size == 0) {
+		return;
+	}
+
+	k_mutex_lock(&etag_lock, K_FOREVER);
+
+	if (generation == etag_generation) {
+		etag_cache[etag_next].path_crc = path_crc;
+		etag_cache[etag_next].content_crc = content_crc;
+		etag_cache[etag_next].size = size;
+
+		etag_next = (etag_next + 1) % ARRAY_SIZE(etag_cache);
+	}
+
+	k_mutex_unlock(&etag_lock);
+}
+
+void http_server_static_fs_cache_clear(void)
+{
+	k_mutex_lock(&etag_lock, K_FOREVER);
+	memset(etag_cache, 0, sizeof(etag_cache));
+	etag_generation++;
+	k_mutex_unlock(&etag_lock);
+}
+
+void http_server_static_fs_cache_invalidate(const char *path)
+{
+	uint32_t path_crc = crc32_ieee((const uint8_t *)path, strlen(path));
+
+	k_mutex_lock(&etag_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(etag_cache, entry) {
+		if (entry->path_crc == path_crc) {
+			entry->size = 0;
+		}
+	}
+
+	etag_generation++;
+
+	k_mutex_unlock(&etag_lock);
+}
+#else
+static inline bool etag_cache_get(uint32_t path_crc, size_t size, uint32_t *content_crc,
+				  uint32_t *generation)
+{
+	return false;
+}
+
+static inline void etag_cache_put(uint32_t path_crc, size_t size, uint32_t content_crc,
+				  uint32_t generation)
+{
+}
+
+void http_server_static_fs_cache_clear(void)
+{
+}
+
+void http_server_static_fs_cache_invalidate(const char *path)
+{
+	ARG_UNUSED(path);
+}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_ETAG_CACHE_SIZE > 0 */
+
+void http_server_fs_request_init(struct http_client_ctx *client)
+{
+	client->range[0] = '\0';
+	client->if_none_match[0] = '\0';
+	client->accept_encoding = 0;
+	client->fs_header_next = HTTP_FS_HEADER_NONE;
+}
+
+enum http_fs_header http_server_fs_header_id(const char *name, size_t len)
+{
+	if (len == sizeof("accept-encoding") - 1 &&
+	    strncasecmp(name, "accept-encoding", len) == 0) {
+		return HTTP_FS_HEADER_ACCEPT_ENCODING;
+	}
+
+	if (len == sizeof("range") - 1 && strncasecmp(name, "range", len) == 0) {
+		return HTTP_FS_HEADER_RANGE;
+	}
+
+	if (len == sizeof("if-none-match") - 1 &&
+	    strncasecmp(name, "if-none-match", len) == 0) {
+		return HTTP_FS_HEADER_IF_NONE_MATCH;
+	}
+
+	return HTTP_FS_HEADER_NONE;
+}
+
+/* Check if the parameters of an Accept-Encoding item have a zero weight */
+static bool zero_weight(const char *params, const char *end)
+{
+	for (; params + 1 < end; params++) {
+		if (tolower((unsigned char)params[0]) != 'q' || params[1] != '=') {
+			continue;
+		}
+
+		for (params += 2; params < end && (*params == '0' || *params == '.'); params++) {
+		}
+
+		while (params < end && *params == ' ') {
+			params++;
+		}
+
+		return params == end;
+	}
+
+	return false;
+}
+
+static uint8_t parse_accept_encoding(const char *value, size_t len)
+{
+	const char *end = value + len;
+	const char *item_end;
+	const char *name;
+	uint8_t accept = 0;
+	size_t name_len;
+
+	while (value < end) {
+		while (value < end && (*value == ' ' || *value == ',')) {
+			value++;
+		}
+
+		name = value;
+
+		while (value < end && *value != ',' && *value != ';' && *value != ' ') {
+			value++;
+		}
+
+		name_len = value - name;
+
+		item_end = memchr(value, ',', end - value);
+		if (item_end == NULL) {
+			item_end = end;
+		}
+
+		if (name_len > 0 && !zero_weight(value, item_end)) {
+			if (name_len == sizeof("gzip") - 1 &&
+			    strncasecmp(name, "gzip", name_len) == 0) {
+				accept |= ACCEPT_GZIP;
+			} else if (name_len == sizeof("br") - 1 &&
+				   strncasecmp(name, "br", name_len) == 0) {
+				accept |= ACCEPT_BR;
+			} else if (name_len == 1 && name[0] == '*') {
+				accept |= ACCEPT_GZIP | ACCEPT_BR;
+			}
+		}
+
+		value = item_end;
+	}
+
+	return accept;
+}
+
+void http_server_fs_header_value(struct http_client_ctx *client, enum http_fs_header header,
+				 const char *value, size_t len)
+{
+	char *dst;
+
+	while (len > 0 && (value[len - 1] == ' ' || value[len - 1] == '\t')) {
+		len--;
+	}
+
+	switch (header) {
+	case HTTP_FS_HEADER_ACCEPT_ENCODING:
+		client->accept_encoding = parse_accept_encoding(value, len);
+		return;
+	case HTTP_FS_HEADER_RANGE:
+		dst = client->range;
+		break;
+	case HTTP_FS_HEADER_IF_NONE_MATCH:
+		dst = client->if_none_match;
+		break;
+	default:
+		return;
+	}
+
+	/* A truncated value would be wrongly interpreted, ignore it instead */
+	if (len > sizeof(client->range) - 1) {
+		LOG_DBG("Header value too long (%zu bytes)", len);
+		dst[0] = '\0';
+		return;
+	}
+
+	memcpy(dst, value, len);
+	dst[len] = '\0';
+}
+
+/* Put the path of the requested file in buf, and return its length */
+static int file_path(const char *root, const char *url, char *buf, size_t buf_len)
+{
+	size_t root_len = strlen(root);
+	size_t url_len = strcspn(url, "?#");
+	size_t len;
+
+	if (url[0] != '/') {
+		return -EINVAL;
+	}
+
+	/* Do not let the client go out of the root directory */
+	for (size_t i = 0; i + 2 < url_len; i++) {
+		if (url[i] == '/' && url[i + 1] == '.' && url[i + 2] == '.' &&
+		    (i + 3 == url_len || url[i + 3] == '/')) {
+			return -EINVAL;
+		}
+	}
+
+	while (root_len > 0 && root[root_len - 1] == '/') {
+		root_len--;
+	}
+
+	len = root_len + url_len;
+	if (url[url_len - 1] == '/') {
+		len += sizeof(INDEX_FILE) - 1;
+	}
+
+	/* Leave room for the suffix of the compressed variants */
+	if (len + sizeof(".gz") > buf_len) {
+		return -ENAMETOOLONG;
+	}
+
+	memcpy(buf, root, root_len);
+	memcpy(&buf[root_len], url, url_len);
+	buf[root_len + url_len] = '\0';
+
+	if (url[url_len - 1] == '/') {
+		strcat(buf, INDEX_FILE);
+	}
+
+	return len;
+}
+
+static const char *guess_content_type(const char *path)
+{
+	const char *extension = strrchr(path, '.');
+
+	if (extension == NULL || strchr(extension, '/') != NULL) {
+		return "application/octet-stream";
+	}
+
+	extension++;
+
+	ARRAY_FOR_EACH(content_types, i) {
+		if (strcasecmp(extension, content_types[i].extension) == 0) {
+			return content_types[i].content_type;
+		}
+	}
+
+	return "application/octet-stream";
+}
+
+/* The entity tag is left empty when it is not cached, it is then computed if
+ * the whole file is sent.
+ */
+static void lookup_etag(struct http_fs_response *rsp, const char *path)
+{
+	uint32_t content_crc;
+
+	rsp->path_crc = crc32_ieee((const uint8_t *)path, strlen(path));
+
+	if (etag_cache_get(rsp->path_crc, rsp->size, &content_crc, &rsp->cache_generation)) {
+		snprintk(rsp->etag, sizeof(rsp->etag), "\"%08x-%08x\"",
+			 (uint32_t)rsp->size, content_crc);
+	}
+}
+
+/* Only a single range is supported. As allowed by RFC 9110, the whole file is
+ * sent when the Range header is invalid or has several ranges.
+ */
+static int parse_range(const char *range, size_t size, size_t *offset, size_t *len)
+{
+	unsigned long first, last;
+	char *end;
+
+	if (strncmp(range, "bytes=", sizeof("bytes=") - 1) != 0) {
+		return -EINVAL;
+	}
+
+	range += sizeof("bytes=") - 1;
+
+	if (range[0] == '-') {
+		/* Last bytes of the file */
+		if (!isdigit((unsigned char)range[1])) {
+			return -EINVAL;
+		}
+
+		last = strtoul(&range[1], &end, 10);
+		if (*end != '\0') {
+			return -EINVAL;
+		}
+
+		if (last == 0 || size == 0) {
+			return -ERANGE;
+		}
+
+		*len = MIN(last, size);
+		*offset = size - *len;
+
+		return 0;
+	}
+
+	if (!isdigit((unsigned char)range[0])) {
+		return -EINVAL;
+	}
+
+	first = strtoul(range, &end, 10);
+	if (*end != '-') {
+		return -EINVAL;
+	}
+
+	range = end + 1;
+
+	if (range[0] == '\0') {
+		last = ULONG_MAX;
+	} else {
+		if (!isdigit((unsigned char)range[0])) {
+			return -EINVAL;
+		}
+
+		last = strtoul(range, &end, 10);
+		if (*end != '\0' || last < first) {
+			return -EINVAL;
+		}
+	}
+
+	if (first >= size) {
+		return -ERANGE;
+	}
+
+	last = MIN(last, size - 1);
+
+	*offset = first;
+	*len = last - first + 1;
+
+	return 0;
+}
+
+int http_server_fs_open(struct http_client_ctx *client,
+			struct http_resource_detail_static_fs *detail,
+			struct http_fs_response *rsp, char *buf, size_t buf_len)
+{
+	struct fs_dirent entry;
+	size_t variant;
+	int path_len;
+	int ret;
+
+	memset(rsp, 0, sizeof(*rsp));
+	fs_file_t_init(&rsp->file);
+	rsp->status = HTTP_404_NOT_FOUND;
+
+	path_len = file_path(detail->fs_path, (const char *)client->url_buffer, buf, buf_len);
+	if (path_len < 0) {
+		LOG_DBG("Invalid path %s (%d)", client->url_buffer, path_len);
+		return 0;
+	}
+
+	rsp->content_type = detail->common.content_type;
+	if (rsp->content_type == NULL) {
+		rsp->content_type = guess_content_type(buf);
+	}
+
+	for (variant = 0; variant < ARRAY_SIZE(variants); variant++) {
+		if (variants[variant].accept != 0 &&
+		    (client->accept_encoding & variants[variant].accept) == 0) {
+			continue;
+		}
+
+		strcpy(&buf[path_len], variants[variant].suffix);
+
+		if (fs_stat(buf, &entry) == 0 && entry.type == FS_DIR_ENTRY_FILE) {
+			break;
+		}
+	}
+
+	if (variant == ARRAY_SIZE(variants)) {
+		buf[path_len] = '\0';
+		LOG_DBG("No file %s", buf);
+		return 0;
+	}
+
+	/* The file may have been removed since fs_stat() was called, any
+	 * other error is reported as such to the client.
+	 */
+	ret = fs_open(&rsp->file, buf, FS_O_READ);
+	if (ret < 0) {
+		LOG_DBG("Cannot open %s (%d)", buf, ret);
+		rsp->status = ret == -ENOENT ? HTTP_404_NOT_FOUND :
+					       HTTP_500_INTERNAL_SERVER_ERROR;
+		return 0;
+	}
+
+	rsp->content_encoding = variants[variant].encoding;
+	rsp->size = entry.size;
+
+	lookup_etag(rsp, buf);
+
+	/* An unknown entity tag matches nothing but "*" */
+	if (client->if_none_match[0] != '\0' &&
+	    (strcmp(client->if_none_match, "*") == 0 ||
+	     (rsp->etag[0] != '\0' && strstr(client->if_none_match, rsp->etag) != NULL))) {
+		rsp->status = HTTP_304_NOT_MODIFIED;
+		return 0;
+	}
+
+	rsp->status = HTTP_200_OK;
+	rsp->len = rsp->size;
+
+	if (client->range[0] == '\0') {
+		rsp->compute_crc = ETAG_CACHED && rsp->etag[0] == '\0';
+		return 0;
+	}
+
+	ret = parse_range(client->range, rsp->size, &rsp->offset, &rsp->len);
+	if (ret == -ERANGE) {
+		rsp->status = HTTP_416_RANGE_NOT_SATISFIABLE;
+		rsp->len = 0;
+		return 0;
+	} else if (ret < 0) {
+		rsp->len = rsp->size;
+		rsp->compute_crc = ETAG_CACHED && rsp->etag[0] == '\0';
+		return 0;
+	}
+
+	rsp->status = HTTP_206_PARTIAL_CONTENT;
+
+	ret = fs_seek(&rsp->file, rsp->offset, FS_SEEK_SET);
+	if (ret < 0) {
+		LOG_DBG("Cannot seek %s (%d)", buf, ret);
+		rsp->status = HTTP_500_INTERNAL_SERVER_ERROR;
+		rsp->len = 0;
+	}
+
+	return 0;
+}
+
+int http_server_fs_content_range(const struct http_fs_response *rsp, char *buf, size_t len)
+{
+	if (rsp->status == HTTP_206_PARTIAL_CONTENT) {
+		return snprintk(buf, len, "bytes %zu-%zu/%zu", rsp->offset,
+				rsp->offset + rsp->len - 1, rsp->size);
+	}
+
+	if (rsp->status == HTTP_416_RANGE_NOT_SATISFIABLE) {
+		return snprintk(buf, len, "bytes */%zu", rsp->size);
+	}
+
+	return 0;
+}
+
+int http_server_fs_read(struct http_fs_response *rsp, void *buf, size_t len)
+{
+	ssize_t ret;
+
+	ret = fs_read(&rsp->file, buf, MIN(len, rsp->len));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (ret == 0 && rsp->len > 0) {
+		/* The file was truncated since it was opened */
+		return -EIO;
+	}
+
+	rsp->len -= ret;
+
+	if (rsp->compute_crc) {
+		rsp->content_crc = crc32_ieee_update(rsp->content_crc, buf, ret);
+
+		if (rsp->len == 0) {
+			etag_cache_put(rsp->path_crc, rsp->size, rsp->content_crc,
+				       rsp->cache_generation);
+		}
+	}
+
+	return ret;
+}
+
+void http_server_fs_close(struct http_fs_response *rsp)
+{
+	(void)fs_close(&rsp->file);
+}
@@ -25,12 +25,23 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+#if CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0
+	/* The queued messages not retired are dropped with the connection. */
+	client->internal.pub_retired = 0U;
+	client->internal.pub_head = 0U;
+	client->internal.pub_count = 0U;
+	client->internal.pub_written = 0U;
+	client->internal.pub_inflight = 0U;
+#endif
 }
 
-/** @brief Initialize tx buffer. */
+/** @brief Initialize tx buffer.
+ *
+ *  The encoders write every byte of the packet, so the buffer is not cleared.
+ */
 static void tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
 {
-	memset(client->tx_buf, 0, client->tx_buf_size);
 	buf->cur = client->tx_buf;
 	buf->end = client->tx_buf + client->tx_buf_size;
 }
@@ -49,6 +60,7 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt)
 static void client_disconnect(struct mqtt_client *client, int result,
 			      bool notify)
 {
+	uint8_t pub_dropped = 0U;
 	int err_code;
 
 	err_code = mqtt_transport_disconnect(client);
@@ -56,12 +68,21 @@ static void client_disconnect(struct mqtt_client *client, int result,
 		NET_ERR("Failed to disconnect transport!");
 	}
 
+#if CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0
+	pub_dropped = client->internal.pub_count;
+	if (pub_dropped > 0U) {
+		NET_WARN("[CID %p]: Dropping %u queued messages", client,
+			 pub_dropped);
+	}
+#endif
+
 	/* Reset internal state. */
 	client_reset(client);
 
 	if (notify) {
 		struct mqtt_evt evt = {
 			.type = MQTT_EVT_DISCONNECT,
+			.param.disconnect.pub_dropped = pub_dropped,
 			.result = result,
 		};
 
@@ -287,6 +308,226 @@ error:
 	return err_code;
 }
 
+#if CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0
+/* Number of messages written with a single sendmsg() call. */
+#define PUBLISH_QUEUE_BATCH MIN(CONFIG_MQTT_PUBLISH_QUEUE_SIZE, 8)
+
+/* The publish queue is a ring of pub_count messages starting at pub_head,
+ * the first pub_written of them being already written. Messages are
+ * positioned relative to pub_head.
+ */
+static uint8_t publish_queue_index(const struct mqtt_client *client,
+				   uint8_t pos)
+{
+	return (client->internal.pub_head + pos) %
+	       CONFIG_MQTT_PUBLISH_QUEUE_SIZE;
+}
+
+/* Release the slots of the oldest messages once they are retired. The
+ * broker acknowledges the messages in order, but QoS 0 messages are retired
+ * as soon as they are written, possibly before older QoS 1 or 2 ones.
+ */
+static void publish_queue_retire(struct mqtt_client *client, uint8_t pos)
+{
+	struct mqtt_internal *internal = &client->internal;
+
+	internal->pub_retired |= BIT(publish_queue_index(client, pos));
+
+	while ((internal->pub_written > 0U) &&
+	       (internal->pub_retired & BIT(internal->pub_head))) {
+		internal->pub_retired &= ~BIT(internal->pub_head);
+		internal->pub_head = publish_queue_index(client, 1U);
+		internal->pub_count--;
+		internal->pub_written--;
+	}
+}
+
+static int publish_queue_write(struct mqtt_client *client)
+{
+	struct mqtt_internal *internal = &client->internal;
+	struct iovec io_vector[2 * PUBLISH_QUEUE_BATCH];
+	const struct mqtt_publish_param *param;
+	struct buf_ctx packet;
+	struct msghdr msg;
+	uint8_t inflight;
+	uint8_t batch;
+	int err_code;
+
+	while (internal->pub_written < internal->pub_count) {
+		packet.cur = client->tx_buf;
+		inflight = internal->pub_inflight;
+		batch = 0U;
+
+		/* Encode the headers one after the other in the TX buffer,
+		 * keeping the messages in order.
+		 */
+		while ((batch < PUBLISH_QUEUE_BATCH) &&
+		       (internal->pub_written + batch < internal->pub_count)) {
+			param = &internal->pub_queue[publish_queue_index(
+					client, internal->pub_written + batch)];
+
+			if ((param->message.topic.qos != MQTT_QOS_0_AT_MOST_ONCE) &&
+			    (inflight >= CONFIG_MQTT_PUBLISH_QUEUE_INFLIGHT)) {
+				break;
+			}
+
+			packet.end = client->tx_buf + client->tx_buf_size;
+
+			if (publish_encode(param, &packet) < 0) {
+				/* No room left in the TX buffer. */
+				break;
+			}
+
+			if (param->message.topic.qos != MQTT_QOS_0_AT_MOST_ONCE) {
+				inflight++;
+			}
+
+			io_vector[2 * batch].iov_base = packet.cur;
+			io_vector[2 * batch].iov_len = packet.end - packet.cur;
+			io_vector[2 * batch + 1].iov_base =
+						param->message.payload.data;
+			io_vector[2 * batch + 1].iov_len =
+						param->message.payload.len;
+
+			packet.cur = packet.end;
+			batch++;
+		}
+
+		if (batch == 0U) {
+			break;
+		}
+
+		memset(&msg, 0, sizeof(msg));
+
+		msg.msg_iov = io_vector;
+		msg.msg_iovlen = 2 * batch;
+
+		NET_DBG("[CID %p]: Writing %u queued messages", client, batch);
+
+		err_code = client_write_msg(client, &msg);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		while (batch-- > 0U) {
+			param = &internal->pub_queue[publish_queue_index(
+					client, internal->pub_written)];
+
+			internal->pub_written++;
+
+			if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+				publish_queue_retire(client,
+						     internal->pub_written - 1U);
+			} else {
+				internal->pub_inflight++;
+			}
+		}
+	}
+
+	return 0;
+}
+
+void mqtt_publish_queue_ack(struct mqtt_client *client, uint8_t qos,
+			    uint16_t message_id)
+{
+	struct mqtt_internal *internal = &client->internal;
+	const struct mqtt_publish_param *param;
+	uint8_t index;
+
+	for (uint8_t pos = 0U; pos < internal->pub_written; pos++) {
+		index = publish_queue_index(client, pos);
+		param = &internal->pub_queue[index];
+
+		if ((internal->pub_retired & BIT(index)) ||
+		    (param->message.topic.qos != qos) ||
+		    (param->message_id != message_id)) {
+			continue;
+		}
+
+		internal->pub_inflight--;
+		publish_queue_retire(client, pos);
+		return;
+	}
+
+	NET_DBG("[CID %p]: Message id 0x%04x not queued", client, message_id);
+}
+
+int mqtt_publish_queue(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param)
+{
+	struct mqtt_internal *internal;
+	struct buf_ctx packet;
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+
+	mqtt_mutex_lock(client);
+
+	internal = &client->internal;
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	if (internal->pub_count == CONFIG_MQTT_PUBLISH_QUEUE_SIZE) {
+		err_code = -ENOBUFS;
+		goto error;
+	}
+
+	/* Check that the message can be encoded alone in the TX buffer, so
+	 * that it does not block the queue once accepted.
+	 */
+	tx_buf_init(client, &packet);
+
+	err_code = publish_encode(param, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	internal->pub_queue[publish_queue_index(client, internal->pub_count)] =
+									*param;
+	internal->pub_count++;
+
+error:
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_publish_queue_flush(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	err_code = verify_tx_state(client);
+	if (err_code == 0) {
+		err_code = publish_queue_write(client);
+	}
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_publish_queue_count(struct mqtt_client *client)
+{
+	int count;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+	count = client->internal.pub_count;
+	mqtt_mutex_unlock(client);
+
+	return count;
+}
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0 */
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
@@ -652,6 +893,18 @@ int mqtt_input(struct mqtt_client *client)
 		err_code = -ENOTCONN;
 	}
 
+#if CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0
+	/* Refill the in-flight window once half of it is free, so that the
+	 * queued messages are written in batches rather than one per
+	 * acknowledgment.
+	 */
+	if ((err_code == 0) && MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED) &&
+	    (client->internal.pub_inflight <=
+	     CONFIG_MQTT_PUBLISH_QUEUE_INFLIGHT / 2)) {
+		err_code = publish_queue_write(client);
+	}
+#endif
+
 	mqtt_mutex_unlock(client);
 
 	return err_code;
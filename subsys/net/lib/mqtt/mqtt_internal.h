@@ -162,6 +162,18 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
  */
 int mqtt_handle_rx(struct mqtt_client *client);
 
+#if CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0
+/**@brief Retire the queued message acknowledged by the peer.
+ *
+ * @param[in] client Identifies the client for which the packet was received.
+ * @param[in] qos QoS of the message acknowledged, 1 for a Publish Ack and 2
+ *                for a Publish Complete.
+ * @param[in] message_id Message id of the acknowledgment.
+ */
+void mqtt_publish_queue_ack(struct mqtt_client *client, uint8_t qos,
+			    uint16_t message_id);
+#endif
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
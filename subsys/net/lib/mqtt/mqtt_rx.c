@@ -77,6 +77,13 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+
+#if CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0
+		if (err_code == 0) {
+			mqtt_publish_queue_ack(client, MQTT_QOS_1_AT_LEAST_ONCE,
+					       evt.param.puback.message_id);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -101,6 +108,13 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+
+#if CONFIG_MQTT_PUBLISH_QUEUE_SIZE > 0
+		if (err_code == 0) {
+			mqtt_publish_queue_ack(client, MQTT_QOS_2_EXACTLY_ONCE,
+					       evt.param.pubcomp.message_id);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
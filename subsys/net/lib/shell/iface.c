@@ -53,6 +53,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
 	EC(ETHERNET_DSA_SLAVE_PORT,       "DSA slave port"),
 	EC(ETHERNET_DSA_MASTER_PORT,      "DSA master port"),
+	EC(ETHERNET_HW_TSO,               "TCP segmentation offload"),
 };
 
 static void print_supported_ethernet_capabilities(
@@ -572,6 +573,66 @@ err:
 #endif /* CONFIG_NET_L2_ETHERNET */
 }
 
+static int cmd_net_rx_queues(const struct shell *sh, size_t argc, char *argv[])
+{
+#if !defined(CONFIG_NET_RX_STEERING) || !defined(CONFIG_NET_MGMT)
+	PR_WARNING("Set %s to enable %s support.\n",
+		   "CONFIG_NET_RX_STEERING and CONFIG_NET_MGMT", "RX steering");
+	return -ENOEXEC;
+#else
+	struct net_rx_steering_config config;
+	struct net_if *iface;
+	int idx, ret;
+
+	if (argc < 2) {
+		PR_WARNING("Missing interface index\n");
+		return -ENOEXEC;
+	}
+
+	idx = get_iface_idx(sh, argv[1]);
+	if (idx < 0) {
+		return -ENOEXEC;
+	}
+
+	iface = net_if_get_by_index(idx);
+	if (!iface) {
+		PR_WARNING("No such interface in index %d\n", idx);
+		return -ENOEXEC;
+	}
+
+	if (argc > 2) {
+		unsigned long queues;
+
+		ret = 0;
+		queues = shell_strtoul(argv[2], 10, &ret);
+		if (ret < 0 || queues > UINT8_MAX) {
+			PR_WARNING("Invalid number of queues: %s\n", argv[2]);
+			return -ENOEXEC;
+		}
+
+		config.queues = queues;
+
+		ret = net_mgmt(NET_REQUEST_RX_STEERING_SET, iface, &config,
+			       sizeof(config));
+		if (ret < 0) {
+			PR_WARNING("Cannot set RX queues, max is %d (%d)\n",
+				   CONFIG_NET_RX_STEERING_QUEUES, ret);
+			return -ENOEXEC;
+		}
+	}
+
+	ret = net_mgmt(NET_REQUEST_RX_STEERING_GET, iface, &config, sizeof(config));
+	if (ret < 0) {
+		PR_WARNING("Cannot get RX queues (%d)\n", ret);
+		return -ENOEXEC;
+	}
+
+	PR("Interface %d RX queues: %d\n", idx, config.queues);
+
+	return 0;
+#endif /* CONFIG_NET_RX_STEERING && CONFIG_NET_MGMT */
+}
+
 static int cmd_net_iface_up(const struct shell *sh, size_t argc, char *argv[])
 {
 	struct net_if *iface;
@@ -683,6 +744,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_iface,
 	SHELL_CMD(set_mac, IFACE_DYN_CMD,
 		  "'net iface set_mac <index> <MAC>' sets MAC address for the network interface.",
 		  cmd_net_set_mac),
+	SHELL_CMD(rx_queues, IFACE_DYN_CMD,
+		  "'net iface rx_queues <index> [<count>]' shows or sets the number "
+		  "of RX queues the received packets are spread over.",
+		  cmd_net_rx_queues),
 	SHELL_SUBCMD_SET_END
 );
 
@@ -54,6 +54,10 @@ __net_socket struct spair {
 	struct k_poll_signal writeable;
 	/** buffer for @a recv_q recv_q */
 	uint8_t buf[CONFIG_NET_SOCKETPAIR_BUFFER_SIZE];
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	/** persistent readiness watches of the local endpoint */
+	sys_slist_t poll_watch;
+#endif
 };
 
 #ifdef CONFIG_NET_SOCKETPAIR_STATIC
@@ -71,6 +75,18 @@ static inline bool sock_is_nonblock(const struct spair *spair)
 	return !!(spair->flags & SPAIR_FLAG_NONBLOCK);
 }
 
+/** Notify the persistent readiness watches of an endpoint, if any */
+static inline void spair_notify_watch(struct spair *spair)
+{
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	if (spair != NULL) {
+		zvfs_poll_watch_notify(&spair->poll_watch);
+	}
+#else
+	ARG_UNUSED(spair);
+#endif
+}
+
 /** Determine if a @ref spair is connected */
 static inline bool sock_is_connected(const struct spair *spair)
 {
@@ -84,6 +100,42 @@ static inline bool sock_is_connected(const struct spair *spair)
 	return true;
 }
 
+/**
+ * Notify the watches of the remote endpoint of @p spair, after a read made
+ * room in the local pipe.
+ *
+ * Must be called without the semaphore of @p spair held: a writer on the
+ * remote endpoint holds its own semaphore while it takes the local one.
+ */
+static void spair_notify_remote_watch(struct spair *spair, int remote_fd)
+{
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	struct spair *remote;
+
+	remote = z_get_fd_obj(remote_fd,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, 0);
+	if (remote == NULL) {
+		return;
+	}
+
+	if (k_sem_take(&remote->sem, K_FOREVER) < 0) {
+		return;
+	}
+
+	/* The remote endpoint may have been closed in the meantime */
+	if (z_get_fd_obj(remote->remote,
+			 (const struct fd_op_vtable *)&spair_fd_op_vtable,
+			 0) == spair) {
+		spair_notify_watch(remote);
+	}
+
+	k_sem_give(&remote->sem);
+#else
+	ARG_UNUSED(spair);
+	ARG_UNUSED(remote_fd);
+#endif
+}
+
 #undef sock_is_eof
 /** Determine if a @ref spair has encountered end-of-file */
 static inline bool sock_is_eof(const struct spair *spair)
@@ -182,6 +234,7 @@ static void spair_delete(struct spair *spair)
 				__ASSERT(res == 0,
 					"k_poll_signal_raise() failed: %d",
 					res);
+				spair_notify_watch(remote);
 			}
 		}
 	}
@@ -191,6 +244,10 @@ static void spair_delete(struct spair *spair)
 	res = k_poll_signal_raise(&spair->writeable, SPAIR_SIG_CANCEL);
 	__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	zvfs_poll_watch_detach_all(&spair->poll_watch);
+#endif
+
 	if (remote != NULL && have_remote_sem) {
 		k_sem_give(&remote->sem);
 	}
@@ -561,6 +618,8 @@ static ssize_t spair_write(void *obj, const void *buffer, size_t count)
 	res = k_poll_signal_raise(&remote->readable, SPAIR_SIG_DATA);
 	__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
 
+	spair_notify_watch(remote);
+
 	res = bytes_written;
 
 out:
@@ -618,6 +677,7 @@ static ssize_t spair_read(void *obj, void *buffer, size_t count)
 	size_t bytes_read;
 	bool have_local_sem = false;
 	bool will_block = false;
+	int remote_fd = -1;
 	struct spair *const spair = (struct spair *)obj;
 
 	if (obj == NULL || buffer == NULL || count == 0) {
@@ -735,6 +795,9 @@ static ssize_t spair_read(void *obj, void *buffer, size_t count)
 	if (is_connected) {
 		res = k_poll_signal_raise(&spair->writeable, SPAIR_SIG_DATA);
 		__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
+
+		/* the remote endpoint may write again */
+		remote_fd = spair->remote;
 	}
 
 	res = bytes_read;
@@ -745,6 +808,10 @@ out:
 		k_sem_give(&spair->sem);
 	}
 
+	if (remote_fd != -1) {
+		spair_notify_remote_watch(spair, remote_fd);
+	}
+
 	return res;
 }
 
@@ -990,6 +1057,15 @@ static int spair_ioctl(void *obj, unsigned int request, va_list args)
 			goto out;
 		}
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+		case ZFD_IOCTL_POLL_WATCH: {
+			zvfs_poll_watch_attach(&spair->poll_watch,
+					       va_arg(args, struct zvfs_poll_watch *));
+			res = 0;
+			goto out;
+		}
+#endif
+
 		default: {
 			errno = EOPNOTSUPP;
 			res = -1;
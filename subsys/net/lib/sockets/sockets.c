@@ -275,6 +275,10 @@ int zsock_close_ctx(struct net_context *ctx)
 	ctx->user_data = INT_TO_POINTER(EINTR);
 	sock_set_error(ctx);
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	zvfs_poll_watch_detach_all(&ctx->poll_watch);
+#endif
+
 	zsock_flush_queue(ctx);
 
 	SET_ERRNO(net_context_put(ctx));
@@ -366,6 +370,15 @@ static inline int z_vrfy_zsock_shutdown(int sock, int how)
 #include <zephyr/syscalls/zsock_shutdown_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static inline void zsock_notify_watch(struct net_context *ctx)
+{
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	zvfs_poll_watch_notify(&ctx->poll_watch);
+#else
+	ARG_UNUSED(ctx);
+#endif
+}
+
 static void zsock_accepted_cb(struct net_context *new_ctx,
 			      struct sockaddr *addr, socklen_t addrlen,
 			      int status, void *user_data) {
@@ -392,6 +405,8 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		net_context_ref(new_ctx);
 
 		(void)k_condvar_signal(&parent->cond.recv);
+
+		zsock_notify_watch(parent);
 	}
 
 }
@@ -446,6 +461,8 @@ unlock:
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
 
+	zsock_notify_watch(ctx);
+
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
 	}
@@ -521,6 +538,7 @@ static void zsock_connected_cb(struct net_context *ctx, int status, void *user_d
 	if (status < 0) {
 		ctx->user_data = INT_TO_POINTER(-status);
 		sock_set_error(ctx);
+		zsock_notify_watch(ctx);
 	}
 }
 
@@ -998,92 +1016,238 @@ ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+static void msghdr_copy_free(struct msghdr *msg_copy, size_t iovlen)
+{
+	k_free(msg_copy->msg_name);
+	k_free(msg_copy->msg_control);
+
+	if (msg_copy->msg_iov != NULL) {
+		for (size_t i = 0; i < iovlen; i++) {
+			k_free(msg_copy->msg_iov[i].iov_base);
+		}
+
+		k_free(msg_copy->msg_iov);
+	}
+}
+
+/* Make a kernel copy of a message to be sent. On failure, what was copied
+ * so far is still to be freed with msghdr_copy_free().
+ */
+static int sendmsg_copy_from_user(struct msghdr *msg_copy,
+				  const struct msghdr *msg)
 {
-	struct msghdr msg_copy;
 	size_t i;
-	int ret;
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
+				       msg_copy->msg_iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
-		goto fail;
+		return -1;
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
+	/* Clear the pointers in the copy so that if the allocation in the
+	 * next loop fails, we do not try to free non allocated memory.
+	 */
+	memset(msg_copy->msg_iov, 0, msg_copy->msg_iovlen * sizeof(struct iovec));
+
+	for (i = 0; i < msg_copy->msg_iovlen; i++) {
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
-	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
+	if (msg_copy->msg_namelen > 0) {
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+							   msg_copy->msg_namelen);
+		if (!msg_copy->msg_name) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 	}
 
-	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = k_usermode_alloc_from_copy(msg->msg_control,
-							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
+	if (msg_copy->msg_controllen > 0) {
+		msg_copy->msg_control = k_usermode_alloc_from_copy(msg->msg_control,
+							  msg_copy->msg_controllen);
+		if (!msg_copy->msg_control) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 	}
 
-	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
-				   flags);
+	return 0;
+}
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	int ret;
 
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	ret = sendmsg_copy_from_user(&msg_copy, msg);
+	if (ret == 0) {
+		ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
+					   flags);
 	}
 
-	k_free(msg_copy.msg_iov);
+	msghdr_copy_free(&msg_copy, msg_copy.msg_iovlen);
 
 	return ret;
+}
+#include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+/* Same limit as UIO_MAXIOV on Linux, larger batches are truncated */
+#define MMSG_VLEN_MAX 1024
+
+#ifdef CONFIG_USERSPACE
+/* User messages are copied in and out in batches of this size, so that
+ * the original number of vectors of each can be kept on the stack and the
+ * kernel copy stays small whatever the number of messages.
+ */
+#define MMSG_USER_BATCH 8
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	/* The socket is looked up and locked once for the whole batch */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0U; count < vlen; count++) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmsg, sock,
+						&msgvec[count].msg_hdr, flags);
+
+		ret = vtable->sendmsg(obj, &msgvec[count].msg_hdr, flags);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmsg, sock,
+					       ret < 0 ? -errno : ret);
+
+		sock_obj_core_update_send_stats(sock, ret);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
+	k_mutex_unlock(lock);
+
+	/* As with Linux, an error is only reported if nothing was sent */
+	if (count == 0U && ret < 0) {
+		return -1;
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	size_t iovlens[MMSG_USER_BATCH];
+	struct mmsghdr *vec_copy;
+	unsigned int count = 0U;
+	unsigned int batch, copied;
+	int ret = 0;
+
+	if (vlen == 0U) {
+		return 0;
+	}
+
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	vec_copy = k_usermode_alloc_from_copy(msgvec, MIN(vlen, MMSG_USER_BATCH) *
+						      sizeof(*msgvec));
+	if (vec_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	while (count < vlen) {
+		batch = MIN(vlen - count, MMSG_USER_BATCH);
+
+		for (copied = 0U; copied < batch; copied++) {
+			ret = sendmsg_copy_from_user(&vec_copy[copied].msg_hdr,
+						     &msgvec[count + copied].msg_hdr);
+			iovlens[copied] = vec_copy[copied].msg_hdr.msg_iovlen;
+
+			if (ret < 0) {
+				msghdr_copy_free(&vec_copy[copied].msg_hdr,
+						 iovlens[copied]);
+				break;
 			}
 		}
 
-		k_free(msg_copy.msg_iov);
+		/* If a message cannot be copied, the ones before it are still
+		 * sent and the call stops there, reporting what was sent.
+		 */
+		if (copied > 0U) {
+			ret = z_impl_zsock_sendmmsg(sock, vec_copy, copied, flags);
+		}
+
+		for (int i = 0; i < ret; i++) {
+			K_OOPS(k_usermode_to_copy(&msgvec[count + i].msg_len,
+						  &vec_copy[i].msg_len,
+						  sizeof(msgvec[i].msg_len)));
+		}
+
+		while (copied-- > 0U) {
+			msghdr_copy_free(&vec_copy[copied].msg_hdr,
+					 iovlens[copied]);
+		}
+
+		if (ret < 0) {
+			break;
+		}
+
+		count += ret;
+
+		if ((unsigned int)ret < batch) {
+			break;
+		}
 	}
 
-	return -1;
+	k_free(vec_copy);
+
+	if (count == 0U && ret < 0) {
+		return -1;
+	}
+
+	return count;
 }
-#include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
@@ -1902,6 +2066,307 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <zephyr/syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+/* Take the data of a packet from its cursor on. The fragments in front
+ * of it are released and the first one is pulled, unless the fragments
+ * are shared with another packet, in which case the data is copied.
+ */
+static int sock_pkt_take_data(struct net_pkt *pkt, struct net_buf **data)
+{
+	size_t len = net_pkt_remaining_data(pkt);
+	size_t skip = net_pkt_get_len(pkt) - len;
+	struct net_buf *buf;
+
+	for (buf = pkt->buffer; buf != NULL; buf = buf->frags) {
+		if (buf->ref > 1) {
+			goto copy;
+		}
+	}
+
+	buf = pkt->buffer;
+	pkt->buffer = NULL;
+
+	while (buf != NULL && skip >= buf->len) {
+		skip -= buf->len;
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	if (buf != NULL) {
+		(void)net_buf_pull(buf, skip);
+	}
+
+	*data = buf;
+
+	return 0;
+
+copy:
+	*data = NULL;
+
+	while (len > 0) {
+		size_t frag_len;
+
+		buf = net_pkt_get_frag(pkt, len, K_NO_WAIT);
+		if (buf == NULL) {
+			goto fail;
+		}
+
+		*data = net_buf_frag_add(*data, buf);
+
+		frag_len = MIN(len, net_buf_tailroom(buf));
+		if (net_pkt_read(pkt, net_buf_add(buf, frag_len), frag_len)) {
+			goto fail;
+		}
+
+		len -= frag_len;
+	}
+
+	return 0;
+
+fail:
+	if (*data != NULL) {
+		net_buf_unref(*data);
+		*data = NULL;
+	}
+
+	return -ENOBUFS;
+}
+
+static ssize_t zsock_recv_buf_ctx(struct net_context *ctx, struct net_buf **buf,
+				  int flags, struct sockaddr *src_addr,
+				  socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t len;
+	int ret;
+
+	*buf = NULL;
+
+	if (flags & ~ZSOCK_MSG_DONTWAIT) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM &&
+	    net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+	}
+
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	if (pkt == NULL) {
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (sock_type == SOCK_DGRAM && src_addr && addrlen) {
+		ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					    src_addr, *addrlen);
+		if (ret < 0) {
+			errno = -ret;
+			goto fail;
+		}
+
+		if (src_addr->sa_family == AF_INET) {
+			*addrlen = sizeof(struct sockaddr_in);
+		} else {
+			*addrlen = sizeof(struct sockaddr_in6);
+		}
+	}
+
+	len = net_pkt_remaining_data(pkt);
+
+	ret = sock_pkt_take_data(pkt, buf);
+	if (ret < 0) {
+		errno = -ret;
+		goto fail;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	net_pkt_unref(pkt);
+
+	return len;
+
+fail:
+	net_pkt_unref(pkt);
+
+	return -1;
+}
+
+static ssize_t zsock_send_buf_ctx(struct net_context *ctx, struct net_buf *buf,
+				  int flags, const struct sockaddr *dest_addr,
+				  socklen_t addrlen)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	int status;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	while (1) {
+		status = net_context_send_buf(ctx, buf, dest_addr, addrlen,
+					      NULL, timeout, ctx->user_data);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return status;
+			}
+
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		break;
+	}
+
+	return status;
+}
+
+/* Buffers are handed over to native UDP and TCP sockets only */
+static struct net_context *zsock_zerocopy_ctx(int sock, struct k_mutex **lock)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable, lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	if (vtable != &sock_fd_op_vtable ||
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx)) ||
+	    (net_context_get_proto(ctx) != IPPROTO_UDP &&
+	     net_context_get_proto(ctx) != IPPROTO_TCP)) {
+		errno = EOPNOTSUPP;
+		return NULL;
+	}
+
+	return ctx;
+}
+
+ssize_t zsock_recv_buf(int sock, struct net_buf **buf, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (buf == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zsock_zerocopy_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_buf_ctx(ctx, buf, flags, src_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_recv_stats(sock, ret);
+
+	return ret;
+}
+
+void zsock_buf_release(struct net_buf *buf)
+{
+	if (buf != NULL) {
+		net_buf_unref(buf);
+	}
+}
+
+ssize_t zsock_send_buf(int sock, struct net_buf *buf, int flags,
+		       const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (buf == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zsock_zerocopy_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_send_buf_ctx(ctx, buf, flags, dest_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_send_stats(sock, ret);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 			  int flags)
 {
@@ -1953,12 +2418,14 @@ ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+/* Make a kernel copy of a message to receive into. On failure, what was
+ * copied so far is still to be freed with msghdr_copy_free().
+ */
+static int recvmsg_copy_from_user(struct msghdr *msg_copy, struct msghdr *msg)
 {
-	struct msghdr msg_copy;
-	size_t iovlen;
 	size_t i;
-	int ret;
+
+	memset(msg_copy, 0, sizeof(*msg_copy));
 
 	if (msg == NULL) {
 		errno = EINVAL;
@@ -1970,156 +2437,295 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 		return -1;
 	}
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
 
-	k_usermode_from_copy(&iovlen, &msg->msg_iovlen, sizeof(iovlen));
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
-
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
+				       msg_copy->msg_iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
-		goto fail;
+		return -1;
 	}
 
 	/* Clear the pointers in the copy so that if the allocation in the
-	 * next loop fails, we do not try to free non allocated memory
-	 * in fail branch.
+	 * next loop fails, we do not try to free non allocated memory.
 	 */
-	memset(msg_copy.msg_iov, 0, msg->msg_iovlen * sizeof(struct iovec));
+	memset(msg_copy->msg_iov, 0, msg_copy->msg_iovlen * sizeof(struct iovec));
 
-	for (i = 0; i < iovlen; i++) {
+	for (i = 0; i < msg_copy->msg_iovlen; i++) {
 		/* TODO: In practice we do not need to copy the actual data
 		 * in msghdr when receiving data but currently there is no
 		 * ready made function to do just that (unless we want to call
 		 * relevant malloc function here ourselves). So just use
 		 * the copying variant for now.
 		 */
-		msg_copy.msg_iov[i].iov_base =
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 						   msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
-	if (msg->msg_namelen > 0) {
+	if (msg_copy->msg_namelen > 0) {
 		if (msg->msg_name == NULL) {
 			errno = EINVAL;
-			goto fail;
+			return -1;
 		}
 
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (msg_copy.msg_name == NULL) {
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+							   msg_copy->msg_namelen);
+		if (msg_copy->msg_name == NULL) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 	}
 
-	if (msg->msg_controllen > 0) {
+	if (msg_copy->msg_controllen > 0) {
 		if (msg->msg_control == NULL) {
 			errno = EINVAL;
-			goto fail;
+			return -1;
 		}
 
-		msg_copy.msg_control =
+		msg_copy->msg_control =
 			k_usermode_alloc_from_copy(msg->msg_control,
-						   msg->msg_controllen);
-		if (msg_copy.msg_control == NULL) {
+						   msg_copy->msg_controllen);
+		if (msg_copy->msg_control == NULL) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 	}
 
-	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+	return 0;
+}
 
-	/* Do not copy anything back if there was an error or nothing was
-	 * received.
-	 */
-	if (ret > 0) {
-		if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_name,
-						  msg_copy.msg_name,
-						  msg_copy.msg_namelen));
-		}
+/* Copy a received message back to the user, iovlen being the number of
+ * vectors the message had before it was received into.
+ */
+static void recvmsg_copy_to_user(struct msghdr *msg,
+				 const struct msghdr *msg_copy, size_t iovlen)
+{
+	size_t i;
+
+	if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_name,
+					  msg_copy->msg_name,
+					  msg_copy->msg_namelen));
+	}
+
+	if (msg->msg_controllen > 0 &&
+	    msg->msg_control != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_control,
+					  msg_copy->msg_control,
+					  msg_copy->msg_controllen));
+
+		msg->msg_controllen = msg_copy->msg_controllen;
+	} else {
+		msg->msg_controllen = 0U;
+	}
+
+	k_usermode_to_copy(&msg->msg_iovlen,
+			   &msg_copy->msg_iovlen,
+			   sizeof(msg->msg_iovlen));
 
-		if (msg->msg_controllen > 0 &&
-		    msg->msg_control != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_control,
-						  msg_copy.msg_control,
-						  msg_copy.msg_controllen));
+	/* The new iovlen cannot be bigger than the original one */
+	NET_ASSERT(msg_copy->msg_iovlen <= iovlen);
 
-			msg->msg_controllen = msg_copy.msg_controllen;
+	for (i = 0; i < iovlen; i++) {
+		if (i < msg_copy->msg_iovlen) {
+			K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_len));
+			K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
+						  &msg_copy->msg_iov[i].iov_len,
+						  sizeof(msg->msg_iov[i].iov_len)));
 		} else {
-			msg->msg_controllen = 0U;
+			/* Clear out those vectors that we could not populate */
+			msg->msg_iov[i].iov_len = 0;
 		}
+	}
+
+	k_usermode_to_copy(&msg->msg_flags,
+			   &msg_copy->msg_flags,
+			   sizeof(msg->msg_flags));
+}
+
+ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	struct msghdr msg_copy;
+	size_t iovlen;
+	int ret;
 
-		k_usermode_to_copy(&msg->msg_iovlen,
-				   &msg_copy.msg_iovlen,
-				   sizeof(msg->msg_iovlen));
+	ret = recvmsg_copy_from_user(&msg_copy, msg);
 
-		/* The new iovlen cannot be bigger than the original one */
-		NET_ASSERT(msg_copy.msg_iovlen <= iovlen);
+	/* Note that we need to free according to original iovlen */
+	iovlen = msg_copy.msg_iovlen;
 
-		for (i = 0; i < iovlen; i++) {
-			if (i < msg_copy.msg_iovlen) {
-				K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_len));
-				K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
-							  &msg_copy.msg_iov[i].iov_len,
-							  sizeof(msg->msg_iov[i].iov_len)));
-			} else {
-				/* Clear out those vectors that we could not populate */
-				msg->msg_iov[i].iov_len = 0;
-			}
+	if (ret == 0) {
+		ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+		/* Do not copy anything back if there was an error or nothing
+		 * was received.
+		 */
+		if (ret > 0) {
+			recvmsg_copy_to_user(msg, &msg_copy, iovlen);
 		}
+	}
+
+	msghdr_copy_free(&msg_copy, iovlen);
+
+	return ret;
+}
+#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
 
-		k_usermode_to_copy(&msg->msg_flags,
-				   &msg_copy.msg_flags,
-				   sizeof(msg->msg_flags));
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
 	}
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
 
-	/* Note that we need to free according to original iovlen */
-	for (i = 0; i < iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	/* The socket is looked up and locked once for the whole batch, the
+	 * lock is released by the receive path while it waits for data.
+	 */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0U; count < vlen; count++) {
+		int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+
+		if (count > 0U && (flags & ZSOCK_MSG_WAITFORONE)) {
+			msg_flags |= ZSOCK_MSG_DONTWAIT;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, recvmsg, sock,
+						&msgvec[count].msg_hdr, msg_flags);
+
+		ret = vtable->recvmsg(obj, &msgvec[count].msg_hdr, msg_flags);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, recvmsg, sock,
+					       &msgvec[count].msg_hdr,
+					       ret < 0 ? -errno : ret);
+
+		sock_obj_core_update_recv_stats(sock, ret);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
 	}
 
-	k_free(msg_copy.msg_iov);
+	k_mutex_unlock(lock);
 
-	return ret;
+	/* As with Linux, an error is only reported if nothing was received */
+	if (count == 0U && ret < 0) {
+		return -1;
+	}
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	size_t iovlens[MMSG_USER_BATCH];
+	struct mmsghdr *vec_copy;
+	unsigned int count = 0U;
+	unsigned int batch, copied;
+	int ret = 0;
+
+	if (vlen == 0U) {
+		return 0;
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	vec_copy = k_usermode_alloc_from_copy(msgvec, MIN(vlen, MMSG_USER_BATCH) *
+						      sizeof(*msgvec));
+	if (vec_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
+	while (count < vlen) {
+		batch = MIN(vlen - count, MMSG_USER_BATCH);
+
+		for (copied = 0U; copied < batch; copied++) {
+			ret = recvmsg_copy_from_user(&vec_copy[copied].msg_hdr,
+						     &msgvec[count + copied].msg_hdr);
+			iovlens[copied] = vec_copy[copied].msg_hdr.msg_iovlen;
+
+			if (ret < 0) {
+				msghdr_copy_free(&vec_copy[copied].msg_hdr,
+						 iovlens[copied]);
+				break;
 			}
 		}
 
-		k_free(msg_copy.msg_iov);
+		if (ret == 0) {
+			ret = z_impl_zsock_recvmmsg(sock, vec_copy, batch, flags);
+		}
+
+		for (int i = 0; i < ret; i++) {
+			recvmsg_copy_to_user(&msgvec[count + i].msg_hdr,
+					     &vec_copy[i].msg_hdr, iovlens[i]);
+			K_OOPS(k_usermode_to_copy(&msgvec[count + i].msg_len,
+						  &vec_copy[i].msg_len,
+						  sizeof(msgvec[i].msg_len)));
+		}
+
+		while (copied-- > 0U) {
+			msghdr_copy_free(&vec_copy[copied].msg_hdr,
+					 iovlens[copied]);
+		}
+
+		if (ret < 0) {
+			break;
+		}
+
+		count += ret;
+
+		if ((unsigned int)ret < batch) {
+			break;
+		}
+
+		/* Only the very first message is waited for */
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
 	}
 
-	return -1;
+	k_free(vec_copy);
+
+	if (count == 0U && ret < 0) {
+		return -1;
+	}
+
+	return count;
 }
-#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 /* As this is limited function, we don't follow POSIX signature, with
@@ -2763,6 +3369,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -3340,6 +3960,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
@@ -3815,6 +4449,16 @@ static int sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return zsock_poll_update_ctx(obj, pfd, pev);
 	}
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	case ZFD_IOCTL_POLL_WATCH: {
+		struct net_context *ctx = obj;
+
+		zvfs_poll_watch_attach(&ctx->poll_watch,
+				       va_arg(args, struct zvfs_poll_watch *));
+		return 0;
+	}
+#endif
+
 	case ZFD_IOCTL_SET_LOCK: {
 		struct k_mutex *lock;
 
@@ -179,6 +179,10 @@ static void zcan_received_cb(struct net_context *ctx, struct net_pkt *pkt,
 		}
 
 		k_condvar_signal(&ctx->cond.recv);
+
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+		zvfs_poll_watch_notify(&ctx->poll_watch);
+#endif
 	}
 
 	if (clone && clone != pkt) {
@@ -0,0 +1,604 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include "sockets_internal.h"
+
+/* Event sets keep their file descriptors in a fixed table of items. Each
+ * item has a persistent watch attached to its file descriptor, whose
+ * callback puts the item on the ready list of the set. A wait then only
+ * visits the items on that list and asks each of them for its current
+ * state with the regular poll methods, so the readiness logic of every
+ * file descriptor type is reused as is.
+ *
+ * Level-triggered items that were found ready are put back on the list,
+ * to be checked again by the next wait. Edge-triggered items stay off the
+ * list until their file descriptor signals again.
+ */
+
+#define EPOLL_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLPRI | ZSOCK_EPOLLOUT | \
+		      ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+#define EPOLL_FLAGS (ZSOCK_EPOLLET | ZSOCK_EPOLLONESHOT)
+
+struct epoll_set;
+
+struct epoll_item {
+	/** Watch attached to the file descriptor */
+	struct zvfs_poll_watch watch;
+	/** Node in the ready list of the set */
+	sys_dnode_t ready_node;
+	struct epoll_set *set;
+	/** Object behind the file descriptor, to spot a closed one */
+	void *obj;
+	/** File descriptor, -1 if the item is free */
+	int fd;
+	/** Cleared once a one-shot item reported an event */
+	bool armed;
+	uint32_t events;
+	zsock_epoll_data_t data;
+};
+
+struct epoll_set {
+	struct epoll_item items[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+	/** Items which may be ready, protected by @a lock */
+	sys_dlist_t ready;
+	/** Raised whenever @a ready is not empty */
+	struct k_poll_signal ready_sig;
+	struct k_spinlock lock;
+	/** Serializes changes of the items with waits */
+	struct k_mutex ctl_lock;
+	bool in_use;
+};
+
+static struct epoll_set epoll_sets[CONFIG_NET_SOCKETS_EPOLL_MAX];
+static K_MUTEX_DEFINE(epoll_sets_lock);
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static void epoll_queue_locked(struct epoll_set *set, struct epoll_item *item)
+{
+	if (!sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_append(&set->ready, &item->ready_node);
+	}
+
+	(void)k_poll_signal_raise(&set->ready_sig, 0);
+}
+
+static void epoll_watch_cb(struct zvfs_poll_watch *watch)
+{
+	struct epoll_item *item = CONTAINER_OF(watch, struct epoll_item, watch);
+	struct epoll_set *set = item->set;
+	k_spinlock_key_t key = k_spin_lock(&set->lock);
+
+	epoll_queue_locked(set, item);
+
+	k_spin_unlock(&set->lock, key);
+}
+
+static void epoll_item_free(struct epoll_set *set, struct epoll_item *item)
+{
+	k_spinlock_key_t key;
+
+	zvfs_poll_watch_detach(&item->watch);
+
+	key = k_spin_lock(&set->lock);
+
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	k_spin_unlock(&set->lock, key);
+
+	item->fd = -1;
+	item->obj = NULL;
+}
+
+/* The watch of a closed file descriptor is detached by its owner, and the
+ * descriptor number may already have been reused.
+ */
+static bool epoll_item_is_stale(struct epoll_item *item)
+{
+	return item->watch.list == NULL ||
+	       z_get_fd_obj(item->fd, NULL, 0) != item->obj;
+}
+
+static struct epoll_item *epoll_item_find(struct epoll_set *set, int fd)
+{
+	for (int i = 0; i < ARRAY_SIZE(set->items); i++) {
+		struct epoll_item *item = &set->items[i];
+
+		if (item->fd != fd) {
+			continue;
+		}
+
+		if (epoll_item_is_stale(item)) {
+			epoll_item_free(set, item);
+			return NULL;
+		}
+
+		return item;
+	}
+
+	return NULL;
+}
+
+static int epoll_item_add(struct epoll_set *set, int fd,
+			  const struct zsock_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct epoll_item *item = NULL;
+	struct k_mutex *lock;
+	k_spinlock_key_t key;
+	void *obj;
+	int ret;
+
+	obj = z_get_fd_obj_and_vtable(fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -EBADF;
+	}
+
+	if (obj == set) {
+		return -EINVAL;
+	}
+
+	if (epoll_item_find(set, fd) != NULL) {
+		return -EEXIST;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(set->items); i++) {
+		if (set->items[i].fd < 0) {
+			item = &set->items[i];
+			break;
+		}
+	}
+
+	if (item == NULL) {
+		return -ENOMEM;
+	}
+
+	item->fd = fd;
+	item->obj = obj;
+	item->armed = true;
+	item->events = event->events;
+	item->data = event->data;
+	item->watch.cb = epoll_watch_cb;
+	item->watch.list = NULL;
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_WATCH, &item->watch);
+	k_mutex_unlock(lock);
+
+	if (ret < 0) {
+		item->fd = -1;
+		item->obj = NULL;
+
+		/* Same as Linux for files which cannot be waited for */
+		return errno == EOPNOTSUPP ? -EPERM : -errno;
+	}
+
+	/* The file descriptor may be ready already */
+	key = k_spin_lock(&set->lock);
+	epoll_queue_locked(set, item);
+	k_spin_unlock(&set->lock, key);
+
+	return 0;
+}
+
+static int epoll_ctl_locked(struct epoll_set *set, int op, int fd,
+			    const struct zsock_epoll_event *event)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+
+	if (op != ZSOCK_EPOLL_CTL_DEL &&
+	    (event->events & ~(EPOLL_EVENTS | EPOLL_FLAGS)) != 0) {
+		return -EINVAL;
+	}
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		return epoll_item_add(set, fd, event);
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		item = epoll_item_find(set, fd);
+		if (item == NULL) {
+			return -ENOENT;
+		}
+
+		item->armed = true;
+		item->events = event->events;
+		item->data = event->data;
+
+		key = k_spin_lock(&set->lock);
+		epoll_queue_locked(set, item);
+		k_spin_unlock(&set->lock, key);
+
+		return 0;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		item = epoll_item_find(set, fd);
+		if (item == NULL) {
+			return -ENOENT;
+		}
+
+		epoll_item_free(set, item);
+
+		return 0;
+
+	default:
+		return -EINVAL;
+	}
+}
+
+/* Check the items queued when the call started, at most once each */
+static int epoll_collect(struct epoll_set *set, struct zsock_epoll_event *events,
+			 int maxevents)
+{
+	struct zsock_pollfd pfd;
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+	int count = 0;
+
+	sys_dlist_init(&pending);
+
+	key = k_spin_lock(&set->lock);
+
+	while ((node = sys_dlist_get(&set->ready)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	k_spin_unlock(&set->lock, key);
+
+	while (count < maxevents) {
+		key = k_spin_lock(&set->lock);
+		node = sys_dlist_get(&pending);
+		k_spin_unlock(&set->lock, key);
+
+		if (node == NULL) {
+			break;
+		}
+
+		item = CONTAINER_OF(node, struct epoll_item, ready_node);
+
+		if (epoll_item_is_stale(item)) {
+			epoll_item_free(set, item);
+			continue;
+		}
+
+		if (!item->armed) {
+			continue;
+		}
+
+		pfd.fd = item->fd;
+		pfd.events = item->events & EPOLL_EVENTS;
+		pfd.revents = 0;
+
+		(void)zsock_poll_internal(&pfd, 1, K_NO_WAIT);
+
+		if (pfd.revents & ZSOCK_POLLNVAL) {
+			epoll_item_free(set, item);
+			continue;
+		}
+
+		pfd.revents &= item->events | ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP;
+		if (pfd.revents == 0) {
+			continue;
+		}
+
+		events[count].events = pfd.revents;
+		events[count].data = item->data;
+		count++;
+
+		if (item->events & ZSOCK_EPOLLONESHOT) {
+			item->armed = false;
+		} else if (!(item->events & ZSOCK_EPOLLET)) {
+			key = k_spin_lock(&set->lock);
+			epoll_queue_locked(set, item);
+			k_spin_unlock(&set->lock, key);
+		}
+	}
+
+	key = k_spin_lock(&set->lock);
+
+	/* Whatever was not looked at goes back to the head of the list */
+	while ((node = sys_dlist_peek_tail(&pending)) != NULL) {
+		sys_dlist_remove(node);
+		sys_dlist_prepend(&set->ready, node);
+	}
+
+	if (sys_dlist_is_empty(&set->ready)) {
+		k_poll_signal_reset(&set->ready_sig);
+	} else {
+		(void)k_poll_signal_raise(&set->ready_sig, 0);
+	}
+
+	k_spin_unlock(&set->lock, key);
+
+	return count;
+}
+
+int z_impl_zsock_epoll_create1(int flags)
+{
+	struct epoll_set *set = NULL;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(&epoll_sets_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_sets); i++) {
+		if (!epoll_sets[i].in_use) {
+			set = &epoll_sets[i];
+			set->in_use = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&epoll_sets_lock);
+
+	if (set == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(set->items); i++) {
+		set->items[i].fd = -1;
+		set->items[i].obj = NULL;
+		set->items[i].set = set;
+		sys_dnode_init(&set->items[i].ready_node);
+	}
+
+	sys_dlist_init(&set->ready);
+	k_poll_signal_init(&set->ready_sig);
+	k_mutex_init(&set->ctl_lock);
+
+	z_finalize_fd(fd, set, &epoll_fd_op_vtable);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create1(int flags)
+{
+	return z_impl_zsock_epoll_create1(flags);
+}
+#include <zephyr/syscalls/zsock_epoll_create1_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	struct epoll_set *set;
+	int ret;
+
+	set = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (set == NULL) {
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&set->ctl_lock, K_FOREVER);
+	ret = epoll_ctl_locked(set, op, fd, event);
+	k_mutex_unlock(&set->ctl_lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (op == ZSOCK_EPOLL_CTL_DEL || event == NULL) {
+		return z_impl_zsock_epoll_ctl(epfd, op, fd, event);
+	}
+
+	K_OOPS(k_usermode_from_copy(&event_copy, event, sizeof(event_copy)));
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, &event_copy);
+}
+#include <zephyr/syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct k_poll_event poll_event;
+	struct epoll_set *set;
+	k_timepoint_t end;
+	int ret;
+
+	set = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (set == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	k_poll_event_init(&poll_event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set->ready_sig);
+
+	while (true) {
+		(void)k_mutex_lock(&set->ctl_lock, K_FOREVER);
+
+		if (!set->in_use) {
+			/* Closed while waiting */
+			k_mutex_unlock(&set->ctl_lock);
+			errno = EBADF;
+			return -1;
+		}
+
+		ret = epoll_collect(set, events, maxevents);
+		k_mutex_unlock(&set->ctl_lock);
+
+		if (ret > 0) {
+			return ret;
+		}
+
+		poll_event.state = K_POLL_STATE_NOT_READY;
+
+		ret = k_poll(&poll_event, 1, sys_timepoint_timeout(end));
+		if (ret == -EAGAIN) {
+			return 0;
+		} else if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	if (maxevents > 0) {
+		K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(events, maxevents,
+						    sizeof(struct zsock_epoll_event)));
+	}
+
+	return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#include <zephyr/syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct epoll_set *set = obj;
+
+	(void)k_mutex_lock(&set->ctl_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(set->items); i++) {
+		if (set->items[i].fd >= 0) {
+			epoll_item_free(set, &set->items[i]);
+		}
+	}
+
+	(void)k_mutex_lock(&epoll_sets_lock, K_FOREVER);
+	set->in_use = false;
+	k_mutex_unlock(&epoll_sets_lock);
+
+	/* Wake up the waiters, they find out the set is gone */
+	(void)k_poll_signal_raise(&set->ready_sig, 0);
+
+	k_mutex_unlock(&set->ctl_lock);
+
+	return 0;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	struct epoll_set *set = obj;
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		if (!(pfd->events & ZSOCK_POLLIN)) {
+			return 0;
+		}
+
+		if (*pev == pev_end) {
+			errno = ENOMEM;
+			return -1;
+		}
+
+		k_poll_event_init(*pev, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &set->ready_sig);
+		(*pev)++;
+
+		return 0;
+	}
+
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		unsigned int signaled;
+		int result;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		if (!(pfd->events & ZSOCK_POLLIN)) {
+			return 0;
+		}
+
+		k_poll_signal_check(&set->ready_sig, &signaled, &result);
+		if (signaled) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+
+		(*pev)++;
+
+		return 0;
+	}
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
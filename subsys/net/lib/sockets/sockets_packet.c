@@ -117,6 +117,10 @@ static void zpacket_received_cb(struct net_context *ctx,
 	net_pkt_set_eof(pkt, false);
 
 	k_fifo_put(&ctx->recv_q, pkt);
+
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	zvfs_poll_watch_notify(&ctx->poll_watch);
+#endif
 }
 
 static int zpacket_bind_ctx(struct net_context *ctx,
@@ -46,7 +46,9 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
+#include <mbedtls/platform_util.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -192,6 +194,9 @@ __net_socket struct tls_context {
 		/** Session cache enabled on a socket. */
 		bool cache_enabled;
 
+		/** Session tickets enabled on a socket, -1 if not set. */
+		int8_t tickets;
+
 		/** Socket TX timeout */
 		k_timeout_t timeout_tx;
 
@@ -223,6 +228,22 @@ __net_socket struct tls_context {
 	socklen_t dtls_peer_addrlen;
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+	/** Data sent with ZSOCK_MSG_MORE, not written to a record yet. */
+	uint8_t *coalesce_buf;
+
+	/** Length of the data in the coalescing buffer. */
+	uint16_t coalesce_len;
+
+	/** Length of the data already written from the coalescing buffer. */
+	uint16_t coalesce_sent;
+
+	/** The coalescing buffer is being written, and cannot change until
+	 *  mbedTLS has written all of it, as mbedtls_ssl_write() requires.
+	 */
+	bool coalesce_flushing;
+#endif
+
 #if defined(CONFIG_MBEDTLS)
 	/** mbedTLS context. */
 	mbedtls_ssl_context ssl;
@@ -252,6 +273,29 @@ static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_S
 
 #if defined(MBEDTLS_SSL_CACHE_C)
 static mbedtls_ssl_cache_context server_cache;
+
+/* mbedTLS is built without threading support, so the server sockets doing
+ * their handshakes from different threads are serialized here.
+ */
+static struct k_mutex server_cache_lock;
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+#define TICKET_LIFETIME CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME
+
+#if defined(MBEDTLS_GCM_C)
+#define TICKET_CIPHER MBEDTLS_CIPHER_AES_256_GCM
+#else
+#define TICKET_CIPHER MBEDTLS_CIPHER_AES_256_CCM
+#endif
+
+/* Protection of the session tickets issued by all the server sockets,
+ * set up on first use.
+ */
+static mbedtls_ssl_ticket_context server_ticket;
+static struct k_mutex server_ticket_lock;
+static bool server_ticket_ready;
+static int64_t server_ticket_rotated;
 #endif
 
 /* A mutex for protecting TLS context allocation. */
@@ -371,6 +415,12 @@ static int tls_init(void)
 
 #if defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_init(&server_cache);
+	k_mutex_init(&server_cache_lock);
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&server_ticket);
+	k_mutex_init(&server_ticket_lock);
 #endif
 
 	return 0;
@@ -450,6 +500,7 @@ static struct tls_context *tls_alloc(void)
 			(void)memset(tls, 0, sizeof(*tls));
 			tls->is_used = true;
 			tls->options.verify_level = -1;
+			tls->options.tickets = -1;
 			tls->options.timeout_tx = K_FOREVER;
 			tls->options.timeout_rx = K_FOREVER;
 			tls->sock = -1;
@@ -542,6 +593,14 @@ static int tls_release(struct tls_context *tls)
 	mbedtls_pk_free(&tls->priv_key);
 #endif
 
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+	mbedtls_free(tls->coalesce_buf);
+	tls->coalesce_buf = NULL;
+	tls->coalesce_len = 0;
+	tls->coalesce_sent = 0;
+	tls->coalesce_flushing = false;
+#endif
+
 	tls->is_used = false;
 
 	return 0;
@@ -722,13 +781,164 @@ exit:
 	mbedtls_ssl_session_free(&session);
 }
 
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int tls_server_cache_get(void *data, unsigned char const *session_id,
+				size_t session_id_len,
+				mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&server_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_get(data, session_id, session_id_len, session);
+	k_mutex_unlock(&server_cache_lock);
+
+	return ret;
+}
+
+static int tls_server_cache_set(void *data, unsigned char const *session_id,
+				size_t session_id_len,
+				const mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&server_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_set(data, session_id, session_id_len, session);
+	k_mutex_unlock(&server_cache_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Called with server_ticket_lock held. The context stays registered in the
+ * configuration of the server sockets, so it is set up again in place, with
+ * new random keys, rather than left torn down.
+ */
+static int tls_server_ticket_reset(void)
+{
+	int ret;
+
+	if (server_ticket_ready) {
+		mbedtls_ssl_ticket_free(&server_ticket);
+		mbedtls_ssl_ticket_init(&server_ticket);
+		server_ticket_ready = false;
+	}
+
+	ret = mbedtls_ssl_ticket_setup(&server_ticket, tls_ctr_drbg_random,
+				       NULL, TICKET_CIPHER, TICKET_LIFETIME);
+	if (ret != 0) {
+		NET_ERR("Failed to set up session tickets, err: -0x%x", -ret);
+		return -ENOMEM;
+	}
+
+	server_ticket_ready = true;
+	server_ticket_rotated = k_uptime_get();
+
+	return 0;
+}
+
+static int tls_server_ticket_setup(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&server_ticket_lock, K_FOREVER);
+
+	if (!server_ticket_ready) {
+		ret = tls_server_ticket_reset();
+	}
+
+	k_mutex_unlock(&server_ticket_lock);
+
+	return ret;
+}
+
+/* Called with server_ticket_lock held. Without a time source, mbedTLS
+ * neither replaces the ticket key nor checks the ticket age, so the key is
+ * replaced here once per lifetime, from the system uptime. As the previous
+ * key is kept, a ticket stays valid for one to two lifetimes.
+ */
+static void tls_server_ticket_rotate(void)
+{
+#if !defined(MBEDTLS_HAVE_TIME)
+	int64_t now = k_uptime_get();
+	unsigned char name[4];
+	unsigned char key[32];
+	int ret;
+
+	if (now - server_ticket_rotated < TICKET_LIFETIME * MSEC_PER_SEC) {
+		return;
+	}
+
+	if (tls_ctr_drbg_random(NULL, name, sizeof(name)) != 0 ||
+	    tls_ctr_drbg_random(NULL, key, sizeof(key)) != 0) {
+		return;
+	}
+
+	ret = mbedtls_ssl_ticket_rotate(&server_ticket, name, sizeof(name),
+					key, sizeof(key), TICKET_LIFETIME);
+	if (ret != 0) {
+		NET_WARN("Failed to rotate session ticket key, err: -0x%x",
+			 -ret);
+	} else {
+		server_ticket_rotated = now;
+	}
+
+	mbedtls_platform_zeroize(key, sizeof(key));
+#endif /* !MBEDTLS_HAVE_TIME */
+}
+
+static int tls_server_ticket_write(void *p_ticket,
+				   const mbedtls_ssl_session *session,
+				   unsigned char *start,
+				   const unsigned char *end,
+				   size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&server_ticket_lock, K_FOREVER);
+	tls_server_ticket_rotate();
+	ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end, tlen,
+				       lifetime);
+	k_mutex_unlock(&server_ticket_lock);
+
+	return ret;
+}
+
+static int tls_server_ticket_parse(void *p_ticket,
+				   mbedtls_ssl_session *session,
+				   unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&server_ticket_lock, K_FOREVER);
+	tls_server_ticket_rotate();
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	k_mutex_unlock(&server_ticket_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 static void tls_session_purge(void)
 {
 	tls_session_cache_reset();
 
 #if defined(MBEDTLS_SSL_CACHE_C)
+	k_mutex_lock(&server_cache_lock, K_FOREVER);
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
+	k_mutex_unlock(&server_cache_lock);
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	/* The tickets issued so far cannot be decrypted with the new keys.
+	 * Nothing to do if no server socket has used tickets yet.
+	 */
+	k_mutex_lock(&server_ticket_lock, K_FOREVER);
+	if (server_ticket_ready) {
+		(void)tls_server_ticket_reset();
+	}
+	k_mutex_unlock(&server_ticket_lock);
 #endif
 }
 
@@ -1170,6 +1380,13 @@ static int tls_mbedtls_reset(struct tls_context *context)
 
 	k_sem_reset(&context->tls_established);
 
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+	/* The data held back belongs to the session being reset */
+	context->coalesce_len = 0;
+	context->coalesce_sent = 0;
+	context->coalesce_flushing = false;
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	/* Server role: reset the address so that a new
 	 *              client can connect w/o a need to reopen a socket
@@ -1416,8 +1633,32 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 #if defined(MBEDTLS_SSL_CACHE_C)
 	if (is_server && context->options.cache_enabled) {
 		mbedtls_ssl_conf_session_cache(&context->config, &server_cache,
-					       mbedtls_ssl_cache_get,
-					       mbedtls_ssl_cache_set);
+					       tls_server_cache_get,
+					       tls_server_cache_set);
+	}
+#endif
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+	/* Clients use tickets by default, unless disabled on the socket */
+	if (!is_server && context->options.tickets != -1) {
+		mbedtls_ssl_conf_session_tickets(&context->config,
+			context->options.tickets == TLS_SESSION_TICKETS_ENABLED ?
+			MBEDTLS_SSL_SESSION_TICKETS_ENABLED :
+			MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+	}
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (is_server && context->options.tickets == TLS_SESSION_TICKETS_ENABLED) {
+		ret = tls_server_ticket_setup();
+		if (ret < 0) {
+			return ret;
+		}
+
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    tls_server_ticket_write,
+						    tls_server_ticket_parse,
+						    &server_ticket);
 	}
 #endif
 
@@ -1941,6 +2182,44 @@ static int tls_opt_session_cache_get(struct tls_context *context,
 	return 0;
 }
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+static int tls_opt_session_tickets_set(struct tls_context *context,
+				       const void *optval, socklen_t optlen)
+{
+	int *val = (int *)optval;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (sizeof(int) != optlen) {
+		return -EINVAL;
+	}
+
+	context->options.tickets = (*val == TLS_SESSION_TICKETS_ENABLED) ?
+				   TLS_SESSION_TICKETS_ENABLED :
+				   TLS_SESSION_TICKETS_DISABLED;
+
+	return 0;
+}
+
+static int tls_opt_session_tickets_get(struct tls_context *context,
+				       void *optval, socklen_t *optlen)
+{
+	int tickets_enabled = (context->options.tickets == TLS_SESSION_TICKETS_ENABLED) ?
+			      TLS_SESSION_TICKETS_ENABLED :
+			      TLS_SESSION_TICKETS_DISABLED;
+
+	if (*optlen != sizeof(tickets_enabled)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = tickets_enabled;
+
+	return 0;
+}
+#endif /* MBEDTLS_SSL_SESSION_TICKETS */
+
 static int tls_opt_session_cache_purge_set(struct tls_context *context,
 					   const void *optval, socklen_t optlen)
 {
@@ -2104,6 +2383,10 @@ free_fd:
 	return -1;
 }
 
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+static int tls_coalesce_flush_pending(struct tls_context *ctx, bool is_block);
+#endif
+
 int ztls_close_ctx(struct tls_context *ctx)
 {
 	int ret, err = 0;
@@ -2111,6 +2394,10 @@ int ztls_close_ctx(struct tls_context *ctx)
 	/* Try to send close notification. */
 	ctx->flags = 0;
 
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+	(void)tls_coalesce_flush_pending(ctx, true);
+#endif
+
 	(void)mbedtls_ssl_close_notify(&ctx->ssl);
 
 	err = tls_release(ctx);
@@ -2258,32 +2545,15 @@ error:
 	return -1;
 }
 
-static ssize_t send_tls(struct tls_context *ctx, const void *buf,
-			size_t len, int flags)
+/* Write at most one record, mbedTLS limiting the length to the maximum
+ * record payload.
+ */
+static ssize_t tls_write(struct tls_context *ctx, const void *buf,
+			 size_t len, bool is_block, k_timepoint_t end)
 {
-	const bool is_block = is_blocking(ctx->sock, flags);
 	k_timeout_t timeout;
-	k_timepoint_t end;
 	int ret;
 
-	if (ctx->error != 0) {
-		errno = ctx->error;
-		return -1;
-	}
-
-	if (ctx->session_closed) {
-		errno = ECONNABORTED;
-		return -1;
-	}
-
-	if (!is_block) {
-		timeout = K_NO_WAIT;
-	} else {
-		timeout = ctx->options.timeout_tx;
-	}
-
-	end = sys_timepoint_calc(timeout);
-
 	do {
 		ret = mbedtls_ssl_write(&ctx->ssl, buf, len);
 		if (ret >= 0) {
@@ -2337,6 +2607,197 @@ static ssize_t send_tls(struct tls_context *ctx, const void *buf,
 	return -1;
 }
 
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+static void tls_coalesce_clear(struct tls_context *ctx)
+{
+	ctx->coalesce_len = 0;
+	ctx->coalesce_sent = 0;
+	ctx->coalesce_flushing = false;
+}
+
+/* Write the coalescing buffer. On a timeout (errno set to EAGAIN), the
+ * data not written yet stays in the buffer, on other errors it is dropped
+ * as the connection cannot be used anymore.
+ */
+static int tls_coalesce_flush(struct tls_context *ctx, bool is_block,
+			      k_timepoint_t end)
+{
+	ssize_t ret;
+
+	ctx->coalesce_flushing = true;
+
+	while (ctx->coalesce_sent < ctx->coalesce_len) {
+		ret = tls_write(ctx, ctx->coalesce_buf + ctx->coalesce_sent,
+				ctx->coalesce_len - ctx->coalesce_sent,
+				is_block, end);
+		if (ret < 0) {
+			if (errno != EAGAIN) {
+				tls_coalesce_clear(ctx);
+			}
+
+			return -1;
+		}
+
+		ctx->coalesce_sent += ret;
+	}
+
+	tls_coalesce_clear(ctx);
+
+	return 0;
+}
+
+/* Data gathered before writing the buffer, so that the coalesced record
+ * is not larger than the maximum record payload of the session, which
+ * the peer may have lowered with the maximum fragment length or record
+ * size limit extensions.
+ */
+static size_t tls_coalesce_limit(struct tls_context *ctx)
+{
+	int max_payload = mbedtls_ssl_get_max_out_record_payload(&ctx->ssl);
+
+	if (max_payload <= 0) {
+		return CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE;
+	}
+
+	return MIN((size_t)max_payload, CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE);
+}
+
+/* Add the data to the coalescing buffer, and write the buffer when it is
+ * full or when no more data is announced. Returns the length of the data
+ * taken, or a negative value with errno set when nothing was taken.
+ */
+static ssize_t tls_coalesce(struct tls_context *ctx, const void *buf,
+			    size_t len, bool more, k_timepoint_t end)
+{
+	size_t limit = tls_coalesce_limit(ctx);
+	size_t copy;
+
+	if (ctx->coalesce_flushing && tls_coalesce_flush(ctx, true, end) < 0) {
+		return -1;
+	}
+
+	copy = MIN(len, limit - MIN(ctx->coalesce_len, limit));
+	memcpy(ctx->coalesce_buf + ctx->coalesce_len, buf, copy);
+	ctx->coalesce_len += copy;
+
+	if (more && ctx->coalesce_len < limit) {
+		return copy;
+	}
+
+	if (tls_coalesce_flush(ctx, true, end) < 0) {
+		if (errno != EAGAIN || copy == 0) {
+			return -1;
+		}
+
+		/* On a timeout, the data taken stays in the buffer and is
+		 * written by the next send(), recv(), poll() or close().
+		 */
+	}
+
+	return copy;
+}
+
+/* Write the data held back before reading or closing, so that the peer
+ * does not wait for it.
+ */
+static int tls_coalesce_flush_pending(struct tls_context *ctx, bool is_block)
+{
+	k_timeout_t timeout = is_block ? ctx->options.timeout_tx : K_NO_WAIT;
+
+	if (ctx->coalesce_len == 0 || ctx->error != 0) {
+		return 0;
+	}
+
+	if (tls_coalesce_flush(ctx, is_block, sys_timepoint_calc(timeout)) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+static bool tls_coalesce_buf_get(struct tls_context *ctx)
+{
+	if (ctx->coalesce_buf == NULL) {
+		ctx->coalesce_buf = mbedtls_calloc(1, CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE);
+		if (ctx->coalesce_buf == NULL) {
+			NET_DBG("No memory for the coalescing buffer");
+		}
+	}
+
+	return ctx->coalesce_buf != NULL;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0 */
+
+static ssize_t send_tls_once(struct tls_context *ctx, const void *buf,
+			     size_t len, int flags, bool is_block,
+			     k_timepoint_t end)
+{
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+	if (ctx->type == SOCK_STREAM) {
+		const bool more = (flags & ZSOCK_MSG_MORE) != 0;
+
+		/* Non-blocking writes are not held back, as nothing would
+		 * write the buffer once the socket is writable again.
+		 */
+		if (is_block && (more || ctx->coalesce_len > 0) &&
+		    tls_coalesce_buf_get(ctx)) {
+			return tls_coalesce(ctx, buf, len, more, end);
+		}
+
+		if (ctx->coalesce_len > 0 &&
+		    tls_coalesce_flush(ctx, is_block, end) < 0) {
+			return -1;
+		}
+	}
+#endif
+
+	return tls_write(ctx, buf, len, is_block, end);
+}
+
+static ssize_t send_tls(struct tls_context *ctx, const void *buf,
+			size_t len, int flags)
+{
+	const bool is_block = is_blocking(ctx->sock, flags);
+	k_timeout_t timeout;
+	k_timepoint_t end;
+	size_t sent = 0;
+	ssize_t ret;
+
+	if (ctx->error != 0) {
+		errno = ctx->error;
+		return -1;
+	}
+
+	if (ctx->session_closed) {
+		errno = ECONNABORTED;
+		return -1;
+	}
+
+	if (!is_block) {
+		timeout = K_NO_WAIT;
+	} else {
+		timeout = ctx->options.timeout_tx;
+	}
+
+	end = sys_timepoint_calc(timeout);
+
+	/* A blocking write on a stream socket writes all the data, in as
+	 * many records of the maximum size as needed, instead of returning
+	 * after the first record.
+	 */
+	do {
+		ret = send_tls_once(ctx, (const uint8_t *)buf + sent, len - sent,
+				    flags, is_block, end);
+		if (ret < 0) {
+			return sent > 0 ? sent : -1;
+		}
+
+		sent += ret;
+	} while (is_block && ctx->type == SOCK_STREAM && sent < len);
+
+	return sent;
+}
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 static ssize_t sendto_dtls_client(struct tls_context *ctx, const void *buf,
 				  size_t len, int flags,
@@ -2485,9 +2946,19 @@ static ssize_t tls_sendmsg_loop_and_send(struct tls_context *ctx,
 {
 	ssize_t len = 0;
 	ssize_t ret;
+	int last = -1;
+
+	for (int i = 0; i < msg->msg_iovlen; i++) {
+		if (msg->msg_iov[i].iov_len > 0) {
+			last = i;
+		}
+	}
 
 	for (int i = 0; i < msg->msg_iovlen; i++) {
 		struct iovec *vec = msg->msg_iov + i;
+		/* Let the buffers of a TLS stream go to the same record */
+		int vec_flags = (ctx->type == SOCK_STREAM && i != last) ?
+				(flags | ZSOCK_MSG_MORE) : flags;
 		size_t sent = 0;
 
 		if (vec->iov_len == 0) {
@@ -2498,7 +2969,7 @@ static ssize_t tls_sendmsg_loop_and_send(struct tls_context *ctx,
 			uint8_t *ptr = (uint8_t *)vec->iov_base + sent;
 
 			ret = ztls_sendto_ctx(ctx, ptr, vec->iov_len - sent,
-					      flags, msg->msg_name,
+					      vec_flags, msg->msg_name,
 					      msg->msg_namelen);
 			if (ret < 0) {
 				return ret;
@@ -2566,6 +3037,14 @@ static ssize_t recv_tls(struct tls_context *ctx, void *buf,
 		return 0;
 	}
 
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+	ret = tls_coalesce_flush_pending(ctx, is_block);
+	if (ret < 0 && ret != -EAGAIN) {
+		errno = -ret;
+		return -1;
+	}
+#endif
+
 	if (!is_block) {
 		timeout = K_NO_WAIT;
 	} else {
@@ -2574,6 +3053,12 @@ static ssize_t recv_tls(struct tls_context *ctx, void *buf,
 
 	end = sys_timepoint_calc(timeout);
 
+	/* Once some data is read, keep on reading the records already
+	 * received while there is room for them, without blocking. This saves
+	 * a call per record when the peer writes small records. mbedTLS
+	 * decrypts the records in its own buffer, so the data is copied once
+	 * anyway.
+	 */
 	do {
 		size_t read_len = max_len - recv_len;
 
@@ -2603,6 +3088,11 @@ static ssize_t recv_tls(struct tls_context *ctx, void *buf,
 			    ret ==  MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS) {
 				int timeout_ms;
 
+				if (recv_len > 0 && !waitall) {
+					/* No more records received so far */
+					break;
+				}
+
 				if (!is_block) {
 					ret = -EAGAIN;
 					goto err;
@@ -2629,6 +3119,14 @@ static ssize_t recv_tls(struct tls_context *ctx, void *buf,
 			} else {
 				NET_ERR("TLS recv error: -%x", -ret);
 				ret = -EIO;
+
+				if (recv_len > 0 && !waitall) {
+					/* Return the data read so far, the
+					 * next call reports the error.
+					 */
+					ctx->error = EIO;
+					break;
+				}
 			}
 
 err:
@@ -2641,7 +3139,7 @@ err:
 		}
 
 		recv_len += ret;
-	} while ((recv_len == 0) || (waitall && (recv_len < max_len)));
+	} while (recv_len < max_len);
 
 	return recv_len;
 }
@@ -3000,6 +3498,13 @@ static int ztls_poll_prepare_ctx(struct tls_context *ctx,
 		pfd->events &= ~ZSOCK_POLLIN;
 	}
 
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+	/* The peer might wait for the data held back before sending
+	 * anything, try to write it without blocking.
+	 */
+	(void)tls_coalesce_flush_pending(ctx, false);
+#endif
+
 	obj = z_get_fd_obj_and_vtable(
 		ctx->sock, (const struct fd_op_vtable **)&vtable, &lock);
 	if (obj == NULL) {
@@ -3471,6 +3976,12 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_get(ctx, optval, optlen);
 		break;
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+	case TLS_SESSION_TICKETS:
+		err = tls_opt_session_tickets_get(ctx, optval, optlen);
+		break;
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	case TLS_DTLS_HANDSHAKE_TIMEOUT_MIN:
 		err = tls_opt_dtls_handshake_timeout_get(ctx, optval,
@@ -3593,6 +4104,12 @@ int ztls_setsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_purge_set(ctx, optval, optlen);
 		break;
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+	case TLS_SESSION_TICKETS:
+		err = tls_opt_session_tickets_set(ctx, optval, optlen);
+		break;
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	case TLS_DTLS_HANDSHAKE_TIMEOUT_MIN:
 		err = tls_opt_dtls_handshake_timeout_set(ctx, optval,
@@ -3738,6 +4255,39 @@ static int tls_sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return ztls_poll_offload(fds, nfds, timeout);
 	}
 
+	case ZFD_IOCTL_POLL_WATCH: {
+		const struct fd_op_vtable *vtable;
+		struct zvfs_poll_watch *watch;
+		void *fd_obj;
+		int ret;
+
+		/* Readiness of the TLS socket follows the underlying one,
+		 * the watch is attached there.
+		 */
+		fd_obj = z_get_fd_obj_and_vtable(ctx->sock,
+				(const struct fd_op_vtable **)&vtable, NULL);
+		if (fd_obj == NULL) {
+			errno = EBADF;
+			return -1;
+		}
+
+		watch = va_arg(args, struct zvfs_poll_watch *);
+
+		ret = z_fdtable_call_ioctl(vtable, fd_obj, request, watch);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* Data already decrypted by mbedTLS will not show up on the
+		 * underlying socket again.
+		 */
+		if (mbedtls_ssl_get_bytes_avail(&ctx->ssl) > 0) {
+			watch->cb(watch);
+		}
+
+		return 0;
+	}
+
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
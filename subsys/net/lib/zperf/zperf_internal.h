@@ -39,6 +39,9 @@
 
 #define PACKET_SIZE_MAX CONFIG_NET_ZPERF_MAX_PACKET_SIZE
 
+/* Number of packets a zero-copy upload may have in flight */
+#define ZEROCOPY_BUF_COUNT 16
+
 #define MY_SRC_PORT 50000
 #define DEF_PORT 5001
 #define DEF_PORT_STR STRINGIFY(DEF_PORT)
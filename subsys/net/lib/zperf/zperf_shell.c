@@ -404,6 +404,34 @@ static int shell_cmd_download(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+#ifdef CONFIG_NET_SOCKETS_ZEROCOPY
+		case 'z':
+			param->zerocopy = true;
+			opt_cnt += 1;
+			break;
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+#if CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1
+		case 'B':
+			i++;
+			if (i >= argc) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "-B <batch size>\n");
+				return -ENOEXEC;
+			}
+
+			param->batch = strtoul(argv[i], NULL, 10);
+			if (param->batch < 1 ||
+			    param->batch > CONFIG_NET_ZPERF_UDP_BATCH_MAX) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			opt_cnt += 2;
+			break;
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1 */
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -926,6 +954,34 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+#ifdef CONFIG_NET_SOCKETS_ZEROCOPY
+		case 'z':
+			param.options.zerocopy = true;
+			opt_cnt += 1;
+			break;
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+#if CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1
+		case 'B': {
+			int batch = parse_arg(&i, argc, argv);
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -B option\n");
+				return -ENOEXEC;
+			}
+			if (batch < 1 || batch > CONFIG_NET_ZPERF_UDP_BATCH_MAX) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.options.batch = batch;
+			opt_cnt += 2;
+			break;
+		}
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1 */
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -1159,6 +1215,34 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+#ifdef CONFIG_NET_SOCKETS_ZEROCOPY
+		case 'z':
+			param.options.zerocopy = true;
+			opt_cnt += 1;
+			break;
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+#if CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1
+		case 'B': {
+			int batch = parse_arg(&i, argc, argv);
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -B option\n");
+				return -ENOEXEC;
+			}
+			if (batch < 1 || batch > CONFIG_NET_ZPERF_UDP_BATCH_MAX) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.options.batch = batch;
+			opt_cnt += 2;
+			break;
+		}
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1 */
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -1365,6 +1449,12 @@ static int cmd_tcp_download(const struct shell *sh, size_t argc,
 			return -ENOEXEC;
 		}
 
+		if (param.batch > 1U) {
+			shell_fprintf(sh, SHELL_WARNING,
+				      "TCP does not support -B option\n");
+			return -ENOEXEC;
+		}
+
 		ret = zperf_bind_host(sh, argc - start, &argv[start], &param);
 		if (ret < 0) {
 			shell_fprintf(sh, SHELL_WARNING,
@@ -1476,6 +1566,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
+#ifdef CONFIG_NET_SOCKETS_ZEROCOPY
+		  "-z: Send without copying the data\n"
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
 		  "Example: tcp upload 192.0.2.2 1111 1 1K\n"
 		  "Example: tcp upload 2001:db8::2\n",
 		  cmd_tcp_upload),
@@ -1496,6 +1589,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
+#ifdef CONFIG_NET_SOCKETS_ZEROCOPY
+		  "-z: Send without copying the data\n"
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
 		  "Example: tcp upload2 v6 1 1K\n"
 		  "Example: tcp upload2 v4\n"
 #if defined(CONFIG_NET_IPV6) && defined(MY_IP6ADDR_SET)
@@ -1511,6 +1607,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 	SHELL_CMD(download, &zperf_cmd_tcp_download,
 		  "[<port>]:  Server port to listen on/connect to\n"
 		  "[<host>]:  Bind to <host>, an interface address\n"
+#ifdef CONFIG_NET_SOCKETS_ZEROCOPY
+		  "Available options:\n"
+		  "-z: Receive without copying the data\n"
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
 		  "Example: tcp download 5001 192.168.0.1\n",
 		  cmd_tcp_download),
 	SHELL_SUBCMD_SET_END
@@ -1542,6 +1642,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+#ifdef CONFIG_NET_SOCKETS_ZEROCOPY
+		  "-z: Send without copying the data\n"
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+#if CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1
+		  "-B count: Send count packets per call\n"
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1 */
 		  "Example: udp upload 192.0.2.2 1111 1 1K 1M\n"
 		  "Example: udp upload 2001:db8::2\n",
 		  cmd_udp_upload),
@@ -1563,6 +1669,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+#ifdef CONFIG_NET_SOCKETS_ZEROCOPY
+		  "-z: Send without copying the data\n"
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+#if CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1
+		  "-B count: Send count packets per call\n"
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1 */
 		  "Example: udp upload2 v4 1 1K 1M\n"
 		  "Example: udp upload2 v6\n"
 #if defined(CONFIG_NET_IPV6) && defined(MY_IP6ADDR_SET)
@@ -1581,6 +1693,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "[<host>]:  Bind to <host>, an interface address\n"
 		  "Available options:\n"
 		  "-I <interface name>: Specify host interface name\n"
+#ifdef CONFIG_NET_SOCKETS_ZEROCOPY
+		  "-z: Receive without copying the data\n"
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+#if CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1
+		  "-B <count>: Receive up to count packets per call\n"
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1 */
 		  "Example: udp download 5001 192.168.0.1\n",
 		  cmd_udp_download),
 	SHELL_SUBCMD_SET_END
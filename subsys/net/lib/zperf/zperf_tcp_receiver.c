@@ -35,6 +35,7 @@ static void *tcp_user_data;
 static bool tcp_server_running;
 static uint16_t tcp_server_port;
 static struct sockaddr tcp_server_addr;
+static bool tcp_server_zerocopy;
 
 static struct zsock_pollfd fds[SOCK_ID_MAX];
 static struct sockaddr sock_addr[SOCK_ID_MAX];
@@ -121,6 +122,24 @@ static void tcp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_TCP);
 }
 
+static int tcp_recv(int sock, uint8_t *buf, size_t len)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	if (tcp_server_zerocopy) {
+		struct net_buf *zc_buf = NULL;
+		int ret;
+
+		/* The data is only counted, it is not copied at all */
+		ret = zsock_recv_buf(sock, &zc_buf, 0, NULL, NULL);
+		zsock_buf_release(zc_buf);
+
+		return ret;
+	}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+	return zsock_recv(sock, buf, len, 0);
+}
+
 static int tcp_recv_data(struct net_socket_service_event *pev)
 {
 	static uint8_t buf[TCP_RECEIVER_BUF_SIZE];
@@ -189,7 +208,7 @@ static int tcp_recv_data(struct net_socket_service_event *pev)
 		}
 
 	} else {
-		ret = zsock_recv(pev->event.fd, buf, sizeof(buf), 0);
+		ret = tcp_recv(pev->event.fd, buf, sizeof(buf));
 		if (ret < 0) {
 			(void)zsock_getsockopt(pev->event.fd, SOL_SOCKET,
 					       SO_DOMAIN, &family, &optlen);
@@ -408,6 +427,7 @@ int zperf_tcp_download(const struct zperf_download_params *param,
 	tcp_session_cb = callback;
 	tcp_user_data = user_data;
 	tcp_server_port = param->port;
+	tcp_server_zerocopy = param->zerocopy;
 	memcpy(&tcp_server_addr, &param->addr, sizeof(struct sockaddr));
 
 	ret = zperf_tcp_receiver_init();
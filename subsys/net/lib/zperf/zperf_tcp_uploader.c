@@ -11,6 +11,7 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #include <errno.h>
 
+#include <zephyr/net/buf.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/zperf.h>
 
@@ -36,9 +37,53 @@ static ssize_t sendall(int sock, const void *buf, size_t len)
 	return 0;
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+/* In zero-copy mode the sample data is sent in place. Running out of
+ * buffers throttles the upload until the peer has acknowledged data and
+ * the connection has released them.
+ */
+NET_BUF_POOL_DEFINE(tcp_zerocopy_pool, ZEROCOPY_BUF_COUNT, 0, 0, NULL);
+
+static ssize_t send_zerocopy(int sock, const void *buf, size_t len,
+			     k_timepoint_t end)
+{
+	struct net_buf *zc_buf;
+	ssize_t ret;
+
+	zc_buf = net_buf_alloc_with_data(&tcp_zerocopy_pool, (void *)buf, len,
+					 sys_timepoint_timeout(end));
+	if (zc_buf == NULL) {
+		errno = ETIMEDOUT;
+		return -1;
+	}
+
+	ret = zsock_send_buf(sock, zc_buf, 0, NULL, 0);
+	if (ret < 0) {
+		net_buf_unref(zc_buf);
+		return ret;
+	}
+
+	return 0;
+}
+#else
+static ssize_t send_zerocopy(int sock, const void *buf, size_t len,
+			     k_timepoint_t end)
+{
+	ARG_UNUSED(sock);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(len);
+	ARG_UNUSED(end);
+
+	errno = ENOTSUP;
+
+	return -1;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 static int tcp_upload(int sock,
 		      unsigned int duration_in_ms,
 		      unsigned int packet_size,
+		      bool zerocopy,
 		      struct zperf_results *results)
 {
 	k_timepoint_t end = sys_timepoint_calc(K_MSEC(duration_in_ms));
@@ -66,7 +111,17 @@ static int tcp_upload(int sock,
 
 	do {
 		/* Send the packet */
-		ret = sendall(sock, sample_packet, packet_size);
+		if (zerocopy) {
+			ret = send_zerocopy(sock, sample_packet, packet_size, end);
+			if (ret < 0 && errno == ETIMEDOUT) {
+				/* The upload ended while waiting for buffers */
+				ret = 0;
+				break;
+			}
+		} else {
+			ret = sendall(sock, sample_packet, packet_size);
+		}
+
 		if (ret < 0) {
 			if (nb_errors == 0 && ret != -ENOMEM) {
 				NET_ERR("Failed to send the packet (%d)", errno);
@@ -139,7 +194,8 @@ int zperf_tcp_upload(const struct zperf_upload_params *param,
 		return sock;
 	}
 
-	ret = tcp_upload(sock, param->duration_ms, param->packet_size, result);
+	ret = tcp_upload(sock, param->duration_ms, param->packet_size,
+			 param->options.zerocopy, result);
 
 	zsock_close(sock);
 
@@ -188,7 +244,8 @@ static void tcp_upload_async_work(struct k_work *work)
 			} else {
 				round_duration = report_interval;
 			}
-			ret = tcp_upload(sock, round_duration, param.packet_size, &periodic_result);
+			ret = tcp_upload(sock, round_duration, param.packet_size,
+					 param.options.zerocopy, &periodic_result);
 			if (ret < 0) {
 				upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
 						     upload_ctx->user_data);
@@ -205,7 +262,8 @@ static void tcp_upload_async_work(struct k_work *work)
 		result.packet_size = periodic_result.packet_size;
 
 	} else {
-		ret = tcp_upload(sock, param.duration_ms, param.packet_size, &result);
+		ret = tcp_upload(sock, param.duration_ms, param.packet_size,
+				 param.options.zerocopy, &result);
 		if (ret < 0) {
 			upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
 					     upload_ctx->user_data);
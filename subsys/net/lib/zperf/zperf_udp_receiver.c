@@ -42,6 +42,11 @@ static void *udp_user_data;
 static bool udp_server_running;
 static uint16_t udp_server_port;
 static struct sockaddr udp_server_addr;
+static bool udp_server_zerocopy;
+static uint16_t udp_server_batch;
+
+/* Room for a batch of datagrams, a single one unless batch mode is enabled */
+static uint8_t udp_recv_bufs[CONFIG_NET_ZPERF_UDP_BATCH_MAX][UDP_RECEIVER_BUF_SIZE];
 
 struct zsock_pollfd fds[SOCK_ID_MAX] = { 0 };
 
@@ -307,9 +312,76 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
+static int udp_recv(int sock, uint8_t *buf, size_t len,
+		    struct sockaddr *addr, socklen_t *addrlen)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	if (udp_server_zerocopy) {
+		struct net_buf *zc_buf = NULL;
+		int ret;
+
+		/* Only the iperf header is copied out of the buffers */
+		ret = zsock_recv_buf(sock, &zc_buf, 0, addr, addrlen);
+		if (ret > 0) {
+			(void)net_buf_linearize(buf, len, zc_buf, 0,
+						sizeof(struct zperf_udp_datagram));
+		}
+
+		zsock_buf_release(zc_buf);
+
+		return ret;
+	}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+	return zsock_recvfrom(sock, buf, len, 0, addr, addrlen);
+}
+
+#if CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1
+/* Receive what is queued, up to a batch of datagrams, with a single call */
+static int udp_recv_batch(int sock)
+{
+	static struct sockaddr addrs[CONFIG_NET_ZPERF_UDP_BATCH_MAX];
+	static struct iovec iov[CONFIG_NET_ZPERF_UDP_BATCH_MAX];
+	static struct mmsghdr msgs[CONFIG_NET_ZPERF_UDP_BATCH_MAX];
+	int ret;
+
+	for (int i = 0; i < udp_server_batch; i++) {
+		iov[i].iov_base = udp_recv_bufs[i];
+		iov[i].iov_len = sizeof(udp_recv_bufs[i]);
+
+		(void)memset(&msgs[i], 0, sizeof(msgs[i]));
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* The socket is readable, so there is at least one datagram */
+	ret = zsock_recvmmsg(sock, msgs, udp_server_batch, ZSOCK_MSG_DONTWAIT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		udp_received(sock, &addrs[i], udp_recv_bufs[i], msgs[i].msg_len);
+	}
+
+	return ret;
+}
+#else
+static int udp_recv_batch(int sock)
+{
+	ARG_UNUSED(sock);
+
+	errno = ENOTSUP;
+
+	return -1;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1 */
+
 static int udp_recv_data(struct net_socket_service_event *pev)
 {
-	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	uint8_t *buf = udp_recv_bufs[0];
 	int ret = 0;
 	int family, sock_error;
 	struct sockaddr addr;
@@ -336,8 +408,13 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		return 0;
 	}
 
-	ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), 0,
-			     &addr, &addrlen);
+	if (udp_server_batch > 1U) {
+		ret = udp_recv_batch(pev->event.fd);
+	} else {
+		ret = udp_recv(pev->event.fd, buf, UDP_RECEIVER_BUF_SIZE,
+			       &addr, &addrlen);
+	}
+
 	if (ret < 0) {
 		ret = -errno;
 		(void)zsock_getsockopt(pev->event.fd, SOL_SOCKET,
@@ -347,7 +424,9 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		goto error;
 	}
 
-	udp_received(pev->event.fd, &addr, buf, ret);
+	if (udp_server_batch <= 1U) {
+		udp_received(pev->event.fd, &addr, buf, ret);
+	}
 
 	return ret;
 
@@ -519,9 +598,16 @@ int zperf_udp_download(const struct zperf_download_params *param,
 		return -EALREADY;
 	}
 
+	if (param->batch > CONFIG_NET_ZPERF_UDP_BATCH_MAX ||
+	    (param->batch > 1U && param->zerocopy)) {
+		return -EINVAL;
+	}
+
 	udp_session_cb = callback;
 	udp_user_data  = user_data;
 	udp_server_port = param->port;
+	udp_server_zerocopy = param->zerocopy;
+	udp_server_batch = MAX(param->batch, 1U);
 	memcpy(&udp_server_addr, &param->addr, sizeof(struct sockaddr));
 
 	if (param->if_name[0]) {
@@ -9,6 +9,7 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
 
+#include <zephyr/net/buf.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/zperf.h>
 
@@ -20,6 +21,115 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 
 static struct zperf_async_upload_context udp_async_upload_ctx;
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+#define ZEROCOPY_HDR_LEN (sizeof(struct zperf_udp_datagram) + \
+			  sizeof(struct zperf_client_hdr_v1))
+
+/* In zero-copy mode a datagram is a copy of the iperf headers, followed
+ * by the payload of the sample packet which is sent in place.
+ */
+NET_BUF_POOL_DEFINE(udp_zerocopy_hdr_pool, ZEROCOPY_BUF_COUNT,
+		    ZEROCOPY_HDR_LEN, 0, NULL);
+NET_BUF_POOL_DEFINE(udp_zerocopy_pool, ZEROCOPY_BUF_COUNT, 0, 0, NULL);
+
+static int send_zerocopy(int sock, size_t packet_size)
+{
+	size_t hdr_len = MIN(packet_size, ZEROCOPY_HDR_LEN);
+	struct net_buf *hdr, *payload;
+	int ret;
+
+	hdr = net_buf_alloc(&udp_zerocopy_hdr_pool, K_FOREVER);
+	net_buf_add_mem(hdr, sample_packet, hdr_len);
+
+	if (packet_size > hdr_len) {
+		payload = net_buf_alloc_with_data(&udp_zerocopy_pool,
+						  sample_packet + hdr_len,
+						  packet_size - hdr_len,
+						  K_FOREVER);
+		net_buf_frag_add(hdr, payload);
+	}
+
+	ret = zsock_send_buf(sock, hdr, 0, NULL, 0);
+	if (ret < 0) {
+		net_buf_unref(hdr);
+	}
+
+	return ret;
+}
+#else
+static int send_zerocopy(int sock, size_t packet_size)
+{
+	ARG_UNUSED(sock);
+	ARG_UNUSED(packet_size);
+
+	errno = ENOTSUP;
+
+	return -1;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+#if CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1
+#define BATCH_HDR_LEN (sizeof(struct zperf_udp_datagram) + \
+		       sizeof(struct zperf_client_hdr_v1))
+
+/* In batch mode every datagram gets a copy of the iperf headers with its
+ * own sequence number, followed by the payload of the sample packet.
+ */
+static uint8_t batch_hdrs[CONFIG_NET_ZPERF_UDP_BATCH_MAX][BATCH_HDR_LEN];
+static struct iovec batch_iov[CONFIG_NET_ZPERF_UDP_BATCH_MAX][2];
+static struct mmsghdr batch_msgs[CONFIG_NET_ZPERF_UDP_BATCH_MAX];
+
+static int send_batch(int sock, size_t packet_size, uint32_t id,
+		      uint32_t count)
+{
+	size_t hdr_len = MIN(packet_size, BATCH_HDR_LEN);
+	struct zperf_udp_datagram *datagram;
+	uint32_t sent = 0U;
+	int ret;
+
+	for (uint32_t i = 0U; i < count; i++) {
+		memcpy(batch_hdrs[i], sample_packet, hdr_len);
+
+		datagram = (struct zperf_udp_datagram *)batch_hdrs[i];
+		datagram->id = htonl(id + i);
+
+		batch_iov[i][0].iov_base = batch_hdrs[i];
+		batch_iov[i][0].iov_len = hdr_len;
+		batch_iov[i][1].iov_base = sample_packet + hdr_len;
+		batch_iov[i][1].iov_len = packet_size - hdr_len;
+
+		(void)memset(&batch_msgs[i], 0, sizeof(batch_msgs[i]));
+		batch_msgs[i].msg_hdr.msg_iov = batch_iov[i];
+		batch_msgs[i].msg_hdr.msg_iovlen = packet_size > hdr_len ? 2 : 1;
+	}
+
+	/* Send the rest again if only a part of the batch went out */
+	while (sent < count) {
+		ret = zsock_sendmmsg(sock, &batch_msgs[sent], count - sent, 0);
+		if (ret < 0) {
+			return ret;
+		}
+
+		sent += ret;
+	}
+
+	return sent;
+}
+#else
+static int send_batch(int sock, size_t packet_size, uint32_t id,
+		      uint32_t count)
+{
+	ARG_UNUSED(sock);
+	ARG_UNUSED(packet_size);
+	ARG_UNUSED(id);
+	ARG_UNUSED(count);
+
+	errno = ENOTSUP;
+
+	return -1;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH_MAX > 1 */
+
 static inline void zperf_upload_decode_stat(const uint8_t *data,
 					    size_t datalen,
 					    struct zperf_results *results)
@@ -145,8 +255,10 @@ static int udp_upload(int sock, int port,
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
+	uint32_t batch = MAX(param->options.batch, 1U);
 	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
-	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
+	/* In batch mode, the rate is kept per batch of packets */
+	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us * batch);
 	uint32_t delay = packet_duration;
 	uint32_t nb_packets = 0U;
 	int64_t start_time, end_time;
@@ -165,6 +277,12 @@ static int udp_upload(int sock, int port,
 		packet_size = sizeof(struct zperf_udp_datagram);
 	}
 
+	if (batch > CONFIG_NET_ZPERF_UDP_BATCH_MAX ||
+	    (batch > 1U && param->options.zerocopy)) {
+		NET_ERR("Unsupported batch size %u", batch);
+		return -EINVAL;
+	}
+
 	/* Start the loop */
 	start_time = k_uptime_ticks();
 	last_loop_time = start_time;
@@ -227,12 +345,19 @@ static int udp_upload(int sock, int port,
 		hdr->num_of_bytes = htonl(packet_size);
 
 		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		if (batch > 1U) {
+			ret = send_batch(sock, packet_size, nb_packets, batch);
+		} else if (param->options.zerocopy) {
+			ret = send_zerocopy(sock, packet_size);
+		} else {
+			ret = zsock_send(sock, sample_packet, packet_size, 0);
+		}
+
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			return -errno;
 		} else {
-			nb_packets++;
+			nb_packets += batch;
 		}
 
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
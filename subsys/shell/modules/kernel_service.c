@@ -159,6 +159,11 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 			    (uint32_t)rt_stats_thread.peak_cycles);
 		shell_print(sh, "\tAverage execution cycles: %u",
 			    (uint32_t)rt_stats_thread.average_cycles);
+#endif
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+		shell_print(sh, "\tPeak wakeup latency cycles: %u (%u wakeups)",
+			    rt_stats_thread.wakeup_peak_cycles,
+			    rt_stats_thread.wakeup_count);
 #endif
 	} else {
 		shell_print(sh, "\tTotal execution cycles: ? (? %%)");
@@ -292,6 +297,78 @@ static void shell_stack_dump(const struct k_thread *thread, void *user_data)
 		thread, tname ? tname : "NA", size, unused, size - unused, size, pcnt);
 }
 
+#if defined(CONFIG_SCHED_THREAD_WAKEUP_LATENCY) && defined(CONFIG_THREAD_MONITOR)
+
+struct wakeup_dump_ctx {
+	const struct shell *sh;
+	const struct k_thread *thread;
+	bool found;
+};
+
+static void shell_wakeup_dump(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	struct wakeup_dump_ctx *ctx = user_data;
+	k_thread_runtime_stats_t stats;
+	const char *tname;
+
+	if ((ctx->thread != NULL) && (ctx->thread != cthread)) {
+		return;
+	}
+
+	ctx->found = true;
+
+	if (k_thread_runtime_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+
+	shell_print(ctx->sh, "%p %-" STRINGIFY(THREAD_MAX_NAM_LEN) "s "
+		    "wakeups %u, peak %u cycles",
+		    thread, tname ? tname : "NA",
+		    stats.wakeup_count, stats.wakeup_peak_cycles);
+
+	for (int i = 0; i < CONFIG_SCHED_THREAD_WAKEUP_LATENCY_BUCKETS; i++) {
+		uint32_t low = (i == 0) ? 0U : BIT(i);
+
+		if (stats.wakeup_buckets[i] == 0U) {
+			continue;
+		}
+
+		if (i == CONFIG_SCHED_THREAD_WAKEUP_LATENCY_BUCKETS - 1) {
+			shell_print(ctx->sh, "\t%10u -            cycles: %u",
+				    low, stats.wakeup_buckets[i]);
+		} else {
+			shell_print(ctx->sh, "\t%10u - %10u cycles: %u",
+				    low, (uint32_t)BIT(i + 1) - 1U,
+				    stats.wakeup_buckets[i]);
+		}
+	}
+}
+
+static int cmd_kernel_wakeup(const struct shell *sh, size_t argc, char **argv)
+{
+	struct wakeup_dump_ctx ctx = {
+		.sh = sh,
+	};
+
+	if (argc > 1) {
+		ctx.thread = UINT_TO_POINTER(strtoll(argv[1], NULL, 16));
+	}
+
+	k_thread_foreach_unlocked(shell_wakeup_dump, &ctx);
+
+	if ((ctx.thread != NULL) && !ctx.found) {
+		shell_error(sh, "Invalid thread id %p", (void *)ctx.thread);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY && CONFIG_THREAD_MONITOR */
+
 K_KERNEL_STACK_ARRAY_DECLARE(z_interrupt_stacks, CONFIG_MP_MAX_NUM_CPUS,
 			     CONFIG_ISR_STACK_SIZE);
 
@@ -468,6 +545,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD_ARG(uptime, NULL, "Kernel uptime. Can be called with the -p or --pretty options",
 		      cmd_kernel_uptime, 1, 1),
 	SHELL_CMD(version, NULL, "Kernel version.", cmd_kernel_version),
+#if defined(CONFIG_SCHED_THREAD_WAKEUP_LATENCY) && defined(CONFIG_THREAD_MONITOR)
+	SHELL_CMD_ARG(wakeup, NULL, "Thread wakeup latency histograms. "
+		      "Can be called with a thread id", cmd_kernel_wakeup, 1, 1),
+#endif
 	SHELL_CMD_ARG(sleep, NULL, "ms", cmd_kernel_sleep, 2, 0),
 #if defined(CONFIG_LOG_RUNTIME_FILTERING)
 	SHELL_CMD_ARG(log-level, NULL, "<module name> <severity (0-4)>",
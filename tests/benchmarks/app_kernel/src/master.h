@@ -34,6 +34,7 @@
 #define NR_OF_SEMA_RUNS 500
 #define NR_OF_MUTEX_RUNS 1000
 #define NR_OF_MAP_RUNS 1000
+#define NR_OF_MAP_BULK_PAGES 2 /* all of MAP1 */
 #define NR_OF_MBOX_RUNS 128
 #define NR_OF_PIPE_RUNS 256
 #define SEMA_WAIT_TIME (5000)
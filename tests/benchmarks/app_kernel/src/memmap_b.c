@@ -19,6 +19,7 @@ void memorymap_test(void)
 	timing_t  end;
 	int i;
 	void *p;
+	void *pages[NR_OF_MAP_BULK_PAGES];
 	int alloc_status;
 
 	PRINT_STRING(dashline);
@@ -37,4 +38,22 @@ void memorymap_test(void)
 
 	PRINT_F(FORMAT, "average alloc and dealloc memory page",
 		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, (2 * NR_OF_MAP_RUNS)));
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_MAP_RUNS; i++) {
+		alloc_status = k_mem_slab_alloc_bulk(&MAP1, pages,
+						     NR_OF_MAP_BULK_PAGES);
+		if (alloc_status != 0) {
+			PRINT_F(FORMAT,
+				"Error: Slab allocation failed.", alloc_status);
+			break;
+		}
+		k_mem_slab_free_bulk(&MAP1, pages, NR_OF_MAP_BULK_PAGES);
+	}
+	end = timing_timestamp_get();
+	et = (uint32_t)timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "average bulk alloc and dealloc memory page",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et,
+			(2 * NR_OF_MAP_RUNS * NR_OF_MAP_BULK_PAGES)));
 }
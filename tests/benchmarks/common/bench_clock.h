@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTS_BENCHMARKS_COMMON_BENCH_CLOCK_H_
+#define ZEPHYR_TESTS_BENCHMARKS_COMMON_BENCH_CLOCK_H_
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+
+#if defined(CONFIG_NATIVE_LIBRARY)
+/* Implemented in host_clock.c, on the host side */
+uint64_t bench_host_time_us(void);
+
+/* Simulated time does not advance while the CPU is busy, so the host
+ * clock is used.
+ */
+static inline uint64_t bench_now_us(void)
+{
+	return bench_host_time_us();
+}
+#else
+static inline uint64_t bench_now_us(void)
+{
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+#endif
+
+#endif /* ZEPHYR_TESTS_BENCHMARKS_COMMON_BENCH_CLOCK_H_ */
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Built with the native simulator runner, runs on the host side */
+
+#include <stdint.h>
+#include <time.h>
+
+uint64_t bench_host_time_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000U + ts.tv_nsec / 1000U;
+}
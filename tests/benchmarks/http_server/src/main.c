@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/printk.h>
+
+#include "bench_clock.h"
+
+/* HTTP server request rate benchmark. The server has a service with
+ * NUM_RESOURCES exact resources, as a REST API would have, plus a couple of
+ * wildcard ones for the static files. The load generator runs in the same
+ * image and sends GET requests over the loopback interface, first from one
+ * client thread, then from CLIENT_THREADS threads at once. Each request uses
+ * a new connection, as the server closes it after the response.
+ *
+ * Before that, the resource lookup alone is timed for the same kind of paths.
+ */
+
+#define SERVER_ADDR "127.0.0.1"
+#define SERVER_PORT 8080
+
+#define NUM_RESOURCES       100
+#define CLIENT_THREADS      4
+#define REQUESTS            1000U
+#define LOOKUPS             10000U
+#define LOOKUP_PATHS        64
+#define PATH_LEN            sizeof("/api/v1/item99?id=4294967295")
+#define CLIENT_STACK_SIZE   2048
+#define CLIENT_PRIORITY     K_PRIO_PREEMPT(8)
+
+extern struct http_resource_detail *get_resource_detail(const char *path,
+							int *path_len,
+							bool is_websocket);
+
+static uint16_t bench_service_port = SERVER_PORT;
+HTTP_SERVICE_DEFINE(bench_service, SERVER_ADDR, &bench_service_port,
+		    CONFIG_HTTP_SERVER_MAX_CLIENTS, CONFIG_HTTP_SERVER_MAX_CLIENTS, NULL);
+
+static const char bench_body[] = "ok";
+
+static struct http_resource_detail_static bench_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.content_type = "text/plain",
+	},
+	.static_data = bench_body,
+	.static_data_len = sizeof(bench_body) - 1,
+};
+
+#define BENCH_RESOURCE(n, _)						\
+	HTTP_RESOURCE_DEFINE(bench_item_##n, bench_service,		\
+			     "/api/v1/item" #n, &bench_detail)
+
+LISTIFY(NUM_RESOURCES, BENCH_RESOURCE, (;));
+
+HTTP_RESOURCE_DEFINE(bench_static, bench_service, "/static/*", &bench_detail);
+HTTP_RESOURCE_DEFINE(bench_images, bench_service, "/img/*.png", &bench_detail);
+
+static K_THREAD_STACK_ARRAY_DEFINE(client_stacks, CLIENT_THREADS, CLIENT_STACK_SIZE);
+static struct k_thread client_threads[CLIENT_THREADS];
+
+static atomic_t next_request;
+static atomic_t failed;
+
+/* Three requests out of four go to the API, the others to static files */
+static void request_path(char *path, size_t len, uint32_t n)
+{
+	switch (n % 8) {
+	case 3:
+		snprintk(path, len, "/static/app%u.js", n % 16);
+		break;
+	case 7:
+		snprintk(path, len, "/img/logo%u.png", n % 16);
+		break;
+	default:
+		snprintk(path, len, "/api/v1/item%u?id=%u", n % NUM_RESOURCES, n);
+		break;
+	}
+}
+
+static int send_request(const struct sockaddr_in *sa, uint32_t n)
+{
+	static const char status_ok[] = "HTTP/1.1 200";
+	char path[PATH_LEN];
+	char buf[128];
+	size_t received = 0;
+	bool ok = false;
+	int fd, ret, len;
+
+	request_path(path, sizeof(path), n);
+	len = snprintk(buf, sizeof(buf),
+		       "GET %s HTTP/1.1\r\nHost: " SERVER_ADDR "\r\n\r\n", path);
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	ret = zsock_connect(fd, (const struct sockaddr *)sa, sizeof(*sa));
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	ret = zsock_send(fd, buf, len, 0);
+	if (ret != len) {
+		ret = -EIO;
+		goto out;
+	}
+
+	/* The server closes the connection after the response */
+	while (true) {
+		ret = zsock_recv(fd, buf, sizeof(buf), 0);
+		if (ret <= 0) {
+			break;
+		}
+
+		if (received == 0) {
+			ok = (size_t)ret >= sizeof(status_ok) - 1 &&
+			     memcmp(buf, status_ok, sizeof(status_ok) - 1) == 0;
+		}
+
+		received += ret;
+	}
+
+	ret = ok ? 0 : -EBADMSG;
+
+out:
+	(void)zsock_close(fd);
+
+	return ret;
+}
+
+static void client_thread(void *p1, void *p2, void *p3)
+{
+	const struct sockaddr_in *sa = p1;
+	atomic_val_t n;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while ((n = atomic_inc(&next_request)) < REQUESTS) {
+		if (send_request(sa, n) < 0) {
+			atomic_inc(&failed);
+		}
+	}
+}
+
+static void bench_requests(const struct sockaddr_in *sa, int clients)
+{
+	uint64_t start, elapsed;
+
+	atomic_set(&next_request, 0);
+	atomic_set(&failed, 0);
+
+	start = bench_now_us();
+
+	for (int i = 0; i < clients; i++) {
+		k_thread_create(&client_threads[i], client_stacks[i],
+				K_THREAD_STACK_SIZEOF(client_stacks[i]),
+				client_thread, (void *)sa, NULL, NULL,
+				CLIENT_PRIORITY, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < clients; i++) {
+		k_thread_join(&client_threads[i], K_FOREVER);
+	}
+
+	elapsed = MAX(bench_now_us() - start, 1U);
+
+	printk("clients %2d requests %5u failed %3u %7u req/s\n",
+	       clients, REQUESTS, (uint32_t)atomic_get(&failed),
+	       (uint32_t)(REQUESTS * USEC_PER_SEC / elapsed));
+}
+
+static void bench_lookup(void)
+{
+	static char paths[LOOKUP_PATHS][PATH_LEN];
+	uint32_t missed = 0U;
+	uint64_t start, elapsed;
+	int path_len;
+
+	for (uint32_t i = 0; i < LOOKUP_PATHS; i++) {
+		/* Spread over all the resources */
+		request_path(paths[i], PATH_LEN, i * 13U);
+	}
+
+	start = bench_now_us();
+
+	for (uint32_t i = 0; i < LOOKUPS; i++) {
+		if (get_resource_detail(paths[i % LOOKUP_PATHS], &path_len, false) == NULL) {
+			missed++;
+		}
+	}
+
+	elapsed = bench_now_us() - start;
+
+	if (missed > 0U) {
+		printk("ERROR: %u lookups failed\n", missed);
+	}
+
+	printk("lookup %6u ns\n", (uint32_t)(elapsed * NSEC_PER_USEC / LOOKUPS));
+}
+
+int main(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+
+	(void)zsock_inet_pton(AF_INET, SERVER_ADDR, &sa.sin_addr);
+
+	printk("resources %d workers %d index %d\n", NUM_RESOURCES + 2,
+	       CONFIG_HTTP_SERVER_NUM_WORKERS, CONFIG_HTTP_SERVER_RESOURCE_INDEX_SIZE);
+
+	bench_lookup();
+
+	if (http_server_start() < 0) {
+		printk("ERROR: cannot start the server\n");
+		return 0;
+	}
+
+	/* Let the server open its listening socket */
+	k_sleep(K_MSEC(100));
+
+	bench_requests(&sa, 1);
+	bench_requests(&sa, CLIENT_THREADS);
+
+	(void)http_server_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
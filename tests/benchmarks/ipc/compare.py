@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Compare two runs of the IPC benchmark.
+
+Reads the console output of two runs, in either of the JSON or CSV
+formats of the benchmark, and reports the rounds whose throughput
+dropped by more than a threshold. Exits with status 1 if any did.
+"""
+
+import argparse
+import json
+import sys
+
+KEY = ('primitive', 'cpus', 'pairs', 'payload')
+CSV_FIELDS = ('primitive', 'cpus', 'pairs', 'payload', 'msgs',
+              'msgs_per_sec', 'ns_per_msg')
+
+
+def parse_results(path):
+    results = {}
+
+    with open(path, encoding='utf-8', errors='replace') as f:
+        for line in f:
+            line = line.strip()
+            # Console logs may prefix the output with timestamps
+            start = line.find('{"primitive"')
+            if start >= 0:
+                try:
+                    rec = json.loads(line[start:])
+                except json.JSONDecodeError:
+                    continue
+            else:
+                fields = line.split(',')
+                if len(fields) != len(CSV_FIELDS) or not fields[1].isdigit():
+                    continue
+                rec = dict(zip(CSV_FIELDS, fields))
+                rec.update({k: int(v) for k, v in rec.items() if k != 'primitive'})
+
+            results[tuple(rec[k] for k in KEY)] = rec['msgs_per_sec']
+
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('baseline', help='output of the reference run')
+    parser.add_argument('current', help='output of the run to check')
+    parser.add_argument('-t', '--threshold', type=float, default=10.0,
+                        help='allowed throughput drop in percent (default: 10)')
+    args = parser.parse_args()
+
+    baseline = parse_results(args.baseline)
+    current = parse_results(args.current)
+    regressions = 0
+
+    print(f"{'primitive':<10} {'cpus':>4} {'pairs':>5} {'payload':>7} "
+          f"{'baseline':>10} {'current':>10} {'change':>8}")
+
+    for key in sorted(baseline.keys() & current.keys()):
+        old, new = baseline[key], current[key]
+        change = (new - old) * 100.0 / old if old else 0.0
+        flag = ''
+        if change < -args.threshold:
+            flag = '  REGRESSION'
+            regressions += 1
+
+        print(f'{key[0]:<10} {key[1]:>4} {key[2]:>5} {key[3]:>7} '
+              f'{old:>10} {new:>10} {change:>7.1f}%{flag}')
+
+    for key in sorted(baseline.keys() - current.keys()):
+        print(f'missing from current run: {key}')
+
+    if regressions:
+        print(f'{regressions} round(s) regressed by more than {args.threshold}%')
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTS_BENCHMARKS_IPC_SRC_IPC_BENCH_H_
+#define ZEPHYR_TESTS_BENCHMARKS_IPC_SRC_IPC_BENCH_H_
+
+#include <zephyr/kernel.h>
+
+#define MAX_PAIRS 4
+#define MAX_PAYLOAD 512
+
+/* Depth of the queues, a power of 2 for k_mpmcq */
+#define QUEUE_LEN 16
+
+/* One measurement: every producer sends msgs messages of payload bytes,
+ * every consumer receives as many (or all the messages for zbus, where
+ * each subscriber sees every publication).
+ */
+struct ipc_round {
+	uint32_t pairs;
+	size_t payload;
+	uint32_t msgs;
+};
+
+/* Producer and consumer threads get the round as first argument and
+ * the index of their pair as second one.
+ */
+struct ipc_primitive {
+	const char *name;
+	/* false when messages carry no data, only run with a payload of 0 */
+	bool payload;
+	void (*setup)(const struct ipc_round *round);
+	k_thread_entry_t producer;
+	k_thread_entry_t consumer;
+};
+
+extern const struct ipc_primitive ipc_msgq;
+extern const struct ipc_primitive ipc_fifo;
+extern const struct ipc_primitive ipc_pipe;
+extern const struct ipc_primitive ipc_mpmcq;
+extern const struct ipc_primitive ipc_event;
+extern const struct ipc_primitive ipc_condvar;
+extern const struct ipc_primitive ipc_zbus;
+
+#endif /* ZEPHYR_TESTS_BENCHMARKS_IPC_SRC_IPC_BENCH_H_ */
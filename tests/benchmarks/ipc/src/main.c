@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/version.h>
+#include "ipc_bench.h"
+
+/* IPC throughput benchmark.  Every primitive passes messages between
+ * producer and consumer threads, for every number of producer/consumer
+ * pairs and payload size of the sweep, and on SMP for every number of
+ * CPUs the threads may run on.  Results are printed in a machine
+ * readable format, one line per round.
+ */
+
+#define STACK_SIZE (2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define THREAD_PRIO K_PRIO_PREEMPT(1)
+
+static const uint32_t pair_counts[] = { 1, 2, MAX_PAIRS };
+static const size_t payloads[] = { 16, 128, MAX_PAYLOAD };
+
+static const struct ipc_primitive *const primitives[] = {
+	&ipc_msgq,
+	&ipc_fifo,
+	&ipc_pipe,
+#ifdef CONFIG_MPMCQ
+	&ipc_mpmcq,
+#endif
+	&ipc_event,
+	&ipc_condvar,
+	&ipc_zbus,
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_PAIRS, STACK_SIZE);
+static struct k_thread threads[2 * MAX_PAIRS];
+
+static void print_header(void)
+{
+#ifdef CONFIG_BENCHMARK_IPC_OUTPUT_JSON
+	printk("{\"benchmark\":\"ipc\",\"board\":\"%s\",\"version\":\"%s\","
+	       "\"cpus\":%u}\n", CONFIG_BOARD_TARGET, KERNEL_VERSION_STRING,
+	       arch_num_cpus());
+#else
+	printk("# ipc benchmark, board %s, version %s, cpus %u\n",
+	       CONFIG_BOARD_TARGET, KERNEL_VERSION_STRING, arch_num_cpus());
+	printk("primitive,cpus,pairs,payload,msgs,msgs_per_sec,ns_per_msg\n");
+#endif
+}
+
+static void print_result(const char *name, uint32_t cpus, uint32_t pairs,
+			 size_t payload, uint32_t msgs, uint64_t ns)
+{
+	uint32_t rate = (uint32_t)(((uint64_t)msgs * NSEC_PER_SEC) / MAX(ns, 1U));
+	uint32_t ns_per_msg = (uint32_t)(ns / MAX(msgs, 1U));
+
+#ifdef CONFIG_BENCHMARK_IPC_OUTPUT_JSON
+	printk("{\"primitive\":\"%s\",\"cpus\":%u,\"pairs\":%u,\"payload\":%u,"
+	       "\"msgs\":%u,\"msgs_per_sec\":%u,\"ns_per_msg\":%u}\n",
+	       name, cpus, pairs, (uint32_t)payload, msgs, rate, ns_per_msg);
+#else
+	printk("%s,%u,%u,%u,%u,%u,%u\n", name, cpus, pairs,
+	       (uint32_t)payload, msgs, rate, ns_per_msg);
+#endif
+}
+
+static void bench_round(const struct ipc_primitive *prim, uint32_t cpus,
+			uint32_t pairs, size_t payload)
+{
+	struct ipc_round round = {
+		.pairs = pairs,
+		.payload = payload,
+		.msgs = CONFIG_BENCHMARK_IPC_MSGS / pairs,
+	};
+	uint64_t ns;
+	timing_t start, end;
+
+	prim->setup(&round);
+
+	/* Lower priority than us, so that they all start together */
+	for (uint32_t i = 0; i < pairs; i++) {
+		k_thread_create(&threads[2 * i], stacks[2 * i], STACK_SIZE,
+				prim->consumer, &round, UINT_TO_POINTER(i),
+				NULL, THREAD_PRIO, 0, K_FOREVER);
+		k_thread_create(&threads[2 * i + 1], stacks[2 * i + 1],
+				STACK_SIZE, prim->producer, &round,
+				UINT_TO_POINTER(i), NULL, THREAD_PRIO, 0,
+				K_FOREVER);
+	}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	for (uint32_t i = 0; i < 2 * pairs; i++) {
+		(void)k_thread_cpu_mask_clear(&threads[i]);
+		for (uint32_t cpu = 0; cpu < cpus; cpu++) {
+			(void)k_thread_cpu_mask_enable(&threads[i], cpu);
+		}
+	}
+#endif
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < 2 * pairs; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (uint32_t i = 0; i < 2 * pairs; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	end = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	print_result(prim->name, cpus, pairs, payload, round.msgs * pairs, ns);
+}
+
+int main(void)
+{
+	uint32_t min_cpus = arch_num_cpus();
+
+	/* With CPU masks, also sweep the number of CPUs */
+	if (IS_ENABLED(CONFIG_SCHED_CPU_MASK)) {
+		min_cpus = 1U;
+	}
+
+	timing_init();
+	timing_start();
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(0));
+
+	print_header();
+
+	for (int p = 0; p < ARRAY_SIZE(primitives); p++) {
+		for (uint32_t cpus = min_cpus; cpus <= arch_num_cpus(); cpus++) {
+			for (int t = 0; t < ARRAY_SIZE(pair_counts); t++) {
+				if (!primitives[p]->payload) {
+					bench_round(primitives[p], cpus,
+						    pair_counts[t], 0);
+					continue;
+				}
+
+				for (int s = 0; s < ARRAY_SIZE(payloads); s++) {
+					bench_round(primitives[p], cpus,
+						    pair_counts[t], payloads[s]);
+				}
+			}
+		}
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "ipc_bench.h"
+
+/* Queue like primitives, all the pairs share the same queue */
+
+static char __aligned(4) msgq_buf[QUEUE_LEN * MAX_PAYLOAD];
+static struct k_msgq msgq;
+
+static void msgq_setup(const struct ipc_round *round)
+{
+	k_msgq_init(&msgq, msgq_buf, round->payload, QUEUE_LEN);
+}
+
+static void msgq_producer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD] = { 0 };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)k_msgq_put(&msgq, buf, K_FOREVER);
+	}
+}
+
+static void msgq_consumer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)k_msgq_get(&msgq, buf, K_FOREVER);
+	}
+}
+
+const struct ipc_primitive ipc_msgq = {
+	.name = "k_msgq",
+	.payload = true,
+	.setup = msgq_setup,
+	.producer = msgq_producer,
+	.consumer = msgq_consumer,
+};
+
+/* Items are copied in and out of preallocated nodes, which consumers
+ * give back to their producer through a per-pair free list.
+ */
+struct fifo_item {
+	void *fifo_reserved;
+	uint32_t owner;
+	uint8_t data[MAX_PAYLOAD];
+};
+
+static struct fifo_item fifo_items[MAX_PAIRS][QUEUE_LEN / MAX_PAIRS];
+static struct k_fifo data_fifo;
+static struct k_fifo free_fifo[MAX_PAIRS];
+static size_t fifo_payload;
+
+static void fifo_setup(const struct ipc_round *round)
+{
+	fifo_payload = round->payload;
+	k_fifo_init(&data_fifo);
+
+	for (uint32_t p = 0; p < MAX_PAIRS; p++) {
+		k_fifo_init(&free_fifo[p]);
+
+		for (int i = 0; i < ARRAY_SIZE(fifo_items[p]); i++) {
+			fifo_items[p][i].owner = p;
+			k_fifo_put(&free_fifo[p], &fifo_items[p][i]);
+		}
+	}
+}
+
+static void fifo_producer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint32_t pair = POINTER_TO_UINT(p2);
+	uint8_t buf[MAX_PAYLOAD] = { 0 };
+	struct fifo_item *item;
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		item = k_fifo_get(&free_fifo[pair], K_FOREVER);
+		memcpy(item->data, buf, fifo_payload);
+		k_fifo_put(&data_fifo, item);
+	}
+}
+
+static void fifo_consumer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD];
+	struct fifo_item *item;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		item = k_fifo_get(&data_fifo, K_FOREVER);
+		memcpy(buf, item->data, fifo_payload);
+		k_fifo_put(&free_fifo[item->owner], item);
+	}
+}
+
+const struct ipc_primitive ipc_fifo = {
+	.name = "k_fifo",
+	.payload = true,
+	.setup = fifo_setup,
+	.producer = fifo_producer,
+	.consumer = fifo_consumer,
+};
+
+/* Every transfer moves exactly one message worth of bytes, messages of
+ * concurrent producers may interleave in the pipe, which is fine as
+ * only byte counts matter.
+ */
+static unsigned char __aligned(4) pipe_buf[QUEUE_LEN * MAX_PAYLOAD];
+static struct k_pipe pipe;
+
+static void pipe_setup(const struct ipc_round *round)
+{
+	k_pipe_init(&pipe, pipe_buf, QUEUE_LEN * round->payload);
+}
+
+static void pipe_producer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD] = { 0 };
+	size_t written;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)k_pipe_put(&pipe, buf, round->payload, &written,
+				 round->payload, K_FOREVER);
+	}
+}
+
+static void pipe_consumer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD];
+	size_t read;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)k_pipe_get(&pipe, buf, round->payload, &read,
+				 round->payload, K_FOREVER);
+	}
+}
+
+const struct ipc_primitive ipc_pipe = {
+	.name = "k_pipe",
+	.payload = true,
+	.setup = pipe_setup,
+	.producer = pipe_producer,
+	.consumer = pipe_consumer,
+};
+
+#ifdef CONFIG_MPMCQ
+static atomic_t mpmcq_buf[MPMC_BUF_SIZE(MAX_PAYLOAD, QUEUE_LEN) /
+			  sizeof(atomic_t)];
+static struct k_mpmcq mpmcq;
+
+static void mpmcq_setup(const struct ipc_round *round)
+{
+	k_mpmcq_init(&mpmcq, mpmcq_buf, round->payload, QUEUE_LEN);
+}
+
+static void mpmcq_producer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD] = { 0 };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)k_mpmcq_put(&mpmcq, buf, K_FOREVER);
+	}
+}
+
+static void mpmcq_consumer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)k_mpmcq_get(&mpmcq, buf, K_FOREVER);
+	}
+}
+
+const struct ipc_primitive ipc_mpmcq = {
+	.name = "k_mpmcq",
+	.payload = true,
+	.setup = mpmcq_setup,
+	.producer = mpmcq_producer,
+	.consumer = mpmcq_consumer,
+};
+#endif /* CONFIG_MPMCQ */
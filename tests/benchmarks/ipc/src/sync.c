@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "ipc_bench.h"
+
+/* Events carry no data: every pair ping-pongs a request and an
+ * acknowledge bit of a shared k_event.
+ */
+static struct k_event event;
+
+#define EVENT_REQ(pair) BIT(2 * (pair))
+#define EVENT_ACK(pair) BIT(2 * (pair) + 1)
+
+static void event_setup(const struct ipc_round *round)
+{
+	ARG_UNUSED(round);
+
+	k_event_init(&event);
+}
+
+static void event_producer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint32_t pair = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		k_event_post(&event, EVENT_REQ(pair));
+		(void)k_event_wait(&event, EVENT_ACK(pair), false, K_FOREVER);
+		k_event_clear(&event, EVENT_ACK(pair));
+	}
+}
+
+static void event_consumer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint32_t pair = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)k_event_wait(&event, EVENT_REQ(pair), false, K_FOREVER);
+		k_event_clear(&event, EVENT_REQ(pair));
+		k_event_post(&event, EVENT_ACK(pair));
+	}
+}
+
+const struct ipc_primitive ipc_event = {
+	.name = "k_event",
+	.payload = false,
+	.setup = event_setup,
+	.producer = event_producer,
+	.consumer = event_consumer,
+};
+
+/* Bounded queue built out of a mutex and two condition variables */
+static struct k_mutex cv_mutex;
+static struct k_condvar cv_not_empty;
+static struct k_condvar cv_not_full;
+static uint8_t cv_ring[QUEUE_LEN][MAX_PAYLOAD];
+static uint32_t cv_head;
+static uint32_t cv_count;
+static size_t cv_payload;
+
+static void condvar_setup(const struct ipc_round *round)
+{
+	k_mutex_init(&cv_mutex);
+	k_condvar_init(&cv_not_empty);
+	k_condvar_init(&cv_not_full);
+	cv_head = 0U;
+	cv_count = 0U;
+	cv_payload = round->payload;
+}
+
+static void condvar_producer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD] = { 0 };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)k_mutex_lock(&cv_mutex, K_FOREVER);
+
+		while (cv_count == QUEUE_LEN) {
+			(void)k_condvar_wait(&cv_not_full, &cv_mutex, K_FOREVER);
+		}
+
+		memcpy(cv_ring[(cv_head + cv_count) % QUEUE_LEN], buf, cv_payload);
+		cv_count++;
+
+		(void)k_condvar_signal(&cv_not_empty);
+		(void)k_mutex_unlock(&cv_mutex);
+	}
+}
+
+static void condvar_consumer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)k_mutex_lock(&cv_mutex, K_FOREVER);
+
+		while (cv_count == 0U) {
+			(void)k_condvar_wait(&cv_not_empty, &cv_mutex, K_FOREVER);
+		}
+
+		memcpy(buf, cv_ring[cv_head], cv_payload);
+		cv_head = (cv_head + 1U) % QUEUE_LEN;
+		cv_count--;
+
+		(void)k_condvar_signal(&cv_not_full);
+		(void)k_mutex_unlock(&cv_mutex);
+	}
+}
+
+const struct ipc_primitive ipc_condvar = {
+	.name = "k_condvar",
+	.payload = true,
+	.setup = condvar_setup,
+	.producer = condvar_producer,
+	.consumer = condvar_consumer,
+};
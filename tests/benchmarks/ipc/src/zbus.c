@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zbus/zbus.h>
+#include "ipc_bench.h"
+
+/* zbus channels have a fixed message type, so there is one channel per
+ * payload size of the sweep.  Consumers are message subscribers, which
+ * all get a copy of every publication.  Plain subscribers would have to
+ * read the channel, which the publisher keeps locked while it waits for
+ * room in their queues.  The subscribers of the pairs not taking part
+ * in a round are disabled.
+ */
+struct payload_16 {
+	uint8_t data[16];
+};
+
+struct payload_128 {
+	uint8_t data[128];
+};
+
+struct payload_512 {
+	uint8_t data[512];
+};
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(bench_sub0);
+ZBUS_MSG_SUBSCRIBER_DEFINE(bench_sub1);
+ZBUS_MSG_SUBSCRIBER_DEFINE(bench_sub2);
+ZBUS_MSG_SUBSCRIBER_DEFINE(bench_sub3);
+
+BUILD_ASSERT(MAX_PAIRS == 4, "one subscriber per pair");
+
+static struct zbus_observer *const subs[MAX_PAIRS] = {
+	&bench_sub0, &bench_sub1, &bench_sub2, &bench_sub3,
+};
+
+ZBUS_CHAN_DEFINE(bench_chan_16, struct payload_16, NULL, NULL,
+		 ZBUS_OBSERVERS(bench_sub0, bench_sub1, bench_sub2, bench_sub3),
+		 ZBUS_MSG_INIT(0));
+
+ZBUS_CHAN_DEFINE(bench_chan_128, struct payload_128, NULL, NULL,
+		 ZBUS_OBSERVERS(bench_sub0, bench_sub1, bench_sub2, bench_sub3),
+		 ZBUS_MSG_INIT(0));
+
+ZBUS_CHAN_DEFINE(bench_chan_512, struct payload_512, NULL, NULL,
+		 ZBUS_OBSERVERS(bench_sub0, bench_sub1, bench_sub2, bench_sub3),
+		 ZBUS_MSG_INIT(0));
+
+static const struct zbus_channel *chan;
+
+static void zbus_setup(const struct ipc_round *round)
+{
+	switch (round->payload) {
+	case sizeof(struct payload_16):
+		chan = &bench_chan_16;
+		break;
+	case sizeof(struct payload_128):
+		chan = &bench_chan_128;
+		break;
+	default:
+		__ASSERT(round->payload == sizeof(struct payload_512),
+			 "no zbus channel for %zu bytes", round->payload);
+		chan = &bench_chan_512;
+		break;
+	}
+
+	for (uint32_t p = 0; p < MAX_PAIRS; p++) {
+		(void)zbus_obs_set_enable(subs[p], p < round->pairs);
+	}
+}
+
+static void zbus_producer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint8_t buf[MAX_PAYLOAD] = { 0 };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs; i++) {
+		(void)zbus_chan_pub(chan, buf, K_FOREVER);
+	}
+}
+
+static void zbus_consumer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_round *round = p1;
+	uint32_t pair = POINTER_TO_UINT(p2);
+	const struct zbus_channel *notified;
+	uint8_t buf[MAX_PAYLOAD];
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < round->msgs * round->pairs; i++) {
+		(void)zbus_sub_wait_msg(subs[pair], &notified, buf, K_FOREVER);
+	}
+}
+
+const struct ipc_primitive ipc_zbus = {
+	.name = "zbus",
+	.payload = true,
+	.setup = zbus_setup,
+	.producer = zbus_producer,
+	.consumer = zbus_consumer,
+};
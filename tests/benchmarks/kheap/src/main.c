@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/timing/timing.h>
+
+/* k_heap throughput benchmark.  For a growing number of threads
+ * sharing one k_heap, each thread runs the sys_heap_stress() harness
+ * over its share of the heap, and the aggregate number of allocations
+ * and frees per second is reported.
+ */
+
+#define MAX_THREADS 8
+#define HEAP_BYTES 32768
+#define OPS_PER_THREAD 20000
+#define TARGET_PERCENT 50
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static const uint32_t thread_counts[] = { 1, 2, 4, MAX_THREADS };
+
+static struct k_heap bench_heap;
+static char __aligned(8) heap_mem[HEAP_BYTES];
+
+/* Scratch space of the harness, about half the heap share is plenty */
+static uint8_t __aligned(8) scratch[MAX_THREADS][HEAP_BYTES / 2 / MAX_THREADS];
+static struct z_heap_stress_result results[MAX_THREADS];
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+
+static void *bench_alloc(void *arg, size_t bytes)
+{
+	return k_heap_alloc(arg, bytes, K_NO_WAIT);
+}
+
+static void bench_free(void *arg, void *p)
+{
+	k_heap_free(arg, p);
+}
+
+static void stress_thread(void *p1, void *p2, void *p3)
+{
+	uint32_t idx = POINTER_TO_UINT(p1);
+	uint32_t nthreads = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	sys_heap_stress(bench_alloc, bench_free, &bench_heap,
+			HEAP_BYTES / nthreads, OPS_PER_THREAD,
+			scratch[idx], sizeof(scratch[idx]),
+			TARGET_PERCENT, &results[idx]);
+}
+
+static void bench_round(uint32_t nthreads)
+{
+	uint64_t ops = 0U;
+	uint64_t ns;
+	timing_t start, end;
+
+	k_heap_init(&bench_heap, heap_mem, sizeof(heap_mem));
+
+	/* Lower priority than us, so that they all start together */
+	for (uint32_t i = 0; i < nthreads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				stress_thread, UINT_TO_POINTER(i),
+				UINT_TO_POINTER(nthreads), NULL,
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+	}
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < nthreads; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (uint32_t i = 0; i < nthreads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	end = timing_counter_get();
+
+	for (uint32_t i = 0; i < nthreads; i++) {
+		ops += results[i].total_allocs + results[i].total_frees;
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	printk("threads %2u ops/s %8u\n", nthreads,
+	       (uint32_t)((ops * NSEC_PER_SEC) / MAX(ns, 1U)));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(0));
+
+	for (int i = 0; i < ARRAY_SIZE(thread_counts); i++) {
+		bench_round(thread_counts[i]);
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time for sys_mutex lock/unlock and sys_sem give/take
+ *
+ * This file contains the test that measures the time to lock and unlock
+ * a sys_mutex, and to give and take a sys_sem. Neither is contended.
+ * Build with CONFIG_SYS_MUTEX_FUTEX to compare the futex based sys_mutex
+ * against the default syscall based one.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/mutex.h>
+#include <zephyr/sys/sem.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+BENCH_BMEM SYS_MUTEX_DEFINE(test_sys_mutex);
+BENCH_BMEM SYS_SEM_DEFINE(test_sys_sem, 0, 1);
+
+static void start_sys_lock_unlock(void *p1, void *p2, void *p3)
+{
+	uint32_t  i;
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p1;
+	timing_t  start;
+	timing_t  finish;
+	uint64_t  mutex_cycles;
+	uint64_t  sem_cycles;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_timestamp_get();
+
+	for (i = 0; i < num_iterations; i++) {
+		sys_mutex_lock(&test_sys_mutex, K_NO_WAIT);
+		sys_mutex_unlock(&test_sys_mutex);
+	}
+
+	finish = timing_timestamp_get();
+
+	mutex_cycles = timing_cycles_get(&start, &finish);
+
+	start = timing_timestamp_get();
+
+	for (i = 0; i < num_iterations; i++) {
+		sys_sem_give(&test_sys_sem);
+		sys_sem_take(&test_sys_sem, K_NO_WAIT);
+	}
+
+	finish = timing_timestamp_get();
+
+	sem_cycles = timing_cycles_get(&start, &finish);
+
+	timestamp.cycles = mutex_cycles;
+	k_sem_take(&pause_sem, K_FOREVER);
+
+	timestamp.cycles = sem_cycles;
+}
+
+/**
+ *
+ * @brief Test for the sys_mutex lock/unlock and sys_sem give/take time
+ *
+ * The routine locks and unlocks a sys_mutex, then gives and takes a
+ * sys_sem multiple times to measure the necessary time.
+ *
+ * @return 0 on success
+ */
+int sys_mutex_lock_unlock(uint32_t num_iterations, uint32_t options)
+{
+	char tag[50];
+	char description[120];
+	int  priority;
+	uint64_t  cycles;
+
+	timing_start();
+
+	priority = k_thread_priority_get(k_current_get());
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			start_sys_lock_unlock,
+			(void *)(uintptr_t)num_iterations, NULL, NULL,
+			priority - 1, options, K_FOREVER);
+
+	k_thread_access_grant(&start_thread, &pause_sem);
+	k_thread_start(&start_thread);
+
+	cycles = timestamp.cycles;
+	k_sem_give(&pause_sem);
+
+	snprintf(tag, sizeof(tag),
+		 "sys_mutex.lock.unlock.immediate.%s",
+		 (options & K_USER) == K_USER ? "user" : "kernel");
+	snprintf(description, sizeof(description),
+		 "%-40s - Lock and unlock a sys_mutex", tag);
+	PRINT_STATS_AVG(description, (uint32_t)cycles, num_iterations,
+			false, "");
+
+	cycles = timestamp.cycles;
+
+	snprintf(tag, sizeof(tag),
+		 "sys_sem.give.take.immediate.%s",
+		 (options & K_USER) == K_USER ? "user" : "kernel");
+	snprintf(description, sizeof(description),
+		 "%-40s - Give and take a sys_sem", tag);
+	PRINT_STATS_AVG(description, (uint32_t)cycles, num_iterations,
+			false, "");
+
+	timing_stop();
+	return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* Message queue throughput benchmark.  The same number of messages is
+ * passed from producer to consumer threads through a k_msgq and through
+ * a k_mpmcq, and the number of messages per second is reported.
+ */
+
+#define MAX_PAIRS 4
+#define QUEUE_LEN 64
+#define NUM_MSGS 40000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define THREAD_PRIO K_PRIO_PREEMPT(1)
+
+struct bench_msg {
+	uint32_t seq;
+	uint32_t payload[3];
+};
+
+static const uint32_t num_pairs[] = { 1, MAX_PAIRS };
+
+K_MSGQ_DEFINE(bench_msgq, sizeof(struct bench_msg), QUEUE_LEN, 4);
+K_MPMCQ_DEFINE(bench_mpmcq, sizeof(struct bench_msg), QUEUE_LEN);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_PAIRS, STACK_SIZE);
+static struct k_thread threads[2 * MAX_PAIRS];
+
+static void msgq_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t count = POINTER_TO_UINT(p1);
+	struct bench_msg msg = { 0 };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (msg.seq = 0; msg.seq < count; msg.seq++) {
+		(void)k_msgq_put(&bench_msgq, &msg, K_FOREVER);
+	}
+}
+
+static void msgq_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t count = POINTER_TO_UINT(p1);
+	struct bench_msg msg;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < count; i++) {
+		(void)k_msgq_get(&bench_msgq, &msg, K_FOREVER);
+	}
+}
+
+static void mpmcq_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t count = POINTER_TO_UINT(p1);
+	struct bench_msg msg = { 0 };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (msg.seq = 0; msg.seq < count; msg.seq++) {
+		(void)k_mpmcq_put(&bench_mpmcq, &msg, K_FOREVER);
+	}
+}
+
+static void mpmcq_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t count = POINTER_TO_UINT(p1);
+	struct bench_msg msg;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < count; i++) {
+		(void)k_mpmcq_get(&bench_mpmcq, &msg, K_FOREVER);
+	}
+}
+
+static uint32_t bench_round(uint32_t pairs, k_thread_entry_t producer,
+			    k_thread_entry_t consumer)
+{
+	uint32_t count = NUM_MSGS / pairs;
+	uint64_t ns;
+	timing_t start, end;
+
+	/* Lower priority than us, so that they all start together */
+	for (uint32_t i = 0; i < pairs; i++) {
+		k_thread_create(&threads[2 * i], stacks[2 * i], STACK_SIZE,
+				consumer, UINT_TO_POINTER(count), NULL, NULL,
+				THREAD_PRIO, 0, K_FOREVER);
+		k_thread_create(&threads[2 * i + 1], stacks[2 * i + 1],
+				STACK_SIZE, producer, UINT_TO_POINTER(count),
+				NULL, NULL, THREAD_PRIO, 0, K_FOREVER);
+	}
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < 2 * pairs; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (uint32_t i = 0; i < 2 * pairs; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	end = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	return (uint32_t)(((uint64_t)count * pairs * NSEC_PER_SEC) /
+			  MAX(ns, 1U));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(0));
+
+	for (int i = 0; i < ARRAY_SIZE(num_pairs); i++) {
+		uint32_t pairs = num_pairs[i];
+
+		printk("k_msgq   %uP%uC msgs/s %8u\n", pairs, pairs,
+		       bench_round(pairs, msgq_producer, msgq_consumer));
+		printk("k_mpmcq  %uP%uC msgs/s %8u\n", pairs, pairs,
+		       bench_round(pairs, mpmcq_producer, mpmcq_consumer));
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/mqtt.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+
+#include "bench_clock.h"
+
+/* MQTT publish rate benchmark. A broker stand-in thread accepts MQTT
+ * connections over the loopback interface, counts the PUBLISH packets and
+ * acknowledges the QoS 1 ones, writing the PUBACK packets once it has
+ * parsed all the data received. The client publishes MESSAGES messages on
+ * a new connection for each mode:
+ *
+ * - sync: mqtt_publish() at QoS 1, waiting for the PUBACK of each message
+ *   before publishing the next one,
+ * - queue: mqtt_publish_queue() at QoS 0, then at QoS 1, the messages
+ *   being written in batches within the in-flight window.
+ */
+
+#define SERVER_ADDR "127.0.0.1"
+#define SERVER_PORT 1883
+
+#define MESSAGES            2000U
+#define PAYLOAD_LEN         64
+#define TOPIC               "bench/publish"
+#define BROKER_STACK_SIZE   4096
+#define BROKER_PRIORITY     K_PRIO_PREEMPT(8)
+
+#define MQTT_PACKET_CONNECT    1
+#define MQTT_PACKET_PUBLISH    3
+#define MQTT_PACKET_DISCONNECT 14
+
+struct bench_mode {
+	const char *name;
+	uint8_t qos;
+	bool queue;
+};
+
+static const struct bench_mode modes[] = {
+	{ .name = "sync", .qos = MQTT_QOS_1_AT_LEAST_ONCE },
+	{ .name = "queue", .qos = MQTT_QOS_0_AT_MOST_ONCE, .queue = true },
+	{ .name = "queue", .qos = MQTT_QOS_1_AT_LEAST_ONCE, .queue = true },
+};
+
+struct broker_stream {
+	int fd;
+	size_t len;
+	size_t pos;
+	size_t out_len;
+	uint8_t buf[1024];
+	uint8_t out[256];
+};
+
+static K_THREAD_STACK_DEFINE(broker_stack, BROKER_STACK_SIZE);
+static struct k_thread broker_thread_data;
+static struct broker_stream broker_stream;
+static K_SEM_DEFINE(broker_done, 0, 1);
+static int broker_fd = -1;
+static uint32_t broker_messages;
+static bool stopping;
+
+static int broker_flush(struct broker_stream *s)
+{
+	if (s->out_len > 0 &&
+	    zsock_send(s->fd, s->out, s->out_len, 0) != s->out_len) {
+		return -EIO;
+	}
+
+	s->out_len = 0;
+
+	return 0;
+}
+
+/* Copy the next len bytes to dst, or skip them when dst is NULL. The
+ * acknowledgments are written before waiting for more data.
+ */
+static int broker_read(struct broker_stream *s, uint8_t *dst, size_t len)
+{
+	ssize_t ret;
+	size_t copy;
+
+	while (len > 0) {
+		if (s->pos == s->len) {
+			if (broker_flush(s) < 0) {
+				return -EIO;
+			}
+
+			ret = zsock_recv(s->fd, s->buf, sizeof(s->buf), 0);
+			if (ret <= 0) {
+				return -EIO;
+			}
+
+			s->len = ret;
+			s->pos = 0;
+		}
+
+		copy = MIN(len, s->len - s->pos);
+
+		if (dst != NULL) {
+			memcpy(dst, &s->buf[s->pos], copy);
+			dst += copy;
+		}
+
+		s->pos += copy;
+		len -= copy;
+	}
+
+	return 0;
+}
+
+static int broker_ack(struct broker_stream *s, const uint8_t *message_id)
+{
+	if (s->out_len + 4 > sizeof(s->out) && broker_flush(s) < 0) {
+		return -EIO;
+	}
+
+	s->out[s->out_len++] = 0x40;
+	s->out[s->out_len++] = 0x02;
+	s->out[s->out_len++] = message_id[0];
+	s->out[s->out_len++] = message_id[1];
+
+	return 0;
+}
+
+/* Returns the type of the next packet, acknowledging it if needed */
+static int broker_packet(struct broker_stream *s)
+{
+	uint32_t remaining = 0U;
+	uint32_t shift = 0U;
+	uint8_t header;
+	uint8_t byte;
+	uint8_t field[2];
+	uint16_t topic_len;
+
+	if (broker_read(s, &header, 1) < 0) {
+		return -EIO;
+	}
+
+	do {
+		if (broker_read(s, &byte, 1) < 0 || shift > 21U) {
+			return -EIO;
+		}
+
+		remaining |= (uint32_t)(byte & 0x7f) << shift;
+		shift += 7U;
+	} while (byte & 0x80);
+
+	if ((header >> 4) == MQTT_PACKET_PUBLISH && (header & 0x06) != 0) {
+		/* Topic, then the message id to acknowledge */
+		if (remaining < 4U || broker_read(s, field, sizeof(field)) < 0) {
+			return -EIO;
+		}
+
+		topic_len = sys_get_be16(field);
+
+		if (remaining < 4U + topic_len ||
+		    broker_read(s, NULL, topic_len) < 0 ||
+		    broker_read(s, field, sizeof(field)) < 0 ||
+		    broker_ack(s, field) < 0) {
+			return -EIO;
+		}
+
+		remaining -= 4U + topic_len;
+	}
+
+	if (broker_read(s, NULL, remaining) < 0) {
+		return -EIO;
+	}
+
+	return header >> 4;
+}
+
+static void broker_session(struct broker_stream *s)
+{
+	static const uint8_t connack[] = { 0x20, 0x02, 0x00, 0x00 };
+	int type;
+
+	s->len = 0;
+	s->pos = 0;
+	s->out_len = 0;
+
+	if (broker_packet(s) != MQTT_PACKET_CONNECT ||
+	    zsock_send(s->fd, connack, sizeof(connack), 0) != sizeof(connack)) {
+		return;
+	}
+
+	while (true) {
+		type = broker_packet(s);
+		if (type < 0 || type == MQTT_PACKET_DISCONNECT) {
+			break;
+		}
+
+		if (type == MQTT_PACKET_PUBLISH) {
+			broker_messages++;
+		}
+	}
+}
+
+static void broker_thread(void *p1, void *p2, void *p3)
+{
+	struct broker_stream *s = &broker_stream;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stopping) {
+		s->fd = zsock_accept(broker_fd, NULL, NULL);
+		if (s->fd < 0) {
+			continue;
+		}
+
+		broker_session(s);
+
+		(void)zsock_close(s->fd);
+		k_sem_give(&broker_done);
+	}
+}
+
+static int broker_start(const struct sockaddr_in *sa)
+{
+	broker_fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (broker_fd < 0) {
+		return -errno;
+	}
+
+	if (zsock_bind(broker_fd, (const struct sockaddr *)sa, sizeof(*sa)) < 0 ||
+	    zsock_listen(broker_fd, 1) < 0) {
+		return -errno;
+	}
+
+	k_thread_create(&broker_thread_data, broker_stack,
+			K_THREAD_STACK_SIZEOF(broker_stack),
+			broker_thread, NULL, NULL, NULL,
+			BROKER_PRIORITY, 0, K_NO_WAIT);
+
+	return 0;
+}
+
+static struct mqtt_client client;
+static struct sockaddr_storage broker;
+static uint8_t rx_buf[256];
+static uint8_t tx_buf[512];
+static bool connected;
+static uint32_t acked;
+
+static void evt_handler(struct mqtt_client *c, const struct mqtt_evt *evt)
+{
+	ARG_UNUSED(c);
+
+	if (evt->type == MQTT_EVT_CONNACK && evt->result == 0) {
+		connected = true;
+	} else if (evt->type == MQTT_EVT_PUBACK && evt->result == 0) {
+		acked++;
+	}
+}
+
+static int wait_input(void)
+{
+	struct zsock_pollfd fds[1] = {
+		{ .fd = client.transport.tcp.sock, .events = ZSOCK_POLLIN },
+	};
+
+	if (zsock_poll(fds, 1, MSEC_PER_SEC) <= 0) {
+		return -ETIMEDOUT;
+	}
+
+	return mqtt_input(&client);
+}
+
+static int bench_connect(const struct sockaddr_in *sa)
+{
+	int ret;
+
+	mqtt_client_init(&client);
+
+	memcpy(&broker, sa, sizeof(*sa));
+
+	client.broker = &broker;
+	client.evt_cb = evt_handler;
+	client.client_id.utf8 = (uint8_t *)"bench";
+	client.client_id.size = sizeof("bench") - 1;
+	client.protocol_version = MQTT_VERSION_3_1_1;
+	client.rx_buf = rx_buf;
+	client.rx_buf_size = sizeof(rx_buf);
+	client.tx_buf = tx_buf;
+	client.tx_buf_size = sizeof(tx_buf);
+	client.transport.type = MQTT_TRANSPORT_NON_SECURE;
+
+	connected = false;
+
+	ret = mqtt_connect(&client);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while (!connected) {
+		ret = wait_input();
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int publish_sync(struct mqtt_publish_param *param)
+{
+	int ret;
+
+	for (uint32_t i = 0; i < MESSAGES; i++) {
+		param->message_id = i + 1;
+
+		ret = mqtt_publish(&client, param);
+		if (ret < 0) {
+			return ret;
+		}
+
+		while (acked < i + 1) {
+			ret = wait_input();
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int publish_queue(struct mqtt_publish_param *param)
+{
+	uint32_t i = 0;
+	int ret;
+
+	while (i < MESSAGES) {
+		param->message_id = i + 1;
+
+		ret = mqtt_publish_queue(&client, param);
+		if (ret == 0) {
+			i++;
+			continue;
+		}
+
+		if (ret != -ENOBUFS) {
+			return ret;
+		}
+
+		ret = mqtt_publish_queue_flush(&client);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* The window is full, wait for acknowledgments */
+		if (mqtt_publish_queue_count(&client) == CONFIG_MQTT_PUBLISH_QUEUE_SIZE) {
+			ret = wait_input();
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
+	ret = mqtt_publish_queue_flush(&client);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while (mqtt_publish_queue_count(&client) > 0) {
+		ret = wait_input();
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void bench_publish(const struct sockaddr_in *sa, const struct bench_mode *mode)
+{
+	static const uint8_t payload[PAYLOAD_LEN];
+	struct mqtt_publish_param param = {
+		.message.topic.qos = mode->qos,
+		.message.topic.topic.utf8 = (uint8_t *)TOPIC,
+		.message.topic.topic.size = sizeof(TOPIC) - 1,
+		.message.payload.data = (uint8_t *)payload,
+		.message.payload.len = sizeof(payload),
+	};
+	uint64_t start, elapsed;
+	int ret;
+
+	ret = bench_connect(sa);
+	if (ret < 0) {
+		printk("ERROR: cannot connect to the broker (%d)\n", ret);
+		return;
+	}
+
+	broker_messages = 0U;
+	acked = 0U;
+
+	start = bench_now_us();
+
+	ret = mode->queue ? publish_queue(&param) : publish_sync(&param);
+	if (ret < 0) {
+		printk("ERROR: publishing failed (%d)\n", ret);
+	}
+
+	(void)mqtt_disconnect(&client);
+
+	/* The broker has received all the messages when it gets DISCONNECT */
+	(void)k_sem_take(&broker_done, K_FOREVER);
+
+	elapsed = MAX(bench_now_us() - start, 1U);
+
+	if (broker_messages != MESSAGES) {
+		printk("ERROR: %s qos %u: %u of %u messages received\n", mode->name,
+		       mode->qos, broker_messages, MESSAGES);
+		return;
+	}
+
+	printk("%-5s qos %u messages %5u received %5u %6u msg/s\n", mode->name, mode->qos,
+	       MESSAGES, broker_messages,
+	       (uint32_t)(broker_messages * USEC_PER_SEC / elapsed));
+}
+
+int main(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int ret;
+
+	(void)zsock_inet_pton(AF_INET, SERVER_ADDR, &sa.sin_addr);
+
+	printk("in-flight window %d\n", CONFIG_MQTT_PUBLISH_QUEUE_INFLIGHT);
+
+	ret = broker_start(&sa);
+	if (ret < 0) {
+		printk("ERROR: cannot start the broker (%d)\n", ret);
+		return 0;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(modes); i++) {
+		bench_publish(&sa, &modes[i]);
+	}
+
+	/* Closing the socket wakes the broker thread up from accept() */
+	stopping = true;
+	(void)zsock_close(broker_fd);
+	k_thread_join(&broker_thread_data, K_FOREVER);
+
+	printk("fin\n");
+
+	return 0;
+}
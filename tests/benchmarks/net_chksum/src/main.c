@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include "net_private.h"
+
+/* Internet checksum benchmark.  Times calc_chksum() over buffers of the
+ * sizes typical of headers, small and full sized frames and jumbo
+ * frames, starting both at an aligned and at an odd address, and checks
+ * the result against a byte by byte reference.
+ */
+
+#define ITERATIONS 2000U
+#define MAX_SIZE 9000U
+
+static const size_t sizes[] = { 20, 40, 64, 128, 256, 576, 1280, 1500, 4096, MAX_SIZE };
+
+static uint8_t __aligned(8) data[MAX_SIZE + 1];
+
+static uint16_t chksum_ref(const uint8_t *buf, size_t len)
+{
+	uint32_t sum = 0U;
+
+	for (size_t i = 0; i + 1 < len; i += 2) {
+		sum += (buf[i] << 8) + buf[i + 1];
+	}
+
+	if (len % 2) {
+		sum += buf[len - 1] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+static uint32_t bench_chksum(const uint8_t *buf, size_t len)
+{
+	volatile uint16_t sum = 0U;
+	timing_t start, end;
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < ITERATIONS; i++) {
+		sum = calc_chksum(0U, buf, len);
+	}
+
+	end = timing_counter_get();
+
+	if (sum != chksum_ref(buf, len)) {
+		printk("ERROR: checksum mismatch for %zu bytes at %p\n", len, buf);
+	}
+
+	return (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &end)) /
+			  ITERATIONS);
+}
+
+static uint32_t mb_per_sec(size_t len, uint32_t ns)
+{
+	return (uint32_t)(((uint64_t)len * NSEC_PER_SEC) / MAX(ns, 1U) / 1000000U);
+}
+
+int main(void)
+{
+	uint32_t aligned_ns, unaligned_ns;
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		data[i] = (uint8_t)((i + 13) * 17);
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int s = 0; s < ARRAY_SIZE(sizes); s++) {
+		aligned_ns = bench_chksum(data, sizes[s]);
+		unaligned_ns = bench_chksum(data + 1, sizes[s]);
+
+		printk("size %5zu aligned %6u ns %5u MB/s unaligned %6u ns %5u MB/s\n",
+		       sizes[s], aligned_ns, mb_per_sec(sizes[s], aligned_ns),
+		       unaligned_ns, mb_per_sec(sizes[s], unaligned_ns));
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
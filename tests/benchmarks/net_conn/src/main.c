@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include "connection.h"
+
+/* Connection demultiplexing benchmark.  A growing number of connected
+ * UDP handlers share a local port, next to a single wildcard listener
+ * on another port.  For every number of handlers, the same packet is
+ * fed to net_conn_input() over and over, once for the handler that was
+ * registered first and once for the listener, both of which are the
+ * last ones in the list of connections.
+ */
+
+#define ITERATIONS 10000U
+#define MAX_CONNS 1000U
+
+#define LOCAL_PORT 4242U
+#define LISTEN_PORT 4243U
+#define REMOTE_PORT 10000U
+
+BUILD_ASSERT(CONFIG_NET_MAX_CONN > MAX_CONNS, "one more for the listener");
+
+static const uint32_t conn_counts[] = { 1, 10, 100, MAX_CONNS };
+
+static struct net_conn_handle *handles[MAX_CONNS];
+static struct net_conn_handle *listener;
+static uint32_t delivered;
+
+static struct sockaddr_in local_addr = {
+	.sin_family = AF_INET,
+	.sin_addr = { { { 192, 0, 2, 1 } } },
+};
+
+static struct sockaddr_in remote_addr = {
+	.sin_family = AF_INET,
+	.sin_addr = { { { 192, 0, 2, 2 } } },
+};
+
+static enum net_verdict bench_cb(struct net_conn *conn, struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 union net_proto_header *proto_hdr,
+				 void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	delivered++;
+
+	/* The packet is kept, it is fed again in the next iteration */
+	return NET_OK;
+}
+
+static uint32_t bench_input(struct net_pkt *pkt, struct net_ipv4_hdr *ipv4,
+			    struct net_udp_hdr *udp)
+{
+	union net_ip_header ip_hdr = { .ipv4 = ipv4 };
+	union net_proto_header proto_hdr = { .udp = udp };
+	uint32_t expected = delivered + ITERATIONS;
+	timing_t start, end;
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < ITERATIONS; i++) {
+		(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	end = timing_counter_get();
+
+	if (delivered != expected) {
+		printk("ERROR: %u packets not delivered\n", expected - delivered);
+	}
+
+	return (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &end)) /
+			  ITERATIONS);
+}
+
+int main(void)
+{
+	struct net_ipv4_hdr ipv4 = {
+		.vhl = 0x45,
+		.ttl = 64,
+		.proto = IPPROTO_UDP,
+	};
+	struct net_udp_hdr udp = { 0 };
+	struct net_pkt *pkt;
+	uint32_t registered = 0U;
+	uint32_t tuple_ns, listener_ns;
+	int ret;
+
+	pkt = net_pkt_alloc_on_iface(net_if_get_default(), K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET);
+
+	ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+				(struct sockaddr *)&local_addr, 0, LISTEN_PORT,
+				NULL, bench_cb, NULL, &listener);
+	if (ret < 0) {
+		printk("ERROR: cannot register listener (%d)\n", ret);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int c = 0; c < ARRAY_SIZE(conn_counts); c++) {
+		while (registered < conn_counts[c]) {
+			ret = net_conn_register(IPPROTO_UDP, AF_INET,
+						(struct sockaddr *)&remote_addr,
+						(struct sockaddr *)&local_addr,
+						REMOTE_PORT + registered, LOCAL_PORT,
+						NULL, bench_cb, NULL,
+						&handles[registered]);
+			if (ret < 0) {
+				printk("ERROR: cannot register handler %u (%d)\n",
+				       registered, ret);
+				return 0;
+			}
+
+			registered++;
+		}
+
+		/* To the handler that was registered first */
+		net_ipv4_addr_copy_raw(ipv4.src, (uint8_t *)&remote_addr.sin_addr);
+		net_ipv4_addr_copy_raw(ipv4.dst, (uint8_t *)&local_addr.sin_addr);
+		udp.src_port = htons(REMOTE_PORT);
+		udp.dst_port = htons(LOCAL_PORT);
+
+		tuple_ns = bench_input(pkt, &ipv4, &udp);
+
+		/* To the listener, from an unknown peer */
+		ipv4.src[3] = 3U;
+		udp.src_port = htons(REMOTE_PORT - 1U);
+		udp.dst_port = htons(LISTEN_PORT);
+
+		listener_ns = bench_input(pkt, &ipv4, &udp);
+
+		printk("conns %5u tuple %6u ns/pkt listener %6u ns/pkt\n",
+		       registered, tuple_ns, listener_ns);
+	}
+
+	timing_stop();
+
+	for (uint32_t i = 0; i < registered; i++) {
+		(void)net_conn_unregister(handles[i]);
+	}
+
+	(void)net_conn_unregister(listener);
+
+	net_pkt_unref(pkt);
+
+	printk("fin\n");
+
+	return 0;
+}
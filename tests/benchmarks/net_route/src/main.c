@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include "ipv6.h"
+#include "route.h"
+
+/* Route lookup benchmark, the lookup being what a router does for every
+ * forwarded packet. The routing table is filled with a growing number of
+ * /64 routes via the same next hop. For every table size, the lookups
+ * either go round robin to a destination in each of the routes, or always
+ * to the same destination. Then packets to the destinations of all the
+ * routes are received and forwarded, to put the lookup cost in proportion
+ * with the rest of the forwarding path.
+ */
+
+#define ITERATIONS 10000U
+#define MAX_ROUTES 256U
+#define PAYLOAD_LEN 64U
+
+BUILD_ASSERT(CONFIG_NET_MAX_ROUTES >= MAX_ROUTES);
+BUILD_ASSERT(CONFIG_NET_MAX_NEXTHOPS >= MAX_ROUTES);
+
+static const uint32_t route_counts[] = { 1, 16, 64, MAX_ROUTES };
+
+static struct net_route_entry *routes[MAX_ROUTES];
+static struct in6_addr destinations[MAX_ROUTES];
+
+static struct in6_addr nexthop = { { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+
+static uint8_t nexthop_lladdr[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+static uint8_t iface_lladdr[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 };
+
+static struct in6_addr source = { { { 0x20, 0x01, 0x0d, 0xb8, 0xff, 0xff, 0, 0,
+				      0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+
+/* UDP packet received from source, its destination is set before each
+ * reception.
+ */
+static struct {
+	struct net_ipv6_hdr ipv6;
+	struct net_udp_hdr udp;
+	uint8_t payload[PAYLOAD_LEN];
+} __packed frame;
+
+static uint32_t forwarded;
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, iface_lladdr, sizeof(iface_lladdr),
+			     NET_LINK_ETHERNET);
+}
+
+/* The routes point back to the interface the packets are received on, so
+ * the forwarded packets end up here and are dropped.
+ */
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+
+	if (net_pkt_forwarding(pkt)) {
+		forwarded++;
+	}
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_route_bench, "net_route_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV6_MTU);
+
+static void route_prefix(struct in6_addr *addr, uint32_t idx)
+{
+	*addr = (struct in6_addr){ { { 0x20, 0x01, 0x0d, 0xb8, 0, 0,
+				       idx >> 8, idx & 0xff } } };
+}
+
+static uint32_t bench_lookup(struct net_if *iface, uint32_t count)
+{
+	uint32_t failed = 0U;
+	timing_t start, end;
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < ITERATIONS; i++) {
+		if (net_route_lookup(iface, &destinations[i % count]) == NULL) {
+			failed++;
+		}
+	}
+
+	end = timing_counter_get();
+
+	if (failed > 0U) {
+		printk("ERROR: %u lookups failed\n", failed);
+	}
+
+	return (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &end)) /
+			  ITERATIONS);
+}
+
+static void frame_init(void)
+{
+	frame.ipv6.vtc = 0x60;
+	frame.ipv6.len = htons(sizeof(frame.udp) + sizeof(frame.payload));
+	frame.ipv6.nexthdr = IPPROTO_UDP;
+	frame.ipv6.hop_limit = 64U;
+	memcpy(frame.ipv6.src, &source, sizeof(frame.ipv6.src));
+
+	frame.udp.src_port = htons(4242);
+	frame.udp.dst_port = htons(4242);
+	frame.udp.len = frame.ipv6.len;
+}
+
+/* Receive packets round robin to the destinations, as a driver would */
+static uint32_t bench_forward(struct net_if *iface, uint32_t count)
+{
+	uint32_t failed = 0U;
+	timing_t start, end;
+	struct net_pkt *pkt;
+
+	forwarded = 0U;
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < ITERATIONS; i++) {
+		memcpy(frame.ipv6.dst, &destinations[i % count],
+		       sizeof(frame.ipv6.dst));
+
+		pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(frame),
+						   AF_UNSPEC, 0, K_FOREVER);
+		if (pkt == NULL) {
+			failed++;
+			continue;
+		}
+
+		if (net_pkt_write(pkt, &frame, sizeof(frame)) < 0 ||
+		    net_recv_data(iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+			failed++;
+		}
+	}
+
+	end = timing_counter_get();
+
+	if (failed > 0U || forwarded != ITERATIONS) {
+		printk("ERROR: %u packets not received, %u not forwarded\n",
+		       failed, ITERATIONS - failed - forwarded);
+	}
+
+	return (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &end)) /
+			  ITERATIONS);
+}
+
+int main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct net_linkaddr lladdr = {
+		.addr = nexthop_lladdr,
+		.len = sizeof(nexthop_lladdr),
+		.type = NET_LINK_ETHERNET,
+	};
+	uint32_t added = 0U;
+	uint32_t spread_ns, same_ns, forward_ns;
+
+	if (net_ipv6_nbr_add(iface, &nexthop, &lladdr, true,
+			     NET_IPV6_NBR_STATE_STATIC) == NULL) {
+		printk("ERROR: cannot add next hop\n");
+		return 0;
+	}
+
+	frame_init();
+
+	timing_init();
+	timing_start();
+
+	for (int c = 0; c < ARRAY_SIZE(route_counts); c++) {
+		while (added < route_counts[c]) {
+			struct in6_addr prefix;
+
+			route_prefix(&prefix, added);
+
+			routes[added] = net_route_add(iface, &prefix, 64, &nexthop,
+						      NET_IPV6_ND_INFINITE_LIFETIME,
+						      NET_ROUTE_PREFERENCE_MEDIUM);
+			if (routes[added] == NULL) {
+				printk("ERROR: cannot add route %u\n", added);
+				return 0;
+			}
+
+			destinations[added] = prefix;
+			destinations[added].s6_addr[15] = 1U;
+
+			added++;
+		}
+
+		spread_ns = bench_lookup(iface, added);
+		same_ns = bench_lookup(iface, 1U);
+		forward_ns = bench_forward(iface, added);
+
+		printk("routes %4u spread %6u ns/pkt same %6u ns/pkt "
+		       "forward %6u ns/pkt\n",
+		       added, spread_ns, same_ns, forward_ns);
+	}
+
+	timing_stop();
+
+	for (uint32_t i = 0; i < added; i++) {
+		(void)net_route_del(routes[i]);
+	}
+
+	printk("fin\n");
+
+	return 0;
+}
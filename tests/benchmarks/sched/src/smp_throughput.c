@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* SMP context switch throughput benchmark.  Each "pair" is two
+ * threads bouncing a pair of semaphores, so every iteration forces
+ * two context switches through the ready queue.  Running one pair,
+ * then two, and so on up to one pair per CPU shows how scheduling
+ * throughput scales (or doesn't) with the number of busy CPUs.  Both
+ * threads of pair N are pinned to CPU N, so the runs measure the
+ * scheduler and not the migration of the pairs between CPUs.
+ */
+
+#define MAX_PAIRS   CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+struct pair {
+	struct k_sem ping;
+	struct k_sem pong;
+	uint32_t iterations;
+};
+
+static struct pair pairs[MAX_PAIRS];
+static struct k_thread threads[2 * MAX_PAIRS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_PAIRS, STACK_SIZE);
+
+static volatile bool stop;
+
+static void pinger(void *p1, void *p2, void *p3)
+{
+	struct pair *pair = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		k_sem_give(&pair->ping);
+		k_sem_take(&pair->pong, K_FOREVER);
+		pair->iterations++;
+	}
+}
+
+static void ponger(void *p1, void *p2, void *p3)
+{
+	struct pair *pair = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		k_sem_take(&pair->ping, K_FOREVER);
+		k_sem_give(&pair->pong);
+	}
+}
+
+static uint64_t run(unsigned int npairs)
+{
+	uint64_t switches = 0U;
+
+	stop = false;
+
+	for (unsigned int i = 0; i < npairs; i++) {
+		k_sem_init(&pairs[i].ping, 0, 1);
+		k_sem_init(&pairs[i].pong, 0, 1);
+		pairs[i].iterations = 0U;
+
+		k_thread_create(&threads[2 * i], stacks[2 * i], STACK_SIZE,
+				pinger, &pairs[i], NULL, NULL,
+				WORKER_PRIO, 0, K_FOREVER);
+		k_thread_create(&threads[2 * i + 1], stacks[2 * i + 1],
+				STACK_SIZE, ponger, &pairs[i], NULL, NULL,
+				WORKER_PRIO, 0, K_FOREVER);
+		k_thread_cpu_pin(&threads[2 * i], i);
+		k_thread_cpu_pin(&threads[2 * i + 1], i);
+	}
+
+	for (unsigned int i = 0; i < 2 * npairs; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	k_msleep(CONFIG_SCHED_BENCH_SMP_DURATION_MS);
+	stop = true;
+
+	for (unsigned int i = 0; i < npairs; i++) {
+		/* Release whichever side is blocked */
+		k_sem_give(&pairs[i].ping);
+		k_sem_give(&pairs[i].pong);
+	}
+
+	for (unsigned int i = 0; i < npairs; i++) {
+		k_thread_join(&threads[2 * i], K_FOREVER);
+		k_thread_join(&threads[2 * i + 1], K_FOREVER);
+		switches += 2U * pairs[i].iterations;
+	}
+
+	return switches;
+}
+
+int main(void)
+{
+	/* Stay above the workers so that we get back on time */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	for (unsigned int n = 1; n <= arch_num_cpus(); n++) {
+		uint64_t switches = run(n);
+
+		printk("cpus %2u switches/s %8u\n", n,
+		       (uint32_t)((switches * MSEC_PER_SEC) /
+				  CONFIG_SCHED_BENCH_SMP_DURATION_MS));
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/irq_offload.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/drivers/timer/system_timer.h>
+#include <timeout_q.h>
+
+/* Timeout queue microbenchmark.  For a growing number of armed
+ * "background" timeouts, it measures the cost of arming one more
+ * timeout at a random position, of aborting it again, and of a
+ * sys_clock_announce() which expires one timeout sitting at the
+ * head of the queue.  Background timeouts are spread far enough in
+ * the future that they never fire while the benchmark runs.
+ *
+ * The internal timeout API is used to measure the queue alone, without
+ * the k_timer layer.  The announcements are made in interrupt context
+ * with irq_offload(), as the system timer driver makes them, but each
+ * covers one tick more than the hardware clock has counted, so the
+ * kernel uptime runs ahead of it once the benchmark completes.
+ */
+
+#define MAX_TIMEOUTS 10000
+#define N_RUNS 100
+
+/* All background and probe timeouts lie beyond this many ticks */
+#define FAR_TICKS 1000000
+
+static const uint32_t queue_sizes[] = { 10, 100, 1000, MAX_TIMEOUTS };
+
+static struct _timeout background[MAX_TIMEOUTS];
+static struct _timeout probe;
+static volatile bool probe_fired;
+static uint64_t announce_cycles;
+
+static uint32_t rand_state = 1U;
+
+/* Simple LCG, we only need a cheap and reproducible spread */
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void background_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	__ASSERT(false, "background timeout expired");
+}
+
+static void probe_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	probe_fired = true;
+}
+
+static k_timeout_t far_timeout(void)
+{
+	return K_TICKS(FAR_TICKS + (next_rand() % (16U * MAX_TIMEOUTS)));
+}
+
+static uint64_t bench_insert_abort(uint64_t *abort_cycles)
+{
+	uint64_t insert_cycles = 0U;
+	timing_t start, mid, end;
+
+	*abort_cycles = 0U;
+
+	for (int i = 0; i < N_RUNS; i++) {
+		k_timeout_t timeout = far_timeout();
+		unsigned int key = irq_lock();
+
+		start = timing_counter_get();
+		z_add_timeout(&probe, probe_fn, timeout);
+		mid = timing_counter_get();
+		z_abort_timeout(&probe);
+		end = timing_counter_get();
+
+		irq_unlock(key);
+
+		insert_cycles += timing_cycles_get(&start, &mid);
+		*abort_cycles += timing_cycles_get(&mid, &end);
+	}
+
+	return insert_cycles;
+}
+
+/* Runs in interrupt context, like the system timer driver ISR.  The
+ * lock keeps a nested timer interrupt from announcing the probe first.
+ */
+static void announce_isr(const void *arg)
+{
+	unsigned int key = irq_lock();
+	timing_t start, end;
+
+	ARG_UNUSED(arg);
+
+	/* Expires at the next tick boundary, i.e. the head of the queue,
+	 * and any announcement covering the ticks elapsed so far plus one
+	 * will fire it.
+	 */
+	probe_fired = false;
+	z_add_timeout(&probe, probe_fn, K_NO_WAIT);
+
+	start = timing_counter_get();
+	sys_clock_announce(sys_clock_elapsed() + 1);
+	end = timing_counter_get();
+
+	irq_unlock(key);
+
+	announce_cycles += timing_cycles_get(&start, &end);
+}
+
+static uint64_t bench_announce(void)
+{
+	announce_cycles = 0U;
+
+	for (int i = 0; i < N_RUNS; i++) {
+		irq_offload(announce_isr, NULL);
+
+		__ASSERT(probe_fired, "probe timeout did not expire");
+	}
+
+	return announce_cycles;
+}
+
+int main(void)
+{
+	uint32_t armed = 0U;
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(queue_sizes); i++) {
+		uint64_t insert, abort, announce;
+
+		for (; armed < queue_sizes[i]; armed++) {
+			z_init_timeout(&background[armed]);
+			z_add_timeout(&background[armed], background_fn,
+				      far_timeout());
+		}
+
+		z_init_timeout(&probe);
+		insert = bench_insert_abort(&abort);
+		announce = bench_announce();
+
+		printk("timeouts %5u insert %5u ns abort %5u ns announce %5u ns\n",
+		       armed,
+		       (uint32_t)timing_cycles_to_ns_avg(insert, N_RUNS),
+		       (uint32_t)timing_cycles_to_ns_avg(abort, N_RUNS),
+		       (uint32_t)timing_cycles_to_ns_avg(announce, N_RUNS));
+	}
+
+	for (uint32_t i = 0U; i < armed; i++) {
+		z_abort_timeout(&background[i]);
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+	return 0;
+}
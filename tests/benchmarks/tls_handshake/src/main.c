@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/tls_credentials.h>
+#include <zephyr/sys/printk.h>
+
+#include "bench_clock.h"
+
+/* TLS handshake rate benchmark. A server thread accepts TLS connections
+ * over the loopback interface, with both the session cache and the session
+ * tickets enabled. The client connects HANDSHAKES times, exchanges one byte
+ * and closes the connection, in three modes:
+ *
+ * - full: the client does not keep the session, every handshake is a full
+ *   ECDHE-PSK one,
+ * - session_id: the client keeps the session but does not use tickets, so
+ *   the server resumes it from its session cache,
+ * - ticket: the client keeps the session with its ticket, so the server
+ *   resumes it from the ticket.
+ *
+ * The stored sessions are purged before each mode, and the first connection
+ * of a mode, doing the full handshake, is not measured.
+ */
+
+#define SERVER_ADDR "127.0.0.1"
+#define SERVER_PORT 4443
+#define PSK_TAG     1
+
+#define HANDSHAKES          100U
+#define SERVER_STACK_SIZE   8192
+#define SERVER_PRIORITY     K_PRIO_PREEMPT(8)
+
+static const unsigned char psk[] = {
+	0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const char psk_id[] = "bench_identity";
+
+static const sec_tag_t sec_tags[] = {
+	PSK_TAG,
+};
+
+struct bench_mode {
+	const char *name;
+	bool cache;
+	bool tickets;
+};
+
+static const struct bench_mode modes[] = {
+	{ .name = "full" },
+	{ .name = "session_id", .cache = true },
+	{ .name = "ticket", .cache = true, .tickets = true },
+};
+
+static K_THREAD_STACK_DEFINE(server_stack, SERVER_STACK_SIZE);
+static struct k_thread server_thread_data;
+static int server_fd = -1;
+static bool stopping;
+
+static int set_option(int fd, int option, int value)
+{
+	return zsock_setsockopt(fd, SOL_TLS, option, &value, sizeof(value));
+}
+
+static void server_thread(void *p1, void *p2, void *p3)
+{
+	char byte;
+	int fd;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stopping) {
+		/* The handshake is done by accept() */
+		fd = zsock_accept(server_fd, NULL, NULL);
+		if (fd < 0) {
+			continue;
+		}
+
+		if (zsock_recv(fd, &byte, sizeof(byte), 0) == sizeof(byte)) {
+			(void)zsock_send(fd, &byte, sizeof(byte), 0);
+		}
+
+		(void)zsock_close(fd);
+	}
+}
+
+static int server_start(const struct sockaddr_in *sa)
+{
+	server_fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	if (server_fd < 0) {
+		return -errno;
+	}
+
+	if (zsock_setsockopt(server_fd, SOL_TLS, TLS_SEC_TAG_LIST,
+			     sec_tags, sizeof(sec_tags)) < 0 ||
+	    set_option(server_fd, TLS_SESSION_CACHE, TLS_SESSION_CACHE_ENABLED) < 0 ||
+	    set_option(server_fd, TLS_SESSION_TICKETS, TLS_SESSION_TICKETS_ENABLED) < 0 ||
+	    zsock_bind(server_fd, (const struct sockaddr *)sa, sizeof(*sa)) < 0 ||
+	    zsock_listen(server_fd, 1) < 0) {
+		return -errno;
+	}
+
+	k_thread_create(&server_thread_data, server_stack,
+			K_THREAD_STACK_SIZEOF(server_stack),
+			server_thread, NULL, NULL, NULL,
+			SERVER_PRIORITY, 0, K_NO_WAIT);
+
+	return 0;
+}
+
+static int handshake(const struct sockaddr_in *sa, const struct bench_mode *mode)
+{
+	char byte = 'x';
+	int fd, ret;
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	if (zsock_setsockopt(fd, SOL_TLS, TLS_SEC_TAG_LIST, sec_tags, sizeof(sec_tags)) < 0 ||
+	    set_option(fd, TLS_SESSION_CACHE,
+		       mode->cache ? TLS_SESSION_CACHE_ENABLED :
+				     TLS_SESSION_CACHE_DISABLED) < 0 ||
+	    set_option(fd, TLS_SESSION_TICKETS,
+		       mode->tickets ? TLS_SESSION_TICKETS_ENABLED :
+				       TLS_SESSION_TICKETS_DISABLED) < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	/* The handshake is done by connect() */
+	ret = zsock_connect(fd, (const struct sockaddr *)sa, sizeof(*sa));
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	if (zsock_send(fd, &byte, sizeof(byte), 0) != sizeof(byte) ||
+	    zsock_recv(fd, &byte, sizeof(byte), 0) != sizeof(byte)) {
+		ret = -EIO;
+		goto out;
+	}
+
+	ret = 0;
+
+out:
+	(void)zsock_close(fd);
+
+	return ret;
+}
+
+static void bench_handshakes(const struct sockaddr_in *sa, const struct bench_mode *mode)
+{
+	uint32_t failed = 0U;
+	uint64_t start, elapsed;
+
+	(void)set_option(server_fd, TLS_SESSION_CACHE_PURGE, 0);
+
+	/* Full handshake storing the session to resume */
+	if (handshake(sa, mode) < 0) {
+		failed++;
+	}
+
+	start = bench_now_us();
+
+	for (uint32_t i = 0; i < HANDSHAKES; i++) {
+		if (handshake(sa, mode) < 0) {
+			failed++;
+		}
+	}
+
+	elapsed = MAX(bench_now_us() - start, 1U);
+
+	printk("%-10s handshakes %4u failed %3u %6u hs/s\n", mode->name, HANDSHAKES,
+	       failed, (uint32_t)(HANDSHAKES * USEC_PER_SEC / elapsed));
+}
+
+int main(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int ret;
+
+	(void)zsock_inet_pton(AF_INET, SERVER_ADDR, &sa.sin_addr);
+
+	if (tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK, psk, sizeof(psk)) < 0 ||
+	    tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK_ID, psk_id,
+			       sizeof(psk_id) - 1) < 0) {
+		printk("ERROR: cannot add the credentials\n");
+		return 0;
+	}
+
+	ret = server_start(&sa);
+	if (ret < 0) {
+		printk("ERROR: cannot start the server (%d)\n", ret);
+		return 0;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(modes); i++) {
+		bench_handshakes(&sa, &modes[i]);
+	}
+
+	/* Closing the socket wakes the server thread up from accept() */
+	stopping = true;
+	(void)zsock_close(server_fd);
+	k_thread_join(&server_thread_data, K_FOREVER);
+
+	printk("fin\n");
+
+	return 0;
+}
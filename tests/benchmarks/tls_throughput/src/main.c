@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/mqtt.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/tls_credentials.h>
+#include <zephyr/sys/printk.h>
+
+#include "bench_clock.h"
+
+/* TLS socket throughput benchmark, over the loopback interface, on the two
+ * paths writing small pieces of data to TLS sockets:
+ *
+ * - the HTTPS server, which writes the headers of a response and then its
+ *   body. A client thread sends GET requests for a small and a large static
+ *   resource, each request using a new connection as the server closes it
+ *   after the response.
+ * - an MQTT client publishing over TLS, the MQTT library writing the header
+ *   of each PUBLISH packet and then its payload. A minimal broker in the
+ *   same image accepts the connection and counts the messages.
+ *
+ * Compare the default scenario, coalescing the writes into records, with
+ * the no_coalesce one.
+ */
+
+#define SERVER_ADDR "127.0.0.1"
+#define HTTPS_PORT  8443
+#define MQTT_PORT   8883
+#define PSK_TAG     1
+
+#define SMALL_BODY_LEN      256
+#define LARGE_BODY_LEN      16384
+#define SMALL_REQUESTS      200U
+#define LARGE_REQUESTS      50U
+#define MQTT_MESSAGES       2000U
+#define MQTT_PAYLOAD_LEN    64
+#define MQTT_TOPIC          "bench/tls"
+#define BROKER_STACK_SIZE   8192
+#define BROKER_PRIORITY     K_PRIO_PREEMPT(8)
+
+#define MQTT_PACKET_CONNECT    1
+#define MQTT_PACKET_PUBLISH    3
+#define MQTT_PACKET_DISCONNECT 14
+
+static const unsigned char psk[] = {
+	0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const char psk_id[] = "bench_identity";
+
+static const sec_tag_t sec_tags[] = {
+	PSK_TAG,
+};
+
+static uint16_t bench_service_port = HTTPS_PORT;
+HTTPS_SERVICE_DEFINE(bench_service, SERVER_ADDR, &bench_service_port, 1, 1, NULL,
+		     sec_tags, sizeof(sec_tags));
+
+static uint8_t small_body[SMALL_BODY_LEN];
+static uint8_t large_body[LARGE_BODY_LEN];
+
+static struct http_resource_detail_static small_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.content_type = "application/json",
+	},
+	.static_data = small_body,
+	.static_data_len = sizeof(small_body),
+};
+
+static struct http_resource_detail_static large_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.content_type = "application/octet-stream",
+	},
+	.static_data = large_body,
+	.static_data_len = sizeof(large_body),
+};
+
+HTTP_RESOURCE_DEFINE(small_resource, bench_service, "/small", &small_detail);
+HTTP_RESOURCE_DEFINE(large_resource, bench_service, "/large", &large_detail);
+
+static int tls_socket(void)
+{
+	int fd;
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	if (zsock_setsockopt(fd, SOL_TLS, TLS_SEC_TAG_LIST, sec_tags, sizeof(sec_tags)) < 0) {
+		(void)zsock_close(fd);
+		return -errno;
+	}
+
+	return fd;
+}
+
+static int https_get(const struct sockaddr_in *sa, const char *path, size_t body_len)
+{
+	static const char status_ok[] = "HTTP/1.1 200";
+	char buf[512];
+	size_t received = 0;
+	bool ok = false;
+	int fd, ret, len;
+
+	len = snprintk(buf, sizeof(buf), "GET %s HTTP/1.1\r\nHost: " SERVER_ADDR "\r\n\r\n",
+		       path);
+
+	fd = tls_socket();
+	if (fd < 0) {
+		return fd;
+	}
+
+	ret = zsock_connect(fd, (const struct sockaddr *)sa, sizeof(*sa));
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	ret = zsock_send(fd, buf, len, 0);
+	if (ret != len) {
+		ret = -EIO;
+		goto out;
+	}
+
+	/* The server closes the connection after the response */
+	while (true) {
+		ret = zsock_recv(fd, buf, sizeof(buf), 0);
+		if (ret <= 0) {
+			break;
+		}
+
+		if (received == 0) {
+			ok = (size_t)ret >= sizeof(status_ok) - 1 &&
+			     memcmp(buf, status_ok, sizeof(status_ok) - 1) == 0;
+		}
+
+		received += ret;
+	}
+
+	ret = (ok && received > body_len) ? 0 : -EBADMSG;
+
+out:
+	(void)zsock_close(fd);
+
+	return ret;
+}
+
+static void bench_https(const struct sockaddr_in *sa, const char *path, size_t body_len,
+			uint32_t requests)
+{
+	uint32_t failed = 0U;
+	uint64_t start, elapsed;
+
+	start = bench_now_us();
+
+	for (uint32_t i = 0; i < requests; i++) {
+		if (https_get(sa, path, body_len) < 0) {
+			failed++;
+		}
+	}
+
+	elapsed = MAX(bench_now_us() - start, 1U);
+
+	printk("https %5zu B requests %4u failed %3u %6u req/s %6u kB/s\n", body_len,
+	       requests, failed, (uint32_t)(requests * USEC_PER_SEC / elapsed),
+	       (uint32_t)((uint64_t)requests * body_len * USEC_PER_SEC / elapsed / 1024U));
+}
+
+/* Minimal MQTT broker: accepts one connection and counts the PUBLISH
+ * packets until the DISCONNECT one.
+ */
+
+struct broker_stream {
+	int fd;
+	size_t len;
+	size_t pos;
+	uint8_t buf[1024];
+};
+
+static K_THREAD_STACK_DEFINE(broker_stack, BROKER_STACK_SIZE);
+static struct k_thread broker_thread_data;
+static struct broker_stream broker_stream;
+static K_SEM_DEFINE(broker_done, 0, 1);
+static int broker_fd = -1;
+static uint32_t broker_messages;
+
+static int broker_fill(struct broker_stream *s)
+{
+	ssize_t ret;
+
+	if (s->pos < s->len) {
+		return 0;
+	}
+
+	ret = zsock_recv(s->fd, s->buf, sizeof(s->buf), 0);
+	if (ret <= 0) {
+		return -EIO;
+	}
+
+	s->len = ret;
+	s->pos = 0;
+
+	return 0;
+}
+
+/* Returns the type of the next packet, its content being skipped */
+static int broker_packet(struct broker_stream *s)
+{
+	uint32_t remaining = 0U;
+	uint32_t shift = 0U;
+	uint8_t type;
+	uint8_t byte;
+
+	if (broker_fill(s) < 0) {
+		return -EIO;
+	}
+
+	type = s->buf[s->pos++] >> 4;
+
+	do {
+		if (broker_fill(s) < 0 || shift > 21U) {
+			return -EIO;
+		}
+
+		byte = s->buf[s->pos++];
+		remaining |= (uint32_t)(byte & 0x7f) << shift;
+		shift += 7U;
+	} while (byte & 0x80);
+
+	while (remaining > 0U) {
+		size_t len;
+
+		if (broker_fill(s) < 0) {
+			return -EIO;
+		}
+
+		len = MIN(remaining, s->len - s->pos);
+		s->pos += len;
+		remaining -= len;
+	}
+
+	return type;
+}
+
+static void broker_thread(void *p1, void *p2, void *p3)
+{
+	static const uint8_t connack[] = { 0x20, 0x02, 0x00, 0x00 };
+	struct broker_stream *s = &broker_stream;
+	int type;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	s->fd = zsock_accept(broker_fd, NULL, NULL);
+	if (s->fd < 0) {
+		goto out;
+	}
+
+	if (broker_packet(s) != MQTT_PACKET_CONNECT ||
+	    zsock_send(s->fd, connack, sizeof(connack), 0) != sizeof(connack)) {
+		goto out;
+	}
+
+	while (true) {
+		type = broker_packet(s);
+		if (type < 0 || type == MQTT_PACKET_DISCONNECT) {
+			break;
+		}
+
+		if (type == MQTT_PACKET_PUBLISH) {
+			broker_messages++;
+		}
+	}
+
+out:
+	if (s->fd >= 0) {
+		(void)zsock_close(s->fd);
+	}
+
+	k_sem_give(&broker_done);
+}
+
+static int broker_start(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(MQTT_PORT),
+	};
+
+	(void)zsock_inet_pton(AF_INET, SERVER_ADDR, &sa.sin_addr);
+
+	broker_fd = tls_socket();
+	if (broker_fd < 0) {
+		return broker_fd;
+	}
+
+	if (zsock_bind(broker_fd, (struct sockaddr *)&sa, sizeof(sa)) < 0 ||
+	    zsock_listen(broker_fd, 1) < 0) {
+		return -errno;
+	}
+
+	k_thread_create(&broker_thread_data, broker_stack,
+			K_THREAD_STACK_SIZEOF(broker_stack),
+			broker_thread, NULL, NULL, NULL,
+			BROKER_PRIORITY, 0, K_NO_WAIT);
+
+	return 0;
+}
+
+static struct mqtt_client mqtt_client;
+static struct sockaddr_storage mqtt_broker;
+static uint8_t mqtt_rx_buf[128];
+static uint8_t mqtt_tx_buf[128];
+static bool mqtt_connected;
+
+static void mqtt_evt_handler(struct mqtt_client *client, const struct mqtt_evt *evt)
+{
+	ARG_UNUSED(client);
+
+	if (evt->type == MQTT_EVT_CONNACK && evt->result == 0) {
+		mqtt_connected = true;
+	}
+}
+
+static int mqtt_bench_connect(void)
+{
+	struct sockaddr_in *broker = (struct sockaddr_in *)&mqtt_broker;
+	struct mqtt_sec_config *tls_config;
+	struct zsock_pollfd fds[1];
+	int ret;
+
+	broker->sin_family = AF_INET;
+	broker->sin_port = htons(MQTT_PORT);
+	(void)zsock_inet_pton(AF_INET, SERVER_ADDR, &broker->sin_addr);
+
+	mqtt_client_init(&mqtt_client);
+
+	mqtt_client.broker = &mqtt_broker;
+	mqtt_client.evt_cb = mqtt_evt_handler;
+	mqtt_client.client_id.utf8 = (uint8_t *)"bench";
+	mqtt_client.client_id.size = sizeof("bench") - 1;
+	mqtt_client.protocol_version = MQTT_VERSION_3_1_1;
+	mqtt_client.rx_buf = mqtt_rx_buf;
+	mqtt_client.rx_buf_size = sizeof(mqtt_rx_buf);
+	mqtt_client.tx_buf = mqtt_tx_buf;
+	mqtt_client.tx_buf_size = sizeof(mqtt_tx_buf);
+	mqtt_client.transport.type = MQTT_TRANSPORT_SECURE;
+
+	tls_config = &mqtt_client.transport.tls.config;
+	tls_config->peer_verify = TLS_PEER_VERIFY_NONE;
+	tls_config->sec_tag_list = sec_tags;
+	tls_config->sec_tag_count = ARRAY_SIZE(sec_tags);
+
+	ret = mqtt_connect(&mqtt_client);
+	if (ret < 0) {
+		return ret;
+	}
+
+	fds[0].fd = mqtt_client.transport.tls.sock;
+	fds[0].events = ZSOCK_POLLIN;
+
+	while (!mqtt_connected) {
+		if (zsock_poll(fds, 1, MSEC_PER_SEC) <= 0) {
+			return -ETIMEDOUT;
+		}
+
+		ret = mqtt_input(&mqtt_client);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void bench_mqtt(void)
+{
+	static uint8_t payload[MQTT_PAYLOAD_LEN];
+	struct mqtt_publish_param param = {
+		.message.topic.qos = MQTT_QOS_0_AT_MOST_ONCE,
+		.message.topic.topic.utf8 = (uint8_t *)MQTT_TOPIC,
+		.message.topic.topic.size = sizeof(MQTT_TOPIC) - 1,
+		.message.payload.data = payload,
+		.message.payload.len = sizeof(payload),
+	};
+	uint64_t start, elapsed;
+	int ret;
+
+	memset(payload, 'x', sizeof(payload));
+
+	ret = broker_start();
+	if (ret < 0) {
+		printk("ERROR: cannot start the broker (%d)\n", ret);
+		return;
+	}
+
+	ret = mqtt_bench_connect();
+	if (ret < 0) {
+		printk("ERROR: cannot connect to the broker (%d)\n", ret);
+		return;
+	}
+
+	start = bench_now_us();
+
+	for (uint32_t i = 0; i < MQTT_MESSAGES; i++) {
+		param.message_id = i + 1;
+
+		if (mqtt_publish(&mqtt_client, &param) < 0) {
+			break;
+		}
+	}
+
+	(void)mqtt_disconnect(&mqtt_client);
+
+	/* The broker has received all the messages when it gets DISCONNECT */
+	(void)k_sem_take(&broker_done, K_FOREVER);
+
+	elapsed = MAX(bench_now_us() - start, 1U);
+
+	printk("mqtt %5u B messages %5u received %5u %6u msg/s %6u kB/s\n",
+	       MQTT_PAYLOAD_LEN, MQTT_MESSAGES, broker_messages,
+	       (uint32_t)(broker_messages * USEC_PER_SEC / elapsed),
+	       (uint32_t)((uint64_t)broker_messages * MQTT_PAYLOAD_LEN * USEC_PER_SEC /
+			  elapsed / 1024U));
+
+	(void)zsock_close(broker_fd);
+	k_thread_join(&broker_thread_data, K_FOREVER);
+}
+
+int main(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(HTTPS_PORT),
+	};
+
+	(void)zsock_inet_pton(AF_INET, SERVER_ADDR, &sa.sin_addr);
+
+	for (size_t i = 0; i < sizeof(large_body); i++) {
+		large_body[i] = i;
+	}
+
+	memset(small_body, ' ', sizeof(small_body));
+
+	printk("coalescing buffer %d\n", CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE);
+
+	if (tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK, psk, sizeof(psk)) < 0 ||
+	    tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK_ID, psk_id,
+			       sizeof(psk_id) - 1) < 0) {
+		printk("ERROR: cannot add the credentials\n");
+		return 0;
+	}
+
+	if (http_server_start() < 0) {
+		printk("ERROR: cannot start the server\n");
+		return 0;
+	}
+
+	/* Let the server open its listening socket */
+	k_sleep(K_MSEC(100));
+
+	bench_https(&sa, "/small", SMALL_BODY_LEN, SMALL_REQUESTS);
+	bench_https(&sa, "/large", LARGE_BODY_LEN, LARGE_REQUESTS);
+
+	(void)http_server_stop();
+
+	bench_mqtt();
+
+	printk("fin\n");
+
+	return 0;
+}
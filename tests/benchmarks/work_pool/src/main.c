@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* Work queue pool throughput benchmark.  The same batch of work items
+ * is processed by a single work queue and by a pool of workers, and
+ * the number of items completed per second is reported.
+ */
+
+#define NUM_WORKERS 4
+#define NUM_ITEMS 256
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+static const uint32_t work_us[] = { 0, 50 };
+
+K_WORK_POOL_DEFINE(bench_pool, NUM_WORKERS, STACK_SIZE);
+
+static K_THREAD_STACK_DEFINE(queue_stack, STACK_SIZE);
+static struct k_work_q bench_queue;
+
+static struct k_work items[NUM_ITEMS];
+static K_SEM_DEFINE(done_sem, 0, 1);
+static atomic_t remaining;
+static uint32_t item_us;
+
+static void item_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (item_us != 0U) {
+		k_busy_wait(item_us);
+	}
+
+	if (atomic_dec(&remaining) == 1) {
+		k_sem_give(&done_sem);
+	}
+}
+
+static uint32_t bench_round(struct k_work_pool *pool)
+{
+	uint64_t ns;
+	timing_t start, end;
+
+	atomic_set(&remaining, NUM_ITEMS);
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		if (pool != NULL) {
+			(void)k_work_pool_submit(pool, &items[i]);
+		} else {
+			(void)k_work_submit_to_queue(&bench_queue, &items[i]);
+		}
+	}
+
+	k_sem_take(&done_sem, K_FOREVER);
+
+	end = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	return (uint32_t)(((uint64_t)NUM_ITEMS * NSEC_PER_SEC) / MAX(ns, 1U));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	/* Below the workers, so that they start right away */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(2));
+
+	k_work_queue_start(&bench_queue, queue_stack,
+			   K_THREAD_STACK_SIZEOF(queue_stack), WORKER_PRIO,
+			   NULL);
+	k_work_pool_start(&bench_pool, WORKER_PRIO, NULL);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], item_handler);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(work_us); i++) {
+		item_us = work_us[i];
+
+		printk("queue   work_us %2u items/s %8u\n", item_us,
+		       bench_round(NULL));
+		printk("pool  %u work_us %2u items/s %8u\n", NUM_WORKERS,
+		       item_us, bench_round(&bench_pool));
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
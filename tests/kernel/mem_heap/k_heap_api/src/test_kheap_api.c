@@ -265,3 +265,54 @@ ZTEST(k_heap_api, test_k_heap_alloc_pending_null)
 
 	k_heap_free(&k_heap_test, p);
 }
+
+/**
+ * @brief Validate the k_heap per-CPU caches.
+ *
+ * @details A freed small block is cached and handed out again by the
+ * next allocation of the same size class, and cached blocks are given
+ * back to the heap when an allocation would otherwise fail.
+ *
+ * @ingroup kernel_heap_tests
+ */
+ZTEST(k_heap_api, test_k_heap_cache)
+{
+#ifdef CONFIG_KHEAP_CACHE
+	/* Stay on the same CPU, and thus use the same cache */
+	unsigned int key = irq_lock();
+	char *p = (char *)k_heap_alloc(&k_heap_test, 24, K_NO_WAIT);
+	char *q = NULL;
+
+	if (p != NULL) {
+		k_heap_free(&k_heap_test, p);
+		q = (char *)k_heap_alloc(&k_heap_test, 32, K_NO_WAIT);
+	}
+
+	irq_unlock(key);
+
+	zassert_not_null(p, "k_heap_alloc operation failed");
+	zassert_equal_ptr(p, q, "freed block was not cached");
+	k_heap_free(&k_heap_test, q);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	struct sys_memory_stats heap_stats;
+	struct sys_memory_stats stats;
+
+	/* The cached block is free for the k_heap, not for its sys_heap */
+	zassert_ok(sys_heap_runtime_stats_get(&k_heap_test.heap, &heap_stats));
+	zassert_ok(k_heap_runtime_stats_get(&k_heap_test, &stats));
+	zassert_true(stats.free_bytes > heap_stats.free_bytes,
+		     "cached block not accounted as free");
+	zassert_equal(stats.free_bytes + stats.allocated_bytes,
+		      heap_stats.free_bytes + heap_stats.allocated_bytes,
+		      "cached bytes accounted twice");
+#endif
+
+	/* Cached blocks must not get in the way of large allocations */
+	p = (char *)k_heap_alloc(&k_heap_test, ALLOC_SIZE_1 + 512, K_NO_WAIT);
+	zassert_not_null(p, "cached blocks were not returned to the heap");
+	k_heap_free(&k_heap_test, p);
+#else
+	ztest_test_skip();
+#endif
+}
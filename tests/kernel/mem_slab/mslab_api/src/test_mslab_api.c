@@ -338,3 +338,39 @@ ZTEST(mslab_api, test_mslab_pending)
 	/* Free memory block */
 	k_mem_slab_free(&kmslab, b);
 }
+
+/**
+ * @brief Verify allocating and freeing multiple blocks at once
+ *
+ * @details Allocate all blocks with @see k_mem_slab_alloc_bulk(),
+ * check that a further bulk allocation fails without allocating
+ * anything, then free all blocks with @see k_mem_slab_free_bulk().
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_api, test_mslab_bulk)
+{
+	void *block[BLK_NUM];
+	void *b;
+
+	zassert_equal(k_mem_slab_alloc_bulk(&mslab, block, BLK_NUM), 0);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), 0);
+
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_not_null(block[i]);
+		zassert_true((uintptr_t)block[i] % BLK_ALIGN == 0U);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(block[i], block[j]);
+		}
+	}
+
+	/* all or nothing */
+	k_mem_slab_free(&mslab, block[0]);
+	zassert_equal(k_mem_slab_alloc_bulk(&mslab, &b, 2), -ENOMEM);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), BLK_NUM - 1);
+	zassert_equal(k_mem_slab_alloc_bulk(&mslab, &block[0], 1), 0);
+
+	k_mem_slab_free_bulk(&mslab, block, BLK_NUM);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 0);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM);
+}
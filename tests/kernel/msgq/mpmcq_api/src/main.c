@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+
+#define MSG_SIZE 4
+#define MSGQ_LEN 4
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_THREADS 4
+#define MSGS_PER_THREAD 5000
+
+K_MPMCQ_DEFINE(kmpmcq, MSG_SIZE, MSGQ_LEN);
+
+static struct k_mpmcq mpmcq;
+static atomic_t mpmcq_buf[MPMC_BUF_SIZE(MSG_SIZE, MSGQ_LEN) / sizeof(atomic_t)];
+
+static K_THREAD_STACK_ARRAY_DEFINE(tstacks, 2 * NUM_THREADS, STACK_SIZE);
+static struct k_thread tdata[2 * NUM_THREADS];
+
+static uint64_t consumed_sum[NUM_THREADS];
+
+static void put_get_msgs(struct k_mpmcq *q)
+{
+	uint32_t data;
+
+	zassert_equal(k_mpmcq_num_used_get(q), 0);
+	zassert_equal(k_mpmcq_num_free_get(q), MSGQ_LEN);
+	zassert_equal(k_mpmcq_get(q, &data, K_NO_WAIT), -ENOMSG);
+
+	for (uint32_t i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_mpmcq_put(q, &i, K_NO_WAIT), 0);
+	}
+
+	zassert_equal(k_mpmcq_num_used_get(q), MSGQ_LEN);
+	zassert_equal(k_mpmcq_num_free_get(q), 0);
+	zassert_equal(k_mpmcq_put(q, &data, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_mpmcq_put(q, &data, K_MSEC(10)), -EAGAIN);
+
+	for (uint32_t i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_mpmcq_get(q, &data, K_NO_WAIT), 0);
+		zassert_equal(data, i, "messages should be FIFO");
+	}
+
+	zassert_equal(k_mpmcq_get(q, &data, K_MSEC(10)), -EAGAIN);
+}
+
+/**
+ * @brief Test lock-free message queue put and get
+ */
+ZTEST(mpmcq_api, test_mpmcq_put_get)
+{
+	put_get_msgs(&kmpmcq);
+
+	k_mpmcq_init(&mpmcq, mpmcq_buf, MSG_SIZE, MSGQ_LEN);
+	put_get_msgs(&mpmcq);
+}
+
+static void isr_put_get(const void *p)
+{
+	uint32_t data = 0xcafe;
+
+	zassert_equal(k_mpmcq_put((struct k_mpmcq *)p, &data, K_NO_WAIT), 0);
+	zassert_equal(k_mpmcq_get((struct k_mpmcq *)p, &data, K_NO_WAIT), 0);
+	zassert_equal(data, 0xcafe);
+	zassert_equal(k_mpmcq_put((struct k_mpmcq *)p, &data, K_NO_WAIT), 0);
+}
+
+/**
+ * @brief Test lock-free message queue put and get from an ISR
+ */
+ZTEST(mpmcq_api, test_mpmcq_isr)
+{
+	uint32_t data;
+
+	irq_offload(isr_put_get, &kmpmcq);
+
+	zassert_equal(k_mpmcq_get(&kmpmcq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, 0xcafe);
+}
+
+static void delayed_put(void *p1, void *p2, void *p3)
+{
+	uint32_t data = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	k_msleep(10);
+	zassert_equal(k_mpmcq_put(p1, &data, K_NO_WAIT), 0);
+}
+
+static void delayed_get(void *p1, void *p2, void *p3)
+{
+	uint32_t data;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_msleep(10);
+	zassert_equal(k_mpmcq_get(p1, &data, K_NO_WAIT), 0);
+}
+
+/**
+ * @brief Test threads waiting on an empty, then a full queue
+ */
+ZTEST(mpmcq_api, test_mpmcq_pend)
+{
+	uint32_t data;
+
+	k_thread_create(&tdata[0], tstacks[0], STACK_SIZE, delayed_put,
+			&kmpmcq, UINT_TO_POINTER(42), NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_mpmcq_get(&kmpmcq, &data, K_FOREVER), 0);
+	zassert_equal(data, 42);
+	k_thread_join(&tdata[0], K_FOREVER);
+
+	for (uint32_t i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_mpmcq_put(&kmpmcq, &i, K_NO_WAIT), 0);
+	}
+
+	k_thread_create(&tdata[0], tstacks[0], STACK_SIZE, delayed_get,
+			&kmpmcq, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	data = MSGQ_LEN;
+	zassert_equal(k_mpmcq_put(&kmpmcq, &data, K_FOREVER), 0);
+	k_thread_join(&tdata[0], K_FOREVER);
+
+	for (uint32_t i = 1; i <= MSGQ_LEN; i++) {
+		zassert_equal(k_mpmcq_get(&kmpmcq, &data, K_NO_WAIT), 0);
+		zassert_equal(data, i);
+	}
+}
+
+/**
+ * @brief Test polling a lock-free message queue
+ */
+ZTEST(mpmcq_api, test_mpmcq_poll)
+{
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_MPMCQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+		&kmpmcq);
+	uint32_t data;
+
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN);
+
+	k_thread_create(&tdata[0], tstacks[0], STACK_SIZE, delayed_put,
+			&kmpmcq, UINT_TO_POINTER(7), NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_poll(&event, 1, K_FOREVER), 0);
+	zassert_equal(event.state, K_POLL_STATE_MPMCQ_DATA_AVAILABLE);
+	zassert_equal(k_mpmcq_get(&kmpmcq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, 7);
+	k_thread_join(&tdata[0], K_FOREVER);
+
+	/* Data already there */
+	event.state = K_POLL_STATE_NOT_READY;
+	zassert_equal(k_mpmcq_put(&kmpmcq, &data, K_NO_WAIT), 0);
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), 0);
+	zassert_equal(event.state, K_POLL_STATE_MPMCQ_DATA_AVAILABLE);
+	zassert_equal(k_mpmcq_get(&kmpmcq, &data, K_NO_WAIT), 0);
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 1; i <= MSGS_PER_THREAD; i++) {
+		zassert_equal(k_mpmcq_put(p1, &i, K_FOREVER), 0);
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t id = POINTER_TO_UINT(p2);
+	uint32_t data;
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < MSGS_PER_THREAD; i++) {
+		zassert_equal(k_mpmcq_get(p1, &data, K_FOREVER), 0);
+		consumed_sum[id] += data;
+	}
+}
+
+/**
+ * @brief Test concurrent blocking producers and consumers
+ *
+ * The queue is much smaller than the number of messages in flight, so
+ * both sides keep pending and waking up each other.  Every message must
+ * be received exactly once.
+ */
+ZTEST(mpmcq_api, test_mpmcq_threads)
+{
+	uint64_t expected = (uint64_t)NUM_THREADS * MSGS_PER_THREAD *
+			    (MSGS_PER_THREAD + 1) / 2;
+	uint64_t sum = 0;
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&tdata[i], tstacks[i], STACK_SIZE, consumer,
+				&kmpmcq, UINT_TO_POINTER(i), NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+		k_thread_create(&tdata[NUM_THREADS + i], tstacks[NUM_THREADS + i],
+				STACK_SIZE, producer, &kmpmcq, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < 2 * NUM_THREADS; i++) {
+		k_thread_join(&tdata[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		sum += consumed_sum[i];
+	}
+
+	zassert_equal(sum, expected, "messages lost or duplicated");
+	zassert_equal(k_mpmcq_num_used_get(&kmpmcq), 0);
+}
+
+ZTEST_SUITE(mpmcq_api, NULL, NULL, NULL, NULL, NULL);
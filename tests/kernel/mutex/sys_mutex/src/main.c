@@ -329,6 +329,9 @@ void join_participant_threads(void)
 
 ZTEST_USER_OR_NOT(mutex_complex, test_mutex)
 {
+	/* Futex based mutexes do not implement priority inheritance */
+	Z_TEST_SKIP_IFDEF(CONFIG_SYS_MUTEX_FUTEX);
+
 	create_participant_threads();
 	start_participant_threads();
 	/*
@@ -437,6 +440,91 @@ ZTEST_USER_OR_NOT(mutex_complex, test_mutex)
 	TC_PRINT("Recursive locking tests successful\n");
 }
 
+#define CONTENDED_LOOPS 100
+
+static ZTEST_BMEM SYS_MUTEX_DEFINE(contended_mutex);
+static ZTEST_BMEM volatile uint32_t contended_count;
+static ZTEST_BMEM volatile bool contender_locked;
+K_THREAD_STACK_DEFINE(contender_stack_area, STACKSIZE);
+struct k_thread contender_thread_data;
+
+static void contended_loop(void)
+{
+	for (int i = 0; i < CONTENDED_LOOPS; i++) {
+		if (sys_mutex_lock(&contended_mutex, K_FOREVER) != 0) {
+			tc_rc = TC_FAIL;
+			return;
+		}
+
+		contended_count++;
+
+		/* Let the other thread find the mutex locked */
+		k_yield();
+
+		if (sys_mutex_unlock(&contended_mutex) != 0) {
+			tc_rc = TC_FAIL;
+			return;
+		}
+	}
+}
+
+static void contender(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Waits until the test thread unlocks the mutex */
+	if (sys_mutex_lock(&contended_mutex, K_FOREVER) != 0) {
+		tc_rc = TC_FAIL;
+		return;
+	}
+
+	contender_locked = true;
+
+	if (sys_mutex_unlock(&contended_mutex) != 0) {
+		tc_rc = TC_FAIL;
+		return;
+	}
+
+	contended_loop();
+}
+
+/**
+ * @brief Test a mutex locked and unlocked by two threads
+ *
+ * A thread waiting for the mutex is woken up when it is unlocked, and
+ * the two threads then keep on taking the mutex from each other.
+ */
+ZTEST_USER_OR_NOT(mutex_complex, test_mutex_contended)
+{
+	int rv;
+
+	rv = sys_mutex_lock(&contended_mutex, K_NO_WAIT);
+	zassert_equal(rv, 0, "Failed to lock the mutex");
+
+	k_thread_create(&contender_thread_data, contender_stack_area, STACKSIZE,
+			contender, NULL, NULL, NULL,
+			k_thread_priority_get(k_current_get()),
+			PARTICIPANT_THREAD_OPTIONS, K_NO_WAIT);
+
+	/* Give the contender a chance to wait on the mutex */
+	k_sleep(K_MSEC(10));
+	zassert_false(contender_locked, "Contender locked a locked mutex");
+
+	rv = sys_mutex_unlock(&contended_mutex);
+	zassert_equal(rv, 0, "Failed to unlock the mutex");
+
+	contended_loop();
+
+	k_thread_join(&contender_thread_data, K_FOREVER);
+
+	zassert_true(contender_locked, "Contender was not woken up");
+	zassert_equal(contended_count, 2 * CONTENDED_LOOPS,
+		      "Mutual exclusion broken, count %u", contended_count);
+	zassert_equal(tc_rc, TC_PASS);
+}
+
 /* We deliberately disable userspace, even on platforms that
  * support it, so that the alternate implementation of sys_mutex
  * (which is just a very thin wrapper to k_mutex) is exercised.
@@ -447,7 +535,7 @@ ZTEST(mutex_complex, test_supervisor_access)
 {
 	int rv;
 
-#ifdef CONFIG_USERSPACE
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FUTEX)
 	/* coverage for get_k_mutex checks */
 	rv = sys_mutex_lock((struct sys_mutex *)NULL, K_NO_WAIT);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
@@ -457,7 +545,7 @@ ZTEST(mutex_complex, test_supervisor_access)
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
 	rv = sys_mutex_unlock((struct sys_mutex *)k_current_get());
 	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
-#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_USERSPACE && !CONFIG_SYS_MUTEX_FUTEX */
 
 	rv = sys_mutex_unlock(&not_my_mutex);
 	zassert_true(rv == -EPERM, "unlocked a mutex that wasn't owner");
@@ -470,6 +558,9 @@ ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 #ifdef CONFIG_USERSPACE
 	int rv;
 
+	/* An uncontended futex based mutex is not validated by the kernel */
+	Z_TEST_SKIP_IFDEF(CONFIG_SYS_MUTEX_FUTEX);
+
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
 	rv = sys_mutex_unlock(&no_access_mutex);
@@ -496,7 +587,8 @@ static void *sys_mutex_tests_setup(void)
 				&thread_08_thread_data, &thread_08_stack_area,
 				&thread_09_thread_data, &thread_09_stack_area,
 				&thread_11_thread_data, &thread_11_stack_area,
-				&thread_12_thread_data, &thread_12_stack_area);
+				&thread_12_thread_data, &thread_12_stack_area,
+				&contender_thread_data, &contender_stack_area);
 #endif
 	rv = sys_mutex_lock(&not_my_mutex, K_NO_WAIT);
 	if (rv != 0) {
@@ -1216,6 +1216,107 @@ ZTEST(smp, test_smp_affinity)
 }
 #endif
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+#define STEAL_HI_PRIO K_PRIO_PREEMPT(2)
+#define STEAL_LO_PRIO K_PRIO_PREEMPT(5)
+
+static struct k_thread steal_threads[2];
+static K_THREAD_STACK_ARRAY_DEFINE(steal_stacks, 2, STACK_SIZE);
+static atomic_t steal_order;
+static atomic_t steal_busy_cpus;
+static volatile bool steal_release;
+static volatile int steal_busy_cpu;
+
+static void steal_busy(void *arg0, void *arg1, void *arg2)
+{
+	ARG_UNUSED(arg0);
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+
+	steal_busy_cpu = curr_cpu();
+	atomic_inc(&steal_busy_cpus);
+
+	while (!steal_release) {
+		k_busy_wait(DELAY_US);
+	}
+}
+
+static void steal_record(void *arg0, void *arg1, void *arg2)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+
+	volatile struct thread_info *info = arg0;
+
+	info->executed = atomic_inc(&steal_order);
+	info->cpu_id = curr_cpu();
+}
+
+/* Queue a thread on the ready queue of the given CPU: a thread made
+ * runnable is queued on the CPU it last ran on.
+ */
+static void steal_start(int i, int prio, int cpu)
+{
+	k_thread_create(&steal_threads[i], steal_stacks[i], STACK_SIZE,
+			steal_record, (void *)&tinfo[i], NULL, NULL,
+			prio, 0, K_FOREVER);
+	tinfo[i].executed = -1;
+	tinfo[i].cpu_id = -1;
+	steal_threads[i].base.cpu = cpu;
+	k_thread_start(&steal_threads[i]);
+}
+
+/**
+ * @brief Verify that per-CPU ready queues keep the priority order
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Keep every other CPU busy with a cooperative thread, then
+ * queue a low priority thread on this CPU's ready queue and a higher
+ * priority one on the queue of a busy CPU. Once this CPU gives up the
+ * processor, it must steal and run the higher priority thread first.
+ */
+ZTEST(smp, test_per_cpu_runq_steal)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int cpu = curr_cpu();
+
+	steal_release = false;
+	atomic_clear(&steal_busy_cpus);
+	atomic_clear(&steal_order);
+
+	/* The test thread is cooperative, it keeps this CPU meanwhile */
+	for (unsigned int i = 0; i < num_cpus - 1; i++) {
+		k_thread_create(&tthread[i], tstack[i], STACK_SIZE,
+				steal_busy, NULL, NULL, NULL,
+				K_PRIO_COOP(2), 0, K_NO_WAIT);
+	}
+
+	while (atomic_get(&steal_busy_cpus) < (num_cpus - 1)) {
+		k_busy_wait(DELAY_US);
+	}
+
+	steal_start(0, STEAL_LO_PRIO, cpu);
+	steal_start(1, STEAL_HI_PRIO, steal_busy_cpu);
+
+	k_msleep(TIMEOUT);
+	steal_release = true;
+
+	for (int i = 0; i < 2; i++) {
+		k_thread_join(&steal_threads[i], K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < num_cpus - 1; i++) {
+		k_thread_join(&tthread[i], K_FOREVER);
+	}
+
+	zassert_equal(tinfo[1].executed, 0, "higher priority thread not run first");
+	zassert_equal(tinfo[1].cpu_id, cpu, "higher priority thread not stolen");
+	zassert_equal(tinfo[0].executed, 1, "lower priority thread not run");
+	zassert_equal(tinfo[0].cpu_id, cpu, "lower priority thread moved");
+}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 static void *smp_tests_setup(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
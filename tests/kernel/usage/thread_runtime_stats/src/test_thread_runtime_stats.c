@@ -541,5 +541,78 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_THREAD_WAKEUP_LATENCY
+static K_SEM_DEFINE(wakeup_sem, 0, 1);
+
+/**
+ * @brief Helper thread to test_thread_wakeup_latency()
+ */
+void helper_wakeup(void *p1, void *p2, void *p3)
+{
+	while (1) {
+		k_sem_take(&wakeup_sem, K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test the wakeup latency fields of k_thread_runtime_stats_get()
+ *
+ * Wake a higher priority helper thread a few times, which should run
+ * right away.  Then wake a lower priority helper thread and keep it
+ * waiting for at least a tick, which should show up as its peak
+ * wakeup latency.
+ */
+ZTEST(usage_api, test_thread_wakeup_latency)
+{
+	k_thread_runtime_stats_t  stats1;
+	k_thread_runtime_stats_t  stats2;
+	uint32_t  sum;
+	int  priority;
+	k_tid_t  tid;
+
+	priority = k_thread_priority_get(_current);
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_wakeup, NULL, NULL, NULL,
+			      priority - 1, 0, K_NO_WAIT);
+
+	k_thread_runtime_stats_get(tid, &stats1);
+
+	for (int i = 0; i < 10; i++) {
+		k_sem_give(&wakeup_sem);
+		k_yield();
+	}
+
+	k_thread_runtime_stats_get(tid, &stats2);
+	zassert_true(stats2.wakeup_count >= stats1.wakeup_count + 10);
+
+	sum = 0;
+	for (int i = 0; i < CONFIG_SCHED_THREAD_WAKEUP_LATENCY_BUCKETS; i++) {
+		sum += stats2.wakeup_buckets[i];
+	}
+	zassert_equal(sum, stats2.wakeup_count);
+
+	k_thread_abort(tid);
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_wakeup, NULL, NULL, NULL,
+			      priority + 1, 0, K_NO_WAIT);
+
+	/* Let it pend on the semaphore */
+	k_sleep(K_TICKS(1));
+
+	k_sem_give(&wakeup_sem);
+	busy_loop(2);
+	k_sleep(K_TICKS(1));
+
+	k_thread_runtime_stats_get(tid, &stats1);
+	zassert_true(stats1.wakeup_peak_cycles >= k_ticks_to_cyc_floor32(1));
+
+	k_thread_abort(tid);
+}
+#endif /* CONFIG_SCHED_THREAD_WAKEUP_LATENCY */
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
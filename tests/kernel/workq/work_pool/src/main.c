@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_WORKERS 3
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_ITEMS 8
+
+K_WORK_POOL_DEFINE(test_pool, NUM_WORKERS, STACK_SIZE);
+
+static K_SEM_DEFINE(blocker_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, NUM_ITEMS);
+
+static atomic_t run_count;
+static atomic_t active;
+static atomic_t max_active;
+
+static void blocking_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_sem_take(&blocker_sem, K_FOREVER);
+	atomic_inc(&run_count);
+}
+
+static void counting_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	atomic_inc(&run_count);
+	k_sem_give(&done_sem);
+}
+
+static void sleeping_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_msleep(10);
+	atomic_inc(&run_count);
+}
+
+/* Resubmits itself while running, and records how many instances of
+ * the handler ever ran at the same time.
+ */
+static void reentry_handler(struct k_work *work)
+{
+	atomic_val_t now = atomic_inc(&active) + 1;
+	atomic_val_t max = atomic_get(&max_active);
+
+	while ((now > max) && !atomic_cas(&max_active, max, now)) {
+		max = atomic_get(&max_active);
+	}
+
+	if (atomic_inc(&run_count) < NUM_ITEMS - 1) {
+		zassert_equal(k_work_pool_submit(&test_pool, work), 2);
+	}
+
+	k_busy_wait(1000);
+	atomic_dec(&active);
+
+	if (atomic_get(&run_count) == NUM_ITEMS) {
+		k_sem_give(&done_sem);
+	}
+}
+
+static void *pool_setup(void)
+{
+	k_work_pool_start(&test_pool, K_PRIO_PREEMPT(2), NULL);
+
+	return NULL;
+}
+
+static void pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_clear(&run_count);
+	atomic_clear(&active);
+	atomic_clear(&max_active);
+	k_sem_reset(&blocker_sem);
+	k_sem_reset(&done_sem);
+}
+
+/**
+ * @brief Verify a blocked handler doesn't stall the rest of the pool
+ *
+ * @details Submit a handler that blocks, then several more items.  An
+ * idle worker must run them all while the first one is still blocked.
+ */
+ZTEST(work_pool, test_pool_no_stall)
+{
+	static struct k_work blocker;
+	static struct k_work items[NUM_ITEMS];
+	struct k_work_sync sync;
+
+	k_work_init(&blocker, blocking_handler);
+	zassert_equal(k_work_pool_submit(&test_pool, &blocker), 1);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], counting_handler);
+		zassert_equal(k_work_pool_submit(&test_pool, &items[i]), 1);
+	}
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_MSEC(1000)));
+	}
+
+	zassert_equal(atomic_get(&run_count), NUM_ITEMS);
+	zassert_equal(k_work_busy_get(&blocker), K_WORK_RUNNING);
+
+	k_sem_give(&blocker_sem);
+	zassert_true(k_work_flush(&blocker, &sync));
+	zassert_equal(atomic_get(&run_count), NUM_ITEMS + 1);
+}
+
+/**
+ * @brief Verify handlers of a pool are not re-entered
+ *
+ * @details A handler resubmitting itself while running is queued to
+ * the worker running it, and never stolen by another one.
+ */
+ZTEST(work_pool, test_pool_no_reentry)
+{
+	static struct k_work work;
+
+	k_work_init(&work, reentry_handler);
+	zassert_equal(k_work_pool_submit(&test_pool, &work), 1);
+
+	zassert_ok(k_sem_take(&done_sem, K_MSEC(1000)));
+	zassert_equal(atomic_get(&max_active), 1);
+}
+
+/**
+ * @brief Verify flushing and cancelling work submitted to a pool
+ */
+ZTEST(work_pool, test_pool_flush_cancel)
+{
+	static struct k_work items[NUM_ITEMS];
+	struct k_work_sync sync;
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], sleeping_handler);
+		zassert_equal(k_work_pool_submit(&test_pool, &items[i]), 1);
+	}
+
+	/* The workers can't have started the last one yet */
+	zassert_true(k_work_cancel_sync(&items[NUM_ITEMS - 1], &sync));
+	zassert_equal(k_work_busy_get(&items[NUM_ITEMS - 1]), 0);
+
+	for (int i = 0; i < NUM_ITEMS - 1; i++) {
+		(void)k_work_flush(&items[i], &sync);
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+
+	zassert_equal(atomic_get(&run_count), NUM_ITEMS - 1);
+}
+
+/**
+ * @brief Verify scheduling delayable work on a pool
+ */
+ZTEST(work_pool, test_pool_delayable)
+{
+	static struct k_work_delayable dwork;
+	struct k_work_sync sync;
+
+	k_work_init_delayable(&dwork, counting_handler);
+	zassert_equal(k_work_pool_schedule(&test_pool, &dwork, K_MSEC(10)), 1);
+	zassert_equal(k_work_pool_reschedule(&test_pool, &dwork, K_MSEC(20)), 1);
+
+	zassert_ok(k_sem_take(&done_sem, K_MSEC(1000)));
+	(void)k_work_flush_delayable(&dwork, &sync);
+	zassert_equal(k_work_delayable_busy_get(&dwork), 0);
+	zassert_equal(atomic_get(&run_count), 1);
+}
+
+/**
+ * @brief Verify draining and plugging a pool
+ */
+ZTEST(work_pool, test_pool_drain)
+{
+	static struct k_work items[NUM_ITEMS];
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], sleeping_handler);
+		zassert_equal(k_work_pool_submit(&test_pool, &items[i]), 1);
+	}
+
+	zassert_true(k_work_pool_drain(&test_pool, true) >= 0);
+	zassert_equal(atomic_get(&run_count), NUM_ITEMS);
+
+	zassert_equal(k_work_pool_submit(&test_pool, &items[0]), -EBUSY);
+	zassert_ok(k_work_pool_unplug(&test_pool));
+	zassert_equal(k_work_pool_unplug(&test_pool), -EALREADY);
+
+	zassert_equal(k_work_pool_submit(&test_pool, &items[0]), 1);
+	zassert_true(k_work_pool_drain(&test_pool, false) >= 0);
+	zassert_equal(atomic_get(&run_count), NUM_ITEMS + 1);
+}
+
+ZTEST_SUITE(work_pool, NULL, pool_setup, pool_before, NULL, NULL);
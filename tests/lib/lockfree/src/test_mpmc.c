@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mpmc_lockfree.h>
+
+#define MPMC_SZ 8
+
+MPMC_DEFINE(put_get_q, sizeof(uint32_t), MPMC_SZ);
+
+/*
+ * @brief Put and get elements, filling the queue and wrapping around
+ *
+ * @see mpmc_put(), mpmc_get()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpmc, test_put_get)
+{
+	uint32_t val;
+
+	zassert_true(mpmc_is_empty(&put_get_q), "Static queue should be empty");
+	zassert_false(mpmc_get(&put_get_q, &val), "Get on empty queue should fail");
+	zassert_equal(mpmc_capacity(&put_get_q), MPMC_SZ);
+
+	for (uint32_t lap = 0; lap < 3; lap++) {
+		for (uint32_t i = 0; i < MPMC_SZ; i++) {
+			val = lap * MPMC_SZ + i;
+			zassert_true(mpmc_put(&put_get_q, &val), "Put should succeed");
+		}
+
+		zassert_true(mpmc_is_full(&put_get_q), "Queue should be full");
+		zassert_false(mpmc_put(&put_get_q, &val), "Put on full queue should fail");
+		zassert_equal(mpmc_num_used(&put_get_q), MPMC_SZ);
+
+		for (uint32_t i = 0; i < MPMC_SZ; i++) {
+			zassert_true(mpmc_get(&put_get_q, &val), "Get should succeed");
+			zassert_equal(val, lap * MPMC_SZ + i, "Elements should be FIFO");
+		}
+
+		zassert_true(mpmc_is_empty(&put_get_q), "Queue should be empty");
+		zassert_equal(mpmc_num_used(&put_get_q), 0);
+	}
+
+	/* Half full queue crossing the end of the ring */
+	for (uint32_t i = 0; i < 3 * MPMC_SZ; i++) {
+		val = i;
+		zassert_true(mpmc_put(&put_get_q, &val), "Put should succeed");
+		if ((i % 2) != 0) {
+			zassert_true(mpmc_get(&put_get_q, &val), "Get should succeed");
+			zassert_equal(val, i / 2, "Elements should be FIFO");
+		}
+	}
+}
+
+#define MPMC_ITERATIONS 100000
+#define MPMC_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MPMC_PRODUCERS 2
+#define MPMC_CONSUMERS 2
+
+MPMC_DEFINE(mpmc_q, sizeof(uint32_t), MPMC_SZ);
+
+static struct k_thread mpmc_thread[MPMC_PRODUCERS + MPMC_CONSUMERS];
+static K_THREAD_STACK_ARRAY_DEFINE(mpmc_stack, MPMC_PRODUCERS + MPMC_CONSUMERS,
+				   MPMC_STACK_SIZE);
+
+static uint64_t consumed_sum[MPMC_CONSUMERS];
+
+static void mpmc_producer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 1; i <= MPMC_ITERATIONS; i++) {
+		while (!mpmc_put(&mpmc_q, &i)) {
+			k_yield();
+		}
+	}
+}
+
+static void mpmc_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t id = (uint32_t)(uintptr_t)p1;
+	uint32_t val;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < MPMC_ITERATIONS * MPMC_PRODUCERS / MPMC_CONSUMERS; i++) {
+		while (!mpmc_get(&mpmc_q, &val)) {
+			k_yield();
+		}
+
+		zassert_true((val > 0) && (val <= MPMC_ITERATIONS),
+			     "Corrupted element %u", val);
+		consumed_sum[id] += val;
+	}
+}
+
+/**
+ * @brief Test that producers and consumers are indeed thread safe
+ *
+ * Every element is consumed exactly once, which this can and should
+ * validate on SMP machines where incoherent memory could cause issues.
+ */
+ZTEST(mpmc, test_mpmc_threaded)
+{
+	uint64_t expected = (uint64_t)MPMC_PRODUCERS * MPMC_ITERATIONS *
+			    (MPMC_ITERATIONS + 1) / 2;
+	uint64_t sum = 0;
+
+	for (int i = 0; i < MPMC_CONSUMERS; i++) {
+		k_thread_create(&mpmc_thread[i], mpmc_stack[i], MPMC_STACK_SIZE,
+				mpmc_consumer, (void *)(uintptr_t)i, NULL, NULL,
+				K_PRIO_PREEMPT(5), K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = MPMC_CONSUMERS; i < MPMC_CONSUMERS + MPMC_PRODUCERS; i++) {
+		k_thread_create(&mpmc_thread[i], mpmc_stack[i], MPMC_STACK_SIZE,
+				mpmc_producer, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(5), K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < MPMC_CONSUMERS + MPMC_PRODUCERS; i++) {
+		k_thread_join(&mpmc_thread[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < MPMC_CONSUMERS; i++) {
+		sum += consumed_sum[i];
+	}
+
+	zassert_equal(sum, expected, "Elements lost or duplicated");
+	zassert_true(mpmc_is_empty(&mpmc_q), "Queue should be drained");
+}
+
+ZTEST_SUITE(mpmc, NULL, NULL, NULL, NULL, NULL);
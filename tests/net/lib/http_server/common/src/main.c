@@ -72,6 +72,8 @@ HTTP_RESOURCE_DEFINE(resource_5, service_D, "/fo*", RES(1));
 HTTP_RESOURCE_DEFINE(resource_6, service_D, "/f[ob]o3.html", RES(1));
 HTTP_RESOURCE_DEFINE(resource_7, service_D, "/fb?3.htm", RES(0));
 HTTP_RESOURCE_DEFINE(resource_8, service_D, "/f*4.html", RES(3));
+HTTP_RESOURCE_DEFINE(resource_9, service_D, "/fooexact", RES(3));
+HTTP_RESOURCE_DEFINE(resource_10, service_D, "/foo/*", RES(0));
 
 
 ZTEST(http_service, test_HTTP_SERVICE_DEFINE)
@@ -329,4 +331,45 @@ ZTEST(http_service, test_HTTP_RESOURCE_WILDCARD)
 	zassert_equal(res, RES(3), "Resource mismatch");
 }
 
+ZTEST(http_service, test_HTTP_RESOURCE_PRECEDENCE)
+{
+	struct http_resource_detail *res;
+	int len;
+
+	/* Exact match wins over the "/fo*" wildcard defined before */
+	res = CHECK_PATH("/fooexact", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/fooexact"), "Wrong length");
+	zassert_equal(res, RES(3), "Resource mismatch");
+
+	res = CHECK_PATH("/fooexact?id=1", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/fooexact"), "Wrong length");
+	zassert_equal(res, RES(3), "Resource mismatch");
+
+	res = CHECK_PATH("/index.html?id=1", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(res, RES(1), "Resource mismatch");
+
+	/* Longest fixed part wins, "/foo1.htm*" over "/fo*" */
+	res = CHECK_PATH("/foo1.htmx", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/foo1.htm*"), "Wrong length");
+	zassert_equal(res, RES(0), "Resource mismatch");
+
+	/* A trailing '*' does not match a '/' */
+	res = CHECK_PATH("/foo/bar", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(res, RES(0), "Resource mismatch");
+
+	res = CHECK_PATH("/foo/bar/baz", &len);
+	zassert_is_null(res, "Resource found");
+	zassert_equal(len, 0, "Length set");
+
+	res = CHECK_PATH("/fooexac", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/fo*"), "Wrong length");
+	zassert_equal(res, RES(1), "Resource mismatch");
+}
+
 ZTEST_SUITE(http_service, NULL, NULL, NULL, NULL, NULL);
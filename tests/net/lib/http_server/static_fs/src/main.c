@@ -0,0 +1,666 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ff.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/net/http/frame.h>
+#include <zephyr/net/http/hpack.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#define MY_IPV4_ADDR "127.0.0.1"
+#define SERVER_PORT  8080
+#define MNT_POINT    "/RAM:"
+#define BIG_FILE_LEN 2000
+#define H2_TIMEOUT   200
+
+static uint16_t test_http_service_port = SERVER_PORT;
+HTTP_SERVICE_DEFINE(test_http_service, MY_IPV4_ADDR,
+		    &test_http_service_port, 1, 10, NULL);
+
+static struct http_resource_detail_static_fs static_fs_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_STATIC_FS,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET) | BIT(HTTP_HEAD),
+	},
+	.fs_path = MNT_POINT "/www",
+};
+
+HTTP_RESOURCE_DEFINE(static_fs_resource, test_http_service, "/*", &static_fs_detail);
+HTTP_RESOURCE_DEFINE(static_fs_subdir_resource, test_http_service, "/*/*", &static_fs_detail);
+/* Lets paths going up twice from a subdirectory reach the file system resource */
+HTTP_RESOURCE_DEFINE(static_fs_deep_resource, test_http_service, "/sub/*/*/*", &static_fs_detail);
+
+static FATFS fat_fs;
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = MNT_POINT,
+	.fs_data = &fat_fs,
+};
+
+static const char index_html[] = "<html>Hello</html>";
+static const char app_js[] = "console.log(1);";
+/* Not actually compressed, only the file selection is checked */
+static const char app_js_gz[] = "gzipped";
+static const char etag_txt[] = "first";
+static const char etag_txt_modified[] = "other";
+
+static char response[BIG_FILE_LEN + 512];
+static size_t response_len;
+
+static void write_file(const char *path, const void *data, size_t len)
+{
+	struct fs_file_t file;
+
+	fs_file_t_init(&file);
+
+	zassert_ok(fs_open(&file, path, FS_O_CREATE | FS_O_WRITE), "Cannot create %s", path);
+	zassert_equal(fs_write(&file, data, len), len, "Cannot write %s", path);
+	zassert_ok(fs_close(&file));
+}
+
+static int connect_to_server(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int fd, ret;
+
+	zassert_equal(zsock_inet_pton(AF_INET, MY_IPV4_ADDR, &sa.sin_addr), 1);
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(fd >= 0, "failed to create client socket (%d)", errno);
+
+	ret = zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa));
+	zassert_ok(ret, "failed to connect (%d)", errno);
+
+	return fd;
+}
+
+static void request(const char *method, const char *path, const char *headers)
+{
+	char req[256];
+	int fd, ret, len;
+
+	len = snprintf(req, sizeof(req), "%s %s HTTP/1.1\r\nHost: " MY_IPV4_ADDR "\r\n%s\r\n",
+		       method, path, headers);
+
+	fd = connect_to_server();
+
+	ret = zsock_send(fd, req, len, 0);
+	zassert_equal(ret, len, "send() failed (%d)", errno);
+
+	/* The server closes the connection after the response */
+	response_len = 0;
+	do {
+		ret = zsock_recv(fd, &response[response_len],
+				 sizeof(response) - 1 - response_len, 0);
+		zassert_true(ret >= 0, "recv() failed (%d)", errno);
+		response_len += ret;
+	} while (ret > 0 && response_len < sizeof(response) - 1);
+
+	response[response_len] = '\0';
+
+	(void)zsock_close(fd);
+}
+
+static const char *response_body(void)
+{
+	char *body = strstr(response, "\r\n\r\n");
+
+	zassert_not_null(body, "No end of headers");
+
+	return body + 4;
+}
+
+static void assert_status(const char *status)
+{
+	zassert_equal(strncmp(response, status, strlen(status)), 0,
+		      "Unexpected response %s", response);
+}
+
+static void assert_header(const char *header)
+{
+	zassert_not_null(strstr(response, header), "No %s in %s", header, response);
+}
+
+ZTEST(server_static_fs, test_get)
+{
+	request("GET", "/app.js", "");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	assert_header("Content-Type: text/javascript\r\n");
+	assert_header("Content-Length: 15\r\n");
+	assert_header("Accept-Ranges: bytes\r\n");
+	zassert_is_null(strstr(response, "Content-Encoding"));
+	zassert_str_equal(response_body(), app_js);
+}
+
+ZTEST(server_static_fs, test_get_index)
+{
+	request("GET", "/?lang=en", "");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	assert_header("Content-Type: text/html\r\n");
+	zassert_str_equal(response_body(), index_html);
+}
+
+ZTEST(server_static_fs, test_get_big_file)
+{
+	const char *body;
+
+	request("GET", "/big.bin", "");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	assert_header("Content-Length: 2000\r\n");
+
+	body = response_body();
+	zassert_equal(response_len - (body - response), BIG_FILE_LEN);
+
+	for (int i = 0; i < BIG_FILE_LEN; i++) {
+		zassert_equal((uint8_t)body[i], (uint8_t)i, "Wrong byte at %d", i);
+	}
+}
+
+ZTEST(server_static_fs, test_head)
+{
+	request("HEAD", "/app.js", "");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	assert_header("Content-Length: 15\r\n");
+	zassert_str_equal(response_body(), "");
+}
+
+ZTEST(server_static_fs, test_precompressed)
+{
+	request("GET", "/app.js", "Accept-Encoding: deflate, gzip\r\n");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	assert_header("Content-Type: text/javascript\r\n");
+	assert_header("Content-Encoding: gzip\r\n");
+	assert_header("Vary: Accept-Encoding\r\n");
+	zassert_str_equal(response_body(), app_js_gz);
+
+	/* There is no brotli variant, and gzip is refused */
+	request("GET", "/app.js", "Accept-Encoding: br, gzip;q=0\r\n");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	zassert_is_null(strstr(response, "Content-Encoding"));
+	zassert_str_equal(response_body(), app_js);
+}
+
+ZTEST(server_static_fs, test_range)
+{
+	request("GET", "/app.js", "Range: bytes=8-\r\n");
+
+	assert_status("HTTP/1.1 206 Partial Content\r\n");
+	assert_header("Content-Range: bytes 8-14/15\r\n");
+	assert_header("Content-Length: 7\r\n");
+	zassert_str_equal(response_body(), "log(1);");
+
+	request("GET", "/app.js", "Range: bytes=-3\r\n");
+
+	assert_status("HTTP/1.1 206 Partial Content\r\n");
+	assert_header("Content-Range: bytes 12-14/15\r\n");
+	zassert_str_equal(response_body(), "1);");
+
+	request("GET", "/app.js", "Range: bytes=15-\r\n");
+
+	assert_status("HTTP/1.1 416 Range Not Satisfiable\r\n");
+	assert_header("Content-Range: bytes */15\r\n");
+	zassert_str_equal(response_body(), "");
+
+	/* Several ranges are not supported, the whole file is sent */
+	request("GET", "/app.js", "Range: bytes=0-1,4-5\r\n");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	zassert_str_equal(response_body(), app_js);
+}
+
+static void get_etag(char *etag, size_t size)
+{
+	const char *start;
+	size_t len;
+
+	start = strstr(response, "ETag: ");
+	zassert_not_null(start, "No ETag in %s", response);
+	start += sizeof("ETag: ") - 1;
+	len = strcspn(start, "\r");
+	zassert_true(len > 2 && len < size);
+
+	memcpy(etag, start, len);
+	etag[len] = '\0';
+}
+
+ZTEST(server_static_fs, test_etag)
+{
+	char etag[32];
+	char new_etag[32];
+	char headers[64];
+
+	if (CONFIG_HTTP_SERVER_STATIC_FS_ETAG_CACHE_SIZE == 0) {
+		request("GET", "/etag.txt", "");
+		request("GET", "/etag.txt", "");
+
+		assert_status("HTTP/1.1 200 OK\r\n");
+		zassert_is_null(strstr(response, "ETag"));
+		return;
+	}
+
+	/* The entity tag is computed when the file is first sent entirely */
+	request("GET", "/etag.txt", "Range: bytes=0-1\r\n");
+
+	assert_status("HTTP/1.1 206 Partial Content\r\n");
+	zassert_is_null(strstr(response, "ETag"));
+
+	request("GET", "/etag.txt", "");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	zassert_is_null(strstr(response, "ETag"));
+
+	request("GET", "/etag.txt", "");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	get_etag(etag, sizeof(etag));
+
+	snprintf(headers, sizeof(headers), "If-None-Match: %s\r\n", etag);
+	request("GET", "/etag.txt", headers);
+
+	assert_status("HTTP/1.1 304 Not Modified\r\n");
+	assert_header(etag);
+	zassert_is_null(strstr(response, "Content-Length"));
+	zassert_str_equal(response_body(), "");
+
+	/* The other files have another entity tag */
+	request("GET", "/app.js", headers);
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	zassert_str_equal(response_body(), app_js);
+
+	/* A file modified without changing its size gets a new tag once the
+	 * application has invalidated the old one.
+	 */
+	write_file(MNT_POINT "/www/etag.txt", etag_txt_modified, sizeof(etag_txt_modified) - 1);
+	http_server_static_fs_cache_invalidate(MNT_POINT "/www/etag.txt");
+
+	request("GET", "/etag.txt", headers);
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	zassert_is_null(strstr(response, "ETag"));
+	zassert_str_equal(response_body(), etag_txt_modified);
+
+	request("GET", "/etag.txt", "");
+
+	get_etag(new_etag, sizeof(new_etag));
+	zassert_true(strcmp(etag, new_etag) != 0, "Same entity tag %s", etag);
+}
+
+ZTEST(server_static_fs, test_long_headers)
+{
+	/* Longer than the 32 bytes used by the other request headers */
+	request("GET", "/app.js",
+		"Accept-Encoding: identity;q=0.5, deflate;q=0.2, compress, gzip;q=0.9\r\n");
+
+	assert_status("HTTP/1.1 200 OK\r\n");
+	assert_header("Content-Encoding: gzip\r\n");
+	zassert_str_equal(response_body(), app_js_gz);
+
+	request("GET", "/big.bin", "Range: bytes=0000000000000000000000000001990-\r\n");
+
+	assert_status("HTTP/1.1 206 Partial Content\r\n");
+	assert_header("Content-Range: bytes 1990-1999/2000\r\n");
+}
+
+ZTEST(server_static_fs, test_not_found)
+{
+	request("GET", "/missing.html", "");
+	assert_status("HTTP/1.1 404 Not Found\r\n");
+
+	/* A directory is not a file */
+	request("GET", "/sub", "");
+	assert_status("HTTP/1.1 404 Not Found\r\n");
+
+	/* The files outside of the resource directory are not reachable */
+	request("GET", "/../secret.txt", "");
+	assert_status("HTTP/1.1 404 Not Found\r\n");
+
+	request("GET", "/sub/../../secret.txt", "");
+	assert_status("HTTP/1.1 404 Not Found\r\n");
+
+	request("GET", "/sub/..", "");
+	assert_status("HTTP/1.1 404 Not Found\r\n");
+}
+
+/* HTTP/2 with prior knowledge */
+
+struct h2_frame {
+	uint8_t type;
+	uint8_t flags;
+	uint32_t stream_id;
+	size_t len;
+	uint8_t payload[1024];
+};
+
+static struct h2_frame h2_frame;
+static struct http_hpack_header_buf h2_header;
+static char h2_headers[256];
+static int h2_status;
+static bool h2_ended;
+
+static void h2_send_frame(int fd, uint8_t type, uint8_t flags, uint32_t stream_id,
+			  const void *payload, size_t len)
+{
+	uint8_t header[HTTP_SERVER_FRAME_HEADER_SIZE];
+
+	sys_put_be24(len, &header[0]);
+	header[3] = type;
+	header[4] = flags;
+	sys_put_be32(stream_id, &header[5]);
+
+	zassert_equal(zsock_send(fd, header, sizeof(header), 0), sizeof(header),
+		      "send() failed (%d)", errno);
+
+	if (len > 0) {
+		zassert_equal(zsock_send(fd, payload, len, 0), len, "send() failed (%d)", errno);
+	}
+}
+
+static void h2_send_setting(int fd, uint16_t id, uint32_t value)
+{
+	uint8_t setting[6];
+
+	sys_put_be16(id, &setting[0]);
+	sys_put_be32(value, &setting[2]);
+
+	h2_send_frame(fd, HTTP_SERVER_SETTINGS_FRAME, 0, 0, setting, sizeof(setting));
+}
+
+static void h2_send_u32(int fd, uint8_t type, uint32_t stream_id, uint32_t value)
+{
+	uint8_t payload[4];
+
+	sys_put_be32(value, payload);
+
+	h2_send_frame(fd, type, 0, stream_id, payload, sizeof(payload));
+}
+
+static int h2_connect(void)
+{
+	struct timeval optval = {
+		.tv_usec = H2_TIMEOUT * USEC_PER_MSEC,
+	};
+	int fd = connect_to_server();
+
+	zassert_ok(zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &optval, sizeof(optval)),
+		   "setsockopt failed (%d)", errno);
+
+	zassert_equal(zsock_send(fd, HTTP2_PREFACE, sizeof(HTTP2_PREFACE) - 1, 0),
+		      sizeof(HTTP2_PREFACE) - 1, "send() failed (%d)", errno);
+
+	h2_send_frame(fd, HTTP_SERVER_SETTINGS_FRAME, 0, 0, NULL, 0);
+
+	return fd;
+}
+
+static void h2_request(int fd, uint32_t stream_id, const char *path)
+{
+	const char *fields[][2] = {
+		{ ":method", "GET" },
+		{ ":scheme", "http" },
+		{ ":path", path },
+		{ ":authority", MY_IPV4_ADDR },
+	};
+	uint8_t block[128];
+	size_t len = 0;
+	int ret;
+
+	ARRAY_FOR_EACH(fields, i) {
+		h2_header.name = fields[i][0];
+		h2_header.name_len = strlen(fields[i][0]);
+		h2_header.value = fields[i][1];
+		h2_header.value_len = strlen(fields[i][1]);
+
+		ret = http_hpack_encode_header(&block[len], sizeof(block) - len, &h2_header);
+		zassert_true(ret > 0, "Cannot encode %s (%d)", fields[i][0], ret);
+		len += ret;
+	}
+
+	h2_send_frame(fd, HTTP_SERVER_HEADERS_FRAME,
+		      HTTP_SERVER_FLAG_END_HEADERS | HTTP_SERVER_FLAG_END_STREAM,
+		      stream_id, block, len);
+}
+
+/* Receive len bytes, return false if nothing comes in time */
+static bool h2_recv(int fd, uint8_t *buf, size_t len)
+{
+	size_t received = 0;
+	int ret;
+
+	while (received < len) {
+		ret = zsock_recv(fd, &buf[received], len - received, 0);
+		if (ret < 0 && errno == EAGAIN && received == 0) {
+			return false;
+		}
+
+		zassert_true(ret > 0, "recv() failed (%d)", errno);
+		received += ret;
+	}
+
+	return true;
+}
+
+static bool h2_recv_frame(int fd)
+{
+	uint8_t header[HTTP_SERVER_FRAME_HEADER_SIZE];
+
+	if (!h2_recv(fd, header, sizeof(header))) {
+		return false;
+	}
+
+	h2_frame.len = sys_get_be24(&header[0]);
+	h2_frame.type = header[3];
+	h2_frame.flags = header[4];
+	h2_frame.stream_id = sys_get_be32(&header[5]) & 0x7fffffff;
+
+	zassert_true(h2_frame.len <= sizeof(h2_frame.payload), "Frame too long");
+	zassert_true(h2_frame.len == 0 || h2_recv(fd, h2_frame.payload, h2_frame.len),
+		     "Incomplete frame");
+
+	return true;
+}
+
+static void h2_decode_headers(void)
+{
+	size_t offset = 0;
+	size_t len = 0;
+	int ret;
+
+	while (offset < h2_frame.len) {
+		ret = http_hpack_decode_header(&h2_frame.payload[offset], h2_frame.len - offset,
+					       &h2_header);
+		zassert_true(ret > 0, "Cannot decode headers (%d)", ret);
+		offset += ret;
+
+		if (h2_header.name_len == sizeof(":status") - 1 &&
+		    strncmp(h2_header.name, ":status", h2_header.name_len) == 0) {
+			h2_status = atoi(h2_header.value);
+		}
+
+		len += snprintf(&h2_headers[len], sizeof(h2_headers) - len, "%.*s: %.*s\r\n",
+				(int)h2_header.name_len, h2_header.name,
+				(int)h2_header.value_len, h2_header.value);
+		zassert_true(len < sizeof(h2_headers), "Headers too long");
+	}
+}
+
+/* Receive the frames of a stream, appending its data to the response, until
+ * the end of the stream or until no frame comes in time.
+ */
+static void h2_recv_stream(int fd, uint32_t stream_id)
+{
+	h2_ended = false;
+
+	while (!h2_ended && h2_recv_frame(fd)) {
+		/* SETTINGS acknowledgments and the other streams */
+		if (h2_frame.stream_id != stream_id) {
+			continue;
+		}
+
+		if (h2_frame.type == HTTP_SERVER_HEADERS_FRAME) {
+			h2_decode_headers();
+		} else if (h2_frame.type == HTTP_SERVER_DATA_FRAME) {
+			zassert_true(response_len + h2_frame.len < sizeof(response));
+			memcpy(&response[response_len], h2_frame.payload, h2_frame.len);
+			response_len += h2_frame.len;
+		}
+
+		h2_ended = (h2_frame.flags & HTTP_SERVER_FLAG_END_STREAM) != 0;
+	}
+
+	response[response_len] = '\0';
+}
+
+static void h2_get(int fd, uint32_t stream_id, const char *path)
+{
+	h2_status = 0;
+	h2_headers[0] = '\0';
+	response_len = 0;
+
+	h2_request(fd, stream_id, path);
+	h2_recv_stream(fd, stream_id);
+}
+
+ZTEST(server_static_fs, test_http2)
+{
+	int fd = h2_connect();
+
+	h2_get(fd, 1, "/app.js");
+
+	zassert_true(h2_ended, "Stream not ended");
+	zassert_equal(h2_status, 200, "Unexpected status %d", h2_status);
+	zassert_not_null(strstr(h2_headers, "content-type: text/javascript\r\n"), "%s",
+			 h2_headers);
+	zassert_not_null(strstr(h2_headers, "content-length: 15\r\n"), "%s", h2_headers);
+	zassert_str_equal(response, app_js);
+
+	h2_get(fd, 3, "/missing.html");
+
+	zassert_true(h2_ended, "Stream not ended");
+	zassert_equal(h2_status, 404, "Unexpected status %d", h2_status);
+
+	/* The files outside of the resource directory are not reachable */
+	h2_get(fd, 5, "/../secret.txt");
+
+	zassert_true(h2_ended, "Stream not ended");
+	zassert_equal(h2_status, 404, "Unexpected status %d", h2_status);
+
+	h2_get(fd, 7, "/sub/../../secret.txt");
+
+	zassert_true(h2_ended, "Stream not ended");
+	zassert_equal(h2_status, 404, "Unexpected status %d", h2_status);
+
+	(void)zsock_close(fd);
+}
+
+ZTEST(server_static_fs, test_http2_flow_control)
+{
+	int fd = h2_connect();
+
+	/* The server sends no more than the window of the stream */
+	h2_send_setting(fd, HTTP_SETTINGS_INITIAL_WINDOW_SIZE, 100);
+	h2_get(fd, 1, "/big.bin");
+
+	zassert_false(h2_ended, "Stream ended");
+	zassert_equal(h2_status, 200, "Unexpected status %d", h2_status);
+	zassert_equal(response_len, 100, "Sent %zu bytes", response_len);
+
+	/* The other streams are served meanwhile */
+	h2_get(fd, 3, "/app.js");
+
+	zassert_true(h2_ended, "Stream not ended");
+	zassert_str_equal(response, app_js);
+
+	response_len = 100;
+
+	h2_send_u32(fd, HTTP_SERVER_WINDOW_UPDATE_FRAME, 1, 1000);
+	h2_recv_stream(fd, 1);
+
+	zassert_false(h2_ended, "Stream ended");
+	zassert_equal(response_len, 1100, "Sent %zu bytes", response_len);
+
+	/* A larger initial window applies to the open streams */
+	h2_send_setting(fd, HTTP_SETTINGS_INITIAL_WINDOW_SIZE, 65535);
+	h2_recv_stream(fd, 1);
+
+	zassert_true(h2_ended, "Stream not ended");
+	zassert_equal(response_len, BIG_FILE_LEN, "Sent %zu bytes", response_len);
+
+	for (int i = 100; i < BIG_FILE_LEN; i++) {
+		zassert_equal((uint8_t)response[i], (uint8_t)i, "Wrong byte at %d", i);
+	}
+
+	/* A reset stream is not sent further */
+	h2_send_setting(fd, HTTP_SETTINGS_INITIAL_WINDOW_SIZE, 100);
+	h2_get(fd, 5, "/big.bin");
+
+	zassert_false(h2_ended, "Stream ended");
+	zassert_equal(response_len, 100, "Sent %zu bytes", response_len);
+
+	h2_send_u32(fd, HTTP_SERVER_RST_STREAM_FRAME, 5, 0x8 /* CANCEL */);
+	h2_send_u32(fd, HTTP_SERVER_WINDOW_UPDATE_FRAME, 5, 1000);
+	h2_recv_stream(fd, 5);
+
+	zassert_equal(response_len, 100, "Sent %zu bytes", response_len);
+
+	(void)zsock_close(fd);
+}
+
+static void *setup(void)
+{
+	static uint8_t big_file[BIG_FILE_LEN];
+
+	zassert_ok(fs_mount(&fatfs_mnt), "Cannot mount the file system");
+
+	zassert_ok(fs_mkdir(MNT_POINT "/www"));
+	zassert_ok(fs_mkdir(MNT_POINT "/www/sub"));
+
+	write_file(MNT_POINT "/www/index.html", index_html, sizeof(index_html) - 1);
+	write_file(MNT_POINT "/www/app.js", app_js, sizeof(app_js) - 1);
+	write_file(MNT_POINT "/www/app.js.gz", app_js_gz, sizeof(app_js_gz) - 1);
+	write_file(MNT_POINT "/www/etag.txt", etag_txt, sizeof(etag_txt) - 1);
+	write_file(MNT_POINT "/secret.txt", "secret", sizeof("secret") - 1);
+
+	for (int i = 0; i < BIG_FILE_LEN; i++) {
+		big_file[i] = i;
+	}
+
+	write_file(MNT_POINT "/www/big.bin", big_file, sizeof(big_file));
+
+	zassert_ok(http_server_start(), "Failed to start the server");
+
+	/* Let the server open its listening socket */
+	k_sleep(K_MSEC(100));
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)http_server_stop();
+	(void)fs_unmount(&fatfs_mnt);
+}
+
+ZTEST_SUITE(server_static_fs, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/net/mqtt.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/posix/fcntl.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <mqtt_internal.h>
+
+/* The client is marked as connected without any CONNECT exchange, and
+ * writes its packets to one end of a socket pair. The test reads them
+ * from the other end and acknowledges the messages by calling
+ * mqtt_publish_queue_ack() as the RX path does.
+ */
+
+#define TOPIC		"sensors"
+#define PAYLOAD		"data"
+#define BUFFER_SIZE	256
+
+#define MQTT_PKT_TYPE_PUBLISH 0x30
+
+static uint8_t rx_buffer[BUFFER_SIZE];
+static uint8_t tx_buffer[BUFFER_SIZE];
+static struct mqtt_client client;
+static int peer_sock = -1;
+
+static struct mqtt_evt disconnect_evt;
+static int disconnect_count;
+
+static void evt_handler(struct mqtt_client *const c, const struct mqtt_evt *evt)
+{
+	ARG_UNUSED(c);
+
+	if (evt->type == MQTT_EVT_DISCONNECT) {
+		disconnect_evt = *evt;
+		disconnect_count++;
+	}
+}
+
+static int queue_msg(uint8_t qos, uint16_t message_id)
+{
+	struct mqtt_publish_param param = {
+		.message.topic.qos = qos,
+		.message.topic.topic.utf8 = (uint8_t *)TOPIC,
+		.message.topic.topic.size = sizeof(TOPIC) - 1,
+		.message.payload.data = (uint8_t *)PAYLOAD,
+		.message.payload.len = sizeof(PAYLOAD) - 1,
+		.message_id = message_id,
+	};
+
+	return mqtt_publish_queue(&client, &param);
+}
+
+/* Number of PUBLISH packets written since the last call */
+static int written_count(void)
+{
+	static uint8_t buf[CONFIG_NET_SOCKETPAIR_BUFFER_SIZE];
+	size_t pos = 0;
+	uint32_t remaining;
+	uint8_t shift;
+	int count = 0;
+	ssize_t len;
+
+	len = zsock_recv(peer_sock, buf, sizeof(buf), 0);
+	if (len < 0) {
+		zassert_equal(errno, EAGAIN, "recv failed (%d)", errno);
+		return 0;
+	}
+
+	while (pos < len) {
+		zassert_equal(buf[pos] & 0xf0, MQTT_PKT_TYPE_PUBLISH, "not a PUBLISH packet");
+		pos++;
+
+		remaining = 0U;
+		shift = 0U;
+		do {
+			zassert_true(pos < len, "truncated packet");
+			remaining |= (buf[pos] & 0x7f) << shift;
+			shift += 7U;
+		} while (buf[pos++] & 0x80);
+
+		pos += remaining;
+		count++;
+	}
+
+	zassert_equal(pos, len, "truncated packet");
+
+	return count;
+}
+
+static void before(void *arg)
+{
+	int sv[2];
+	int ret;
+
+	ARG_UNUSED(arg);
+
+	mqtt_client_init(&client);
+
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+	client.evt_cb = evt_handler;
+
+	ret = zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(ret, 0, "socketpair failed (%d)", errno);
+
+	ret = zsock_fcntl(sv[1], F_SETFL, O_NONBLOCK);
+	zassert_equal(ret, 0, "fcntl failed (%d)", errno);
+
+	client.transport.type = MQTT_TRANSPORT_NON_SECURE;
+	client.transport.tcp.sock = sv[0];
+	peer_sock = sv[1];
+
+	MQTT_SET_STATE(&client, MQTT_STATE_TCP_CONNECTED | MQTT_STATE_CONNECTED);
+
+	disconnect_count = 0;
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	/* Closes the client end of the socket pair */
+	(void)mqtt_abort(&client);
+
+	(void)zsock_close(peer_sock);
+	peer_sock = -1;
+}
+
+ZTEST(mqtt_publish_queue, test_qos0_retired_once_written)
+{
+	for (int i = 0; i < 3; i++) {
+		zassert_ok(queue_msg(MQTT_QOS_0_AT_MOST_ONCE, 0U), "queueing failed");
+	}
+
+	zassert_equal(mqtt_publish_queue_count(&client), 3, "wrong count");
+	zassert_equal(written_count(), 0, "written before the flush");
+
+	zassert_ok(mqtt_publish_queue_flush(&client), "flush failed");
+
+	zassert_equal(written_count(), 3, "wrong number of messages written");
+	zassert_equal(mqtt_publish_queue_count(&client), 0, "messages not retired");
+	zassert_equal(client.internal.pub_retired, 0U, "retired bits left");
+}
+
+ZTEST(mqtt_publish_queue, test_mixed_qos_retire)
+{
+	/* QoS 0 messages written after a QoS 1 or 2 one are retired, but
+	 * their slots are only released with the slot of the older message.
+	 */
+	zassert_ok(queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, 1U), "queueing failed");
+	zassert_ok(queue_msg(MQTT_QOS_0_AT_MOST_ONCE, 0U), "queueing failed");
+	zassert_ok(queue_msg(MQTT_QOS_2_EXACTLY_ONCE, 2U), "queueing failed");
+	zassert_ok(queue_msg(MQTT_QOS_0_AT_MOST_ONCE, 0U), "queueing failed");
+
+	zassert_ok(mqtt_publish_queue_flush(&client), "flush failed");
+
+	zassert_equal(written_count(), 4, "wrong number of messages written");
+	zassert_equal(mqtt_publish_queue_count(&client), 4, "wrong count");
+	zassert_equal(client.internal.pub_inflight, 2U, "wrong in-flight count");
+	zassert_equal(client.internal.pub_retired, BIT(1) | BIT(3), "wrong retired bits");
+
+	/* The QoS must match along with the message id */
+	mqtt_publish_queue_ack(&client, MQTT_QOS_1_AT_LEAST_ONCE, 2U);
+	zassert_equal(client.internal.pub_inflight, 2U, "wrong message acknowledged");
+	zassert_equal(client.internal.pub_retired, BIT(1) | BIT(3), "wrong retired bits");
+
+	mqtt_publish_queue_ack(&client, MQTT_QOS_2_EXACTLY_ONCE, 2U);
+	zassert_equal(client.internal.pub_inflight, 1U, "message not acknowledged");
+	zassert_equal(client.internal.pub_retired, BIT(1) | BIT(2) | BIT(3),
+		      "wrong retired bits");
+	zassert_equal(mqtt_publish_queue_count(&client), 4, "slots released too early");
+
+	/* A duplicate acknowledgment is ignored */
+	mqtt_publish_queue_ack(&client, MQTT_QOS_2_EXACTLY_ONCE, 2U);
+	zassert_equal(client.internal.pub_inflight, 1U, "duplicate acknowledged");
+
+	mqtt_publish_queue_ack(&client, MQTT_QOS_1_AT_LEAST_ONCE, 1U);
+	zassert_equal(client.internal.pub_inflight, 0U, "message not acknowledged");
+	zassert_equal(client.internal.pub_retired, 0U, "retired bits left");
+	zassert_equal(client.internal.pub_head, 4U, "wrong queue head");
+	zassert_equal(mqtt_publish_queue_count(&client), 0, "slots not released");
+}
+
+ZTEST(mqtt_publish_queue, test_inflight_window)
+{
+	BUILD_ASSERT(CONFIG_MQTT_PUBLISH_QUEUE_INFLIGHT == 2);
+
+	zassert_ok(queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, 1U), "queueing failed");
+	zassert_ok(queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, 2U), "queueing failed");
+	zassert_ok(queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, 3U), "queueing failed");
+	zassert_ok(queue_msg(MQTT_QOS_0_AT_MOST_ONCE, 0U), "queueing failed");
+
+	/* The QoS 0 message waits behind the third QoS 1 one, in order */
+	zassert_ok(mqtt_publish_queue_flush(&client), "flush failed");
+	zassert_equal(written_count(), 2, "window not applied");
+	zassert_equal(client.internal.pub_written, 2U, "wrong written count");
+
+	zassert_ok(mqtt_publish_queue_flush(&client), "flush failed");
+	zassert_equal(written_count(), 0, "written over the window");
+
+	mqtt_publish_queue_ack(&client, MQTT_QOS_1_AT_LEAST_ONCE, 1U);
+	zassert_equal(mqtt_publish_queue_count(&client), 3, "slot not released");
+
+	zassert_ok(mqtt_publish_queue_flush(&client), "flush failed");
+	zassert_equal(written_count(), 2, "window not refilled");
+	zassert_equal(mqtt_publish_queue_count(&client), 3, "wrong count");
+
+	/* Acknowledged out of order, the slots are released in order */
+	mqtt_publish_queue_ack(&client, MQTT_QOS_1_AT_LEAST_ONCE, 3U);
+	zassert_equal(mqtt_publish_queue_count(&client), 3, "slots released out of order");
+
+	mqtt_publish_queue_ack(&client, MQTT_QOS_1_AT_LEAST_ONCE, 2U);
+	zassert_equal(mqtt_publish_queue_count(&client), 0, "slots not released");
+}
+
+ZTEST(mqtt_publish_queue, test_queue_full_and_wrap)
+{
+	uint16_t next_ack = 1U;
+	uint16_t id = 1U;
+	int written = 0;
+	int n;
+
+	for (int i = 0; i < CONFIG_MQTT_PUBLISH_QUEUE_SIZE; i++) {
+		zassert_ok(queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, id++), "queueing failed");
+	}
+
+	zassert_equal(queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, id), -ENOBUFS, "queue not full");
+
+	/* Refill the slots released as the messages are acknowledged, so
+	 * that the ring wraps around.
+	 */
+	while (mqtt_publish_queue_count(&client) > 0) {
+		zassert_ok(mqtt_publish_queue_flush(&client), "flush failed");
+
+		n = written_count();
+		zassert_true(n > 0, "nothing written");
+		written += n;
+
+		while (n-- > 0) {
+			mqtt_publish_queue_ack(&client, MQTT_QOS_1_AT_LEAST_ONCE, next_ack++);
+		}
+
+		while (id <= 2U * CONFIG_MQTT_PUBLISH_QUEUE_SIZE &&
+		       queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, id) == 0) {
+			id++;
+		}
+	}
+
+	zassert_equal(written, 2 * CONFIG_MQTT_PUBLISH_QUEUE_SIZE, "messages lost");
+	zassert_equal(client.internal.pub_retired, 0U, "retired bits left");
+}
+
+ZTEST(mqtt_publish_queue, test_dropped_reported_on_disconnect)
+{
+	zassert_ok(queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, 1U), "queueing failed");
+	zassert_ok(queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, 2U), "queueing failed");
+	zassert_ok(queue_msg(MQTT_QOS_0_AT_MOST_ONCE, 0U), "queueing failed");
+	zassert_ok(queue_msg(MQTT_QOS_1_AT_LEAST_ONCE, 3U), "queueing failed");
+
+	zassert_ok(mqtt_publish_queue_flush(&client), "flush failed");
+	zassert_equal(written_count(), 3, "wrong number of messages written");
+
+	mqtt_publish_queue_ack(&client, MQTT_QOS_1_AT_LEAST_ONCE, 1U);
+
+	/* Message 2, the retired QoS 0 message behind it and message 3 */
+	zassert_ok(mqtt_abort(&client), "abort failed");
+
+	zassert_equal(disconnect_count, 1, "no disconnect event");
+	zassert_equal(disconnect_evt.result, -ECONNABORTED, "wrong result");
+	zassert_equal(disconnect_evt.param.disconnect.pub_dropped, 3U,
+		      "wrong number of dropped messages");
+	zassert_equal(mqtt_publish_queue_count(&client), 0, "queue not cleared");
+	zassert_equal(queue_msg(MQTT_QOS_0_AT_MOST_ONCE, 0U), -ENOTCONN,
+		      "queued while disconnected");
+}
+
+ZTEST_SUITE(mqtt_publish_queue, NULL, NULL, before, after, NULL);
@@ -544,6 +544,58 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct in6_addr prefix = { { { 0x20, 0x01, 0x0d, 0xb8 } } };
+	struct in6_addr in_prefix64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					    0, 0, 0, 0, 0x12, 0x34, 0, 0x1 } } };
+	struct in6_addr in_prefix32 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x1, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct in6_addr no_prefix = { { { 0x20, 0x01, 0x0d, 0xb9, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct net_route_entry *route32, *route64, *route128;
+
+	route32 = net_route_add(my_iface, &prefix, 32, &peer_addr,
+				NET_IPV6_ND_INFINITE_LIFETIME,
+				NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route32, "Route add failed");
+
+	/* More specific routes do not replace the covering one */
+	route64 = net_route_add(my_iface, &prefix, 64, &peer_addr_alt,
+				NET_IPV6_ND_INFINITE_LIFETIME,
+				NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route64, "Route add failed");
+
+	route128 = net_route_add(my_iface, &dest_addr, 128, &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route128, "Route add failed");
+
+	zassert_true(route32 != route64 && route64 != route128,
+		     "Routes not distinct");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), route128,
+			  "Host route not selected");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in_prefix64), route64,
+			  "/64 route not selected");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in_prefix32), route32,
+			  "/32 route not selected");
+	zassert_is_null(net_route_lookup(my_iface, &no_prefix),
+			"Route found outside of the prefixes");
+
+	/* A deleted route is not found any more, even if it was cached */
+	zassert_equal(net_route_del(route64), 0, "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in_prefix64), route32,
+			  "/32 route not selected after /64 removal");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), route128,
+			  "Host route not selected after /64 removal");
+
+	zassert_equal(net_route_del(route128), 0, "Route del failed");
+	zassert_equal(net_route_del(route32), 0, "Route del failed");
+
+	zassert_is_null(net_route_lookup(my_iface, &dest_addr),
+			"Route found in an empty table");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +618,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
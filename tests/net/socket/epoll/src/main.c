@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/zvfs/eventfd.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+/* Time for a packet to go through the loopback interface */
+#define LOOPBACK_DELAY_MS 100
+
+static int epfd;
+static int c_sock;
+static int s_sock;
+
+static void epoll_add(int fd, uint32_t events, uint32_t u32)
+{
+	struct zsock_epoll_event event = {
+		.events = events,
+		.data.u32 = u32,
+	};
+
+	zassert_equal(zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, fd, &event), 0,
+		      "epoll_ctl failed (%d)", errno);
+}
+
+static void send_small(void)
+{
+	ssize_t len;
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+}
+
+static void recv_small(void)
+{
+	char buf[10];
+	ssize_t len;
+
+	len = zsock_recv(s_sock, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+}
+
+ZTEST(net_socket_epoll, test_level_triggered)
+{
+	struct zsock_epoll_event events[2];
+	int res;
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN, 1);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "unexpected event");
+
+	send_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), LOOPBACK_DELAY_MS);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+	zassert_equal(events[0].data.u32, 1, "");
+
+	/* Still readable, so reported again */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "level-triggered event not repeated");
+
+	recv_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "event after data was read");
+}
+
+ZTEST(net_socket_epoll, test_edge_triggered)
+{
+	struct zsock_epoll_event events[2];
+	int res;
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN | ZSOCK_EPOLLET, 2);
+
+	send_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), LOOPBACK_DELAY_MS);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(events[0].data.u32, 2, "");
+
+	/* Data left unread is not reported twice */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "edge-triggered event repeated");
+
+	/* But new data is */
+	send_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), LOOPBACK_DELAY_MS);
+	zassert_equal(res, 1, "no event for new data");
+
+	recv_small();
+	recv_small();
+}
+
+ZTEST(net_socket_epoll, test_oneshot)
+{
+	struct zsock_epoll_event event = {
+		.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT,
+		.data.u32 = 3,
+	};
+	int res;
+
+	epoll_add(s_sock, event.events, event.data.u32);
+
+	send_small();
+
+	res = zsock_epoll_wait(epfd, &event, 1, LOOPBACK_DELAY_MS);
+	zassert_equal(res, 1, "no event");
+
+	res = zsock_epoll_wait(epfd, &event, 1, 0);
+	zassert_equal(res, 0, "disabled entry reported");
+
+	/* Re-arming reports the pending data again */
+	event.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &event);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+
+	res = zsock_epoll_wait(epfd, &event, 1, 0);
+	zassert_equal(res, 1, "re-armed entry not reported");
+
+	recv_small();
+}
+
+static int efd;
+
+static void eventfd_write_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	zassert_equal(zvfs_eventfd_write(efd, 1), 0, "eventfd write failed");
+}
+
+static K_WORK_DELAYABLE_DEFINE(eventfd_write_work, eventfd_write_work_handler);
+
+ZTEST(net_socket_epoll, test_socketpair_eventfd)
+{
+	struct zsock_epoll_event events[3];
+	zvfs_eventfd_t value;
+	char buf[10];
+	int sv[2];
+	int res;
+
+	res = zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair failed (%d)", errno);
+
+	efd = zvfs_eventfd(0, ZVFS_EFD_NONBLOCK);
+	zassert_true(efd >= 0, "eventfd failed (%d)", errno);
+
+	epoll_add(sv[0], ZSOCK_EPOLLIN, 10);
+	epoll_add(efd, ZSOCK_EPOLLIN, 11);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "unexpected event");
+
+	res = zsock_send(sv[1], BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "socketpair send failed");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "no socketpair event");
+	zassert_equal(events[0].data.u32, 10, "");
+
+	res = zsock_recv(sv[0], buf, sizeof(buf), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "socketpair recv failed");
+
+	/* A blocking wait is woken up by the eventfd */
+	k_work_schedule(&eventfd_write_work, K_MSEC(10));
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), LOOPBACK_DELAY_MS);
+	zassert_equal(res, 1, "no eventfd event");
+	zassert_equal(events[0].data.u32, 11, "");
+
+	zassert_equal(zvfs_eventfd_read(efd, &value), 0, "eventfd read failed");
+
+	/* Closing the remote endpoint is reported as a hang up */
+	zassert_equal(zsock_close(sv[1]), 0, "close failed");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "no hang up event");
+	zassert_equal(events[0].data.u32, 10, "");
+
+	/* Closed file descriptors leave the set by themselves */
+	zassert_equal(zsock_close(sv[0]), 0, "close failed");
+	zassert_equal(zsock_close(efd), 0, "close failed");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "event for a closed fd");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, efd, NULL);
+	zassert_equal(res, -1, "closed fd still in the set");
+	zassert_equal(errno, ENOENT, "");
+}
+
+ZTEST(net_socket_epoll, test_ctl_errors)
+{
+	struct zsock_epoll_event event = {
+		.events = ZSOCK_EPOLLIN,
+	};
+	int res;
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN, 0);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &event);
+	zassert_equal(res, -1, "fd added twice");
+	zassert_equal(errno, EEXIST, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, c_sock, &event);
+	zassert_equal(res, -1, "unknown fd modified");
+	zassert_equal(errno, ENOENT, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, epfd, &event);
+	zassert_equal(res, -1, "set added to itself");
+	zassert_equal(errno, EINVAL, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, -1, "fd removed twice");
+	zassert_equal(errno, ENOENT, "");
+}
+
+ZTEST(net_socket_epoll, test_poll_set)
+{
+	struct zsock_pollfd pfd = {
+		.events = ZSOCK_POLLIN,
+	};
+	struct zsock_epoll_event event;
+	int res;
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN, 0);
+
+	/* Let the set check the new entry once */
+	res = zsock_epoll_wait(epfd, &event, 1, 0);
+	zassert_equal(res, 0, "unexpected event");
+
+	pfd.fd = epfd;
+
+	res = zsock_poll(&pfd, 1, 0);
+	zassert_equal(res, 0, "idle set reported readable");
+
+	send_small();
+
+	res = zsock_poll(&pfd, 1, LOOPBACK_DELAY_MS);
+	zassert_equal(res, 1, "set not readable");
+	zassert_equal(pfd.revents, ZSOCK_POLLIN, "");
+
+	recv_small();
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	epfd = zsock_epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed (%d)", errno);
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_equal(zsock_close(epfd), 0, "close failed");
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)zsock_close(c_sock);
+	(void)zsock_close(s_sock);
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, setup, before, after, teardown);
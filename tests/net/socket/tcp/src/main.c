@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/posix/fcntl.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net/buf.h>
 #include <zephyr/net/loopback.h>
 
 #include "../../socket_helpers.h"
@@ -297,6 +298,84 @@ ZTEST_USER(net_socket_tcp, test_v6_send_recv)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+static K_SEM_DEFINE(zerocopy_acked, 0, 2);
+
+static void zerocopy_destroy(struct net_buf *buf)
+{
+	net_buf_destroy(buf);
+	k_sem_give(&zerocopy_acked);
+}
+
+NET_BUF_POOL_DEFINE(zerocopy_pool, 2, 0, 0, zerocopy_destroy);
+
+ZTEST(net_socket_tcp, test_v4_send_recv_zerocopy)
+{
+	/* Test if zsock_send_buf() and zsock_recv_buf() work on a ipv4
+	 * stream socket, and that the sent data is left untouched.
+	 */
+	static char payload[] = TEST_STR_LONG;
+	static char rx_data[sizeof(TEST_STR_LONG)];
+	size_t half = STRLEN(TEST_STR_LONG) / 2;
+	size_t total = 0;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct net_buf *buf;
+	ssize_t len;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	/* Application memory sent in place, in two buffers */
+	buf = net_buf_alloc_with_data(&zerocopy_pool, payload, half, K_NO_WAIT);
+	zassert_not_null(buf, "cannot wrap payload");
+	net_buf_frag_add(buf, net_buf_alloc_with_data(&zerocopy_pool,
+						      payload + half,
+						      STRLEN(TEST_STR_LONG) - half,
+						      K_NO_WAIT));
+	zassert_not_null(buf->frags, "cannot wrap payload");
+
+	len = zsock_send_buf(c_sock, buf, 0, NULL, 0);
+	zassert_equal(len, STRLEN(TEST_STR_LONG), "send failed (%d)", errno);
+
+	while (total < STRLEN(TEST_STR_LONG)) {
+		len = zsock_recv_buf(new_sock, &buf, 0, NULL, NULL);
+		zassert_true(len > 0, "recv failed (%d)", errno);
+		zassert_true(total + len <= STRLEN(TEST_STR_LONG), "too much data");
+		zassert_equal(net_buf_frags_len(buf), len, "wrong buffer length");
+
+		net_buf_linearize(rx_data + total, sizeof(rx_data) - total, buf, 0, len);
+		zsock_buf_release(buf);
+		total += len;
+	}
+
+	zassert_mem_equal(rx_data, TEST_STR_LONG, STRLEN(TEST_STR_LONG), "wrong data");
+
+	/* The buffers are given back once the data has been acknowledged */
+	zassert_ok(k_sem_take(&zerocopy_acked, K_MSEC(500)), "no completion");
+	zassert_ok(k_sem_take(&zerocopy_acked, K_MSEC(500)), "no completion");
+	zassert_mem_equal(payload, TEST_STR_LONG, STRLEN(TEST_STR_LONG),
+			  "sent data modified");
+
+	test_close(c_sock);
+	test_eof(new_sock);
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 /* Test the stack behavior with a resonable sized block data, be sure to have multiple packets */
 #define TEST_LARGE_TRANSFER_SIZE 60000
 #define TEST_PRIME 811
@@ -2415,6 +2494,62 @@ ZTEST(net_socket_tcp, test_so_keepalive)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in bind_addr4;
+	int sock, ret;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_DEFAULT_CUBIC)) {
+		zassert_str_equal(name, "cubic", "unexpected default algorithm");
+	} else if (IS_ENABLED(CONFIG_NET_TCP_CA_DEFAULT_BBR)) {
+		zassert_str_equal(name, "bbr", "unexpected default algorithm");
+	} else {
+		zassert_str_equal(name, "reno", "unexpected default algorithm");
+	}
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+
+	/* The name does not have to be NUL terminated */
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "reno", 4);
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "vegas",
+			       sizeof("vegas"));
+	zassert_equal(ret, -1, "unknown algorithm accepted");
+	zassert_equal(errno, ENOENT, "setsockopt set invalid errno (%d)", errno);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_CUBIC)) {
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				       sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_str_equal(name, "cubic", "getsockopt got invalid value");
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_BBR)) {
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "bbr",
+				       sizeof("bbr"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_str_equal(name, "bbr", "getsockopt got invalid value");
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 ZTEST(net_socket_tcp, test_keepalive_timeout)
 {
 	struct sockaddr_in c_saddr, s_saddr;
@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/net/loopback.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/tls_credentials.h>
+#include <zephyr/random/random.h>
 #include <mbedtls/ssl.h>
 
 #include "../../socket_helpers.h"
@@ -1354,6 +1355,170 @@ ZTEST(net_socket_tls, test_send_on_close)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+/* Larger than the maximum record payload, so that it needs several records */
+#define TEST_LARGE_LEN (2 * CONFIG_MBEDTLS_SSL_MAX_CONTENT_LEN + 100)
+
+static uint8_t test_large_buf[TEST_LARGE_LEN];
+
+ZTEST(net_socket_tls, test_send_block_all)
+{
+	struct recv_data test_data = {
+		.data = test_large_buf,
+		.datalen = sizeof(test_large_buf)
+	};
+	struct k_work_sync sync;
+	int ret;
+
+	for (int i = 0; i < sizeof(test_large_buf); i++) {
+		test_large_buf[i] = i;
+	}
+
+	test_prepare_tls_connection(AF_INET6);
+
+	test_data.sock = new_sock;
+	k_work_init_delayable(&test_data.work, recv_work_handler);
+	test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+	/* A blocking send() shall write all the data, not only one record. */
+	ret = zsock_send(c_sock, test_large_buf, sizeof(test_large_buf), 0);
+	zassert_equal(ret, sizeof(test_large_buf), "send() failed");
+
+	k_work_flush_delayable(&test_data.work, &sync);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+#if CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0
+static void test_msg_more_send(int sock, int count)
+{
+	for (int i = 0; i < count; i++) {
+		test_send(sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), ZSOCK_MSG_MORE);
+	}
+}
+
+static void test_msg_more_not_sent(int sock)
+{
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	int ret;
+
+	/* Small delay for packets to propagate. */
+	k_msleep(10);
+
+	ret = zsock_recv(sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "Data sent with MSG_MORE not held back");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+}
+
+static void test_msg_more_recv(int sock, int count)
+{
+	struct zsock_pollfd fds[1] = {
+		{ .fd = sock, .events = ZSOCK_POLLIN },
+	};
+	uint8_t rx_buf[4 * (sizeof(TEST_STR_SMALL) - 1)];
+	size_t len = count * strlen(TEST_STR_SMALL);
+	int ret;
+
+	zassert_true(len <= sizeof(rx_buf), "Too many strings");
+
+	ret = zsock_poll(fds, ARRAY_SIZE(fds), 100);
+	zassert_equal(ret, 1, "Data held back not written");
+
+	ret = zsock_recv(sock, rx_buf, len, ZSOCK_MSG_WAITALL);
+	zassert_equal(ret, len, "recv() failed");
+
+	for (int i = 0; i < count; i++) {
+		zassert_mem_equal(rx_buf + i * strlen(TEST_STR_SMALL), TEST_STR_SMALL,
+				  strlen(TEST_STR_SMALL), "Invalid data received");
+	}
+}
+
+ZTEST(net_socket_tls, test_msg_more_coalesce)
+{
+	char tx_buf[] = TEST_STR_SMALL;
+	struct iovec iov[2] = {
+		{ .iov_base = tx_buf, .iov_len = strlen(tx_buf) },
+		{ .iov_base = tx_buf, .iov_len = strlen(tx_buf) },
+	};
+	struct msghdr msg = { .msg_iov = iov, .msg_iovlen = ARRAY_SIZE(iov) };
+
+	test_prepare_tls_connection(AF_INET6);
+
+	/* The writes flagged with MSG_MORE are held back... */
+	test_msg_more_send(c_sock, 3);
+	test_msg_more_not_sent(new_sock);
+
+	/* ...and written together with the next write without it. */
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	test_msg_more_recv(new_sock, 4);
+
+	/* sendmsg() sets MSG_MORE on all the buffers but the last one. */
+	test_sendmsg(c_sock, &msg, 0);
+	test_msg_more_recv(new_sock, 2);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_tls, test_msg_more_flush_on_recv)
+{
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	struct zsock_pollfd fds[1] = {
+		{ .fd = -1, .events = ZSOCK_POLLIN },
+	};
+	int ret;
+
+	test_prepare_tls_connection(AF_INET6);
+
+	test_msg_more_send(c_sock, 2);
+	test_msg_more_not_sent(new_sock);
+
+	/* The peer might wait for the data before answering, recv() writes
+	 * it even if there is nothing to read.
+	 */
+	ret = zsock_recv(c_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "recv() should've failed");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	test_msg_more_recv(new_sock, 2);
+
+	/* And so does poll(). */
+	test_msg_more_send(c_sock, 2);
+	test_msg_more_not_sent(new_sock);
+
+	fds[0].fd = c_sock;
+	ret = zsock_poll(fds, ARRAY_SIZE(fds), 0);
+	zassert_equal(ret, 0, "Unexpected poll() event");
+
+	test_msg_more_recv(new_sock, 2);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_tls, test_msg_more_flush_on_close)
+{
+	test_prepare_tls_connection(AF_INET6);
+
+	test_msg_more_send(c_sock, 2);
+	test_msg_more_not_sent(new_sock);
+
+	/* The data held back is written before the close notification. */
+	test_close(c_sock);
+	c_sock = -1;
+
+	test_msg_more_recv(new_sock, 2);
+	test_eof(new_sock);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_COALESCE_BUF_SIZE > 0 */
+
 ZTEST(net_socket_tls, test_so_rcvtimeo)
 {
 	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
@@ -1814,6 +1979,225 @@ ZTEST(net_socket_tls, test_poll_dtls_pollerr)
 	k_msleep(10);
 }
 
+#if defined(CONFIG_MBEDTLS_SSL_SESSION_TICKETS)
+#define MASTER_SECRET_LEN 48
+
+static void test_session_tickets_connect(struct sockaddr_in *s_saddr,
+					 unsigned char *master,
+					 mbedtls_ssl_session *session)
+{
+	int optval = TLS_SESSION_CACHE_ENABLED;
+	struct sockaddr_in c_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct connect_data test_data;
+	mbedtls_ssl_context *ssl_ctx;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_psk(-1, c_sock);
+
+	/* Clients request tickets without TLS_SESSION_TICKETS being set */
+	zassert_equal(zsock_setsockopt(c_sock, SOL_TLS, TLS_SESSION_CACHE,
+				       &optval, sizeof(optval)),
+		      0, "setsockopt() failed");
+
+	test_data.sock = c_sock;
+	test_data.addr = (struct sockaddr *)s_saddr;
+	k_work_init_delayable(&test_data.work, client_connect_work_handler);
+	test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	test_work_wait(&test_data.work);
+
+	/* A resumed session keeps the master secret of the original one */
+	ssl_ctx = ztls_get_mbedtls_ssl_context(c_sock);
+	memcpy(master,
+	       ssl_ctx->MBEDTLS_PRIVATE(session)->MBEDTLS_PRIVATE(master),
+	       MASTER_SECRET_LEN);
+
+	if (session != NULL) {
+		zassert_equal(mbedtls_ssl_get_session(ssl_ctx, session), 0,
+			      "Failed to get session");
+	}
+
+	test_close(new_sock);
+	new_sock = -1;
+	test_close(c_sock);
+	c_sock = -1;
+}
+
+/* A client kept out of the socket layer, so that it presents a stored
+ * ticket whatever the state of the client session cache.
+ */
+struct ticket_client_data {
+	struct k_work_delayable work;
+	struct sockaddr *addr;
+	mbedtls_ssl_session *session;
+	unsigned char *master;
+};
+
+static int ticket_client_rng(void *ctx, unsigned char *buf, size_t len)
+{
+	ARG_UNUSED(ctx);
+
+	sys_rand_get(buf, len);
+
+	return 0;
+}
+
+static int ticket_client_send(void *ctx, const unsigned char *buf, size_t len)
+{
+	ssize_t ret = zsock_send(POINTER_TO_INT(ctx), buf, len, 0);
+
+	return ret < 0 ? MBEDTLS_ERR_SSL_INTERNAL_ERROR : (int)ret;
+}
+
+static int ticket_client_recv(void *ctx, unsigned char *buf, size_t len)
+{
+	ssize_t ret = zsock_recv(POINTER_TO_INT(ctx), buf, len, 0);
+
+	return ret < 0 ? MBEDTLS_ERR_SSL_INTERNAL_ERROR : (int)ret;
+}
+
+static void ticket_client_work_handler(struct k_work *work)
+{
+	static mbedtls_ssl_config conf;
+	static mbedtls_ssl_context ssl;
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct ticket_client_data *data =
+		CONTAINER_OF(dwork, struct ticket_client_data, work);
+	int sock;
+	int ret;
+
+	mbedtls_ssl_config_init(&conf);
+	mbedtls_ssl_init(&ssl);
+
+	zassert_equal(mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT,
+						  MBEDTLS_SSL_TRANSPORT_STREAM,
+						  MBEDTLS_SSL_PRESET_DEFAULT),
+		      0, "Failed to set up client configuration");
+	mbedtls_ssl_conf_rng(&conf, ticket_client_rng, NULL);
+	mbedtls_ssl_conf_max_tls_version(&conf, MBEDTLS_SSL_VERSION_TLS1_2);
+	mbedtls_ssl_conf_session_tickets(&conf,
+					 MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+	zassert_equal(mbedtls_ssl_conf_psk(&conf, psk, sizeof(psk),
+					   (const unsigned char *)psk_id,
+					   strlen(psk_id)),
+		      0, "Failed to set PSK");
+	zassert_equal(mbedtls_ssl_setup(&ssl, &conf), 0,
+		      "Failed to set up client");
+	zassert_equal(mbedtls_ssl_set_session(&ssl, data->session), 0,
+		      "Failed to set session");
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket open failed");
+	test_connect(sock, data->addr, sizeof(struct sockaddr_in));
+
+	mbedtls_ssl_set_bio(&ssl, INT_TO_POINTER(sock), ticket_client_send,
+			    ticket_client_recv, NULL);
+
+	do {
+		ret = mbedtls_ssl_handshake(&ssl);
+	} while (ret == MBEDTLS_ERR_SSL_WANT_READ ||
+		 ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+	zassert_equal(ret, 0, "Handshake failed, err: -0x%x", -ret);
+
+	memcpy(data->master,
+	       ssl.MBEDTLS_PRIVATE(session)->MBEDTLS_PRIVATE(master),
+	       MASTER_SECRET_LEN);
+
+	(void)mbedtls_ssl_close_notify(&ssl);
+	test_close(sock);
+	mbedtls_ssl_free(&ssl);
+	mbedtls_ssl_config_free(&conf);
+}
+
+static void test_session_tickets_kept(struct sockaddr_in *s_saddr,
+				      mbedtls_ssl_session *session,
+				      unsigned char *master)
+{
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct ticket_client_data test_data;
+
+	test_data.addr = (struct sockaddr *)s_saddr;
+	test_data.session = session;
+	test_data.master = master;
+	k_work_init_delayable(&test_data.work, ticket_client_work_handler);
+	test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	test_work_wait(&test_data.work);
+
+	test_close(new_sock);
+	new_sock = -1;
+}
+
+ZTEST(net_socket_tls, test_session_tickets)
+{
+	unsigned char master[5][MASTER_SECRET_LEN];
+	mbedtls_ssl_session session;
+	struct sockaddr_in s_saddr;
+	int optval = TLS_SESSION_TICKETS_ENABLED;
+	socklen_t optlen = sizeof(optval);
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_psk(s_sock, -1);
+
+	zassert_equal(zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKETS,
+				       &optval, sizeof(optval)),
+		      0, "setsockopt() failed");
+
+	optval = TLS_SESSION_TICKETS_DISABLED;
+	zassert_equal(zsock_getsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKETS,
+				       &optval, &optlen),
+		      0, "getsockopt() failed");
+	zassert_equal(optval, TLS_SESSION_TICKETS_ENABLED,
+		      "Session tickets not enabled");
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	mbedtls_ssl_session_init(&session);
+
+	test_session_tickets_connect(&s_saddr, master[0], NULL);
+	test_session_tickets_connect(&s_saddr, master[1], &session);
+
+	zassert_mem_equal(master[0], master[1], MASTER_SECRET_LEN,
+			  "Session not resumed");
+
+	/* The ticket is accepted as long as the key is kept */
+	test_session_tickets_kept(&s_saddr, &session, master[2]);
+
+	zassert_mem_equal(master[0], master[2], MASTER_SECRET_LEN,
+			  "Session not resumed from the kept ticket");
+
+	/* A purge drops the stored sessions along with the ticket key */
+	zassert_equal(zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE_PURGE,
+				       &optval, sizeof(optval)),
+		      0, "setsockopt() failed");
+
+	test_session_tickets_kept(&s_saddr, &session, master[3]);
+
+	zassert_true(memcmp(master[0], master[3], MASTER_SECRET_LEN) != 0,
+		     "Kept ticket accepted after purge");
+
+	test_session_tickets_connect(&s_saddr, master[4], NULL);
+
+	zassert_true(memcmp(master[0], master[4], MASTER_SECRET_LEN) != 0,
+		     "Session resumed after purge");
+
+	mbedtls_ssl_session_free(&session);
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+#endif /* CONFIG_MBEDTLS_SSL_SESSION_TICKETS */
+
 static void *tls_tests_setup(void)
 {
 	k_work_queue_init(&tls_test_work_queue);
@@ -2528,6 +2528,168 @@ ZTEST(net_socket_udp, test_37_ipv6_src_addr_select)
 				       &my_addr3, &dest);
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+static K_SEM_DEFINE(zerocopy_sent, 0, 1);
+
+static void zerocopy_destroy(struct net_buf *buf)
+{
+	net_buf_destroy(buf);
+	k_sem_give(&zerocopy_sent);
+}
+
+NET_BUF_POOL_DEFINE(zerocopy_hdr_pool, 1, sizeof(TEST_STR_SMALL), 0, NULL);
+NET_BUF_POOL_DEFINE(zerocopy_pool, 1, 0, 0, zerocopy_destroy);
+
+ZTEST(net_socket_udp, test_38_v4_zerocopy)
+{
+	static const char payload[] = TEST_STR2;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr;
+	socklen_t addrlen = sizeof(src_addr);
+	struct zsock_pollfd pfd;
+	struct net_buf *buf;
+	int client_sock;
+	int server_sock;
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(client_sock, (struct sockaddr *)&client_addr,
+			sizeof(client_addr));
+	zassert_equal(rv, 0, "bind failed");
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	/* A copied header in front of application memory sent in place */
+	buf = net_buf_alloc(&zerocopy_hdr_pool, K_NO_WAIT);
+	zassert_not_null(buf, "cannot allocate header");
+	net_buf_add_mem(buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL));
+	net_buf_frag_add(buf, net_buf_alloc_with_data(&zerocopy_pool,
+						      (void *)payload,
+						      STRLEN(TEST_STR2),
+						      K_NO_WAIT));
+	zassert_not_null(buf->frags, "cannot wrap payload");
+
+	len = zsock_send_buf(client_sock, buf, 0, (struct sockaddr *)&server_addr,
+			     sizeof(server_addr));
+	zassert_equal(len, STRLEN(TEST_STR_SMALL) + STRLEN(TEST_STR2),
+		      "send failed (%d)", errno);
+
+	/* The buffers are given back once the datagram has been sent */
+	zassert_ok(k_sem_take(&zerocopy_sent, K_MSEC(100)), "no completion");
+
+	pfd.fd = server_sock;
+	pfd.events = ZSOCK_POLLIN;
+	rv = zsock_poll(&pfd, 1, 100);
+	zassert_equal(rv, 1, "poll failed");
+	zassert_equal(pfd.revents, ZSOCK_POLLIN, "not readable");
+
+	len = zsock_recv_buf(server_sock, &buf, 0, (struct sockaddr *)&src_addr,
+			     &addrlen);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL) + STRLEN(TEST_STR2),
+		      "recv failed (%d)", errno);
+	zassert_equal(net_buf_frags_len(buf), len, "wrong buffer length");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+	zassert_equal(src_addr.sin_port, client_addr.sin_port, "wrong source port");
+
+	net_buf_linearize(rx_buf, sizeof(rx_buf), buf, 0, len);
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), "wrong data");
+	zassert_mem_equal(rx_buf + STRLEN(TEST_STR_SMALL), payload, STRLEN(TEST_STR2),
+			  "wrong data");
+
+	zsock_buf_release(buf);
+
+	len = zsock_recv_buf(server_sock, &buf, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(len, -1, "recv should have failed");
+	zassert_equal(errno, EAGAIN, "wrong errno");
+	zassert_is_null(buf, "buffer returned");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+ZTEST_USER(net_socket_udp, test_39_v4_sendmmsg_recvmmsg_user)
+{
+	static const char * const data[] = { TEST_STR_SMALL, "second", "x" };
+	struct mmsghdr msgs[ARRAY_SIZE(data) + 1];
+	struct iovec io_vector[ARRAY_SIZE(data) + 1];
+	struct sockaddr_in src_addr[ARRAY_SIZE(data) + 1];
+	char bufs[ARRAY_SIZE(data) + 1][16];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(client_sock, (struct sockaddr *)&client_addr,
+			sizeof(client_addr));
+	zassert_equal(rv, 0, "bind failed");
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		io_vector[i].iov_base = (void *)data[i];
+		io_vector[i].iov_len = strlen(data[i]);
+		msgs[i].msg_hdr.msg_iov = &io_vector[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgs, ARRAY_SIZE(data), 0);
+	zassert_equal(rv, ARRAY_SIZE(data), "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(data[i]), "wrong length sent");
+	}
+
+	/* Ask for one message more than was sent, only the first is waited for */
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		io_vector[i].iov_base = bufs[i];
+		io_vector[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &io_vector[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &src_addr[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(src_addr[i]);
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), ZSOCK_MSG_WAITFORONE);
+	zassert_equal(rv, ARRAY_SIZE(data), "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(data[i]), "wrong length received");
+		zassert_mem_equal(bufs[i], data[i], strlen(data[i]), "wrong data");
+		zassert_equal(msgs[i].msg_hdr.msg_namelen, sizeof(struct sockaddr_in),
+			      "wrong addrlen");
+		zassert_equal(src_addr[i].sin_port, client_addr.sin_port,
+			      "wrong source port");
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should have failed");
+	zassert_equal(errno, EAGAIN, "wrong errno");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -20,6 +20,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stddef.h>
 #include <string.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/linker/sections.h>
 #include <zephyr/tc_util.h>
 
@@ -133,6 +134,7 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_CLIENT_SACK_RETRANSMIT_IPV4 = 19,
 } test_case_no;
 
 static enum test_state t_state;
@@ -157,6 +159,8 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+static void handle_client_sack_retransmit_test(sa_family_t af, struct tcphdr *th,
+					       struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -254,6 +258,19 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+#define SACK_TEST_MSS 256
+#define SACK_TEST_SEGMENTS 5
+#define SACK_TEST_WIN 2048
+
+static const uint8_t sack_syn_options[8] = {
+	0x02, 0x04, SACK_TEST_MSS >> 8, SACK_TEST_MSS & 0xff, /* Max segment */
+	0x01, 0x01, /* NOP */
+	0x04, 0x02, /* SACK permitted */ };
+
+/* SACK block of the next ACKs sent in the SACK test, if any */
+static uint8_t sack_options[12];
+static size_t sack_options_len;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -264,11 +281,21 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (test_case_no == TEST_CLIENT_SACK_RETRANSMIT_IPV4) {
+		if (flags & SYN) {
+			opts = sack_syn_options;
+			opts_len = sizeof(sack_syn_options);
+		} else {
+			opts = sack_options;
+			opts_len = sack_options_len;
+		}
 	}
 
 	/* Allocate buffer */
@@ -303,14 +330,15 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
+	th->th_off = 5U + opts_len / 4U;
+	th->th_flags = flags;
+
+	if (test_case_no == TEST_CLIENT_SACK_RETRANSMIT_IPV4) {
+		th->th_win = htons(SACK_TEST_WIN);
 	} else {
-		th->th_off = 5U;
+		th->th_win = NET_IPV6_MTU;
 	}
 
-	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -322,9 +350,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -509,6 +537,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_CLIENT_SACK_RETRANSMIT_IPV4:
+		handle_client_sack_retransmit_test(net_pkt_family(pkt), &th, pkt);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -738,6 +769,18 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th)
 		break;
 	case T_SYN_ACK:
 		test_verify_flags(th, SYN | ACK);
+
+		if (test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) {
+			/* MSS, plus every enabled option offered by the peer,
+			 * each padded to 32 bits.
+			 */
+			zassert_equal(th->th_off,
+				      6U + IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) +
+				      IS_ENABLED(CONFIG_NET_TCP_SACK) +
+				      3U * IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS),
+				      "unexpected TCP options in SYN ACK");
+		}
+
 		seq++;
 		ack = ntohl(th->th_seq) + 1U;
 		reply = prepare_ack_packet(af, htons(MY_PORT),
@@ -2621,4 +2664,217 @@ ZTEST(net_tcp, test_client_fin_ack_with_data)
 	}
 }
 
+struct sack_test_segment {
+	uint32_t seq;
+	size_t len;
+};
+
+static struct sack_test_segment sack_sent[SACK_TEST_SEGMENTS];
+static int sack_sent_count;
+static struct sack_test_segment sack_resent;
+static int sack_resent_count;
+static uint16_t sack_test_port;
+
+static void handle_client_sack_retransmit_test(sa_family_t af, struct tcphdr *th,
+					       struct net_pkt *pkt)
+{
+	struct net_pkt *reply;
+	size_t len;
+	int ret;
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		device_initial_seq = ntohl(th->th_seq);
+		sack_test_port = th->th_sport;
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_syn_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		seq++;
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		/* connection is success */
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		test_verify_flags(th, PSH | ACK);
+		zassert_true(sack_sent_count < SACK_TEST_SEGMENTS,
+			     "%s:%d unexpected segment", __func__, __LINE__);
+		sack_sent[sack_sent_count].seq = get_rel_seq(th);
+		sack_sent[sack_sent_count].len = len;
+		if (++sack_sent_count == SACK_TEST_SEGMENTS) {
+			test_sem_give();
+		}
+		return;
+	case T_DATA_ACK:
+		/* Only retransmissions are expected */
+		if (len == 0U) {
+			return;
+		}
+
+		sack_resent.seq = get_rel_seq(th);
+		sack_resent.len = len;
+		if (sack_resent_count++ == 0) {
+			test_sem_give();
+		}
+		return;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ntohl(th->th_seq) + 1U;
+		t_state = T_FIN_ACK;
+		reply = prepare_fin_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(net_iface, reply);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+static void send_sack_test_ack(uint32_t rel_ack, uint32_t sack_start,
+			       uint32_t sack_end)
+{
+	struct net_pkt *reply;
+
+	ack = device_initial_seq + rel_ack;
+
+	if (sack_end != sack_start) {
+		sack_options[0] = NET_TCP_NOP_OPT;
+		sack_options[1] = NET_TCP_NOP_OPT;
+		sack_options[2] = NET_TCP_SACK_OPT;
+		sack_options[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		sys_put_be32(device_initial_seq + sack_start, &sack_options[4]);
+		sys_put_be32(device_initial_seq + sack_end, &sack_options[8]);
+		sack_options_len = sizeof(sack_options);
+	} else {
+		sack_options_len = 0;
+	}
+
+	reply = prepare_ack_packet(AF_INET, htons(MY_PORT), sack_test_port);
+	zassert_not_null(reply, "Failed to prepare ACK");
+	zassert_ok(net_recv_data(net_iface, reply), "Failed to send ACK");
+}
+
+/* Test case scenario IPv4
+ *   expect SYN,
+ *   send SYN ACK with SACK permitted,
+ *   expect ACK,
+ *   expect 5 data segments,
+ *   send ACK of the first one,
+ *   send 3 duplicate ACKs reporting the segments after the second one,
+ *   expect the second segment only to be retransmitted,
+ *   send ACK of everything,
+ *   expect FIN,
+ *   send FIN ACK,
+ *   expect ACK.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_sack_retransmit_ipv4)
+{
+	struct net_context *ctx;
+	size_t data_len = SACK_TEST_SEGMENTS * SACK_TEST_MSS;
+	int ret;
+
+	/* The congestion window would only let one segment out at first */
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) ||
+	    !IS_ENABLED(CONFIG_NET_TCP_FAST_RETRANSMIT) ||
+	    IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+		ztest_test_skip();
+	}
+
+	t_state = T_SYN;
+	test_case_no = TEST_CLIENT_SACK_RETRANSMIT_IPV4;
+	seq = ack = 0;
+	sack_options_len = 0;
+	sack_sent_count = 0;
+	sack_resent_count = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to SYN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_send(ctx, lorem_ipsum, data_len, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, data_len, "Failed to send data to peer");
+
+	/* Peer will release the semaphore after it receives all segments */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	for (int i = 0; i < SACK_TEST_SEGMENTS; i++) {
+		zassert_equal(sack_sent[i].seq, 1 + i * SACK_TEST_MSS,
+			      "unexpected sequence number of segment %d", i);
+		zassert_equal(sack_sent[i].len, SACK_TEST_MSS,
+			      "unexpected length of segment %d", i);
+	}
+
+	/* The second segment is lost, the peer receives the next ones */
+	t_state = T_DATA_ACK;
+	send_sack_test_ack(1 + SACK_TEST_MSS, 0, 0);
+
+	for (int i = 3; i <= SACK_TEST_SEGMENTS; i++) {
+		send_sack_test_ack(1 + SACK_TEST_MSS, 1 + 2 * SACK_TEST_MSS,
+				   1 + i * SACK_TEST_MSS);
+	}
+
+	/* Peer will release the semaphore after the retransmission */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(sack_resent.seq, 1 + SACK_TEST_MSS,
+		      "unexpected sequence number of the retransmission");
+	zassert_equal(sack_resent.len, SACK_TEST_MSS,
+		      "unexpected length of the retransmission");
+
+	send_sack_test_ack(1 + data_len, 0, 0);
+
+	zassert_equal(sack_resent_count, 1, "data received by the peer resent");
+
+	t_state = T_FIN;
+	net_context_put(ctx);
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to FIN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+/* Build a copy of the algorithm to reach its static functions, under
+ * another name than the one linked into the stack.
+ */
+#define tcp_ca_bbr test_tcp_ca_bbr
+#include "tcp_bbr.c"
+
+#define MSS NET_TCP_DEFAULT_MSS
+#define RTT 10
+
+static struct net_context context;
+static struct tcp conn;
+
+/* After one round trip, acknowledge acked bytes, inflight bytes staying
+ * in flight.
+ */
+static void ack_data(uint32_t acked, uint32_t inflight)
+{
+	k_sleep(K_MSEC(RTT));
+
+	conn.unacked_len = acked + inflight;
+	bbr_pkts_acked(&conn, acked, RTT);
+
+	conn.seq += acked;
+	conn.unacked_len = inflight;
+}
+
+static uint32_t cwnd_target(uint32_t gain)
+{
+	uint32_t target = MIN((uint64_t)bbr_bdp(&conn) * gain / 100, NET_TCP_MAX_WIN);
+
+	return MAX(target, BBR_MIN_CWND_SEGMENTS * MSS);
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	memset(&context, 0, sizeof(context));
+	net_context_set_family(&context, AF_INET);
+
+	memset(&conn, 0, sizeof(conn));
+	conn.context = &context;
+	conn.recv_options.mss = MSS;
+	conn.recv_options.mss_found = true;
+	conn.seq = 1000U;
+
+	bbr_init(&conn);
+}
+
+ZTEST(net_tcp_bbr, test_state_machine)
+{
+	struct tcp_ca_bbr_state *bbr = &conn.ca.bbr;
+	uint32_t round;
+
+	zassert_equal(bbr->mode, BBR_STARTUP);
+	zassert_equal(conn.ca.pacing_rate, 0U, "paced without a model");
+
+	/* The delivery rate doubles every round */
+	for (uint32_t acked = 2000U; acked <= 8000U; acked *= 2U) {
+		ack_data(acked, 0U);
+
+		zassert_equal(bbr->mode, BBR_STARTUP, "startup left too early");
+		zassert_equal(conn.ca.pacing_rate,
+			      (uint64_t)bbr->max_bw * BBR_STARTUP_GAIN / 100,
+			      "wrong startup pacing rate");
+	}
+
+	zassert_equal(bbr->round_count, 3U, "wrong round count");
+	zassert_equal(bbr->min_rtt, RTT, "wrong min RTT");
+
+	/* Until it stops growing for three rounds, the last one leaving a
+	 * queue of three times the BDP.
+	 */
+	ack_data(8000U, 0U);
+	ack_data(8000U, 0U);
+	zassert_equal(bbr->mode, BBR_STARTUP, "startup left too early");
+
+	ack_data(8000U, 3U * bbr_bdp(&conn));
+	zassert_equal(bbr->mode, BBR_DRAIN, "startup not left");
+	zassert_equal(conn.ca.pacing_rate,
+		      (uint64_t)bbr->max_bw * BBR_DRAIN_GAIN / 100,
+		      "wrong drain pacing rate");
+	zassert_equal(conn.ca.cwnd, cwnd_target(BBR_CWND_GAIN), "window not cut");
+
+	/* Drain until the data in flight fits the BDP */
+	ack_data(4000U, bbr_bdp(&conn) + 4000U);
+	zassert_equal(bbr->mode, BBR_DRAIN, "drain left with a queue");
+
+	ack_data(4000U, bbr_bdp(&conn));
+	zassert_equal(bbr->mode, BBR_PROBE_BW, "drain not left");
+	zassert_equal(bbr->cycle_idx, 0U, "wrong gain cycle");
+
+	/* Each round moves to the next pacing gain of the cycle */
+	ack_data(bbr->round_end_seq - conn.seq, 0U);
+	round = bbr->round_count;
+
+	for (uint32_t i = 1U; i <= 2U * ARRAY_SIZE(bbr_cycle_gain); i++) {
+		zassert_equal(bbr->mode, BBR_PROBE_BW, "probe_bw left");
+		zassert_equal(bbr->cycle_idx, i % ARRAY_SIZE(bbr_cycle_gain),
+			      "wrong gain cycle");
+		zassert_equal(conn.ca.pacing_rate,
+			      (uint64_t)bbr->max_bw * bbr_cycle_gain[bbr->cycle_idx] / 100,
+			      "wrong probe_bw pacing rate");
+		zassert_true(conn.ca.cwnd <= cwnd_target(BBR_CWND_GAIN),
+			     "window over twice the BDP");
+
+		ack_data(8000U, 0U);
+		zassert_equal(bbr->round_count, round + i, "round not ended");
+	}
+}
+
+ZTEST(net_tcp_bbr, test_min_rtt)
+{
+	struct tcp_ca_bbr_state *bbr = &conn.ca.bbr;
+
+	bbr_pkts_acked(&conn, MSS, 20U);
+	zassert_equal(bbr->min_rtt, 20U);
+
+	bbr_pkts_acked(&conn, MSS, 0U);
+	zassert_equal(bbr->min_rtt, 20U, "missing sample used");
+
+	bbr_pkts_acked(&conn, MSS, 10U);
+	bbr_pkts_acked(&conn, MSS, 30U);
+	zassert_equal(bbr->min_rtt, 10U, "minimum not kept");
+
+	/* The minimum expires after the filter window */
+	k_sleep(K_MSEC(BBR_MIN_RTT_WINDOW_MS + 1));
+	bbr_pkts_acked(&conn, MSS, 30U);
+	zassert_equal(bbr->min_rtt, 30U, "minimum not expired");
+}
+
+ZTEST(net_tcp_bbr, test_loss)
+{
+	uint32_t cwnd;
+
+	for (uint32_t acked = 2000U; acked <= 8000U; acked *= 2U) {
+		ack_data(acked, 0U);
+	}
+
+	/* Loss is not a congestion signal */
+	cwnd = conn.ca.cwnd;
+	bbr_fast_retransmit(&conn);
+	bbr_dup_ack(&conn);
+	zassert_equal(conn.ca.cwnd, cwnd, "window reduced on loss");
+
+	/* The window restarts from one segment and grows back to the model */
+	bbr_timeout(&conn);
+	zassert_equal(conn.ca.cwnd, MSS, "window not reset");
+
+	ack_data(MSS, 0U);
+	zassert_equal(conn.ca.cwnd, 2 * MSS, "window not grown back");
+	zassert_equal(conn.ca.bbr.mode, BBR_STARTUP, "model lost");
+}
+
+ZTEST_SUITE(net_tcp_bbr, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+/* Build a copy of the algorithm to reach its static functions, under
+ * another name than the one linked into the stack.
+ */
+#define tcp_ca_cubic test_tcp_ca_cubic
+#include "tcp_cubic.c"
+
+#define MSS NET_TCP_DEFAULT_MSS
+
+static struct net_context context;
+static struct tcp conn;
+
+/* Acknowledge one congestion window, one segment at a time */
+static void ack_window(void)
+{
+	uint32_t segments = conn.ca.cwnd / MSS;
+
+	while (segments-- > 0U) {
+		cubic_pkts_acked(&conn, MSS, 0U);
+	}
+}
+
+/* Reduce the window from w_max segments on a fast retransmit, and
+ * complete the recovery.
+ */
+static void congestion_event(uint32_t w_max)
+{
+	conn.ca.cwnd = w_max * MSS;
+	conn.unacked_len = w_max * MSS;
+
+	cubic_fast_retransmit(&conn);
+	cubic_pkts_acked(&conn, conn.unacked_len, 0U);
+	conn.unacked_len = 0;
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	memset(&context, 0, sizeof(context));
+	net_context_set_family(&context, AF_INET);
+
+	memset(&conn, 0, sizeof(conn));
+	conn.context = &context;
+	conn.recv_options.mss = MSS;
+	conn.recv_options.mss_found = true;
+
+	cubic_init(&conn);
+}
+
+ZTEST(net_tcp_cubic, test_cubic_root)
+{
+	uint64_t cube;
+
+	zassert_equal(cubic_root(0U), 0U);
+	zassert_equal(cubic_root(1U), 1U);
+	zassert_equal(cubic_root(7U), 1U);
+	zassert_equal(cubic_root(8U), 2U);
+	zassert_equal(cubic_root(26U), 2U);
+	zassert_equal(cubic_root(27U), 3U);
+	zassert_equal(cubic_root(999999999U), 999U);
+	zassert_equal(cubic_root(1000000000U), 1000U);
+
+	/* Largest cube that fits into 64 bits */
+	zassert_equal(cubic_root(UINT64_MAX), 2642245U);
+
+	for (uint64_t y = 2U; y <= 2642245U; y += 997U) {
+		cube = y * y * y;
+
+		zassert_equal(cubic_root(cube), y, "wrong root of %llu",
+			      (unsigned long long)cube);
+		zassert_equal(cubic_root(cube - 1U), y - 1U, "wrong root of %llu",
+			      (unsigned long long)(cube - 1U));
+	}
+}
+
+ZTEST(net_tcp_cubic, test_slow_start)
+{
+	zassert_equal(conn.ca.cwnd, MSS * TCP_CONGESTION_INITIAL_WIN);
+	zassert_equal(conn.ca.ssthresh, NET_TCP_MAX_WIN);
+
+	cubic_pkts_acked(&conn, MSS, 0U);
+	zassert_equal(conn.ca.cwnd, 2 * MSS, "window not doubled");
+
+	/* At most one segment per acknowledgment */
+	cubic_pkts_acked(&conn, 3 * MSS, 0U);
+	zassert_equal(conn.ca.cwnd, 3 * MSS, "window grew too fast");
+}
+
+ZTEST(net_tcp_cubic, test_reduction)
+{
+	conn.ca.cwnd = 10 * MSS;
+	conn.unacked_len = 10 * MSS;
+
+	cubic_fast_retransmit(&conn);
+	zassert_equal(conn.ca.cubic.w_max, 10 * MSS, "wrong w_max");
+	zassert_equal(conn.ca.ssthresh, 7 * MSS, "beta not applied");
+	zassert_equal(conn.ca.cwnd, 10 * MSS, "wrong recovery window");
+
+	/* Inflated by the duplicate ACKs during the recovery only */
+	cubic_dup_ack(&conn);
+	zassert_equal(conn.ca.cwnd, 11 * MSS, "window not inflated");
+
+	cubic_pkts_acked(&conn, 10 * MSS, 0U);
+	zassert_equal(conn.ca.pending_fast_retransmit_bytes, 0, "recovery not ended");
+	zassert_equal(conn.ca.cwnd, 7 * MSS, "window not deflated");
+
+	cubic_dup_ack(&conn);
+	zassert_equal(conn.ca.cwnd, 7 * MSS, "window inflated after the recovery");
+
+	/* Fast convergence, the window did not reach w_max again */
+	conn.ca.cwnd = 8 * MSS;
+	cubic_timeout(&conn);
+	zassert_equal(conn.ca.cubic.w_max, 8 * MSS * 17 / 20, "no fast convergence");
+	zassert_equal(conn.ca.ssthresh, 8 * MSS * 7 / 10, "beta not applied");
+	zassert_equal(conn.ca.cwnd, MSS, "window not reset");
+}
+
+ZTEST(net_tcp_cubic, test_window_growth)
+{
+	uint32_t w_max = 10 * MSS;
+	uint32_t cwnd;
+
+	congestion_event(10);
+	cwnd = conn.ca.cwnd;
+
+	/* The first acknowledgment in congestion avoidance starts the epoch,
+	 * K = cubic_root((10 - 7) / 0.4) s = 1957 ms.
+	 */
+	ack_window();
+	zassert_not_equal(conn.ca.cubic.epoch_start, 0U, "epoch not started");
+	zassert_equal(conn.ca.cubic.k, 1957U, "wrong K");
+
+	/* Far from w_max the window grows at the Reno-friendly rate, by less
+	 * than one segment per window.
+	 */
+	zassert_true(conn.ca.cwnd > cwnd, "window did not grow");
+	zassert_true(conn.ca.cwnd < cwnd + MSS, "window grew too fast");
+
+	/* Concave region, the window reaches w_max and stays there */
+	k_sleep(K_MSEC(conn.ca.cubic.k));
+
+	for (int i = 0; i < 4; i++) {
+		ack_window();
+	}
+
+	zassert_true(conn.ca.cwnd >= w_max - MSS && conn.ca.cwnd <= w_max + MSS,
+		     "window %u not at w_max", conn.ca.cwnd);
+
+	/* Convex region, the window probes beyond w_max */
+	k_sleep(K_MSEC(3000));
+
+	cwnd = conn.ca.cwnd;
+	ack_window();
+
+	zassert_true(conn.ca.cwnd > w_max + 2 * MSS, "window %u not probing",
+		     conn.ca.cwnd);
+	zassert_true(conn.ca.cwnd < 2 * cwnd, "window grew faster than in slow start");
+}
+
+ZTEST_SUITE(net_tcp_cubic, NULL, NULL, before, NULL, NULL);
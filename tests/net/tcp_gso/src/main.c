@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP segmentation and receive offloads. The stack talks to a peer played
+ * by the test through a dummy interface, whose driver checks every segment
+ * handed to it, and to itself through the address of that interface.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "net_private.h"
+#include "tcp_private.h"
+
+#define MY_PORT 4242
+#define PEER_PORT 4243
+#define LOCAL_PORT 4244
+
+#define TEST_MTU NET_IPV4_MTU
+#define TEST_MSS (TEST_MTU - NET_IPV4TCPH_LEN)
+#define TEST_WIN 8192
+
+/* Segments in a super-packet, and data sent as two super-packets */
+#define GSO_SEGS (CONFIG_NET_TCP_GSO_MAX_SIZE / TEST_MSS)
+#define DATA_LEN (2 * GSO_SEGS * TEST_MSS)
+
+/* Segments sent back to back to the stack */
+#define GRO_SEGS 4
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct sockaddr_in my_addr_s = {
+	.sin_family = AF_INET,
+	.sin_port = htons(MY_PORT),
+	.sin_addr = { { { 192, 0, 2, 1 } } },
+};
+
+static struct sockaddr_in local_addr_s = {
+	.sin_family = AF_INET,
+	.sin_port = htons(LOCAL_PORT),
+	.sin_addr = { { { 192, 0, 2, 1 } } },
+};
+
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static struct sockaddr_in peer_addr_s = {
+	.sin_family = AF_INET,
+	.sin_port = htons(PEER_PORT),
+	.sin_addr = { { { 192, 0, 2, 2 } } },
+};
+
+static uint8_t test_data[DATA_LEN];
+
+static struct net_if *net_iface;
+static K_SEM_DEFINE(test_sem, 0, 1);
+
+enum test_state {
+	T_SYN = 0,
+	T_DATA,
+	T_CLOSED,
+};
+
+static enum test_state t_state;
+
+/* Port of the stack, and sequence numbers as seen by the peer */
+static uint16_t stack_port;
+static uint32_t stack_isn;
+static uint32_t peer_seq;
+static uint32_t peer_ack;
+
+/* What the driver was given */
+static int driver_pkts;
+static int data_segs;
+static int data_acks;
+
+/* What the application received */
+static struct net_context *accepted_ctx;
+static size_t recv_len;
+static int recv_calls;
+
+static void peer_send(uint8_t flags, const uint8_t *data, size_t len)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	struct net_pkt *pkt;
+	struct tcphdr *th;
+
+	pkt = net_pkt_alloc_with_buffer(net_iface, sizeof(struct tcphdr) + len,
+					AF_INET, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "cannot allocate a packet");
+
+	zassert_ok(net_ipv4_create(pkt, &peer_addr, &my_addr));
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(th, "no room for the TCP header");
+
+	memset(th, 0, sizeof(*th));
+	th->th_sport = htons(PEER_PORT);
+	th->th_dport = stack_port;
+	th->th_off = 5U;
+	th->th_flags = flags;
+	th->th_win = htons(TEST_WIN);
+	th->th_seq = htonl(peer_seq);
+
+	if (flags & ACK) {
+		th->th_ack = htonl(peer_ack);
+	}
+
+	zassert_ok(net_pkt_set_data(pkt, &tcp_access));
+
+	if (len > 0) {
+		zassert_ok(net_pkt_write(pkt, data, len));
+	}
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_TCP));
+	zassert_ok(net_recv_data(net_iface, pkt));
+
+	peer_seq += len + ((flags & (SYN | FIN)) ? 1U : 0U);
+}
+
+/* Check a segment given to the driver: it must fit into the MTU, have
+ * valid checksums and, for data, follow the previous one.
+ */
+static size_t check_segment(struct net_pkt *pkt, struct tcphdr *th)
+{
+	static uint8_t payload[TEST_MSS];
+	size_t len;
+
+	zassert_equal(net_pkt_gso_size(pkt), 0U, "super-packet given to the driver");
+	zassert_true(net_pkt_get_len(pkt) <= TEST_MTU, "segment of %zu bytes over the MTU",
+		     net_pkt_get_len(pkt));
+
+	zassert_equal(net_calc_chksum_ipv4(pkt), 0U, "bad IPv4 header checksum");
+	zassert_equal(net_calc_chksum_tcp(pkt), 0U, "bad TCP checksum");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	zassert_ok(net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt)));
+	zassert_ok(net_pkt_read(pkt, th, sizeof(*th)));
+	zassert_ok(net_pkt_skip(pkt, th_off(th) * 4U - sizeof(*th)));
+
+	len = net_pkt_remaining_data(pkt);
+	if (len == 0U) {
+		return 0U;
+	}
+
+	zassert_true(len <= TEST_MSS, "segment of %zu bytes over the MSS", len);
+	zassert_equal(th_seq(th), peer_ack, "segment out of order");
+	zassert_true(th_seq(th) - (stack_isn + 1U) + len <= DATA_LEN, "too much data");
+
+	zassert_ok(net_pkt_read(pkt, payload, len));
+	zassert_mem_equal(payload, &test_data[th_seq(th) - (stack_isn + 1U)], len,
+			  "data corrupted");
+
+	return len;
+}
+
+static int tester_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct tcphdr th;
+	size_t len;
+
+	ARG_UNUSED(dev);
+
+	driver_pkts++;
+
+	if (NET_IPV4_HDR(pkt)->proto != IPPROTO_TCP) {
+		return 0;
+	}
+
+	len = check_segment(pkt, &th);
+
+	switch (t_state) {
+	case T_SYN:
+		stack_isn = th_seq(&th);
+		peer_ack = stack_isn + 1U;
+
+		if (th_flags(&th) == SYN) {
+			/* The stack connects to the peer */
+			stack_port = th.th_sport;
+			peer_seq = 0U;
+			peer_send(SYN | ACK, NULL, 0U);
+		} else {
+			/* The stack accepts the connection of the peer */
+			zassert_equal(th_flags(&th), SYN | ACK, "SYN not acknowledged");
+			peer_send(ACK, NULL, 0U);
+		}
+
+		t_state = T_DATA;
+		break;
+	case T_DATA:
+		if (len > 0U) {
+			/* PSH is only kept on the last segment of a super-packet */
+			zassert_equal((th_flags(&th) & PSH) != 0U,
+				      data_segs % GSO_SEGS == GSO_SEGS - 1,
+				      "wrong PSH flag on segment %d", data_segs);
+
+			data_segs++;
+			peer_ack += len;
+
+			if (peer_ack == stack_isn + 1U + DATA_LEN) {
+				peer_send(ACK, NULL, 0U);
+				k_sem_give(&test_sem);
+			}
+		} else if (th_flags(&th) & FIN) {
+			peer_ack++;
+			peer_send(FIN | ACK, NULL, 0U);
+			t_state = T_CLOSED;
+		} else if (th_ack(&th) > 1U) {
+			/* The ACKs of the data sent by the peer, whose ISN is 0 */
+			zassert_equal(th_ack(&th), peer_seq, "data not acknowledged");
+			data_acks++;
+		}
+		break;
+	case T_CLOSED:
+		zassert_equal(th_flags(&th), ACK, "FIN not acknowledged");
+		k_sem_give(&test_sem);
+		break;
+	default:
+		zassert_unreachable("unexpected state");
+	}
+
+	return 0;
+}
+
+static void net_tcp_gso_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static struct dummy_api net_tcp_gso_if_api = {
+	.iface_api.init = net_tcp_gso_iface_init,
+	.send = tester_send,
+};
+
+NET_DEVICE_INIT(net_tcp_gso_test, "net_tcp_gso_test",
+		NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&net_tcp_gso_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), TEST_MTU);
+
+static void recv_cb(struct net_context *context, struct net_pkt *pkt,
+		    union net_ip_header *ip_hdr, union net_proto_header *proto_hdr,
+		    int status, void *user_data)
+{
+	size_t total = POINTER_TO_UINT(user_data);
+	static uint8_t payload[TEST_MSS];
+	size_t len;
+
+	ARG_UNUSED(context);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+
+	if (!pkt) {
+		return;
+	}
+
+	zassert_ok(status, "receive error");
+
+	recv_calls++;
+
+	while ((len = MIN(net_pkt_remaining_data(pkt), sizeof(payload))) > 0U) {
+		zassert_true(recv_len + len <= total, "too much data");
+		zassert_ok(net_pkt_read(pkt, payload, len));
+		zassert_mem_equal(payload, &test_data[recv_len], len, "data corrupted");
+		recv_len += len;
+	}
+
+	net_pkt_unref(pkt);
+
+	if (recv_len == total) {
+		k_sem_give(&test_sem);
+	}
+}
+
+static void accept_cb(struct net_context *ctx, struct sockaddr *addr,
+		      socklen_t addrlen, int status, void *user_data)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addrlen);
+	ARG_UNUSED(user_data);
+
+	zassert_ok(status, "accept failed");
+
+	net_context_ref(ctx);
+	accepted_ctx = ctx;
+
+	k_sem_give(&test_sem);
+}
+
+static struct net_context *test_listen(struct sockaddr_in *addr)
+{
+	struct net_context *ctx;
+
+	zassert_ok(net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx));
+	zassert_ok(net_context_bind(ctx, (struct sockaddr *)addr, sizeof(*addr)));
+	zassert_ok(net_context_listen(ctx, 1));
+	zassert_ok(net_context_accept(ctx, accept_cb, K_FOREVER, NULL));
+
+	return ctx;
+}
+
+static void test_close(struct net_context *ctx)
+{
+	net_context_put(ctx);
+
+	zassert_ok(k_sem_take(&test_sem, K_MSEC(1000)), "connection not closed");
+
+	/* Let the connection leave TIME_WAIT */
+	k_msleep(2 * CONFIG_NET_TCP_TIME_WAIT_DELAY);
+}
+
+/* Data sent by the stack leaves the interface in MSS sized segments, cut
+ * out of super-packets.
+ */
+ZTEST(net_tcp_gso, test_gso_segments)
+{
+	struct net_context *ctx;
+	int ret;
+
+	zassert_ok(net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx));
+	zassert_ok(net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				       sizeof(peer_addr_s), NULL, K_MSEC(1000), NULL));
+
+	ret = net_context_send(ctx, test_data, DATA_LEN, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, DATA_LEN, "send failed (%d)", ret);
+
+	zassert_ok(k_sem_take(&test_sem, K_MSEC(1000)), "data not received");
+	zassert_equal(data_segs, 2 * GSO_SEGS, "wrong number of segments");
+
+	test_close(ctx);
+}
+
+/* Data segments queued back to back to the stack are merged, and passed
+ * to the application and acknowledged once.
+ */
+ZTEST(net_tcp_gso, test_gro_merge)
+{
+	struct net_context *ctx;
+
+	stack_port = htons(MY_PORT);
+	peer_seq = 0U;
+
+	ctx = test_listen(&my_addr_s);
+
+	peer_send(SYN, NULL, 0U);
+	zassert_ok(k_sem_take(&test_sem, K_MSEC(1000)), "not accepted");
+
+	zassert_ok(net_context_recv(accepted_ctx, recv_cb, K_NO_WAIT,
+				    UINT_TO_POINTER(GRO_SEGS * TEST_MSS)));
+
+	/* The test thread is cooperative, the RX thread only runs once all
+	 * the segments are queued.
+	 */
+	for (int i = 0; i < GRO_SEGS; i++) {
+		peer_send(i == GRO_SEGS - 1 ? PSH | ACK : ACK,
+			  &test_data[i * TEST_MSS], TEST_MSS);
+	}
+
+	zassert_ok(k_sem_take(&test_sem, K_MSEC(1000)), "data not received");
+	zassert_equal(recv_calls, 1, "segments not merged (%d receives)", recv_calls);
+
+	/* Let the TX thread pass on the ACK */
+	k_msleep(10);
+	zassert_equal(data_acks, 1, "%d ACKs for the merged segments", data_acks);
+
+	net_context_put(ctx);
+	test_close(accepted_ctx);
+}
+
+/* Data sent by the stack to its own address is segmented and checksummed
+ * as well, without going through the driver.
+ */
+ZTEST(net_tcp_gso, test_gso_local)
+{
+	struct net_context *listen_ctx, *ctx;
+	int ret;
+
+	listen_ctx = test_listen(&local_addr_s);
+
+	zassert_ok(net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx));
+	zassert_ok(net_context_connect(ctx, (struct sockaddr *)&local_addr_s,
+				       sizeof(local_addr_s), NULL, K_MSEC(1000), NULL));
+	zassert_ok(k_sem_take(&test_sem, K_MSEC(1000)), "not accepted");
+
+	zassert_ok(net_context_recv(accepted_ctx, recv_cb, K_NO_WAIT,
+				    UINT_TO_POINTER(DATA_LEN)));
+
+	ret = net_context_send(ctx, test_data, DATA_LEN, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, DATA_LEN, "send failed (%d)", ret);
+
+	/* A segment over the MSS or without a checksum would be dropped */
+	zassert_ok(k_sem_take(&test_sem, K_MSEC(1000)), "data not received");
+	zassert_equal(recv_calls, 2 * GSO_SEGS, "data received in %d pieces", recv_calls);
+	zassert_equal(driver_pkts, 0, "local packets given to the driver");
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+	net_context_put(listen_ctx);
+
+	k_msleep(2 * CONFIG_NET_TCP_TIME_WAIT_DELAY);
+}
+
+static void *setup(void)
+{
+	net_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(net_iface, "interface not available");
+
+	zassert_not_null(net_if_ipv4_addr_add(net_iface, &my_addr, NET_ADDR_MANUAL, 0),
+			 "cannot add the IPv4 address");
+
+	for (size_t i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = i % 251;
+	}
+
+	return NULL;
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	t_state = T_SYN;
+	driver_pkts = 0;
+	data_segs = 0;
+	data_acks = 0;
+	accepted_ctx = NULL;
+	recv_len = 0U;
+	recv_calls = 0;
+	k_sem_reset(&test_sem);
+}
+
+ZTEST_SUITE(net_tcp_gso, NULL, setup, before, NULL, NULL);
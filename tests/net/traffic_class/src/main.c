@@ -27,9 +27,11 @@ LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
 #include <zephyr/net/buf.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_mgmt.h>
 #include <zephyr/net/udp.h>
 
 #include "ipv6.h"
+#include "udp_internal.h"
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
@@ -1053,6 +1055,173 @@ ZTEST(net_traffic_class, test_mix_all_2)
 	test_traffic_class_recv_data_mix_all_2();
 }
 
+#if defined(CONFIG_NET_RX_STEERING)
+ZTEST(net_traffic_class, test_rx_steering)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct net_rx_steering_config config;
+	int ret;
+
+	zassert_equal(net_if_rx_steering_get(iface),
+		      CONFIG_NET_RX_STEERING_QUEUES, "All queues not used");
+
+	ret = net_if_rx_steering_set(iface, CONFIG_NET_RX_STEERING_QUEUES + 1);
+	zassert_equal(ret, -EINVAL, "Too many queues accepted");
+
+	config.queues = 1U;
+	ret = net_mgmt(NET_REQUEST_RX_STEERING_SET, iface, &config,
+		       sizeof(config));
+	zassert_equal(ret, 0, "Cannot set RX steering (%d)", ret);
+	zassert_equal(net_if_rx_steering_get(iface), 1U, "Steering not disabled");
+
+	/* The traffic is still received with one queue per traffic class */
+	test_traffic_class_recv_data_mix();
+
+	ret = net_if_rx_steering_set(iface, 0U);
+	zassert_equal(ret, 0, "Cannot reset RX steering (%d)", ret);
+
+	ret = net_mgmt(NET_REQUEST_RX_STEERING_GET, iface, &config,
+		       sizeof(config));
+	zassert_equal(ret, 0, "Cannot get RX steering (%d)", ret);
+	zassert_equal(config.queues, CONFIG_NET_RX_STEERING_QUEUES,
+		      "All queues not used");
+}
+
+#define STEERING_PORT 4343
+#define STEERING_FLOWS 16
+#define STEERING_PKTS_PER_FLOW 4
+
+static int steering_queue[STEERING_FLOWS];
+static uint8_t steering_next_seq[STEERING_FLOWS];
+static atomic_t steering_moved;
+static atomic_t steering_reordered;
+static K_SEM_DEFINE(steering_recv, 0, UINT_MAX);
+
+static void steering_recv_cb(struct net_context *context,
+			     struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr,
+			     union net_proto_header *proto_hdr,
+			     int status,
+			     void *user_data)
+{
+	int flow = ntohs(proto_hdr->udp->src_port) - STEERING_PORT - 1;
+	int queue = net_tc_rx_current();
+	uint8_t seq;
+
+	if (flow >= 0 && flow < STEERING_FLOWS) {
+		if (steering_queue[flow] < 0) {
+			steering_queue[flow] = queue;
+		} else if (steering_queue[flow] != queue) {
+			atomic_inc(&steering_moved);
+		}
+
+		/* The payload starts with the sequence number in the flow */
+		if (net_pkt_read_u8(pkt, &seq) ||
+		    seq != steering_next_seq[flow]) {
+			atomic_inc(&steering_reordered);
+		}
+
+		steering_next_seq[flow] = seq + 1U;
+	}
+
+	net_pkt_unref(pkt);
+	k_sem_give(&steering_recv);
+}
+
+static void steering_recv_pkt(struct net_if *iface, uint16_t src_port,
+			      uint8_t seq)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(seq) + strlen(test_data),
+					   AF_INET6, IPPROTO_UDP, K_SECONDS(1));
+	zassert_not_null(pkt, "Out of mem");
+
+	if (net_ipv6_create(pkt, &dst_addr, &my_addr1) ||
+	    net_udp_create(pkt, htons(src_port), htons(STEERING_PORT)) ||
+	    net_pkt_write_u8(pkt, seq) ||
+	    net_pkt_write(pkt, test_data, strlen(test_data))) {
+		zassert_true(false, "Cannot create IPv6 UDP pkt %p", pkt);
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv6_finalize(pkt, IPPROTO_UDP);
+
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "Cannot recv pkt %p (%d)", pkt, ret);
+}
+
+ZTEST(net_traffic_class, test_rx_steering_flow)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct sockaddr_in6 addr6 = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(STEERING_PORT),
+	};
+	struct net_context *ctx;
+	bool spread = false;
+	int ret;
+
+	zassert_equal(net_if_rx_steering_set(iface, 0U), 0, "Cannot use all the queues");
+
+	ret = net_context_get(AF_INET6, SOCK_DGRAM, IPPROTO_UDP, &ctx);
+	zassert_equal(ret, 0, "Cannot create UDP context (%d)", ret);
+
+	memcpy(&addr6.sin6_addr, &my_addr1, sizeof(struct in6_addr));
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&addr6, sizeof(addr6));
+	zassert_equal(ret, 0, "Cannot bind UDP context (%d)", ret);
+
+	ret = net_context_recv(ctx, steering_recv_cb, K_NO_WAIT, NULL);
+	zassert_equal(ret, 0, "Cannot receive on UDP context (%d)", ret);
+
+	for (int i = 0; i < STEERING_FLOWS; i++) {
+		steering_queue[i] = -1;
+		steering_next_seq[i] = 0U;
+	}
+
+	atomic_set(&steering_moved, 0);
+	atomic_set(&steering_reordered, 0);
+	k_sem_reset(&steering_recv);
+
+	/* The flows are interleaved, so that each packet of a flow could go
+	 * to another queue than the previous one, or overtake it.
+	 */
+	for (int n = 0; n < STEERING_PKTS_PER_FLOW; n++) {
+		for (int i = 0; i < STEERING_FLOWS; i++) {
+			steering_recv_pkt(iface, STEERING_PORT + 1 + i, n);
+		}
+	}
+
+	for (int n = 0; n < STEERING_FLOWS * STEERING_PKTS_PER_FLOW; n++) {
+		zassert_ok(k_sem_take(&steering_recv, WAIT_TIME), "Packet %d not received", n);
+	}
+
+	net_context_put(ctx);
+
+	zassert_equal(atomic_get(&steering_moved), 0,
+		      "%ld packets not in the queue of their flow",
+		      (long)atomic_get(&steering_moved));
+	zassert_equal(atomic_get(&steering_reordered), 0,
+		      "%ld packets received out of order in their flow",
+		      (long)atomic_get(&steering_reordered));
+
+	for (int i = 0; i < STEERING_FLOWS; i++) {
+		zassert_true(steering_queue[i] >= 0, "Flow %d not received by an RX queue", i);
+		zassert_equal(steering_next_seq[i], STEERING_PKTS_PER_FLOW,
+			      "Flow %d not received in full", i);
+
+		if (steering_queue[i] != steering_queue[0]) {
+			spread = true;
+		}
+	}
+
+	/* The flows are spread on the queues */
+	zassert_true(spread, "All the flows in queue %d", steering_queue[0]);
+}
+#endif
+
 static void run_before(void *dummy)
 {
 	ARG_UNUSED(dummy);
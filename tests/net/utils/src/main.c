@@ -923,4 +923,48 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+ZTEST(test_utils_fn, test_ip_checksum_update)
+{
+	uint16_t __aligned(4) hdr[20];
+	uint16_t old_field[8];
+	uint16_t new_field[8];
+	uint32_t old_val;
+	uint32_t new_val;
+	uint16_t chksum;
+
+	for (int i = 0; i < ARRAY_SIZE(hdr); i++) {
+		hdr[i] = (uint16_t)((i + 7) * 0x1d37);
+	}
+
+	chksum = htons(~calc_chksum(0U, (uint8_t *)hdr, sizeof(hdr)));
+
+	/* 16-bit field, e.g. a length or a port */
+	chksum = net_chksum_update16(chksum, hdr[3], htons(0xbeef));
+	hdr[3] = htons(0xbeef);
+
+	zassert_equal(chksum, htons(~calc_chksum(0U, (uint8_t *)hdr, sizeof(hdr))),
+		      "Mismatch after 16-bit field update");
+
+	/* 32-bit field, e.g. an IPv4 address */
+	memcpy(&old_val, &hdr[6], sizeof(old_val));
+	new_val = htonl(0xc0000201);
+	chksum = net_chksum_update32(chksum, old_val, new_val);
+	memcpy(&hdr[6], &new_val, sizeof(new_val));
+
+	zassert_equal(chksum, htons(~calc_chksum(0U, (uint8_t *)hdr, sizeof(hdr))),
+		      "Mismatch after 32-bit field update");
+
+	/* Longer field, e.g. an IPv6 address */
+	memcpy(old_field, &hdr[10], sizeof(old_field));
+	for (int i = 0; i < ARRAY_SIZE(new_field); i++) {
+		new_field[i] = (uint16_t)(i * 0x4b1f);
+	}
+
+	chksum = net_chksum_update(chksum, old_field, new_field, sizeof(new_field));
+	memcpy(&hdr[10], new_field, sizeof(new_field));
+
+	zassert_equal(chksum, htons(~calc_chksum(0U, (uint8_t *)hdr, sizeof(hdr))),
+		      "Mismatch after field update");
+}
+
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);